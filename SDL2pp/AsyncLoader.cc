@@ -0,0 +1,241 @@
+/*
+  libSDL2pp - C++11 bindings/wrapper for SDL2
+  Copyright (C) 2013-2016 Dmitry Marakasov <amdmi3@amdmi3.ru>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include <memory>
+#include <thread>
+#include <utility>
+
+#include <SDL2pp/Config.hh>
+
+#include <SDL_timer.h>
+
+#include <SDL2pp/AsyncLoader.hh>
+#include <SDL2pp/Renderer.hh>
+#include <SDL2pp/ThreadPool.hh>
+#ifdef SDL2PP_WITH_IMAGE
+#	include <SDL2pp/RWops.hh>
+#endif
+
+namespace SDL2pp {
+
+AsyncLoader::AsyncLoader(Renderer& renderer, unsigned int num_threads) : renderer_(&renderer), state_(std::make_shared<State>()) {
+	if (num_threads == 0)
+		num_threads = std::thread::hardware_concurrency();
+	if (num_threads == 0)
+		num_threads = 1;
+
+	own_pool_.reset(new ThreadPool(num_threads));
+	pool_ = own_pool_.get();
+}
+
+AsyncLoader::AsyncLoader(Renderer& renderer, ThreadPool& pool) : renderer_(&renderer), pool_(&pool), state_(std::make_shared<State>()) {
+}
+
+AsyncLoader::~AsyncLoader() {
+	std::deque<Decoded> abandoned;
+
+	{
+		std::unique_lock<std::mutex> lock(state_->mutex);
+		state_->abandoned = true;
+		state_->cond.wait(lock, [this]{ return state_->running == 0; });
+		abandoned.swap(state_->decoded);
+	}
+
+	// own pool discards jobs which have not started yet when
+	// destroyed; jobs in shared pool see the loader abandoned
+	// and do nothing
+}
+
+void AsyncLoader::Enqueue(std::function<void(State&)>&& job) {
+	auto shared_job = std::make_shared<std::function<void(State&)>>(std::move(job));
+	std::shared_ptr<State> state = state_;
+
+	{
+		std::lock_guard<std::mutex> lock(state_->mutex);
+		state_->pending++;
+	}
+
+	try {
+		pool_->Submit([state, shared_job]() {
+				{
+					std::lock_guard<std::mutex> lock(state->mutex);
+					if (state->abandoned)
+						return;
+					state->running++;
+				}
+
+				(*shared_job)(*state);
+
+				{
+					std::lock_guard<std::mutex> lock(state->mutex);
+					state->running--;
+				}
+				state->cond.notify_all();
+			});
+	} catch (...) {
+		std::lock_guard<std::mutex> lock(state_->mutex);
+		state_->pending--;
+		throw;
+	}
+}
+
+void AsyncLoader::EnqueueDecode(const Decoder& decoder, std::function<void(Decoded&)>&& complete) {
+	auto handler = std::make_shared<std::function<void(Decoded&)>>(std::move(complete));
+
+	Enqueue([decoder, handler](State& state) {
+			Decoded decoded;
+			try {
+				decoded.surface.emplace(decoder());
+			} catch (...) {
+				decoded.error = std::current_exception();
+			}
+			decoded.complete = std::move(*handler);
+
+			std::lock_guard<std::mutex> lock(state.mutex);
+			state.decoded.emplace_back(std::move(decoded));
+		});
+}
+
+std::future<Texture> AsyncLoader::Load(const Decoder& decoder) {
+	auto promise = std::make_shared<std::promise<Texture>>();
+	std::future<Texture> future = promise->get_future();
+
+	EnqueueDecode(decoder, [this, promise](Decoded& decoded) {
+			try {
+				if (decoded.error)
+					std::rethrow_exception(decoded.error);
+				promise->set_value(Texture(*renderer_, *decoded.surface));
+			} catch (...) {
+				promise->set_exception(std::current_exception());
+			}
+		});
+
+	return future;
+}
+
+std::future<void> AsyncLoader::Load(const Decoder& decoder, const Callback& callback) {
+	auto promise = std::make_shared<std::promise<void>>();
+	std::future<void> future = promise->get_future();
+
+	EnqueueDecode(decoder, [this, promise, callback](Decoded& decoded) {
+			try {
+				if (decoded.error)
+					std::rethrow_exception(decoded.error);
+				callback(Texture(*renderer_, *decoded.surface));
+				promise->set_value();
+			} catch (...) {
+				promise->set_exception(std::current_exception());
+			}
+		});
+
+	return future;
+}
+
+std::future<Surface> AsyncLoader::LoadSurface(const Decoder& decoder) {
+	auto promise = std::make_shared<std::promise<Surface>>();
+	std::future<Surface> future = promise->get_future();
+
+	Enqueue([decoder, promise](State& state) {
+			try {
+				promise->set_value(decoder());
+			} catch (...) {
+				promise->set_exception(std::current_exception());
+			}
+
+			std::lock_guard<std::mutex> lock(state.mutex);
+			state.pending--;
+		});
+
+	return future;
+}
+
+#ifdef SDL2PP_WITH_IMAGE
+std::future<Texture> AsyncLoader::Load(const std::string& path) {
+	return Load([path]() { return Surface(path); });
+}
+
+std::future<void> AsyncLoader::Load(const std::string& path, const Callback& callback) {
+	return Load([path]() { return Surface(path); }, callback);
+}
+
+std::future<Texture> AsyncLoader::Load(RWops&& rwops) {
+	auto shared = std::make_shared<RWops>(std::move(rwops));
+	return Load([shared]() { return Surface(*shared); });
+}
+
+std::future<void> AsyncLoader::Load(RWops&& rwops, const Callback& callback) {
+	auto shared = std::make_shared<RWops>(std::move(rwops));
+	return Load([shared]() { return Surface(*shared); }, callback);
+}
+
+std::future<Surface> AsyncLoader::LoadSurface(const std::string& path) {
+	return LoadSurface([path]() { return Surface(path); });
+}
+#endif
+
+int AsyncLoader::Pump(size_t byte_budget, double time_budget) {
+	Uint64 start = SDL_GetPerformanceCounter();
+	Uint64 time_limit = static_cast<Uint64>(time_budget * static_cast<double>(SDL_GetPerformanceFrequency()));
+	size_t bytes = 0;
+	int processed = 0;
+
+	while (true) {
+		Decoded decoded;
+
+		{
+			std::lock_guard<std::mutex> lock(state_->mutex);
+
+			if (state_->decoded.empty())
+				break;
+
+			Decoded& front = state_->decoded.front();
+
+			size_t cost = 0;
+			if (front.surface)
+				cost = static_cast<size_t>(front.surface->GetHeight()) * static_cast<size_t>(front.surface->Get()->pitch);
+
+			if (processed > 0) {
+				if (byte_budget != 0 && bytes + cost > byte_budget)
+					break;
+				if (time_limit != 0 && SDL_GetPerformanceCounter() - start >= time_limit)
+					break;
+			}
+
+			decoded = std::move(front);
+			state_->decoded.pop_front();
+			state_->pending--;
+
+			bytes += cost;
+		}
+
+		decoded.complete(decoded);
+		processed++;
+	}
+
+	return processed;
+}
+
+size_t AsyncLoader::GetNumPending() {
+	std::lock_guard<std::mutex> lock(state_->mutex);
+	return state_->pending;
+}
+
+}
@@ -0,0 +1,346 @@
+/*
+  libSDL2pp - C++11 bindings/wrapper for SDL2
+  Copyright (C) 2013-2016 Dmitry Marakasov <amdmi3@amdmi3.ru>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef SDL2PP_ASYNCLOADER_HH
+#define SDL2PP_ASYNCLOADER_HH
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <SDL2pp/Config.hh>
+#include <SDL2pp/Optional.hh>
+#include <SDL2pp/Surface.hh>
+#include <SDL2pp/Texture.hh>
+#include <SDL2pp/Export.hh>
+
+namespace SDL2pp {
+
+class Renderer;
+class ThreadPool;
+
+////////////////////////////////////////////////////////////
+/// \brief Background image loader
+///
+/// \ingroup rendering
+///
+/// \headerfile SDL2pp/AsyncLoader.hh
+///
+/// Decodes images into surfaces on SDL2pp::ThreadPool, either
+/// own or shared with other users, keeping expensive decoding
+/// off the rendering thread. As
+/// textures may only be created on the rendering thread,
+/// decoded surfaces are queued until Pump() is called, which
+/// creates textures from them, limited by per-call byte and
+/// time budgets so uploads do not cause frame hitches.
+///
+/// Results are delivered through futures, or through callbacks
+/// invoked from Pump().
+///
+/// Usage example:
+/// \code
+/// {
+///     SDL2pp::AsyncLoader loader(renderer);
+///
+///     std::future<SDL2pp::Texture> future = loader.Load("level.png");
+///
+///     while (...) {
+///         // create at most 4MB of textures per frame
+///         loader.Pump(4 * 1024 * 1024);
+///
+///         if (future.valid() && future.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+///             level_texture.emplace(future.get());
+///
+///         ...
+///     }
+/// }
+/// \endcode
+///
+/// \note Destroying the loader abandons pending loads, which
+///       makes their futures throw std::future_error
+///
+////////////////////////////////////////////////////////////
+class SDL2PP_EXPORT AsyncLoader {
+public:
+	////////////////////////////////////////////////////////////
+	/// \brief Function which produces surface on a worker thread
+	///
+	////////////////////////////////////////////////////////////
+	typedef std::function<Surface()> Decoder;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Function which receives loaded texture
+	///
+	////////////////////////////////////////////////////////////
+	typedef std::function<void(Texture)> Callback;
+
+private:
+	////////////////////////////////////////////////////////////
+	/// \brief Decoded surface waiting to be turned into texture
+	///
+	////////////////////////////////////////////////////////////
+	struct Decoded {
+		Optional<Surface> surface;                     ///< Decoded surface, if decoding succeeded
+		std::exception_ptr error;                      ///< Decoding error, if decoding failed
+		std::function<void(Decoded&)> complete;        ///< Completion handler, called on rendering thread
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief State shared with jobs queued to the thread pool
+	///
+	/// Jobs may outlive the loader when thread pool is shared,
+	/// so they keep the state alive and check whether the loader
+	/// is still there before running.
+	///
+	////////////////////////////////////////////////////////////
+	struct State {
+		std::mutex mutex;                              ///< Mutex protecting everything below
+		std::condition_variable cond;                  ///< Signaled when a job finishes running
+		std::deque<Decoded> decoded;                   ///< Decoded surfaces waiting for Pump()
+		size_t pending = 0;                            ///< Number of loads not yet completed
+		size_t running = 0;                            ///< Number of jobs currently running
+		bool abandoned = false;                        ///< Whether loader was destroyed
+	};
+
+	Renderer* renderer_;                               ///< Renderer to create textures with
+
+	std::unique_ptr<ThreadPool> own_pool_;             ///< Thread pool created by the loader, if any
+	ThreadPool* pool_;                                 ///< Thread pool to run jobs on
+	std::shared_ptr<State> state_;                     ///< State shared with queued jobs
+
+private:
+	////////////////////////////////////////////////////////////
+	/// \brief Queue job to thread pool
+	///
+	/// \param[in] job Job to run on worker thread, must not throw
+	///
+	////////////////////////////////////////////////////////////
+	void Enqueue(std::function<void(State&)>&& job);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Queue decoding job which finishes on rendering thread
+	///
+	/// \param[in] decoder Function which produces surface
+	/// \param[in] complete Completion handler
+	///
+	////////////////////////////////////////////////////////////
+	void EnqueueDecode(const Decoder& decoder, std::function<void(Decoded&)>&& complete);
+
+public:
+	////////////////////////////////////////////////////////////
+	/// \brief Create loader with its own thread pool
+	///
+	/// \param[in] renderer Rendering context to create textures for
+	/// \param[in] num_threads Number of worker threads, 0 to use
+	///                        number of hardware threads
+	///
+	////////////////////////////////////////////////////////////
+	AsyncLoader(Renderer& renderer, unsigned int num_threads = 0);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Create loader using existing thread pool
+	///
+	/// Decoding jobs are queued to the pool along with other
+	/// work, and are also picked up by threads waiting in
+	/// ThreadPool::ParallelFor(). If the pool has no worker
+	/// threads, images are decoded right in Load().
+	///
+	/// \param[in] renderer Rendering context to create textures for
+	/// \param[in] pool Thread pool to decode images on; must
+	///                 outlive the loader
+	///
+	////////////////////////////////////////////////////////////
+	AsyncLoader(Renderer& renderer, ThreadPool& pool);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Destructor
+	///
+	/// Waits for images currently being decoded, abandons all
+	/// other pending loads.
+	///
+	////////////////////////////////////////////////////////////
+	virtual ~AsyncLoader();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Deleted copy constructor
+	///
+	/// This class is not copyable
+	///
+	////////////////////////////////////////////////////////////
+	AsyncLoader(const AsyncLoader& other) = delete;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Deleted assignment operator
+	///
+	/// This class is not copyable
+	///
+	////////////////////////////////////////////////////////////
+	AsyncLoader& operator=(const AsyncLoader& other) = delete;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Load texture using custom decoder
+	///
+	/// \param[in] decoder Function which produces surface, called
+	///                    on worker thread
+	///
+	/// \returns Future which receives the texture once it's
+	///          created by Pump(), or an exception if decoding or
+	///          texture creation failed
+	///
+	////////////////////////////////////////////////////////////
+	std::future<Texture> Load(const Decoder& decoder);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Load texture using custom decoder, with callback
+	///
+	/// \param[in] decoder Function which produces surface, called
+	///                    on worker thread
+	/// \param[in] callback Function which receives the texture,
+	///                     called from Pump()
+	///
+	/// \returns Future which becomes ready after callback returns,
+	///          or receives an exception if decoding, texture creation
+	///          or callback failed
+	///
+	////////////////////////////////////////////////////////////
+	std::future<void> Load(const Decoder& decoder, const Callback& callback);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Decode surface using custom decoder
+	///
+	/// Does not involve rendering thread, so Pump() does not need
+	/// to be called for the future to become ready.
+	///
+	/// \param[in] decoder Function which produces surface, called
+	///                    on worker thread
+	///
+	/// \returns Future which receives the surface
+	///
+	////////////////////////////////////////////////////////////
+	std::future<Surface> LoadSurface(const Decoder& decoder);
+
+#ifdef SDL2PP_WITH_IMAGE
+	////////////////////////////////////////////////////////////
+	/// \brief Load texture from file
+	///
+	/// \param[in] path Path to image file
+	///
+	/// \returns Future which receives the texture
+	///
+	/// \see http://www.libsdl.org/projects/SDL_image/docs/SDL_image.html#SEC11
+	///
+	////////////////////////////////////////////////////////////
+	std::future<Texture> Load(const std::string& path);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Load texture from file, with callback
+	///
+	/// \param[in] path Path to image file
+	/// \param[in] callback Function which receives the texture,
+	///                     called from Pump()
+	///
+	/// \returns Future which becomes ready after callback returns
+	///
+	/// \see http://www.libsdl.org/projects/SDL_image/docs/SDL_image.html#SEC11
+	///
+	////////////////////////////////////////////////////////////
+	std::future<void> Load(const std::string& path, const Callback& callback);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Load texture from RWops
+	///
+	/// \param[in] rwops RWops used to access an image file; it's
+	///                  taken over by the loader and accessed from
+	///                  worker thread
+	///
+	/// \returns Future which receives the texture
+	///
+	/// \see http://www.libsdl.org/projects/SDL_image/docs/SDL_image.html#SEC11
+	///
+	////////////////////////////////////////////////////////////
+	std::future<Texture> Load(RWops&& rwops);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Load texture from RWops, with callback
+	///
+	/// \param[in] rwops RWops used to access an image file; it's
+	///                  taken over by the loader and accessed from
+	///                  worker thread
+	/// \param[in] callback Function which receives the texture,
+	///                     called from Pump()
+	///
+	/// \returns Future which becomes ready after callback returns
+	///
+	/// \see http://www.libsdl.org/projects/SDL_image/docs/SDL_image.html#SEC11
+	///
+	////////////////////////////////////////////////////////////
+	std::future<void> Load(RWops&& rwops, const Callback& callback);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Decode surface from file
+	///
+	/// \param[in] path Path to image file
+	///
+	/// \returns Future which receives the surface
+	///
+	/// \see http://www.libsdl.org/projects/SDL_image/docs/SDL_image.html#SEC11
+	///
+	////////////////////////////////////////////////////////////
+	std::future<Surface> LoadSurface(const std::string& path);
+#endif
+
+	////////////////////////////////////////////////////////////
+	/// \brief Create textures from decoded surfaces
+	///
+	/// Must be called from the rendering thread, usually once
+	/// per frame. Creates textures and runs completion callbacks
+	/// until either of budgets is exhausted. At least one texture
+	/// is always processed if available, so loading always makes
+	/// progress.
+	///
+	/// \param[in] byte_budget Maximal size of surface data to upload,
+	///                        in bytes, 0 for no limit
+	/// \param[in] time_budget Maximal time to spend, in seconds,
+	///                        0 for no limit
+	///
+	/// \returns Number of textures processed
+	///
+	////////////////////////////////////////////////////////////
+	int Pump(size_t byte_budget = 0, double time_budget = 0.0);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get number of loads which are not yet completed
+	///
+	/// \returns Number of queued, decoding and decoded but not
+	///          yet pumped loads
+	///
+	////////////////////////////////////////////////////////////
+	size_t GetNumPending();
+};
+
+}
+
+#endif
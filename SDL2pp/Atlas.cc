@@ -0,0 +1,273 @@
+/*
+  libSDL2pp - C++11 bindings/wrapper for SDL2
+  Copyright (C) 2013-2016 Dmitry Marakasov <amdmi3@amdmi3.ru>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+#include <SDL_pixels.h>
+#include <SDL_surface.h>
+
+#include <SDL2pp/Atlas.hh>
+#include <SDL2pp/Renderer.hh>
+
+namespace SDL2pp {
+
+AtlasRegion::AtlasRegion() : atlas_(nullptr), index_(0) {
+}
+
+AtlasRegion::AtlasRegion(Atlas* atlas, size_t index) : atlas_(atlas), index_(index) {
+}
+
+bool AtlasRegion::IsValid() const {
+	return atlas_ != nullptr;
+}
+
+Texture& AtlasRegion::GetTexture() const {
+	return atlas_->pages_[atlas_->images_[index_].page];
+}
+
+Rect AtlasRegion::GetRect() const {
+	return atlas_->images_[index_].rect;
+}
+
+int AtlasRegion::GetWidth() const {
+	return atlas_->images_[index_].rect.w;
+}
+
+int AtlasRegion::GetHeight() const {
+	return atlas_->images_[index_].rect.h;
+}
+
+Point AtlasRegion::GetSize() const {
+	return atlas_->images_[index_].rect.GetSize();
+}
+
+Atlas::Image::Image(Surface&& surface) : surface(std::move(surface)), page(0) {
+}
+
+Atlas::Atlas(Renderer& renderer, int page_width, int page_height, int padding, int extrusion, Uint32 format)
+	: renderer_(&renderer),
+	  format_(format),
+	  page_width_(page_width),
+	  page_height_(page_height),
+	  padding_(padding),
+	  extrusion_(extrusion) {
+}
+
+Point Atlas::GetFootprint(const Image& image) const {
+	return Point(
+			image.surface.GetWidth() + extrusion_ * 2 + padding_,
+			image.surface.GetHeight() + extrusion_ * 2 + padding_
+		);
+}
+
+Optional<Rect> Atlas::Place(const Image& image, RectPacker& packer) const {
+	Optional<Rect> area = packer.Pack(GetFootprint(image));
+	if (!area)
+		return NullOpt;
+	return Rect(area->x + extrusion_, area->y + extrusion_, image.surface.GetWidth(), image.surface.GetHeight());
+}
+
+Optional<Rect> Atlas::Place(const Image& image, std::vector<RectPacker>& packers, size_t& page) const {
+	for (page = 0; page < packers.size(); ++page) {
+		Optional<Rect> rect = Place(image, packers[page]);
+		if (rect)
+			return rect;
+	}
+	return NullOpt;
+}
+
+Texture Atlas::CreatePage() {
+	Texture page(*renderer_, format_, SDL_TEXTUREACCESS_STATIC, page_width_, page_height_);
+	page.SetBlendMode(SDL_BLENDMODE_BLEND);
+
+	// make padding transparent
+	int pitch = page_width_ * SDL_BYTESPERPIXEL(format_);
+	std::vector<Uint8> zeroes(static_cast<size_t>(pitch) * static_cast<size_t>(page_height_), 0);
+	page.Update(NullOpt, zeroes.data(), pitch);
+
+	return page;
+}
+
+void Atlas::Upload(Image& image, const Rect& rect, Texture& page) {
+	Surface::LockHandle lock = image.surface.Lock();
+
+	const int bpp = lock.GetFormat().BytesPerPixel;
+	const int w = rect.w;
+	const int h = rect.h;
+	const int e = extrusion_;
+
+	if (e == 0) {
+		page.Update(rect, lock.GetPixels(), lock.GetPitch());
+		return;
+	}
+
+	// copy image into a block with border pixels replicated
+	const int block_w = w + e * 2;
+	const int block_h = h + e * 2;
+	const int block_pitch = block_w * bpp;
+	std::vector<Uint8> block(static_cast<size_t>(block_pitch) * static_cast<size_t>(block_h));
+
+	const Uint8* pixels = static_cast<const Uint8*>(lock.GetPixels());
+	for (int y = 0; y < block_h; ++y) {
+		int src_y = std::min(std::max(y - e, 0), h - 1);
+		const Uint8* src = pixels + src_y * lock.GetPitch();
+		Uint8* dst = block.data() + y * block_pitch;
+
+		for (int x = 0; x < e; ++x)
+			std::memcpy(dst + x * bpp, src, static_cast<size_t>(bpp));
+		std::memcpy(dst + e * bpp, src, static_cast<size_t>(w * bpp));
+		for (int x = 0; x < e; ++x)
+			std::memcpy(dst + (e + w + x) * bpp, src + (w - 1) * bpp, static_cast<size_t>(bpp));
+	}
+
+	page.Update(Rect(rect.x - e, rect.y - e, block_w, block_h), block.data(), block_pitch);
+}
+
+bool Atlas::Relayout(size_t max_pages, Image* pending) {
+	const size_t count = images_.size() + (pending ? 1 : 0);
+	auto image_at = [this, pending](size_t index) -> Image& {
+		return index < images_.size() ? images_[index] : *pending;
+	};
+
+	std::vector<size_t> order(count);
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), [this, &image_at](size_t a, size_t b) {
+			Point fa = GetFootprint(image_at(a));
+			Point fb = GetFootprint(image_at(b));
+			return fa.y > fb.y || (fa.y == fb.y && fa.x > fb.x);
+		});
+
+	// lay out and upload into scratch packers and pages first, so
+	// atlas is left intact if images do not fit or upload fails
+	std::vector<RectPacker> packers;
+	std::vector<std::pair<size_t, Rect>> layout(count);
+
+	for (size_t index : order) {
+		size_t page;
+		Optional<Rect> rect = Place(image_at(index), packers, page);
+		if (!rect) {
+			if (packers.size() >= max_pages)
+				return false;
+			packers.emplace_back(page_width_ + padding_, page_height_ + padding_);
+			rect = Place(image_at(index), packers, page);
+			assert(rect);
+		}
+		layout[index] = std::make_pair(page, *rect);
+	}
+
+	std::vector<Texture> pages;
+	pages.reserve(packers.size());
+	while (pages.size() < packers.size())
+		pages.push_back(CreatePage());
+
+	for (size_t index = 0; index < count; ++index)
+		Upload(image_at(index), layout[index].second, pages[layout[index].first]);
+
+	for (size_t index = 0; index < count; ++index) {
+		image_at(index).page = layout[index].first;
+		image_at(index).rect = layout[index].second;
+	}
+
+	packers_ = std::move(packers);
+	pages_ = std::move(pages);
+
+	return true;
+}
+
+AtlasRegion Atlas::Add(Surface& surface) {
+	if (surface.GetWidth() <= 0 || surface.GetHeight() <= 0)
+		throw std::invalid_argument("Cannot add empty surface to Atlas");
+
+	Image image(surface.Convert(format_));
+
+	Point footprint = GetFootprint(image);
+	if (footprint.x > page_width_ + padding_ || footprint.y > page_height_ + padding_)
+		throw std::invalid_argument("Surface does not fit into Atlas page");
+
+	// image is placed into a copy of page layout, so its space
+	// is only reserved, and image is only stored, after it was
+	// successfully uploaded
+	Optional<Rect> rect;
+	for (size_t page = 0; page < packers_.size() && !rect; ++page) {
+		RectPacker packer = packers_[page];
+		rect = Place(image, packer);
+		if (rect) {
+			Upload(image, *rect, pages_[page]);
+
+			image.page = page;
+			image.rect = *rect;
+			packers_[page] = std::move(packer);
+		}
+	}
+
+	if (!rect && (pages_.empty() || !Relayout(pages_.size(), &image))) {
+		// no luck even after repacking, start a new page
+		std::vector<RectPacker> packers;
+		packers.emplace_back(page_width_ + padding_, page_height_ + padding_);
+		size_t page;
+		rect = Place(image, packers, page);
+		assert(rect);
+
+		Texture texture = CreatePage();
+		Upload(image, *rect, texture);
+
+		image.page = pages_.size();
+		image.rect = *rect;
+		pages_.push_back(std::move(texture));
+		packers_.push_back(std::move(packers.front()));
+	}
+
+	images_.push_back(std::move(image));
+
+	return AtlasRegion(this, images_.size() - 1);
+}
+
+AtlasRegion Atlas::Add(Surface&& surface) {
+	return Add(surface);
+}
+
+Atlas& Atlas::Repack() {
+	Relayout(images_.size());
+	return *this;
+}
+
+AtlasRegion Atlas::GetRegion(size_t index) {
+	return AtlasRegion(this, index);
+}
+
+size_t Atlas::GetNumRegions() const {
+	return images_.size();
+}
+
+size_t Atlas::GetNumPages() const {
+	return pages_.size();
+}
+
+Texture& Atlas::GetPage(size_t index) {
+	return pages_[index];
+}
+
+}
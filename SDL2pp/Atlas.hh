@@ -0,0 +1,396 @@
+/*
+  libSDL2pp - C++11 bindings/wrapper for SDL2
+  Copyright (C) 2013-2016 Dmitry Marakasov <amdmi3@amdmi3.ru>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef SDL2PP_ATLAS_HH
+#define SDL2PP_ATLAS_HH
+
+#include <vector>
+
+#include <SDL_stdinc.h>
+#include <SDL_pixels.h>
+
+#include <SDL2pp/Optional.hh>
+#include <SDL2pp/Point.hh>
+#include <SDL2pp/Rect.hh>
+#include <SDL2pp/RectPacker.hh>
+#include <SDL2pp/Surface.hh>
+#include <SDL2pp/Texture.hh>
+#include <SDL2pp/Export.hh>
+
+namespace SDL2pp {
+
+class Atlas;
+class Renderer;
+
+////////////////////////////////////////////////////////////
+/// \brief Handle to an image stored in SDL2pp::Atlas
+///
+/// \ingroup rendering
+///
+/// \headerfile SDL2pp/Atlas.hh
+///
+/// This is a lightweight copyable handle which may be passed
+/// to Renderer::Copy directly. Texture and rectangle are
+/// resolved on each access, so the handle stays valid when
+/// atlas is repacked. Handle must not outlive its atlas.
+///
+////////////////////////////////////////////////////////////
+class SDL2PP_EXPORT AtlasRegion {
+	friend class Atlas;
+private:
+	Atlas* atlas_; ///< Atlas this region belongs to
+	size_t index_; ///< Index of image in the atlas
+
+private:
+	////////////////////////////////////////////////////////////
+	/// \brief Construct handle for specific image in the atlas
+	///
+	/// \param[in] atlas Atlas image belongs to
+	/// \param[in] index Index of image in the atlas
+	///
+	////////////////////////////////////////////////////////////
+	AtlasRegion(Atlas* atlas, size_t index);
+
+public:
+	////////////////////////////////////////////////////////////
+	/// \brief Construct empty handle
+	///
+	/// This may be initialized with real handle later via
+	/// assignment
+	///
+	////////////////////////////////////////////////////////////
+	AtlasRegion();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Check whether handle refers to an image
+	///
+	/// \returns True if handle is not empty
+	///
+	////////////////////////////////////////////////////////////
+	bool IsValid() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get texture containing the image
+	///
+	/// Returned reference is invalidated by Atlas::Add() and
+	/// Atlas::Repack(), which may repack images into new pages.
+	///
+	/// \returns Atlas page texture
+	///
+	////////////////////////////////////////////////////////////
+	Texture& GetTexture() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get image location in the texture
+	///
+	/// \returns Rectangle occupied by the image in the texture
+	///
+	////////////////////////////////////////////////////////////
+	Rect GetRect() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get image width
+	///
+	/// \returns Image width in pixels
+	///
+	////////////////////////////////////////////////////////////
+	int GetWidth() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get image height
+	///
+	/// \returns Image height in pixels
+	///
+	////////////////////////////////////////////////////////////
+	int GetHeight() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get image size
+	///
+	/// \returns SDL2pp::Point representing image dimensions in pixels
+	///
+	////////////////////////////////////////////////////////////
+	Point GetSize() const;
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Set of images packed into a few large textures
+///
+/// \ingroup rendering
+///
+/// \headerfile SDL2pp/Atlas.hh
+///
+/// Drawing many small images from a single texture avoids
+/// texture switches. Atlas packs surfaces into one or more
+/// textures (pages) of fixed size and returns AtlasRegion
+/// handles which may be drawn with Renderer::Copy.
+///
+/// Images are separated by padding pixels which are kept
+/// transparent. Additionally, image border pixels may be
+/// extruded (replicated outwards) to avoid bleeding of
+/// neighbour pixels when image is drawn scaled with linear
+/// filtering.
+///
+/// When new image does not fit into existing pages, atlas
+/// first tries to repack all images into existing pages,
+/// and only allocates a new page if that fails. For this
+/// purpose, atlas keeps a copy of each image in system
+/// memory.
+///
+/// Page textures are created with SDL_BLENDMODE_BLEND.
+///
+/// Usage example:
+/// \code
+/// {
+///     SDL2pp::Atlas atlas(renderer, 1024, 1024);
+///
+///     SDL2pp::AtlasRegion crate = atlas.Add(SDL2pp::Surface("crate.png"));
+///     SDL2pp::AtlasRegion tree = atlas.Add(SDL2pp::Surface("tree.png"));
+///
+///     // both are drawn from the same texture
+///     renderer.Copy(crate, SDL2pp::Point(0, 0));
+///     renderer.Copy(tree, SDL2pp::Point(32, 0));
+/// }
+/// \endcode
+///
+////////////////////////////////////////////////////////////
+class SDL2PP_EXPORT Atlas {
+	friend class AtlasRegion;
+private:
+	////////////////////////////////////////////////////////////
+	/// \brief Image stored in the atlas
+	///
+	////////////////////////////////////////////////////////////
+	struct Image {
+		Surface surface; ///< Image pixels, in atlas format
+		size_t page;     ///< Index of page containing the image
+		Rect rect;       ///< Image location in the page
+
+		Image(Surface&& surface);
+	};
+
+	Renderer* renderer_;             ///< Renderer to create textures with
+	Uint32 format_;                  ///< Pixel format of page textures
+	int page_width_;                 ///< Width of page textures
+	int page_height_;                ///< Height of page textures
+	int padding_;                    ///< Number of transparent pixels between images
+	int extrusion_;                  ///< Number of border pixels to extrude
+
+	std::vector<Texture> pages_;     ///< Page textures
+	std::vector<RectPacker> packers_; ///< Layout of each page
+	std::vector<Image> images_;      ///< Stored images
+
+private:
+	////////////////////////////////////////////////////////////
+	/// \brief Get size of area occupied by the image in a page
+	///
+	/// \param[in] image Image to get size for
+	///
+	/// \returns Size including extrusion and padding
+	///
+	////////////////////////////////////////////////////////////
+	Point GetFootprint(const Image& image) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Place image into a page
+	///
+	/// \param[in] image Image to place
+	/// \param[in,out] packer Page layout
+	///
+	/// \returns Rectangle occupied by image itself, or NullOpt
+	///          if it does not fit into the page
+	///
+	////////////////////////////////////////////////////////////
+	Optional<Rect> Place(const Image& image, RectPacker& packer) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Place image into first page with enough space
+	///
+	/// \param[in] image Image to place
+	/// \param[in] packers Page layouts
+	/// \param[out] page Index of page the image was placed to
+	///
+	/// \returns Rectangle occupied by image itself, or NullOpt
+	///          if it does not fit into any page
+	///
+	////////////////////////////////////////////////////////////
+	Optional<Rect> Place(const Image& image, std::vector<RectPacker>& packers, size_t& page) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Create new empty page texture
+	///
+	/// \returns Page texture, not yet added to the atlas
+	///
+	/// \throws SDL2pp::Exception
+	///
+	////////////////////////////////////////////////////////////
+	Texture CreatePage();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Upload image (with extruded borders) into a page
+	///
+	/// \param[in] image Image to upload
+	/// \param[in] rect Rectangle occupied by image itself
+	/// \param[in] page Page texture to upload to
+	///
+	/// \throws SDL2pp::Exception
+	///
+	////////////////////////////////////////////////////////////
+	void Upload(Image& image, const Rect& rect, Texture& page);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Lay out all images anew, sorted by height
+	///
+	/// All pages are replaced with new textures.
+	///
+	/// \param[in] max_pages Maximal number of pages to use
+	/// \param[in,out] pending Image not yet stored in the atlas to
+	///                        lay out along with stored ones, or
+	///                        nullptr
+	///
+	/// \returns False if images do not fit into max_pages;
+	///          in that case atlas is not modified
+	///
+	/// \throws SDL2pp::Exception; in that case atlas is not modified
+	///
+	////////////////////////////////////////////////////////////
+	bool Relayout(size_t max_pages, Image* pending = nullptr);
+
+public:
+	////////////////////////////////////////////////////////////
+	/// \brief Create empty atlas
+	///
+	/// \param[in] renderer Rendering context to create textures for
+	/// \param[in] page_width Width of page textures
+	/// \param[in] page_height Height of page textures
+	/// \param[in] padding Number of transparent pixels between images
+	/// \param[in] extrusion Number of image border pixels to replicate
+	///                      outwards
+	/// \param[in] format Pixel format of page textures, one of
+	///                   SDL_PixelFormatEnum values
+	///
+	////////////////////////////////////////////////////////////
+	Atlas(Renderer& renderer, int page_width, int page_height, int padding = 1, int extrusion = 0, Uint32 format = SDL_PIXELFORMAT_ARGB8888);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Deleted copy constructor
+	///
+	/// This class is not copyable, as regions refer to it
+	///
+	////////////////////////////////////////////////////////////
+	Atlas(const Atlas& other) = delete;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Deleted assignment operator
+	///
+	/// This class is not copyable, as regions refer to it
+	///
+	////////////////////////////////////////////////////////////
+	Atlas& operator=(const Atlas& other) = delete;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Add image to the atlas
+	///
+	/// Surface is converted to atlas pixel format and copied, so
+	/// it may be freely modified or destroyed afterwards.
+	///
+	/// \param[in] surface Image to add
+	///
+	/// \returns Handle to added image
+	///
+	/// \throws SDL2pp::Exception
+	/// \throws std::invalid_argument if surface is empty or does not
+	///         fit into a page
+	///
+	////////////////////////////////////////////////////////////
+	AtlasRegion Add(Surface& surface);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Add image to the atlas
+	///
+	/// \param[in] surface Image to add
+	///
+	/// \returns Handle to added image
+	///
+	/// \throws SDL2pp::Exception
+	/// \throws std::invalid_argument if surface is empty or does not
+	///         fit into a page
+	///
+	////////////////////////////////////////////////////////////
+	AtlasRegion Add(Surface&& surface);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Repack all images
+	///
+	/// Lays out all images anew in order of decreasing height,
+	/// which usually gives denser packing than incremental
+	/// insertion, and drops pages which are no longer needed.
+	///
+	/// \returns Reference to self
+	///
+	/// \throws SDL2pp::Exception
+	///
+	////////////////////////////////////////////////////////////
+	Atlas& Repack();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get handle for image by its index
+	///
+	/// \param[in] index Index of image, in order of addition
+	///
+	/// \returns Handle to the image
+	///
+	////////////////////////////////////////////////////////////
+	AtlasRegion GetRegion(size_t index);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get number of images in the atlas
+	///
+	/// \returns Number of images
+	///
+	////////////////////////////////////////////////////////////
+	size_t GetNumRegions() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get number of page textures
+	///
+	/// \returns Number of pages
+	///
+	////////////////////////////////////////////////////////////
+	size_t GetNumPages() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get page texture
+	///
+	/// Returned reference is invalidated by Add() and Repack(),
+	/// which may repack images into new pages.
+	///
+	/// \param[in] index Index of page
+	///
+	/// \returns Page texture
+	///
+	////////////////////////////////////////////////////////////
+	Texture& GetPage(size_t index);
+};
+
+}
+
+#endif
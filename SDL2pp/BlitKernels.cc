@@ -0,0 +1,447 @@
+/*
+  libSDL2pp - C++11 bindings/wrapper for SDL2
+  Copyright (C) 2013-2016 Dmitry Marakasov <amdmi3@amdmi3.ru>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include <cstring>
+
+#include <SDL_cpuinfo.h>
+#include <SDL_pixels.h>
+#include <SDL_rect.h>
+#include <SDL_surface.h>
+#include <SDL_version.h>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#	define SDL2PP_BLIT_X86
+#	include <emmintrin.h>
+#	include <immintrin.h>
+#endif
+
+#if defined(__GNUC__)
+#	define SDL2PP_TARGET(isa) __attribute__((target(isa)))
+#else
+#	define SDL2PP_TARGET(isa)
+#endif
+
+#include <SDL2pp/BlitKernels.hh>
+
+namespace SDL2pp {
+
+namespace {
+
+////////////////////////////////////////////////////////////
+// Scalar kernels
+//
+// Blending follows SDL's BlitRGBtoRGBPixelAlpha bit for bit:
+// red and blue are processed together in one 32 bit word,
+// (s - d) * a >> 8 is used instead of division by 255, and
+// fully transparent and fully opaque pixels are special-cased.
+// SIMD kernels reproduce exactly the same arithmetic.
+////////////////////////////////////////////////////////////
+
+inline Uint32 SwapRB(Uint32 pixel) {
+	return (pixel & 0xff00ff00) | ((pixel >> 16) & 0xff) | ((pixel & 0xff) << 16);
+}
+
+inline Uint32 BlendPixel(Uint32 s, Uint32 d) {
+	Uint32 alpha = s >> 24;
+	if (alpha == 0)
+		return d;
+	if (alpha == 0xff)
+		return s;
+
+	Uint32 s1 = s & 0xff00ff;
+	Uint32 d1 = d & 0xff00ff;
+	d1 = (d1 + ((s1 - d1) * alpha >> 8)) & 0xff00ff;
+
+	Uint32 s2 = s & 0xff00;
+	Uint32 d2 = d & 0xff00;
+	d2 = (d2 + ((s2 - d2) * alpha >> 8)) & 0xff00;
+
+	Uint32 dalpha = d >> 24;
+	dalpha = alpha + (dalpha * (alpha ^ 0xff) >> 8);
+
+	return d1 | d2 | (dalpha << 24);
+}
+
+void CopyRow(const Uint32* src, Uint32* dst, int count) {
+	std::memcpy(dst, src, static_cast<size_t>(count) * sizeof(Uint32));
+}
+
+void CopySwapRowScalar(const Uint32* src, Uint32* dst, int count) {
+	for (int i = 0; i < count; i++)
+		dst[i] = SwapRB(src[i]);
+}
+
+void BlendRowScalar(const Uint32* src, Uint32* dst, int count) {
+	for (int i = 0; i < count; i++)
+		dst[i] = BlendPixel(src[i], dst[i]);
+}
+
+void BlendSwapRowScalar(const Uint32* src, Uint32* dst, int count) {
+	for (int i = 0; i < count; i++)
+		dst[i] = BlendPixel(SwapRB(src[i]), dst[i]);
+}
+
+#ifdef SDL2PP_BLIT_X86
+
+////////////////////////////////////////////////////////////
+// SSE2 kernels, 4 pixels per iteration
+////////////////////////////////////////////////////////////
+
+SDL2PP_TARGET("sse2") inline __m128i SwapRBSSE2(__m128i pixels) {
+	const __m128i mask_ag = _mm_set1_epi32(static_cast<int>(0xff00ff00));
+	const __m128i mask_b = _mm_set1_epi32(0xff);
+
+	return _mm_or_si128(
+		_mm_and_si128(pixels, mask_ag),
+		_mm_or_si128(
+			_mm_and_si128(_mm_srli_epi32(pixels, 16), mask_b),
+			_mm_slli_epi32(_mm_and_si128(pixels, mask_b), 16)
+		)
+	);
+}
+
+// SSE2 has no 32 bit multiplication keeping low halves, so do
+// even and odd lanes with 32x32->64 bit multiplies and merge
+SDL2PP_TARGET("sse2") inline __m128i MulLo32SSE2(__m128i a, __m128i b) {
+	__m128i even = _mm_mul_epu32(a, b);
+	__m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+	return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+SDL2PP_TARGET("sse2") inline __m128i BlendSSE2(__m128i s, __m128i d) {
+	const __m128i mask_rb = _mm_set1_epi32(0xff00ff);
+	const __m128i mask_g = _mm_set1_epi32(0xff00);
+	const __m128i mask_ff = _mm_set1_epi32(0xff);
+
+	__m128i alpha = _mm_srli_epi32(s, 24);
+
+	__m128i s1 = _mm_and_si128(s, mask_rb);
+	__m128i d1 = _mm_and_si128(d, mask_rb);
+	d1 = _mm_and_si128(_mm_add_epi32(d1, _mm_srli_epi32(MulLo32SSE2(_mm_sub_epi32(s1, d1), alpha), 8)), mask_rb);
+
+	__m128i s2 = _mm_and_si128(s, mask_g);
+	__m128i d2 = _mm_and_si128(d, mask_g);
+	d2 = _mm_and_si128(_mm_add_epi32(d2, _mm_srli_epi32(MulLo32SSE2(_mm_sub_epi32(s2, d2), alpha), 8)), mask_g);
+
+	// both factors fit in 8 bits, so 16 bit multiply is exact
+	__m128i dalpha = _mm_srli_epi32(d, 24);
+	dalpha = _mm_add_epi32(alpha, _mm_srli_epi32(_mm_mullo_epi16(dalpha, _mm_xor_si128(alpha, mask_ff)), 8));
+
+	__m128i blended = _mm_or_si128(_mm_or_si128(d1, d2), _mm_slli_epi32(dalpha, 24));
+
+	__m128i transparent = _mm_cmpeq_epi32(alpha, _mm_setzero_si128());
+	__m128i opaque = _mm_cmpeq_epi32(alpha, mask_ff);
+
+	blended = _mm_or_si128(_mm_and_si128(transparent, d), _mm_andnot_si128(transparent, blended));
+	return _mm_or_si128(_mm_and_si128(opaque, s), _mm_andnot_si128(opaque, blended));
+}
+
+SDL2PP_TARGET("sse2") void CopySwapRowSSE2(const Uint32* src, Uint32* dst, int count) {
+	int i = 0;
+	for (; i + 4 <= count; i += 4)
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), SwapRBSSE2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i))));
+	CopySwapRowScalar(src + i, dst + i, count - i);
+}
+
+SDL2PP_TARGET("sse2") void BlendRowSSE2(const Uint32* src, Uint32* dst, int count) {
+	int i = 0;
+	for (; i + 4 <= count; i += 4) {
+		__m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+		__m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), BlendSSE2(s, d));
+	}
+	BlendRowScalar(src + i, dst + i, count - i);
+}
+
+SDL2PP_TARGET("sse2") void BlendSwapRowSSE2(const Uint32* src, Uint32* dst, int count) {
+	int i = 0;
+	for (; i + 4 <= count; i += 4) {
+		__m128i s = SwapRBSSE2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)));
+		__m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), BlendSSE2(s, d));
+	}
+	BlendSwapRowScalar(src + i, dst + i, count - i);
+}
+
+////////////////////////////////////////////////////////////
+// AVX2 kernels, 8 pixels per iteration
+////////////////////////////////////////////////////////////
+
+SDL2PP_TARGET("avx2") inline __m256i SwapRBAVX2(__m256i pixels) {
+	const __m256i shuffle = _mm256_setr_epi8(
+		2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15,
+		2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15
+	);
+	return _mm256_shuffle_epi8(pixels, shuffle);
+}
+
+SDL2PP_TARGET("avx2") inline __m256i BlendAVX2(__m256i s, __m256i d) {
+	const __m256i mask_rb = _mm256_set1_epi32(0xff00ff);
+	const __m256i mask_g = _mm256_set1_epi32(0xff00);
+	const __m256i mask_ff = _mm256_set1_epi32(0xff);
+
+	__m256i alpha = _mm256_srli_epi32(s, 24);
+
+	__m256i s1 = _mm256_and_si256(s, mask_rb);
+	__m256i d1 = _mm256_and_si256(d, mask_rb);
+	d1 = _mm256_and_si256(_mm256_add_epi32(d1, _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_sub_epi32(s1, d1), alpha), 8)), mask_rb);
+
+	__m256i s2 = _mm256_and_si256(s, mask_g);
+	__m256i d2 = _mm256_and_si256(d, mask_g);
+	d2 = _mm256_and_si256(_mm256_add_epi32(d2, _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_sub_epi32(s2, d2), alpha), 8)), mask_g);
+
+	__m256i dalpha = _mm256_srli_epi32(d, 24);
+	dalpha = _mm256_add_epi32(alpha, _mm256_srli_epi32(_mm256_mullo_epi16(dalpha, _mm256_xor_si256(alpha, mask_ff)), 8));
+
+	__m256i blended = _mm256_or_si256(_mm256_or_si256(d1, d2), _mm256_slli_epi32(dalpha, 24));
+
+	__m256i transparent = _mm256_cmpeq_epi32(alpha, _mm256_setzero_si256());
+	__m256i opaque = _mm256_cmpeq_epi32(alpha, mask_ff);
+
+	blended = _mm256_blendv_epi8(blended, d, transparent);
+	return _mm256_blendv_epi8(blended, s, opaque);
+}
+
+SDL2PP_TARGET("avx2") void CopySwapRowAVX2(const Uint32* src, Uint32* dst, int count) {
+	int i = 0;
+	for (; i + 8 <= count; i += 8)
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), SwapRBAVX2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i))));
+	CopySwapRowScalar(src + i, dst + i, count - i);
+}
+
+SDL2PP_TARGET("avx2") void BlendRowAVX2(const Uint32* src, Uint32* dst, int count) {
+	int i = 0;
+	for (; i + 8 <= count; i += 8) {
+		__m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+		__m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), BlendAVX2(s, d));
+	}
+	BlendRowScalar(src + i, dst + i, count - i);
+}
+
+SDL2PP_TARGET("avx2") void BlendSwapRowAVX2(const Uint32* src, Uint32* dst, int count) {
+	int i = 0;
+	for (; i + 8 <= count; i += 8) {
+		__m256i s = SwapRBAVX2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i)));
+		__m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), BlendAVX2(s, d));
+	}
+	BlendSwapRowScalar(src + i, dst + i, count - i);
+}
+
+#endif // SDL2PP_BLIT_X86
+
+}
+
+bool BlitKernels::IsIsaSupported(Isa isa) {
+	switch (isa) {
+	case Isa::Scalar:
+		return true;
+#ifdef SDL2PP_BLIT_X86
+	case Isa::SSE2:
+		return SDL_HasSSE2();
+#	if SDL_VERSION_ATLEAST(2, 0, 4)
+	case Isa::AVX2:
+		return SDL_HasAVX2();
+#	endif
+#endif
+	default:
+		return false;
+	}
+}
+
+BlitKernels::Isa BlitKernels::GetBestIsa() {
+	if (IsIsaSupported(Isa::AVX2))
+		return Isa::AVX2;
+	if (IsIsaSupported(Isa::SSE2))
+		return Isa::SSE2;
+	return Isa::Scalar;
+}
+
+BlitKernels::RowKernel BlitKernels::GetRowKernel(Uint32 src_format, Uint32 dst_format, SDL_BlendMode blend_mode, Isa isa) {
+	if (dst_format != SDL_PIXELFORMAT_ARGB8888)
+		return nullptr;
+	if (src_format != SDL_PIXELFORMAT_ARGB8888 && src_format != SDL_PIXELFORMAT_ABGR8888)
+		return nullptr;
+
+	bool swap = src_format == SDL_PIXELFORMAT_ABGR8888;
+
+	if (blend_mode == SDL_BLENDMODE_NONE) {
+		if (!swap)
+			return &CopyRow;
+
+		switch (isa) {
+#ifdef SDL2PP_BLIT_X86
+		case Isa::AVX2: return &CopySwapRowAVX2;
+		case Isa::SSE2: return &CopySwapRowSSE2;
+#endif
+		default: return &CopySwapRowScalar;
+		}
+	}
+
+	if (blend_mode == SDL_BLENDMODE_BLEND) {
+		switch (isa) {
+#ifdef SDL2PP_BLIT_X86
+		case Isa::AVX2: return swap ? &BlendSwapRowAVX2 : &BlendRowAVX2;
+		case Isa::SSE2: return swap ? &BlendSwapRowSSE2 : &BlendRowSSE2;
+#endif
+		default: return swap ? &BlendSwapRowScalar : &BlendRowScalar;
+		}
+	}
+
+	return nullptr;
+}
+
+BlitKernels::RowKernel BlitKernels::GetSurfaceKernel(SDL_Surface* src, SDL_Surface* dst) {
+	// check whether fast path applies at all
+	if (src == dst || (src->flags & SDL_RLEACCEL))
+		return nullptr;
+
+	Uint32 colorkey;
+	if (SDL_GetColorKey(src, &colorkey) == 0)
+		return nullptr;
+
+	Uint8 r, g, b, a;
+	if (SDL_GetSurfaceColorMod(src, &r, &g, &b) != 0 || r != 0xff || g != 0xff || b != 0xff)
+		return nullptr;
+	if (SDL_GetSurfaceAlphaMod(src, &a) != 0 || a != 0xff)
+		return nullptr;
+
+	SDL_BlendMode blend_mode;
+	if (SDL_GetSurfaceBlendMode(src, &blend_mode) != 0)
+		return nullptr;
+
+	return GetRowKernel(src->format->format, dst->format->format, blend_mode, GetBestIsa());
+}
+
+bool BlitKernels::ClipBlit(const SDL_Surface* src, const SDL_Rect* srcrect, const SDL_Surface* dst, SDL_Rect* dstrect, SDL_Rect* clipped_srcrect) {
+	// same as SDL_UpperBlit
+	int srcx = 0, srcy = 0, w = src->w, h = src->h;
+	if (srcrect) {
+		srcx = srcrect->x;
+		w = srcrect->w;
+		if (srcx < 0) {
+			w += srcx;
+			dstrect->x -= srcx;
+			srcx = 0;
+		}
+		if (src->w - srcx < w)
+			w = src->w - srcx;
+
+		srcy = srcrect->y;
+		h = srcrect->h;
+		if (srcy < 0) {
+			h += srcy;
+			dstrect->y -= srcy;
+			srcy = 0;
+		}
+		if (src->h - srcy < h)
+			h = src->h - srcy;
+	}
+
+	const SDL_Rect& clip = dst->clip_rect;
+
+	int dx = clip.x - dstrect->x;
+	if (dx > 0) {
+		w -= dx;
+		dstrect->x += dx;
+		srcx += dx;
+	}
+	dx = dstrect->x + w - clip.x - clip.w;
+	if (dx > 0)
+		w -= dx;
+
+	int dy = clip.y - dstrect->y;
+	if (dy > 0) {
+		h -= dy;
+		dstrect->y += dy;
+		srcy += dy;
+	}
+	dy = dstrect->y + h - clip.y - clip.h;
+	if (dy > 0)
+		h -= dy;
+
+	if (w <= 0 || h <= 0) {
+		dstrect->w = dstrect->h = 0;
+		return false;
+	}
+
+	dstrect->w = w;
+	dstrect->h = h;
+
+	clipped_srcrect->x = srcx;
+	clipped_srcrect->y = srcy;
+	clipped_srcrect->w = w;
+	clipped_srcrect->h = h;
+
+	return true;
+}
+
+bool BlitKernels::Blit(SDL_Surface* src, const SDL_Rect* srcrect, SDL_Surface* dst, SDL_Rect* dstrect) {
+	RowKernel kernel = GetSurfaceKernel(src, dst);
+	if (kernel == nullptr)
+		return false;
+
+	// dstrect is only updated once it's certain that blit is
+	// done here, as caller passes it to SDL otherwise
+	SDL_Rect final_dstrect = *dstrect;
+	SDL_Rect clipped;
+	if (!ClipBlit(src, srcrect, dst, &final_dstrect, &clipped)) {
+		*dstrect = final_dstrect;
+		return true;
+	}
+
+	// blit
+	bool src_locked = false, dst_locked = false;
+	if (SDL_MUSTLOCK(src)) {
+		if (SDL_LockSurface(src) != 0)
+			return false;
+		src_locked = true;
+	}
+	if (SDL_MUSTLOCK(dst)) {
+		if (SDL_LockSurface(dst) != 0) {
+			if (src_locked)
+				SDL_UnlockSurface(src);
+			return false;
+		}
+		dst_locked = true;
+	}
+
+	const Uint8* srcrow = static_cast<const Uint8*>(src->pixels) + clipped.y * src->pitch + clipped.x * 4;
+	Uint8* dstrow = static_cast<Uint8*>(dst->pixels) + final_dstrect.y * dst->pitch + final_dstrect.x * 4;
+
+	for (int y = 0; y < clipped.h; y++) {
+		kernel(reinterpret_cast<const Uint32*>(srcrow), reinterpret_cast<Uint32*>(dstrow), clipped.w);
+		srcrow += src->pitch;
+		dstrow += dst->pitch;
+	}
+
+	if (dst_locked)
+		SDL_UnlockSurface(dst);
+	if (src_locked)
+		SDL_UnlockSurface(src);
+
+	*dstrect = final_dstrect;
+
+	return true;
+}
+
+}
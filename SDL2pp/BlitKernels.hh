@@ -0,0 +1,179 @@
+/*
+  libSDL2pp - C++11 bindings/wrapper for SDL2
+  Copyright (C) 2013-2016 Dmitry Marakasov <amdmi3@amdmi3.ru>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef SDL2PP_BLITKERNELS_HH
+#define SDL2PP_BLITKERNELS_HH
+
+#include <SDL_stdinc.h>
+#include <SDL_blendmode.h>
+
+#include <SDL2pp/Export.hh>
+
+struct SDL_Surface;
+struct SDL_Rect;
+
+namespace SDL2pp {
+
+////////////////////////////////////////////////////////////
+/// \brief Fast paths for common surface blits
+///
+/// \ingroup graphics
+///
+/// \headerfile SDL2pp/BlitKernels.hh
+///
+/// SDL2pp::Surface::BlitFast() and SDL2pp::SurfaceCanvas use
+/// these for copying and alpha blending of ARGB8888 and ABGR8888
+/// surfaces onto ARGB8888 surfaces, falling back to SDL's generic
+/// blitters for everything else, including surfaces with color
+/// key, color or alpha modulation, or RLE acceleration.
+/// SDL2pp::Surface::Blit() is not affected and always uses SDL.
+///
+/// SSE2 and AVX2 kernels are picked at runtime based on
+/// CPU features, with scalar fallback. All variants produce
+/// identical output, which follows SDL's own scalar
+/// per-pixel alpha blitter. SDL itself may use other blitters
+/// (such as MMX one on x86), so alpha blended pixels may differ
+/// from SDL_BlitSurface output by up to 2 per channel.
+///
+////////////////////////////////////////////////////////////
+class SDL2PP_EXPORT BlitKernels {
+public:
+	////////////////////////////////////////////////////////////
+	/// \brief Instruction set used by kernels
+	///
+	////////////////////////////////////////////////////////////
+	enum class Isa {
+		Scalar, ///< Portable C++ code
+		SSE2,   ///< SSE2 intrinsics
+		AVX2,   ///< AVX2 intrinsics
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Function processing a single row of pixels
+	///
+	/// \param[in] src Source pixels
+	/// \param[in,out] dst Destination pixels
+	/// \param[in] count Number of pixels to process
+	///
+	////////////////////////////////////////////////////////////
+	typedef void (*RowKernel)(const Uint32* src, Uint32* dst, int count);
+
+public:
+	////////////////////////////////////////////////////////////
+	/// \brief Deleted constructor
+	///
+	/// This class only has static members
+	///
+	////////////////////////////////////////////////////////////
+	BlitKernels() = delete;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Check whether instruction set may be used
+	///
+	/// \param[in] isa Instruction set
+	///
+	/// \returns True if kernels for the instruction set were
+	///          compiled in and CPU supports it
+	///
+	/// \see http://wiki.libsdl.org/SDL_HasSSE2
+	/// \see http://wiki.libsdl.org/SDL_HasAVX2
+	///
+	////////////////////////////////////////////////////////////
+	static bool IsIsaSupported(Isa isa);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get best instruction set supported by the CPU
+	///
+	/// \returns Instruction set used by Blit()
+	///
+	////////////////////////////////////////////////////////////
+	static Isa GetBestIsa();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get row kernel for given blit
+	///
+	/// \param[in] src_format Source pixel format
+	/// \param[in] dst_format Destination pixel format
+	/// \param[in] blend_mode Blend mode of the source surface
+	/// \param[in] isa Instruction set to use, must be supported
+	///
+	/// \returns Kernel function, or nullptr if there's no
+	///          fast path for given combination
+	///
+	////////////////////////////////////////////////////////////
+	static RowKernel GetRowKernel(Uint32 src_format, Uint32 dst_format, SDL_BlendMode blend_mode, Isa isa);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get row kernel for blitting one surface onto another
+	///
+	/// Takes into account all surface properties affecting
+	/// the blit, such as blend mode, color key and modulation.
+	///
+	/// \param[in] src Source surface
+	/// \param[in] dst Destination surface
+	///
+	/// \returns Kernel for the best supported instruction set, or
+	///          nullptr if blit has to be done by SDL
+	///
+	////////////////////////////////////////////////////////////
+	static RowKernel GetSurfaceKernel(SDL_Surface* src, SDL_Surface* dst);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Clip blit rectangles the same way SDL_BlitSurface does
+	///
+	/// \param[in] src Source surface
+	/// \param[in] srcrect Source rectangle, or nullptr for the whole surface
+	/// \param[in] dst Destination surface
+	/// \param[in,out] dstrect Destination position, replaced with
+	///                        final destination rectangle
+	/// \param[out] clipped_srcrect Final source rectangle
+	///
+	/// \returns False if nothing is to be blitted
+	///
+	/// \see http://wiki.libsdl.org/SDL_BlitSurface
+	///
+	////////////////////////////////////////////////////////////
+	static bool ClipBlit(const SDL_Surface* src, const SDL_Rect* srcrect, const SDL_Surface* dst, SDL_Rect* dstrect, SDL_Rect* clipped_srcrect);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Perform blit using fast path if possible
+	///
+	/// Clips rectangles the same way SDL_BlitSurface does,
+	/// including updating dstrect with the final blit rectangle.
+	/// If false is returned, dstrect is left untouched.
+	///
+	/// \param[in] src Source surface
+	/// \param[in] srcrect Source rectangle, or nullptr for the whole surface
+	/// \param[in] dst Destination surface
+	/// \param[in,out] dstrect Destination position
+	///
+	/// \returns True if blit was performed, false if there's no fast
+	///          path for given surfaces and SDL_BlitSurface should be used
+	///
+	/// \see http://wiki.libsdl.org/SDL_BlitSurface
+	///
+	////////////////////////////////////////////////////////////
+	static bool Blit(SDL_Surface* src, const SDL_Rect* srcrect, SDL_Surface* dst, SDL_Rect* dstrect);
+};
+
+}
+
+#endif
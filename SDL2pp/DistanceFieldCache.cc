@@ -0,0 +1,406 @@
+/*
+  libSDL2pp - C++11 bindings/wrapper for SDL2
+  Copyright (C) 2013-2016 Dmitry Marakasov <amdmi3@amdmi3.ru>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include <SDL_hints.h>
+
+#include <SDL2pp/DistanceFieldCache.hh>
+#include <SDL2pp/Font.hh>
+#include <SDL2pp/GlyphUtils.hh>
+#include <SDL2pp/PixelView.hh>
+#include <SDL2pp/UTF8.hh>
+
+namespace SDL2pp {
+
+namespace {
+
+// squared distance for pixels without a feature; large, but
+// still finite so it may take part in the arithmetics below
+const double no_feature = 1e20;
+
+// glyph images are generated for discrete scales, this many
+// per doubling of size
+const int scale_steps_per_octave = 4;
+
+int RoundToInt(float value) {
+	return static_cast<int>(std::floor(value + 0.5f));
+}
+
+float GetStepScale(int step) {
+	return std::pow(2.0f, static_cast<float>(step) / scale_steps_per_octave);
+}
+
+// one dimensional squared euclidean distance transform of
+// n values with given stride, done in place; see Felzenszwalb
+// and Huttenlocher, "Distance Transforms of Sampled Functions"
+void DistanceTransform(double* grid, int stride, int n, std::vector<double>& f, std::vector<int>& v, std::vector<double>& z) {
+	for (int q = 0; q < n; q++)
+		f[q] = grid[q * stride];
+
+	// lower envelope of parabolas rooted at each sample
+	int k = 0;
+	v[0] = 0;
+	z[0] = -std::numeric_limits<double>::infinity();
+	z[1] = std::numeric_limits<double>::infinity();
+
+	for (int q = 1; q < n; q++) {
+		double s;
+		while (true) {
+			int r = v[k];
+			s = ((f[q] + q * q) - (f[r] + r * r)) / (2.0 * (q - r));
+			if (s > z[k])
+				break;
+			k--;
+		}
+
+		k++;
+		v[k] = q;
+		z[k] = s;
+		z[k + 1] = std::numeric_limits<double>::infinity();
+	}
+
+	k = 0;
+	for (int q = 0; q < n; q++) {
+		while (z[k + 1] < q)
+			k++;
+		int r = v[k];
+		grid[q * stride] = (q - r) * (q - r) + f[r];
+	}
+}
+
+// two dimensional transform is done by columns, then by rows
+void DistanceTransform(std::vector<double>& grid, int width, int height) {
+	int n = std::max(width, height);
+	std::vector<double> f(n);
+	std::vector<int> v(n);
+	std::vector<double> z(n + 1);
+
+	for (int x = 0; x < width; x++)
+		DistanceTransform(grid.data() + x, width, height, f, v, z);
+	for (int y = 0; y < height; y++)
+		DistanceTransform(grid.data() + y * width, 1, width, f, v, z);
+}
+
+// produces distance field spread pixels larger than glyph on
+// each side, with 128 on the outline, positive inside
+void ComputeDistanceField(Surface& glyph, int spread, std::vector<Uint8>& field, Point& size) {
+	int width = glyph.GetWidth();
+	int height = glyph.GetHeight();
+
+	std::vector<Uint8> coverage;
+	ReadGlyphCoverage(glyph, coverage);
+
+	size = Point(width + spread * 2, height + spread * 2);
+	size_t npixels = static_cast<size_t>(size.x) * static_cast<size_t>(size.y);
+
+	std::vector<double> alphas(npixels, 0.0);
+	for (int y = 0; y < height; y++)
+		for (int x = 0; x < width; x++)
+			alphas[static_cast<size_t>((y + spread) * size.x + x + spread)] = coverage[static_cast<size_t>(y * width + x)] / 255.0;
+
+	// squared distances from pixel centers to centers of nearest
+	// covered and nearest uncovered pixels. Outline passes half a
+	// pixel away from centers of fully covered pixels next to
+	// uncovered ones; in partially covered pixels it is shifted
+	// according to coverage, which is accounted for by extra
+	// initial distance, chosen so it is exact for neighbors
+	std::vector<double> outer(npixels, no_feature);
+	std::vector<double> inner(npixels, no_feature);
+
+	for (size_t i = 0; i < npixels; i++) {
+		if (alphas[i] > 0.0)
+			outer[i] = (2.0 - alphas[i]) * (2.0 - alphas[i]) - 1.0;
+		if (alphas[i] < 1.0)
+			inner[i] = (1.0 + alphas[i]) * (1.0 + alphas[i]) - 1.0;
+	}
+
+	DistanceTransform(outer, size.x, size.y);
+	DistanceTransform(inner, size.x, size.y);
+
+	field.resize(npixels);
+	for (size_t i = 0; i < npixels; i++) {
+		double distance;
+		if (alphas[i] <= 0.0)
+			distance = 0.5 - std::sqrt(outer[i]);
+		else if (alphas[i] >= 1.0)
+			distance = std::sqrt(inner[i]) - 0.5;
+		else
+			distance = alphas[i] - 0.5;
+
+		double value = std::floor(128.0 + distance * 128.0 / spread + 0.5);
+		field[i] = static_cast<Uint8>(std::min(std::max(value, 0.0), 255.0));
+	}
+}
+
+// atlas pages are sampled with linear filtering, which is
+// chosen by a hint when textures are created
+class LinearFilteringHint {
+private:
+	std::string previous_;
+	bool was_set_;
+
+public:
+	LinearFilteringHint() {
+		const char* previous = SDL_GetHint(SDL_HINT_RENDER_SCALE_QUALITY);
+		was_set_ = previous != nullptr;
+		if (was_set_)
+			previous_ = previous;
+		SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "linear");
+	}
+
+	~LinearFilteringHint() {
+		SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, was_set_ ? previous_.c_str() : "nearest");
+	}
+};
+
+}
+
+DistanceFieldCache::DistanceFieldCache(Renderer& renderer, Font& font, int spread, int page_size)
+	: renderer_(renderer),
+	  font_(font),
+	  spread_(spread),
+	  edge_width_(1.0f),
+	  page_size_(page_size),
+	  atlas_(new Atlas(renderer, page_size, page_size)) {
+	if (spread < 1)
+		throw std::invalid_argument("distance field spread must be positive");
+}
+
+AtlasRegion DistanceFieldCache::Upload(const Glyph& glyph, int step) {
+	float step_scale = GetStepScale(step);
+	int width = std::max(RoundToInt(glyph.size.x * step_scale), 1);
+	int height = std::max(RoundToInt(glyph.size.y * step_scale), 1);
+
+	// image pixel centers mapped into the distance field
+	float ratio_x = static_cast<float>(glyph.size.x) / width;
+	float ratio_y = static_cast<float>(glyph.size.y) / height;
+
+	// encoded distance to alpha, with the outline at half opacity
+	// and edge_width_ screen pixels between opaque and transparent
+	float alpha_per_value = spread_ / 128.0f * step_scale / edge_width_;
+
+	Surface image(0, width, height, 32, 0x00ff0000, 0x0000ff00, 0x000000ff, 0xff000000);
+	{
+		Surface::LockHandle lock = image.Lock();
+		PixelView<SDL_PIXELFORMAT_ARGB8888> view(image, lock);
+		for (int y = 0; y < height; y++) {
+			float fy = std::min(std::max((y + 0.5f) * ratio_y - 0.5f, 0.0f), static_cast<float>(glyph.size.y - 1));
+			int y0 = static_cast<int>(fy);
+			int y1 = std::min(y0 + 1, glyph.size.y - 1);
+			float ty = fy - y0;
+
+			const Uint8* row0 = glyph.field.data() + static_cast<size_t>(y0 * glyph.size.x);
+			const Uint8* row1 = glyph.field.data() + static_cast<size_t>(y1 * glyph.size.x);
+
+			Uint32* row = view.GetRow(y);
+			for (int x = 0; x < width; x++) {
+				float fx = std::min(std::max((x + 0.5f) * ratio_x - 0.5f, 0.0f), static_cast<float>(glyph.size.x - 1));
+				int x0 = static_cast<int>(fx);
+				int x1 = std::min(x0 + 1, glyph.size.x - 1);
+				float tx = fx - x0;
+
+				// distances are interpolated before the ramp is
+				// applied, so the outline stays sharp when magnified
+				float top = row0[x0] + (row0[x1] - row0[x0]) * tx;
+				float bottom = row1[x0] + (row1[x1] - row1[x0]) * tx;
+				float value = top + (bottom - top) * ty;
+
+				float alpha = std::min(std::max(0.5f + (value - 128.0f) * alpha_per_value, 0.0f), 1.0f);
+				row[x] = (static_cast<Uint32>(RoundToInt(alpha * 255.0f)) << 24) | 0x00ffffff;
+			}
+		}
+	}
+
+	LinearFilteringHint hint;
+	return atlas_->Add(std::move(image));
+}
+
+DistanceFieldCache::Glyph& DistanceFieldCache::GetGlyph(Uint16 ch) {
+	auto cached = glyphs_.find(ch);
+	if (cached != glyphs_.end())
+		return cached->second;
+
+	GlyphImage image = RenderGlyphImage(font_, ch, false);
+
+	Glyph glyph;
+	glyph.advance = image.advance;
+	if (image.surface) {
+		glyph.offset = image.origin - Point(spread_, spread_);
+		ComputeDistanceField(*image.surface, spread_, glyph.field, glyph.size);
+	}
+
+	return glyphs_.emplace(ch, std::move(glyph)).first->second;
+}
+
+const AtlasRegion& DistanceFieldCache::GetImage(Glyph& glyph, float scale) {
+	int step = static_cast<int>(std::floor(std::log2(scale) * scale_steps_per_octave + 0.5f));
+
+	// images which would not fit into atlas page are replaced
+	// with the largest one which does
+	float max_scale = static_cast<float>(page_size_) / std::max(glyph.size.x, glyph.size.y);
+	step = std::min(step, static_cast<int>(std::floor(std::log2(max_scale) * scale_steps_per_octave)));
+
+	auto cached = glyph.images.find(step);
+	if (cached != glyph.images.end())
+		return cached->second;
+
+	AtlasRegion region = Upload(glyph, step);
+	return glyph.images.emplace(step, std::move(region)).first->second;
+}
+
+Point DistanceFieldCache::Layout(const std::string& text, const Point& pos, float scale, const Color& color, bool queue) {
+	int x = 0;
+	bool first = true;
+	Uint16 prev_ch = 0;
+
+	const char* it = text.data();
+	const char* end = it + text.size();
+	while (it != end) {
+		Uint16 ch = DecodeUTF8ToUCS2(it, end);
+
+		if (!first)
+			x += GetCachedKerning(font_, kerning_, prev_ch, ch);
+
+		Glyph& glyph = GetGlyph(ch);
+		if (queue && !glyph.field.empty()) {
+			// both edges are rounded separately, so adjacent
+			// glyphs neither overlap nor leave gaps
+			int left = pos.x + RoundToInt((x + glyph.offset.x) * scale);
+			int top = pos.y + RoundToInt(glyph.offset.y * scale);
+			int right = pos.x + RoundToInt((x + glyph.offset.x + glyph.size.x) * scale);
+			int bottom = pos.y + RoundToInt((glyph.offset.y + glyph.size.y) * scale);
+
+			if (right > left && bottom > top)
+				queue_.push_back(QueuedGlyph{&GetImage(glyph, scale), Rect(left, top, right - left, bottom - top), color});
+		}
+
+		x += glyph.advance;
+		prev_ch = ch;
+		first = false;
+	}
+
+	return Point(RoundToInt(x * scale), RoundToInt(font_.GetHeight() * scale));
+}
+
+Surface DistanceFieldCache::GenerateDistanceField(Surface& glyph, int spread) {
+	if (spread < 1)
+		throw std::invalid_argument("distance field spread must be positive");
+
+	std::vector<Uint8> field;
+	Point size;
+	ComputeDistanceField(glyph, spread, field, size);
+
+	Surface image(0, size.x, size.y, 32, 0x00ff0000, 0x0000ff00, 0x000000ff, 0xff000000);
+	{
+		Surface::LockHandle lock = image.Lock();
+		PixelView<SDL_PIXELFORMAT_ARGB8888> view(image, lock);
+		for (int y = 0; y < size.y; y++) {
+			Uint32* row = view.GetRow(y);
+			for (int x = 0; x < size.x; x++)
+				row[x] = (static_cast<Uint32>(field[static_cast<size_t>(y * size.x + x)]) << 24) | 0x00ffffff;
+		}
+	}
+
+	return image;
+}
+
+DistanceFieldCache& DistanceFieldCache::PreloadUTF8(const std::string& text) {
+	const char* it = text.data();
+	const char* end = it + text.size();
+	while (it != end)
+		GetGlyph(DecodeUTF8ToUCS2(it, end));
+	return *this;
+}
+
+Point DistanceFieldCache::QueueUTF8(const std::string& text, const Point& pos, float scale, const Color& color) {
+	return Layout(text, pos, scale, color, true);
+}
+
+DistanceFieldCache& DistanceFieldCache::Flush(bool group_by_texture) {
+	FlushGlyphQueue(renderer_, queue_, commands_, group_by_texture);
+	return *this;
+}
+
+DistanceFieldCache& DistanceFieldCache::DrawUTF8(const std::string& text, const Point& pos, float scale, const Color& color) {
+	QueueUTF8(text, pos, scale, color);
+	return Flush();
+}
+
+Point DistanceFieldCache::GetSizeUTF8(const std::string& text, float scale) {
+	return Layout(text, Point(0, 0), scale, Color(), false);
+}
+
+DistanceFieldCache& DistanceFieldCache::SetEdgeWidth(float width) {
+	if (!(width > 0.0f))
+		throw std::invalid_argument("edge width must be positive");
+
+	if (width == edge_width_)
+		return *this;
+
+	edge_width_ = width;
+
+	// regions of the old atlas must not outlive it, even if
+	// re-uploading fails midway
+	for (auto& glyph : glyphs_)
+		for (auto& image : glyph.second.images)
+			image.second = AtlasRegion();
+	atlas_.reset(new Atlas(renderer_, page_size_, page_size_));
+
+	for (auto& glyph : glyphs_)
+		for (auto& image : glyph.second.images)
+			image.second = Upload(glyph.second, image.first);
+
+	return *this;
+}
+
+float DistanceFieldCache::GetEdgeWidth() const {
+	return edge_width_;
+}
+
+int DistanceFieldCache::GetSpread() const {
+	return spread_;
+}
+
+DistanceFieldCache& DistanceFieldCache::Clear() {
+	queue_.clear();
+	glyphs_.clear();
+	kerning_.clear();
+	atlas_.reset(new Atlas(renderer_, page_size_, page_size_));
+	return *this;
+}
+
+size_t DistanceFieldCache::GetNumGlyphs() const {
+	return glyphs_.size();
+}
+
+size_t DistanceFieldCache::GetNumQueued() const {
+	return queue_.size();
+}
+
+Atlas& DistanceFieldCache::GetAtlas() {
+	return *atlas_;
+}
+
+}
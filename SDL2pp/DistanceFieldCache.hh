@@ -0,0 +1,417 @@
+/*
+  libSDL2pp - C++11 bindings/wrapper for SDL2
+  Copyright (C) 2013-2016 Dmitry Marakasov <amdmi3@amdmi3.ru>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef SDL2PP_DISTANCEFIELDCACHE_HH
+#define SDL2PP_DISTANCEFIELDCACHE_HH
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <SDL_stdinc.h>
+
+#include <SDL2pp/Atlas.hh>
+#include <SDL2pp/Color.hh>
+#include <SDL2pp/Point.hh>
+#include <SDL2pp/Rect.hh>
+#include <SDL2pp/Renderer.hh>
+#include <SDL2pp/Surface.hh>
+#include <SDL2pp/Export.hh>
+
+namespace SDL2pp {
+
+class Font;
+
+////////////////////////////////////////////////////////////
+/// \brief Cache of signed distance field font glyphs for
+///        drawing text at any scale
+///
+/// \ingroup ttf
+///
+/// \headerfile SDL2pp/DistanceFieldCache.hh
+///
+/// Each glyph is rasterized once at the font's point size,
+/// which serves as reference size, and converted into a signed
+/// distance field: for each pixel, the distance to the nearest
+/// glyph outline. Text is then drawn at any scale as a batch of
+/// glyph quads, so zooming does not cause any further
+/// rasterization.
+///
+/// SDL renderer has no fragment shaders, so the outline can't
+/// be extracted from the distance field when drawing. Instead,
+/// for each scale text is drawn at, retained distance fields
+/// are resampled on the CPU to that scale, and only then
+/// converted into alpha ramp of configurable width in screen
+/// pixels. Resulting glyph images are cached in the atlas.
+/// As distances, not alpha, are interpolated, outlines stay
+/// sharp and antialiased both when text is magnified and when
+/// it is minified.
+///
+/// To bound the number of cached images, scales are rounded to
+/// quarter octave steps, and glyph images are drawn from page
+/// textures with linear filtering at most about 9% larger or
+/// smaller than they were generated. Images larger than atlas
+/// page are replaced with the largest one which fits, drawn
+/// magnified. Still, each distinct scale step adds its own
+/// set of glyph images to the atlas, so text which is zoomed
+/// across wide range of scales takes proportionally more
+/// texture memory.
+///
+/// Raw distance fields for use with custom shaders may be
+/// produced with GenerateDistanceField().
+///
+/// Cache must be cleared with Clear() after changing font
+/// style, outline or hinting. Font and renderer must outlive
+/// the cache.
+///
+/// Usage example:
+/// \code
+/// {
+///     SDL2pp::Font font("DejaVuSans.ttf", 48);
+///     SDL2pp::DistanceFieldCache cache(renderer, font);
+///
+///     while (running) {
+///         // glyph images are generated on first draw at each
+///         // scale step and reused afterwards
+///         cache.DrawUTF8("Label", SDL2pp::Point(10, 10), zoom);
+///         renderer.Present();
+///     }
+/// }
+/// \endcode
+///
+////////////////////////////////////////////////////////////
+class SDL2PP_EXPORT DistanceFieldCache {
+private:
+	////////////////////////////////////////////////////////////
+	/// \brief Cached glyph
+	///
+	////////////////////////////////////////////////////////////
+	struct Glyph {
+		std::vector<Uint8> field;                    ///< Encoded distance field, empty for blank glyphs
+		Point size;                                  ///< Size of distance field
+		std::unordered_map<int, AtlasRegion> images; ///< Glyph images by scale step
+		Point offset;                                ///< Position of distance field relative to pen position at the top of the line, in reference pixels
+		int advance;                                 ///< Horizontal advance in reference pixels
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Glyph waiting to be drawn
+	///
+	////////////////////////////////////////////////////////////
+	struct QueuedGlyph {
+		const AtlasRegion* region; ///< Region of glyph image, which SetEdgeWidth() may replace
+		Rect dstrect;              ///< Destination rectangle
+		Color color;               ///< Text color
+	};
+
+private:
+	Renderer& renderer_;                               ///< Renderer to draw with
+	Font& font_;                                       ///< Font to take glyphs from
+	int spread_;                                       ///< Maximal encoded distance in reference pixels
+	float edge_width_;                                 ///< Width of alpha ramp at glyph outline in screen pixels
+	int page_size_;                                    ///< Size of atlas pages
+	std::unique_ptr<Atlas> atlas_;                     ///< Storage for glyph images
+	std::unordered_map<Uint16, Glyph> glyphs_;         ///< Cached glyphs
+	std::unordered_map<Uint32, int> kerning_;          ///< Cached kerning pairs
+	std::vector<QueuedGlyph> queue_;                   ///< Glyphs queued for drawing
+	std::vector<Renderer::CopyCommand> commands_;      ///< Reusable batch storage
+
+private:
+	////////////////////////////////////////////////////////////
+	/// \brief Resample distance field to given scale step,
+	///        convert it into glyph image and add it to the atlas
+	///
+	/// \param[in] glyph Glyph with distance field
+	/// \param[in] step Scale step, image is 2^(step / 4) times
+	///                 larger than distance field
+	///
+	/// \returns Atlas region of glyph image
+	///
+	/// \throws SDL2pp::Exception
+	/// \throws std::invalid_argument if image does not fit into
+	///         atlas page
+	///
+	////////////////////////////////////////////////////////////
+	AtlasRegion Upload(const Glyph& glyph, int step);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get cached glyph, generating its distance field
+	///        if needed
+	///
+	/// \param[in] ch UNICODE char
+	///
+	/// \returns Cached glyph
+	///
+	/// \throws SDL2pp::Exception
+	///
+	////////////////////////////////////////////////////////////
+	Glyph& GetGlyph(Uint16 ch);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get glyph image for drawing at given scale,
+	///        generating it if needed
+	///
+	/// \param[in,out] glyph Non-blank glyph
+	/// \param[in] scale Ratio of drawn text size to reference size
+	///
+	/// \returns Atlas region of glyph image
+	///
+	/// \throws SDL2pp::Exception
+	///
+	////////////////////////////////////////////////////////////
+	const AtlasRegion& GetImage(Glyph& glyph, float scale);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Lay out UTF-8 string
+	///
+	/// \param[in] text UTF-8 string
+	/// \param[in] pos Top left corner of text
+	/// \param[in] scale Ratio of drawn text size to reference size
+	/// \param[in] color Text color
+	/// \param[in] queue Whether to queue glyphs for drawing
+	///
+	/// \returns Size of the text
+	///
+	/// \throws SDL2pp::Exception
+	///
+	////////////////////////////////////////////////////////////
+	Point Layout(const std::string& text, const Point& pos, float scale, const Color& color, bool queue);
+
+public:
+	////////////////////////////////////////////////////////////
+	/// \brief Create empty distance field glyph cache
+	///
+	/// \param[in] renderer Rendering context to draw text with
+	/// \param[in] font Font to take glyphs from, its point size
+	///                 is used as reference size
+	/// \param[in] spread Maximal distance from outline stored in
+	///                   distance fields, in reference pixels;
+	///                   glyph images are padded by this amount
+	/// \param[in] page_size Width and height of atlas page textures
+	///
+	/// \throws std::invalid_argument if spread is not positive
+	///
+	////////////////////////////////////////////////////////////
+	DistanceFieldCache(Renderer& renderer, Font& font, int spread = 4, int page_size = 512);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Deleted copy constructor
+	///
+	/// This class is not copyable, as it contains an atlas
+	///
+	////////////////////////////////////////////////////////////
+	DistanceFieldCache(const DistanceFieldCache& other) = delete;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Deleted assignment operator
+	///
+	/// This class is not copyable, as it contains an atlas
+	///
+	////////////////////////////////////////////////////////////
+	DistanceFieldCache& operator=(const DistanceFieldCache& other) = delete;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Generate signed distance field from glyph image
+	///
+	/// Distances are computed with exact euclidean distance
+	/// transform, using antialiased coverage to place outline
+	/// with subpixel precision.
+	///
+	/// \param[in] glyph Glyph image with coverage in alpha channel,
+	///                  such as produced by Font::RenderGlyph_Blended
+	/// \param[in] spread Maximal encoded distance in pixels
+	///
+	/// \returns Image spread pixels larger than glyph on each
+	///          side, in SDL_PIXELFORMAT_ARGB8888 format, white
+	///          with distance encoded in alpha channel: 128 on
+	///          the outline, increasing inwards and reaching 255
+	///          and 0 at spread pixels inside and outside
+	///
+	/// \throws SDL2pp::Exception
+	/// \throws std::invalid_argument if spread is not positive
+	///
+	////////////////////////////////////////////////////////////
+	static Surface GenerateDistanceField(Surface& glyph, int spread);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Rasterize glyphs for all chars of UTF-8 string
+	///
+	/// Useful to populate the cache in advance, before first
+	/// frame is drawn. Only distance fields are generated, glyph
+	/// images are made from them when glyphs are first drawn at
+	/// each scale step.
+	///
+	/// \param[in] text UTF-8 string
+	///
+	/// \returns Reference to self
+	///
+	/// \throws SDL2pp::Exception
+	///
+	////////////////////////////////////////////////////////////
+	DistanceFieldCache& PreloadUTF8(const std::string& text);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Queue scaled UTF-8 string for drawing
+	///
+	/// Glyphs are not drawn until Flush() is called, which allows
+	/// many strings to be submitted as a single batch
+	///
+	/// \param[in] text UTF-8 string
+	/// \param[in] pos Top left corner of text
+	/// \param[in] scale Ratio of drawn text size to reference size
+	/// \param[in] color Text color
+	///
+	/// \returns Size of the text, same as returned by GetSizeUTF8()
+	///
+	/// \throws SDL2pp::Exception
+	///
+	////////////////////////////////////////////////////////////
+	Point QueueUTF8(const std::string& text, const Point& pos, float scale = 1.0f, const Color& color = Color(255, 255, 255));
+
+	////////////////////////////////////////////////////////////
+	/// \brief Draw all queued glyphs
+	///
+	/// \param[in] group_by_texture Whether to reorder copies so
+	///                             glyphs from the same atlas page
+	///                             are drawn together, see
+	///                             Renderer::CopyBatch
+	///
+	/// \returns Reference to self
+	///
+	/// \throws SDL2pp::Exception
+	///
+	////////////////////////////////////////////////////////////
+	DistanceFieldCache& Flush(bool group_by_texture = false);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Draw scaled UTF-8 string
+	///
+	/// Queues the string and flushes the queue immediately
+	///
+	/// \param[in] text UTF-8 string
+	/// \param[in] pos Top left corner of text
+	/// \param[in] scale Ratio of drawn text size to reference size
+	/// \param[in] color Text color
+	///
+	/// \returns Reference to self
+	///
+	/// \throws SDL2pp::Exception
+	///
+	////////////////////////////////////////////////////////////
+	DistanceFieldCache& DrawUTF8(const std::string& text, const Point& pos, float scale = 1.0f, const Color& color = Color(255, 255, 255));
+
+	////////////////////////////////////////////////////////////
+	/// \brief Calculate size of scaled UTF-8 string as drawn by
+	///        the cache
+	///
+	/// Width is sum of glyph advances and kerning, height is font
+	/// height, both multiplied by scale and rounded. Missing
+	/// glyphs are rasterized and cached.
+	///
+	/// \param[in] text UTF-8 string
+	/// \param[in] scale Ratio of drawn text size to reference size
+	///
+	/// \returns Size of the text
+	///
+	/// \throws SDL2pp::Exception
+	///
+	////////////////////////////////////////////////////////////
+	Point GetSizeUTF8(const std::string& text, float scale = 1.0f);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set width of glyph edge antialiasing
+	///
+	/// Edge width is measured in screen pixels, so it is the
+	/// same for text drawn at any scale. Default of one pixel
+	/// gives sharpest text which is still antialiased. Changing
+	/// it re-encodes all cached glyph images from retained
+	/// distance fields, which is much cheaper than rasterizing
+	/// glyphs, but should not be done every frame. Setting the
+	/// current width again does nothing. Queued glyphs are kept.
+	///
+	/// \param[in] width Width of alpha ramp at glyph outline in
+	///                  screen pixels
+	///
+	/// \returns Reference to self
+	///
+	/// \throws SDL2pp::Exception
+	/// \throws std::invalid_argument if width is not positive
+	///
+	////////////////////////////////////////////////////////////
+	DistanceFieldCache& SetEdgeWidth(float width);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get width of glyph edge antialiasing
+	///
+	/// \returns Width of alpha ramp at glyph outline in screen
+	///          pixels
+	///
+	////////////////////////////////////////////////////////////
+	float GetEdgeWidth() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get maximal distance stored in distance fields
+	///
+	/// \returns Spread in reference pixels
+	///
+	////////////////////////////////////////////////////////////
+	int GetSpread() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Drop all cached glyphs and queued text
+	///
+	/// Must be called after changing font style, outline or
+	/// hinting, as cached glyphs are no longer valid then
+	///
+	/// \returns Reference to self
+	///
+	////////////////////////////////////////////////////////////
+	DistanceFieldCache& Clear();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get number of cached glyphs
+	///
+	/// \returns Number of cached glyphs
+	///
+	////////////////////////////////////////////////////////////
+	size_t GetNumGlyphs() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get number of glyph copies waiting for Flush()
+	///
+	/// \returns Number of queued glyphs
+	///
+	////////////////////////////////////////////////////////////
+	size_t GetNumQueued() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get atlas holding glyph images
+	///
+	/// \returns Reference to glyph atlas
+	///
+	////////////////////////////////////////////////////////////
+	Atlas& GetAtlas();
+};
+
+}
+
+#endif
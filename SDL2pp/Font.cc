@@ -19,27 +19,319 @@
   3. This notice may not be removed or altered from any source distribution.
 */
 
+#include <algorithm>
 #include <cassert>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include <SDL_version.h>
 #include <SDL_ttf.h>
 
 #include <SDL2pp/Font.hh>
 #include <SDL2pp/RWops.hh>
 #include <SDL2pp/Exception.hh>
+#include <SDL2pp/GlyphUtils.hh>
+#include <SDL2pp/PixelView.hh>
+#include <SDL2pp/UTF8.hh>
 
 namespace SDL2pp {
 
-Font::Font(TTF_Font* font) : font_(font) {
+struct Font::MetricsTable {
+	struct Glyph {
+		int minx, maxx, miny, maxy; ///< Glyph bounds, as returned by TTF_GlyphMetrics
+		int advance;                ///< Glyph advance
+		int left;                   ///< Left edge of box SDL_ttf measures for the glyph, relative to pen position
+		int right;                  ///< Right edge of box SDL_ttf measures for the glyph, relative to pen position
+		int height;                 ///< Height of box SDL_ttf measures for the glyph
+	};
+
+	std::vector<Uint16> chars;                ///< Chars the table was built for
+	std::unordered_map<Uint16, Glyph> glyphs; ///< Metrics by char
+	std::unordered_map<Uint32, int> kerning;  ///< Non-zero kerning by pair of chars
+	bool stale = false;                       ///< Font settings changed since glyphs and kerning were measured
+
+	void Measure(const Font& font) {
+		std::unordered_map<Uint16, Glyph> new_glyphs;
+		std::unordered_map<Uint32, int> new_kerning;
+
+		for (Uint16 ch : chars)
+			new_glyphs.emplace(ch, MeasureGlyph(font.Get(), ch));
+
+		for (Uint16 prev_ch : chars) {
+			for (Uint16 ch : chars) {
+				int size = font.GetKerningSize(prev_ch, ch);
+				if (size != 0)
+					new_kerning.emplace(MakePair(prev_ch, ch), size);
+			}
+		}
+
+		glyphs.swap(new_glyphs);
+		kerning.swap(new_kerning);
+		stale = false;
+	}
+
+	static Uint32 MakePair(Uint16 prev_ch, Uint16 ch) {
+		return (static_cast<Uint32>(prev_ch) << 16) | ch;
+	}
+
+	static Glyph MeasureGlyph(TTF_Font* font, Uint16 ch) {
+		Glyph glyph;
+		if (TTF_GlyphMetrics(font, ch, &glyph.minx, &glyph.maxx, &glyph.miny, &glyph.maxy, &glyph.advance) != 0)
+			throw Exception("TTF_GlyphMetrics");
+
+		// depending on version, SDL_ttf may reserve more space for
+		// a glyph than its metrics suggest (e.g. it may use bitmap
+		// size or add outline), so take the box it really measures
+		char text[5];
+		text[EncodeUTF8(ch, text)] = '\0';
+
+		int w, h;
+		if (TTF_SizeUTF8(font, text, &w, &h) != 0)
+			throw Exception("TTF_SizeUTF8");
+
+		glyph.left = std::min(glyph.minx, 0);
+		glyph.right = glyph.left + w;
+		glyph.height = h;
+
+		return glyph;
+	}
+
+	// same algorithm as TTF_SizeUTF8 uses, with per-glyph boxes
+	// taken from the table; returns false if text can't be
+	// measured this way
+	bool MeasureUTF8(const Font& font, const std::string& text, Point& size) const {
+		const bool use_kerning = font.GetKerning();
+
+		int x = 0, minx = 0, maxx = 0, h = font.GetHeight();
+
+		Uint16 prev_ch = 0;
+		bool prev_in_table = false;
+		bool first = true;
+
+		const char* it = text.data();
+		const char* end = it + text.size();
+		while (it != end) {
+			Uint32 code = DecodeUTF8(it, end);
+			if (code == 0)
+				break; // SDL_ttf sees C string
+			if (code > 0xFFFF)
+				return false; // not addressable through glyph API
+
+			Uint16 ch = static_cast<Uint16>(code);
+
+			auto cached = glyphs.find(ch);
+			bool in_table = cached != glyphs.end();
+			Glyph glyph = in_table ? cached->second : MeasureGlyph(font.font_, ch);
+
+			if (use_kerning && !first) {
+				if (prev_in_table && in_table) {
+					auto pair = kerning.find(MakePair(prev_ch, ch));
+					if (pair != kerning.end())
+						x += pair->second;
+				} else {
+					x += font.GetKerningSize(prev_ch, ch);
+				}
+			}
+
+			minx = std::min(minx, x + glyph.left);
+			maxx = std::max(maxx, x + glyph.right);
+			h = std::max(h, glyph.height);
+
+			x += glyph.advance;
+
+			prev_ch = ch;
+			prev_in_table = in_table;
+			first = false;
+		}
+
+		size = Point(maxx - minx, h);
+		return true;
+	}
+};
+
+namespace {
+
+// c * a / 255, rounded to nearest
+inline int Multiply(int c, int a) {
+	return (c * a + 127) / 255;
+}
+
+// linear interpolation from one component value to another
+inline int Mix(int from, int to, int a) {
+	return (from * (255 - a) + to * a + 127) / 255;
+}
+
+struct TextCompositor {
+	const Uint8* coverage; ///< Coverage of the whole text box
+	int pitch;             ///< Length of coverage row
+	Point offset;          ///< Position of area in text box
+	Rect area;             ///< Destination area, already clipped
+	bool keyed;            ///< Whether text surface is color keyed, so uncovered pixels are left intact
+	bool shaded;           ///< Whether background box is filled
+	SDL_Color fg;          ///< Text color
+	SDL_Color bg;          ///< Background color
+	SDL_BlendMode blend;   ///< Blend mode
+
+	template<Uint32 Format>
+	void operator()(const PixelView<Format>& view) const {
+		typedef typename PixelView<Format>::Traits Traits;
+
+		for (int y = 0; y < area.h; y++) {
+			const Uint8* src = coverage + (offset.y + y) * pitch + offset.x;
+			typename Traits::PixelType* dst = view.GetRow(area.y + y) + area.x;
+
+			for (int x = 0; x < area.w; x++) {
+				int a = src[x];
+
+				// SDL_BlitSurface skips color keyed pixels in any
+				// blend mode, including SDL_BLENDMODE_NONE
+				if (keyed && a == 0)
+					continue;
+
+				// color of the pixel of rendered text surface
+				int r = fg.r, g = fg.g, b = fg.b, alpha;
+				if (shaded) {
+					r = Mix(bg.r, fg.r, a);
+					g = Mix(bg.g, fg.g, a);
+					b = Mix(bg.b, fg.b, a);
+					alpha = Mix(bg.a, fg.a, a);
+				} else {
+					alpha = Multiply(fg.a, a);
+				}
+
+				// blend it as SDL_BlitSurface does
+				switch (blend) {
+				case SDL_BLENDMODE_NONE:
+					dst[x] = Traits::MapRGBA(static_cast<Uint8>(r), static_cast<Uint8>(g), static_cast<Uint8>(b), static_cast<Uint8>(alpha));
+					break;
+				case SDL_BLENDMODE_BLEND:
+					if (alpha != 0)
+						dst[x] = Traits::MapRGBA(
+								static_cast<Uint8>(Mix(Traits::GetRed(dst[x]), r, alpha)),
+								static_cast<Uint8>(Mix(Traits::GetGreen(dst[x]), g, alpha)),
+								static_cast<Uint8>(Mix(Traits::GetBlue(dst[x]), b, alpha)),
+								static_cast<Uint8>(alpha + Multiply(Traits::GetAlpha(dst[x]), 255 - alpha))
+							);
+					break;
+				case SDL_BLENDMODE_ADD:
+					if (alpha != 0)
+						dst[x] = Traits::MapRGBA(
+								static_cast<Uint8>(std::min(Traits::GetRed(dst[x]) + Multiply(r, alpha), 255)),
+								static_cast<Uint8>(std::min(Traits::GetGreen(dst[x]) + Multiply(g, alpha), 255)),
+								static_cast<Uint8>(std::min(Traits::GetBlue(dst[x]) + Multiply(b, alpha), 255)),
+								Traits::GetAlpha(dst[x])
+							);
+					break;
+				default: // SDL_BLENDMODE_MOD
+					dst[x] = Traits::MapRGBA(
+							static_cast<Uint8>(Multiply(Traits::GetRed(dst[x]), r)),
+							static_cast<Uint8>(Multiply(Traits::GetGreen(dst[x]), g)),
+							static_cast<Uint8>(Multiply(Traits::GetBlue(dst[x]), b)),
+							Traits::GetAlpha(dst[x])
+						);
+					break;
+				}
+			}
+		}
+	}
+};
+
+}
+
+struct Font::GlyphBitmaps {
+	struct Bitmap {
+		std::vector<Uint8> coverage; ///< Glyph coverage, trimmed to non-empty pixels; empty for blank glyphs
+		Rect rect;                   ///< Position and size of coverage relative to pen position at the top of the line
+		int advance;                 ///< Glyph advance
+	};
+
+	std::unordered_map<Uint32, Bitmap> bitmaps; ///< Bitmaps by char and mode
+	std::vector<Uint8> box;                     ///< Coverage of text box being rendered, kept to reuse memory
+
+	const Bitmap& GetBitmap(Font& font, Uint16 ch, bool solid) {
+		Uint32 key = static_cast<Uint32>(ch) | (solid ? 0x10000 : 0);
+
+		auto cached = bitmaps.find(key);
+		if (cached != bitmaps.end())
+			return cached->second;
+
+		GlyphImage image = RenderGlyphImage(font, ch, solid);
+
+		Bitmap bitmap;
+		bitmap.advance = image.advance;
+		if (image.surface) {
+			int width = image.surface->GetWidth();
+			int height = image.surface->GetHeight();
+
+			std::vector<Uint8> coverage;
+			ReadGlyphCoverage(*image.surface, coverage);
+
+			// trim empty rows and columns, which are plentiful as
+			// glyphs are rendered with full line height
+			int left = width, right = 0, top = height, bottom = 0;
+			for (int y = 0; y < height; y++) {
+				for (int x = 0; x < width; x++) {
+					if (coverage[static_cast<size_t>(y * width + x)] != 0) {
+						left = std::min(left, x);
+						right = std::max(right, x + 1);
+						top = std::min(top, y);
+						bottom = std::max(bottom, y + 1);
+					}
+				}
+			}
+
+			if (left < right) {
+				bitmap.rect = Rect(image.origin.x + left, image.origin.y + top, right - left, bottom - top);
+				bitmap.coverage.reserve(static_cast<size_t>(bitmap.rect.w) * static_cast<size_t>(bitmap.rect.h));
+				for (int y = top; y < bottom; y++)
+					bitmap.coverage.insert(bitmap.coverage.end(), coverage.begin() + y * width + left, coverage.begin() + y * width + right);
+			}
+		}
+
+		return bitmaps.emplace(key, std::move(bitmap)).first->second;
+	}
+
+	// calls function(x, bitmap) for each glyph of the text, where
+	// x is pen position; returns final pen position
+	template<typename Function>
+	int LayOut(Font& font, const char* it, const char* end, bool solid, Function&& function) {
+		const bool use_kerning = font.GetKerning();
+
+		int x = 0;
+		Uint16 prev_ch = 0;
+		bool first = true;
+
+		while (it != end) {
+			Uint16 ch = DecodeUTF8ToUCS2(it, end);
+
+			if (use_kerning && !first)
+				x += font.GetKerningSize(prev_ch, ch);
+
+			const Bitmap& bitmap = GetBitmap(font, ch, solid);
+			if (!bitmap.coverage.empty())
+				function(x, bitmap);
+
+			x += bitmap.advance;
+			prev_ch = ch;
+			first = false;
+		}
+
+		return x;
+	}
+};
+
+Font::Font(TTF_Font* font) : font_(font), metrics_() {
 	assert(font);
 }
 
-Font::Font(const std::string& file, int ptsize, long index) {
+Font::Font(const std::string& file, int ptsize, long index) : metrics_() {
 	if ((font_ = TTF_OpenFontIndex(file.c_str(), ptsize, index)) == nullptr)
 		throw Exception("TTF_OpenFontIndex");
 }
 
-Font::Font(RWops& rwops, int ptsize, long index) {
+Font::Font(RWops& rwops, int ptsize, long index) : metrics_() {
 	if ((font_ = TTF_OpenFontIndexRW(rwops.Get(), 0, ptsize, index)) == nullptr)
 		throw Exception("TTF_OpenFontIndexRW");
 }
@@ -49,7 +341,7 @@ Font::~Font() {
 		TTF_CloseFont(font_);
 }
 
-Font::Font(Font&& other) noexcept : font_(other.font_) {
+Font::Font(Font&& other) noexcept : font_(other.font_), metrics_(std::move(other.metrics_)), bitmaps_(std::move(other.bitmaps_)) {
 	other.font_ = nullptr;
 }
 
@@ -59,6 +351,8 @@ Font& Font::operator=(Font&& other) noexcept {
 	if (font_ != nullptr)
 		TTF_CloseFont(font_);
 	font_ = other.font_;
+	metrics_ = std::move(other.metrics_);
+	bitmaps_ = std::move(other.bitmaps_);
 	other.font_ = nullptr;
 	return *this;
 }
@@ -73,6 +367,10 @@ int Font::GetStyle() const {
 
 Font& Font::SetStyle(int style) {
 	TTF_SetFontStyle(font_, style);
+	if (metrics_)
+		metrics_->stale = true;
+	if (bitmaps_)
+		bitmaps_->bitmaps.clear();
 	return *this;
 }
 
@@ -82,6 +380,10 @@ int Font::GetOutline() const {
 
 Font& Font::SetOutline(int outline) {
 	TTF_SetFontOutline(font_, outline);
+	if (metrics_)
+		metrics_->stale = true;
+	if (bitmaps_)
+		bitmaps_->bitmaps.clear();
 	return *this;
 }
 
@@ -91,6 +393,10 @@ int Font::GetHinting() const {
 
 Font& Font::SetHinting(int hinting) {
 	TTF_SetFontHinting(font_, hinting);
+	if (metrics_)
+		metrics_->stale = true;
+	if (bitmaps_)
+		bitmaps_->bitmaps.clear();
 	return *this;
 }
 
@@ -146,11 +452,29 @@ int Font::IsGlyphProvided(Uint16 ch) const {
 }
 
 void Font::GetGlyphMetrics(Uint16 ch, int& minx, int& maxx, int& miny, int& maxy, int& advance) const {
+	if (const MetricsTable* metrics = GetMetricsTable()) {
+		auto glyph = metrics->glyphs.find(ch);
+		if (glyph != metrics->glyphs.end()) {
+			minx = glyph->second.minx;
+			maxx = glyph->second.maxx;
+			miny = glyph->second.miny;
+			maxy = glyph->second.maxy;
+			advance = glyph->second.advance;
+			return;
+		}
+	}
+
 	if (TTF_GlyphMetrics(font_, ch, &minx, &maxx, &miny, &maxy, &advance) != 0)
 		throw Exception("TTF_GlyphMetrics");
 }
 
 Rect Font::GetGlyphRect(Uint16 ch) const {
+	if (const MetricsTable* metrics = GetMetricsTable()) {
+		auto glyph = metrics->glyphs.find(ch);
+		if (glyph != metrics->glyphs.end())
+			return Rect(glyph->second.minx, glyph->second.miny, glyph->second.maxx - glyph->second.minx, glyph->second.maxy - glyph->second.miny);
+	}
+
 	int minx, maxx, miny, maxy;
 	if (TTF_GlyphMetrics(font_, ch, &minx, &maxx, &miny, &maxy, nullptr) != 0)
 		throw Exception("TTF_GlyphMetrics");
@@ -158,12 +482,26 @@ Rect Font::GetGlyphRect(Uint16 ch) const {
 }
 
 int Font::GetGlyphAdvance(Uint16 ch) const {
+	if (const MetricsTable* metrics = GetMetricsTable()) {
+		auto glyph = metrics->glyphs.find(ch);
+		if (glyph != metrics->glyphs.end())
+			return glyph->second.advance;
+	}
+
 	int advance;
 	if (TTF_GlyphMetrics(font_, ch, nullptr, nullptr, nullptr, nullptr, &advance) != 0)
 		throw Exception("TTF_GlyphMetrics");
 	return advance;
 }
 
+int Font::GetKerningSize(Uint16 prev_ch, Uint16 ch) const {
+#if SDL_VERSIONNUM(SDL_TTF_MAJOR_VERSION, SDL_TTF_MINOR_VERSION, SDL_TTF_PATCHLEVEL) >= SDL_VERSIONNUM(2, 0, 14)
+	return TTF_GetFontKerningSizeGlyphs(font_, prev_ch, ch);
+#else
+	return TTF_GetFontKerningSize(font_, TTF_GlyphIsProvided(font_, prev_ch), TTF_GlyphIsProvided(font_, ch));
+#endif
+}
+
 Point Font::GetSizeText(const std::string& text) const {
 	int w, h;
 	if (TTF_SizeText(font_, text.c_str(), &w, &h) != 0)
@@ -172,12 +510,56 @@ Point Font::GetSizeText(const std::string& text) const {
 }
 
 Point Font::GetSizeUTF8(const std::string& text) const {
+	Point size;
+	const MetricsTable* metrics = GetMetricsTable();
+	if (metrics && metrics->MeasureUTF8(*this, text, size))
+		return size;
+
 	int w, h;
 	if (TTF_SizeUTF8(font_, text.c_str(), &w, &h) != 0)
 		throw Exception("TTF_SizeUTF8");
 	return Point(w, h);
 }
 
+Font& Font::BuildMetricsTable(Uint16 first, Uint16 last) {
+	std::vector<Uint16> chars;
+	for (Uint32 ch = first; ch <= last; ch++)
+		chars.push_back(static_cast<Uint16>(ch));
+	BuildMetricsTable(std::move(chars));
+	return *this;
+}
+
+Font& Font::BuildMetricsTable(const std::u16string& chars) {
+	BuildMetricsTable(std::vector<Uint16>(chars.begin(), chars.end()));
+	return *this;
+}
+
+void Font::BuildMetricsTable(std::vector<Uint16> chars) {
+	chars.erase(std::remove(chars.begin(), chars.end(), 0), chars.end());
+	std::sort(chars.begin(), chars.end());
+	chars.erase(std::unique(chars.begin(), chars.end()), chars.end());
+
+	std::unique_ptr<MetricsTable> metrics(new MetricsTable);
+	metrics->chars = std::move(chars);
+	metrics->Measure(*this);
+	metrics_ = std::move(metrics);
+}
+
+const Font::MetricsTable* Font::GetMetricsTable() const {
+	if (metrics_ && metrics_->stale)
+		metrics_->Measure(*this);
+	return metrics_.get();
+}
+
+Font& Font::DropMetricsTable() {
+	metrics_.reset();
+	return *this;
+}
+
+bool Font::HasMetricsTable() const {
+	return metrics_ != nullptr;
+}
+
 Point Font::GetSizeUNICODE(const Uint16* text) const {
 	int w, h;
 	if (TTF_SizeUNICODE(font_, text, &w, &h) != 0)
@@ -293,4 +675,104 @@ Surface Font::RenderGlyph_Blended(Uint16 ch, SDL_Color fg) {
 	return Surface(surface);
 }
 
+Surface Font::RenderUTF8(const std::string& text, TextRenderMode mode, SDL_Color fg, SDL_Color bg) {
+	switch (mode) {
+	case TextRenderMode::Solid:
+		return RenderUTF8_Solid(text, fg);
+	case TextRenderMode::Shaded:
+		return RenderUTF8_Shaded(text, fg, bg);
+	case TextRenderMode::Blended:
+		return RenderUTF8_Blended(text, fg);
+	}
+	throw std::invalid_argument("unknown text render mode");
+}
+
+Rect Font::RenderInto(const char* begin, const char* end, TextRenderMode mode, SDL_Color fg, SDL_Color bg, Surface& dst, const Point& pos, SDL_BlendMode blend) {
+	if (mode != TextRenderMode::Solid && mode != TextRenderMode::Shaded && mode != TextRenderMode::Blended)
+		throw std::invalid_argument("unknown text render mode");
+	if (blend != SDL_BLENDMODE_NONE && blend != SDL_BLENDMODE_BLEND && blend != SDL_BLENDMODE_ADD && blend != SDL_BLENDMODE_MOD)
+		throw std::invalid_argument("unsupported blend mode");
+
+	if (!bitmaps_)
+		bitmaps_.reset(new GlyphBitmaps);
+
+	const bool solid = mode == TextRenderMode::Solid;
+
+	// text box covers the line and all glyph images
+	int left = 0, top = 0, right = 0, bottom = GetHeight();
+	int advance = bitmaps_->LayOut(*this, begin, end, solid, [&](int pen_x, const GlyphBitmaps::Bitmap& bitmap) {
+			left = std::min(left, pen_x + bitmap.rect.x);
+			top = std::min(top, bitmap.rect.y);
+			right = std::max(right, pen_x + bitmap.rect.x + bitmap.rect.w);
+			bottom = std::max(bottom, bitmap.rect.y + bitmap.rect.h);
+		});
+	right = std::max(right, advance);
+
+	Rect box(left, top, right - left, bottom - top);
+
+	std::vector<Uint8>& coverage = bitmaps_->box;
+	coverage.assign(static_cast<size_t>(box.w) * static_cast<size_t>(box.h), 0);
+
+	bitmaps_->LayOut(*this, begin, end, solid, [&box, &coverage](int pen_x, const GlyphBitmaps::Bitmap& bitmap) {
+			// overlapping glyphs are combined the way SDL_ttf does
+			const Uint8* src = bitmap.coverage.data();
+			for (int y = 0; y < bitmap.rect.h; y++) {
+				Uint8* dst = coverage.data() + (bitmap.rect.y - box.y + y) * box.w + (pen_x + bitmap.rect.x - box.x);
+				for (int x = 0; x < bitmap.rect.w; x++, src++)
+					dst[x] = std::max(dst[x], *src);
+			}
+		});
+
+	Rect area = box + pos;
+
+	Optional<Rect> clipped = area.GetIntersection(dst.GetClipRect());
+	if (clipped) {
+		Surface::LockHandle lock = dst.Lock();
+		VisitPixelView(dst, lock, TextCompositor{
+				coverage.data(),
+				box.w,
+				Point(clipped->x - area.x, clipped->y - area.y),
+				*clipped,
+				solid,
+				mode == TextRenderMode::Shaded,
+				fg,
+				bg,
+				blend
+			});
+	}
+
+	return area;
+}
+
+Rect Font::RenderUTF8_Solid(const std::string& text, SDL_Color fg, Surface& dst, const Point& pos, SDL_BlendMode blend) {
+	return RenderInto(text.data(), text.data() + text.size(), TextRenderMode::Solid, fg, SDL_Color{0, 0, 0, 0}, dst, pos, blend);
+}
+
+Rect Font::RenderGlyph_Solid(Uint16 ch, SDL_Color fg, Surface& dst, const Point& pos, SDL_BlendMode blend) {
+	char text[4];
+	return RenderInto(text, text + EncodeUTF8(ch, text), TextRenderMode::Solid, fg, SDL_Color{0, 0, 0, 0}, dst, pos, blend);
+}
+
+Rect Font::RenderUTF8_Shaded(const std::string& text, SDL_Color fg, SDL_Color bg, Surface& dst, const Point& pos, SDL_BlendMode blend) {
+	return RenderInto(text.data(), text.data() + text.size(), TextRenderMode::Shaded, fg, bg, dst, pos, blend);
+}
+
+Rect Font::RenderGlyph_Shaded(Uint16 ch, SDL_Color fg, SDL_Color bg, Surface& dst, const Point& pos, SDL_BlendMode blend) {
+	char text[4];
+	return RenderInto(text, text + EncodeUTF8(ch, text), TextRenderMode::Shaded, fg, bg, dst, pos, blend);
+}
+
+Rect Font::RenderUTF8_Blended(const std::string& text, SDL_Color fg, Surface& dst, const Point& pos, SDL_BlendMode blend) {
+	return RenderInto(text.data(), text.data() + text.size(), TextRenderMode::Blended, fg, SDL_Color{0, 0, 0, 0}, dst, pos, blend);
+}
+
+Rect Font::RenderGlyph_Blended(Uint16 ch, SDL_Color fg, Surface& dst, const Point& pos, SDL_BlendMode blend) {
+	char text[4];
+	return RenderInto(text, text + EncodeUTF8(ch, text), TextRenderMode::Blended, fg, SDL_Color{0, 0, 0, 0}, dst, pos, blend);
+}
+
+Rect Font::RenderUTF8(const std::string& text, TextRenderMode mode, SDL_Color fg, SDL_Color bg, Surface& dst, const Point& pos, SDL_BlendMode blend) {
+	return RenderInto(text.data(), text.data() + text.size(), mode, fg, bg, dst, pos, blend);
+}
+
 }
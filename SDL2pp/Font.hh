@@ -22,7 +22,9 @@
 #ifndef SDL2PP_FONT_HH
 #define SDL2PP_FONT_HH
 
+#include <memory>
 #include <string>
+#include <vector>
 
 #include <SDL_ttf.h>
 
@@ -35,6 +37,20 @@ namespace SDL2pp {
 
 class RWops;
 
+////////////////////////////////////////////////////////////
+/// \brief SDL_ttf text rendering mode
+///
+/// \ingroup ttf
+///
+/// \see SDL2pp::Font::RenderUTF8
+///
+////////////////////////////////////////////////////////////
+enum class TextRenderMode {
+	Solid,   ///< Font::RenderUTF8_Solid
+	Shaded,  ///< Font::RenderUTF8_Shaded
+	Blended, ///< Font::RenderUTF8_Blended
+};
+
 ////////////////////////////////////////////////////////////
 /// \brief Holder of a loaded font
 ///
@@ -47,7 +63,55 @@ class RWops;
 ////////////////////////////////////////////////////////////
 class SDL2PP_EXPORT Font {
 private:
-	TTF_Font* font_; ///< Managed TTF_Font object
+	struct MetricsTable;
+	struct GlyphBitmaps;
+
+	TTF_Font* font_;                        ///< Managed TTF_Font object
+	std::unique_ptr<MetricsTable> metrics_; ///< Precomputed glyph metrics, see BuildMetricsTable()
+	std::unique_ptr<GlyphBitmaps> bitmaps_; ///< Cached glyph images for rendering into existing surfaces
+
+	////////////////////////////////////////////////////////////
+	/// \brief Build metrics table for given set of chars
+	///
+	/// \param[in] chars UNICODE chars to include into table
+	///
+	/// \throws SDL2pp::Exception
+	///
+	////////////////////////////////////////////////////////////
+	void BuildMetricsTable(std::vector<Uint16> chars);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get metrics table, remeasuring it first if font
+	///        settings were changed since it was built
+	///
+	/// \returns Pointer to metrics table or nullptr if it wasn't built
+	///
+	/// \throws SDL2pp::Exception
+	///
+	////////////////////////////////////////////////////////////
+	const MetricsTable* GetMetricsTable() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Render UTF8 text into existing surface
+	///
+	/// \param[in] begin Pointer to the first byte of UTF8 text
+	/// \param[in] end Pointer past the last byte of UTF8 text
+	/// \param[in] mode Render mode
+	/// \param[in] fg Color to render the text in
+	/// \param[in] bg Color to render the background box in, used
+	///               in shaded mode only
+	/// \param[in] dst Surface to render into
+	/// \param[in] pos Top left corner of text in dst
+	/// \param[in] blend Blend mode to combine text with dst
+	///
+	/// \returns Text box in dst, before clipping
+	///
+	/// \throws SDL2pp::Exception
+	/// \throws std::invalid_argument if blend mode or dst pixel
+	///         format is not supported
+	///
+	////////////////////////////////////////////////////////////
+	Rect RenderInto(const char* begin, const char* end, TextRenderMode mode, SDL_Color fg, SDL_Color bg, Surface& dst, const Point& pos, SDL_BlendMode blend);
 
 public:
 
@@ -180,6 +244,11 @@ public:
 	/// glyphs, even if there is no change in style, so it may be best
 	/// to check the current style by using GetStyle() first
 	///
+	/// \note If metrics table was built with BuildMetricsTable(), it
+	/// is marked outdated and remeasured by the next call which uses
+	/// it, so that call takes time quadratic in number of chars in
+	/// the table and may throw SDL2pp::Exception
+	///
 	/// \note TTF_STYLE_UNDERLINE may cause surfaces created by TTF_RenderGlyph_*
 	/// functions to be extended vertically, downward only, to encompass the
 	/// underline if the original glyph metrics didn't allow for the underline
@@ -222,6 +291,9 @@ public:
 	/// glyphs, even if there is no change in outline size, so it may be best
 	/// to check the current outline size by using GetOutline() first
 	///
+	/// \note Metrics table, if built, is remeasured on next use, as
+	/// described for SetStyle()
+	///
 	/// \returns Reference to self
 	///
 	/// \see https://www.libsdl.org/projects/SDL_ttf/docs/SDL_ttf.html#SEC24
@@ -262,6 +334,9 @@ public:
 	/// glyphs, even if there is no change in hinting, so it may be best
 	/// to check the current hinting by using GetHinting() first
 	///
+	/// \note Metrics table, if built, is remeasured on next use, as
+	/// described for SetStyle()
+	///
 	/// \returns Reference to self
 	///
 	/// \see https://www.libsdl.org/projects/SDL_ttf/docs/SDL_ttf.html#SEC26
@@ -466,6 +541,8 @@ public:
 	///
 	/// \throws SDL2pp::Exception
 	///
+	/// Taken from metrics table if it was built and includes ch
+	///
 	/// \see https://www.libsdl.org/projects/SDL_ttf/docs/SDL_ttf.html#SEC38
 	/// \see http://freetype.sourceforge.net/freetype2/docs/tutorial/step2.html
 	///
@@ -481,6 +558,8 @@ public:
 	///
 	/// \throws SDL2pp::Exception
 	///
+	/// Taken from metrics table if it was built and includes ch
+	///
 	/// \see https://www.libsdl.org/projects/SDL_ttf/docs/SDL_ttf.html#SEC38
 	/// \see http://freetype.sourceforge.net/freetype2/docs/tutorial/step2.html
 	///
@@ -496,12 +575,29 @@ public:
 	///
 	/// \throws SDL2pp::Exception
 	///
+	/// Taken from metrics table if it was built and includes ch
+	///
 	/// \see https://www.libsdl.org/projects/SDL_ttf/docs/SDL_ttf.html#SEC38
 	/// \see http://freetype.sourceforge.net/freetype2/docs/tutorial/step2.html
 	///
 	////////////////////////////////////////////////////////////
 	int GetGlyphAdvance(Uint16 ch) const;
 
+	////////////////////////////////////////////////////////////
+	/// \brief Get kerning between two UNICODE chars
+	///
+	/// \param[in] prev_ch Preceding UNICODE char
+	/// \param[in] ch Following UNICODE char
+	///
+	/// \returns Horizontal offset in pixels to add to pen position
+	///          before drawing ch after prev_ch. Kerning setting of
+	///          the font is not taken into account
+	///
+	/// \see https://www.libsdl.org/projects/SDL_ttf/docs/SDL_ttf.html#SEC38
+	///
+	////////////////////////////////////////////////////////////
+	int GetKerningSize(Uint16 prev_ch, Uint16 ch) const;
+
 	///@}
 
 	///@{
@@ -538,6 +634,10 @@ public:
 	/// to get the actual width. The height returned in h is the same
 	/// as you can get using GetHeight()
 	///
+	/// If metrics table was built with BuildMetricsTable(), size is
+	/// calculated from it without calling into SDL_ttf, except for
+	/// chars not present in the table
+	///
 	/// \see https://www.libsdl.org/projects/SDL_ttf/docs/SDL_ttf.html#SEC40
 	///
 	////////////////////////////////////////////////////////////
@@ -581,6 +681,67 @@ public:
 
 	///@}
 
+	///@{
+	/// \name Metrics table
+
+	////////////////////////////////////////////////////////////
+	/// \brief Precompute metrics for a range of chars
+	///
+	/// Glyph advances and bounds for all chars in the range, as
+	/// well as kerning for all pairs of them, are queried from
+	/// SDL_ttf once and stored, so GetSizeUTF8() and
+	/// GetGlyphAdvance() may be answered by plain arithmetic.
+	///
+	/// Building takes time quadratic in number of chars because
+	/// of kerning pairs. When font style, outline or hinting is
+	/// changed through this object, table is not rebuilt at once
+	/// but marked outdated, and remeasured on next call which uses
+	/// it (GetGlyphMetrics(), GetGlyphRect(), GetGlyphAdvance() or
+	/// GetSizeUTF8()), so call this again after changing settings
+	/// to pay that cost at a known time.
+	///
+	/// \param[in] first First UNICODE char of the range
+	/// \param[in] last Last UNICODE char of the range, inclusive
+	///
+	/// \returns Reference to self
+	///
+	/// \throws SDL2pp::Exception
+	///
+	////////////////////////////////////////////////////////////
+	Font& BuildMetricsTable(Uint16 first = 0x20, Uint16 last = 0xFF);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Precompute metrics for a set of chars
+	///
+	/// \param[in] chars UNICODE chars to include into table
+	///
+	/// \returns Reference to self
+	///
+	/// \throws SDL2pp::Exception
+	///
+	/// \see BuildMetricsTable(Uint16, Uint16)
+	///
+	////////////////////////////////////////////////////////////
+	Font& BuildMetricsTable(const std::u16string& chars);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Free metrics table
+	///
+	/// \returns Reference to self
+	///
+	////////////////////////////////////////////////////////////
+	Font& DropMetricsTable();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Check whether metrics table was built
+	///
+	/// \returns True if metrics table is present
+	///
+	////////////////////////////////////////////////////////////
+	bool HasMetricsTable() const;
+
+	///@}
+
 	///@{
 	/// \name Rendering: solid
 
@@ -825,6 +986,184 @@ public:
 	Surface RenderGlyph_Blended(Uint16 ch, SDL_Color fg);
 
 	///@}
+
+	///@{
+	/// \name Rendering: any mode
+
+	////////////////////////////////////////////////////////////
+	/// \brief Render UTF8 text using given mode
+	///
+	/// \param[in] text UTF8 string to render
+	/// \param[in] mode Render mode
+	/// \param[in] fg Color to render the text in
+	/// \param[in] bg Color to render the background box in, used
+	///               in shaded mode only
+	///
+	/// \returns Surface containing rendered text
+	///
+	/// \throws SDL2pp::Exception
+	///
+	////////////////////////////////////////////////////////////
+	Surface RenderUTF8(const std::string& text, TextRenderMode mode, SDL_Color fg, SDL_Color bg = SDL_Color{0, 0, 0, 0});
+
+	///@}
+
+	///@{
+	/// \name Rendering: into existing surface
+	///
+	/// These functions compose text from glyph images cached by
+	/// the font, so once all glyphs of the text were rendered,
+	/// they do not allocate any memory, which makes them suitable
+	/// for text which changes every frame. Glyphs are placed the
+	/// same way as SDL2pp::GlyphCache does, so output may differ
+	/// from that of functions returning new surface by a pixel.
+	/// Cached glyph images are dropped when font style, outline
+	/// or hinting is changed.
+	///
+	/// Text is clipped by dst clip rectangle. Supported blend
+	/// modes are SDL_BLENDMODE_NONE, SDL_BLENDMODE_BLEND,
+	/// SDL_BLENDMODE_ADD and SDL_BLENDMODE_MOD, which are applied
+	/// the same way SDL_BlitSurface does, as if rendered text
+	/// surface with given blend mode was blitted onto dst. As
+	/// solid mode surfaces are color keyed, pixels not covered by
+	/// solid text are left intact in all blend modes.
+	/// Surfaces with palette are not supported.
+
+	////////////////////////////////////////////////////////////
+	/// \brief Render UTF8 text into existing surface using solid mode
+	///
+	/// \param[in] text UTF8 string to render
+	/// \param[in] fg Color to render the text in
+	/// \param[in] dst Surface to render into
+	/// \param[in] pos Top left corner of text in dst
+	/// \param[in] blend Blend mode to combine text with dst
+	///
+	/// \returns Text box in dst, before clipping
+	///
+	/// \throws SDL2pp::Exception
+	/// \throws std::invalid_argument if blend mode or dst pixel
+	///         format is not supported
+	///
+	////////////////////////////////////////////////////////////
+	Rect RenderUTF8_Solid(const std::string& text, SDL_Color fg, Surface& dst, const Point& pos, SDL_BlendMode blend = SDL_BLENDMODE_BLEND);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Render the glyph for UNICODE character into existing surface
+	///        using solid mode
+	///
+	/// \param[in] ch UNICODE character to render
+	/// \param[in] fg Color to render the glyph in
+	/// \param[in] dst Surface to render into
+	/// \param[in] pos Top left corner of text in dst
+	/// \param[in] blend Blend mode to combine text with dst
+	///
+	/// \returns Text box in dst, before clipping
+	///
+	/// \throws SDL2pp::Exception
+	/// \throws std::invalid_argument if blend mode or dst pixel
+	///         format is not supported
+	///
+	////////////////////////////////////////////////////////////
+	Rect RenderGlyph_Solid(Uint16 ch, SDL_Color fg, Surface& dst, const Point& pos, SDL_BlendMode blend = SDL_BLENDMODE_BLEND);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Render UTF8 text into existing surface using shaded mode
+	///
+	/// \param[in] text UTF8 string to render
+	/// \param[in] fg Color to render the text in
+	/// \param[in] bg Color to render the background box in
+	/// \param[in] dst Surface to render into
+	/// \param[in] pos Top left corner of text in dst
+	/// \param[in] blend Blend mode to combine text with dst
+	///
+	/// \returns Text box in dst, before clipping
+	///
+	/// \throws SDL2pp::Exception
+	/// \throws std::invalid_argument if blend mode or dst pixel
+	///         format is not supported
+	///
+	////////////////////////////////////////////////////////////
+	Rect RenderUTF8_Shaded(const std::string& text, SDL_Color fg, SDL_Color bg, Surface& dst, const Point& pos, SDL_BlendMode blend = SDL_BLENDMODE_BLEND);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Render the glyph for UNICODE character into existing surface
+	///        using shaded mode
+	///
+	/// \param[in] ch UNICODE character to render
+	/// \param[in] fg Color to render the glyph in
+	/// \param[in] bg Color to render the background box in
+	/// \param[in] dst Surface to render into
+	/// \param[in] pos Top left corner of text in dst
+	/// \param[in] blend Blend mode to combine text with dst
+	///
+	/// \returns Text box in dst, before clipping
+	///
+	/// \throws SDL2pp::Exception
+	/// \throws std::invalid_argument if blend mode or dst pixel
+	///         format is not supported
+	///
+	////////////////////////////////////////////////////////////
+	Rect RenderGlyph_Shaded(Uint16 ch, SDL_Color fg, SDL_Color bg, Surface& dst, const Point& pos, SDL_BlendMode blend = SDL_BLENDMODE_BLEND);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Render UTF8 text into existing surface using blended mode
+	///
+	/// \param[in] text UTF8 string to render
+	/// \param[in] fg Color to render the text in
+	/// \param[in] dst Surface to render into
+	/// \param[in] pos Top left corner of text in dst
+	/// \param[in] blend Blend mode to combine text with dst
+	///
+	/// \returns Text box in dst, before clipping
+	///
+	/// \throws SDL2pp::Exception
+	/// \throws std::invalid_argument if blend mode or dst pixel
+	///         format is not supported
+	///
+	////////////////////////////////////////////////////////////
+	Rect RenderUTF8_Blended(const std::string& text, SDL_Color fg, Surface& dst, const Point& pos, SDL_BlendMode blend = SDL_BLENDMODE_BLEND);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Render the glyph for UNICODE character into existing surface
+	///        using blended mode
+	///
+	/// \param[in] ch UNICODE character to render
+	/// \param[in] fg Color to render the glyph in
+	/// \param[in] dst Surface to render into
+	/// \param[in] pos Top left corner of text in dst
+	/// \param[in] blend Blend mode to combine text with dst
+	///
+	/// \returns Text box in dst, before clipping
+	///
+	/// \throws SDL2pp::Exception
+	/// \throws std::invalid_argument if blend mode or dst pixel
+	///         format is not supported
+	///
+	////////////////////////////////////////////////////////////
+	Rect RenderGlyph_Blended(Uint16 ch, SDL_Color fg, Surface& dst, const Point& pos, SDL_BlendMode blend = SDL_BLENDMODE_BLEND);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Render UTF8 text into existing surface using given mode
+	///
+	/// \param[in] text UTF8 string to render
+	/// \param[in] mode Render mode
+	/// \param[in] fg Color to render the text in
+	/// \param[in] bg Color to render the background box in, used
+	///               in shaded mode only
+	/// \param[in] dst Surface to render into
+	/// \param[in] pos Top left corner of text in dst
+	/// \param[in] blend Blend mode to combine text with dst
+	///
+	/// \returns Text box in dst, before clipping
+	///
+	/// \throws SDL2pp::Exception
+	/// \throws std::invalid_argument if blend mode or dst pixel
+	///         format is not supported
+	///
+	////////////////////////////////////////////////////////////
+	Rect RenderUTF8(const std::string& text, TextRenderMode mode, SDL_Color fg, SDL_Color bg, Surface& dst, const Point& pos, SDL_BlendMode blend = SDL_BLENDMODE_BLEND);
+
+	///@}
 };
 
 }
@@ -0,0 +1,156 @@
+/*
+  libSDL2pp - C++11 bindings/wrapper for SDL2
+  Copyright (C) 2013-2016 Dmitry Marakasov <amdmi3@amdmi3.ru>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include <climits>
+#include <stdexcept>
+#include <utility>
+
+#include <SDL_rwops.h>
+#include <SDL_ttf.h>
+
+#include <SDL2pp/Exception.hh>
+#include <SDL2pp/FontFace.hh>
+#include <SDL2pp/Optional.hh>
+#include <SDL2pp/RWops.hh>
+#include <SDL2pp/ThreadPool.hh>
+
+namespace SDL2pp {
+
+void FontFace::ReadData(RWops& rwops) {
+	const size_t block_size = 65536;
+
+	size_t size = 0;
+	while (true) {
+		data_.resize(size + block_size);
+		size_t nread = rwops.Read(data_.data() + size, 1, block_size);
+		size += nread;
+		if (nread == 0)
+			break;
+	}
+
+	data_.resize(size);
+	data_.shrink_to_fit();
+}
+
+FontFace::FontFace(const std::string& file, long index) : index_(index) {
+	RWops rwops = RWops::FromFile(file);
+	ReadData(rwops);
+}
+
+FontFace::FontFace(RWops& rwops, long index) : index_(index) {
+	ReadData(rwops);
+}
+
+FontFace::~FontFace() {
+	ClearIdleFonts();
+}
+
+Font FontFace::Open(int ptsize) {
+	return Open(ptsize, index_);
+}
+
+Font FontFace::Open(int ptsize, long index) {
+	if (data_.size() > static_cast<size_t>(INT_MAX))
+		throw std::length_error("font data is too large");
+
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	// unlike Font(RWops&, ...), let SDL_ttf own the stream, as
+	// it keeps reading from it while font is open
+	SDL_RWops* rwops = SDL_RWFromConstMem(data_.data(), static_cast<int>(data_.size()));
+	if (rwops == nullptr)
+		throw Exception("SDL_RWFromConstMem");
+
+	TTF_Font* font = TTF_OpenFontIndexRW(rwops, 1, ptsize, index);
+	if (font == nullptr)
+		throw Exception("TTF_OpenFontIndexRW");
+
+	return Font(font);
+}
+
+Font FontFace::AcquireFont(int ptsize) {
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		auto idle = idle_.find(ptsize);
+		if (idle != idle_.end()) {
+			Font font(std::move(idle->second));
+			idle_.erase(idle);
+			return font;
+		}
+	}
+
+	return Open(ptsize);
+}
+
+void FontFace::ReleaseFont(int ptsize, Font&& font) {
+	std::lock_guard<std::mutex> lock(mutex_);
+	idle_.emplace(ptsize, std::move(font));
+}
+
+std::vector<Surface> FontFace::RenderUTF8(ThreadPool& pool, int ptsize, const std::vector<std::string>& texts, TextRenderMode mode, SDL_Color fg, SDL_Color bg, int style) {
+	std::vector<Optional<Surface>> rendered(texts.size());
+
+	pool.ParallelFor(0, static_cast<int>(texts.size()), 1, [&](int begin, int end) {
+			Font font = AcquireFont(ptsize);
+
+			// changing style flushes glyph caches, even if it's the same
+			if (font.GetStyle() != style)
+				font.SetStyle(style);
+
+			try {
+				for (int i = begin; i < end; i++)
+					rendered[i].emplace(font.RenderUTF8(texts[i], mode, fg, bg));
+			} catch (...) {
+				ReleaseFont(ptsize, std::move(font));
+				throw;
+			}
+
+			ReleaseFont(ptsize, std::move(font));
+		});
+
+	std::vector<Surface> surfaces;
+	surfaces.reserve(rendered.size());
+	for (Optional<Surface>& surface : rendered)
+		surfaces.emplace_back(std::move(*surface));
+
+	return surfaces;
+}
+
+FontFace& FontFace::ClearIdleFonts() {
+	std::lock_guard<std::mutex> lock(mutex_);
+	idle_.clear();
+	return *this;
+}
+
+size_t FontFace::GetNumIdleFonts() {
+	std::lock_guard<std::mutex> lock(mutex_);
+	return idle_.size();
+}
+
+size_t FontFace::GetDataSize() const {
+	return data_.size();
+}
+
+long FontFace::GetIndex() const {
+	return index_;
+}
+
+}
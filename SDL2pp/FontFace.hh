@@ -0,0 +1,252 @@
+/*
+  libSDL2pp - C++11 bindings/wrapper for SDL2
+  Copyright (C) 2013-2016 Dmitry Marakasov <amdmi3@amdmi3.ru>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef SDL2PP_FONTFACE_HH
+#define SDL2PP_FONTFACE_HH
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <SDL_stdinc.h>
+
+#include <SDL2pp/Font.hh>
+#include <SDL2pp/Surface.hh>
+#include <SDL2pp/Export.hh>
+
+namespace SDL2pp {
+
+class RWops;
+class ThreadPool;
+
+////////////////////////////////////////////////////////////
+/// \brief Font file kept in memory, for opening any number
+///        of Font instances
+///
+/// \ingroup ttf
+///
+/// \headerfile SDL2pp/FontFace.hh
+///
+/// TTF_Font objects may not be used by several threads at
+/// once, so to render text in parallel each thread needs its
+/// own Font. FontFace reads font file once and opens fonts
+/// from memory, without touching the filesystem again.
+///
+/// RenderUTF8() rasterizes a batch of strings on a thread pool,
+/// taking fonts from a pool of idle fonts kept by FontFace, so
+/// glyph caches of these fonts stay warm between batches.
+/// Fonts keep style of the last batch they rendered, so caches
+/// are only flushed when batches switch between styles.
+///
+/// Fonts opened by FontFace read font data from it, so they
+/// must not outlive it. Opening and closing fonts is serialized
+/// by FontFace, as FreeType library shared by all fonts does not
+/// allow doing it concurrently, so application must not open or
+/// close other fonts while a batch is being rendered.
+///
+/// Usage example:
+/// \code
+/// {
+///     SDL2pp::ThreadPool pool;
+///     SDL2pp::FontFace face("DejaVuSans.ttf");
+///
+///     std::vector<SDL2pp::Surface> labels = face.RenderUTF8(pool, 16, strings, SDL2pp::TextRenderMode::Blended, SDL2pp::Color(255, 255, 255));
+/// }
+/// \endcode
+///
+////////////////////////////////////////////////////////////
+class SDL2PP_EXPORT FontFace {
+private:
+	std::vector<Uint8> data_;           ///< Font file contents
+	long index_;                        ///< Index of face in font file
+	std::mutex mutex_;                  ///< Mutex protecting idle fonts and serializing font opening and closing
+	std::multimap<int, Font> idle_;     ///< Idle fonts by point size
+
+private:
+	////////////////////////////////////////////////////////////
+	/// \brief Read rest of RWops into data
+	///
+	/// \param[in] rwops RWops to read
+	///
+	////////////////////////////////////////////////////////////
+	void ReadData(RWops& rwops);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Take idle font of given size or open new one
+	///
+	/// \param[in] ptsize Point size
+	///
+	/// \returns Font with the style it was last used with
+	///
+	/// \throws SDL2pp::Exception
+	///
+	////////////////////////////////////////////////////////////
+	Font AcquireFont(int ptsize);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Return font to idle fonts
+	///
+	/// \param[in] ptsize Point size font was opened with
+	/// \param[in] font Font to return
+	///
+	////////////////////////////////////////////////////////////
+	void ReleaseFont(int ptsize, Font&& font);
+
+public:
+	////////////////////////////////////////////////////////////
+	/// \brief Read font file
+	///
+	/// \param[in] file Name of .ttf or .fon file
+	/// \param[in] index Index of face in the file
+	///
+	/// \throws SDL2pp::Exception
+	///
+	////////////////////////////////////////////////////////////
+	FontFace(const std::string& file, long index = 0);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Read font from RWops
+	///
+	/// Everything from current position to the end of RWops is
+	/// read, RWops may be closed afterwards
+	///
+	/// \param[in] rwops RWops to read font from
+	/// \param[in] index Index of face in the font
+	///
+	////////////////////////////////////////////////////////////
+	FontFace(RWops& rwops, long index = 0);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Destructor
+	///
+	/// Closes idle fonts. All fonts opened with Open() must be
+	/// closed already.
+	///
+	////////////////////////////////////////////////////////////
+	virtual ~FontFace();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Deleted copy constructor
+	///
+	/// This class is not copyable, as fonts refer to its data
+	///
+	////////////////////////////////////////////////////////////
+	FontFace(const FontFace& other) = delete;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Deleted assignment operator
+	///
+	/// This class is not copyable, as fonts refer to its data
+	///
+	////////////////////////////////////////////////////////////
+	FontFace& operator=(const FontFace& other) = delete;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Open font from in-memory data
+	///
+	/// Returned font may be used on any single thread, but must
+	/// be destroyed before the FontFace
+	///
+	/// \param[in] ptsize %Point size (based on 72DPI) to load font as
+	///
+	/// \returns New font
+	///
+	/// \throws SDL2pp::Exception
+	///
+	////////////////////////////////////////////////////////////
+	Font Open(int ptsize);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Open another face of font file from in-memory data
+	///
+	/// Same as Open(int), but opens face with given index
+	/// instead of one FontFace was constructed with, so a single
+	/// copy of a font collection file may serve all its faces
+	///
+	/// \param[in] ptsize %Point size (based on 72DPI) to load font as
+	/// \param[in] index Index of face in font file
+	///
+	/// \returns New font
+	///
+	/// \throws SDL2pp::Exception
+	///
+	////////////////////////////////////////////////////////////
+	Font Open(int ptsize, long index);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Render batch of UTF-8 strings in parallel
+	///
+	/// Strings are split between threads of the pool, each
+	/// thread rendering with its own font.
+	///
+	/// \param[in] pool Thread pool to render on
+	/// \param[in] ptsize %Point size of font
+	/// \param[in] texts UTF-8 strings to render
+	/// \param[in] mode Render mode
+	/// \param[in] fg Color to render the text in
+	/// \param[in] bg Color to render the background box in, used
+	///               in shaded mode only
+	/// \param[in] style Font style, a bitmask of TTF_STYLE_* values
+	///
+	/// \returns Rendered surfaces in the same order as texts
+	///
+	/// \throws SDL2pp::Exception
+	///
+	////////////////////////////////////////////////////////////
+	std::vector<Surface> RenderUTF8(ThreadPool& pool, int ptsize, const std::vector<std::string>& texts, TextRenderMode mode, SDL_Color fg, SDL_Color bg = SDL_Color{0, 0, 0, 0}, int style = TTF_STYLE_NORMAL);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Close idle fonts kept for rendering batches
+	///
+	/// \returns Reference to self
+	///
+	////////////////////////////////////////////////////////////
+	FontFace& ClearIdleFonts();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get number of idle fonts kept for rendering batches
+	///
+	/// \returns Number of idle fonts
+	///
+	////////////////////////////////////////////////////////////
+	size_t GetNumIdleFonts();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get size of font data
+	///
+	/// \returns Size of font file in bytes
+	///
+	////////////////////////////////////////////////////////////
+	size_t GetDataSize() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get index of face in font file
+	///
+	/// \returns Face index fonts are opened with
+	///
+	////////////////////////////////////////////////////////////
+	long GetIndex() const;
+};
+
+}
+
+#endif
@@ -0,0 +1,134 @@
+/*
+  libSDL2pp - C++11 bindings/wrapper for SDL2
+  Copyright (C) 2013-2016 Dmitry Marakasov <amdmi3@amdmi3.ru>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include <stdexcept>
+#include <utility>
+
+#include <SDL2pp/FontRegistry.hh>
+#include <SDL2pp/RWops.hh>
+
+namespace SDL2pp {
+
+FontRegistry::Entry& FontRegistry::GetEntry(const std::string& name) {
+	auto entry = entries_.find(name);
+	if (entry == entries_.end())
+		throw std::out_of_range("no font face named " + name);
+	return entry->second;
+}
+
+const FontRegistry::Entry& FontRegistry::GetEntry(const std::string& name) const {
+	auto entry = entries_.find(name);
+	if (entry == entries_.end())
+		throw std::out_of_range("no font face named " + name);
+	return entry->second;
+}
+
+FontRegistry::FontRegistry() {
+}
+
+FontRegistry::~FontRegistry() {
+}
+
+FontRegistry& FontRegistry::Add(const std::string& name, const std::string& file) {
+	if (Has(name))
+		throw std::invalid_argument("font face named " + name + " is already registered");
+
+	// read data before creating an entry, so it's not left
+	// without face if reading fails
+	std::unique_ptr<FontFace> face(new FontFace(file));
+	entries_[name].face = std::move(face);
+	return *this;
+}
+
+FontRegistry& FontRegistry::Add(const std::string& name, RWops& rwops) {
+	if (Has(name))
+		throw std::invalid_argument("font face named " + name + " is already registered");
+
+	std::unique_ptr<FontFace> face(new FontFace(rwops));
+	entries_[name].face = std::move(face);
+	return *this;
+}
+
+FontRegistry& FontRegistry::Remove(const std::string& name) {
+	auto entry = entries_.find(name);
+	if (entry == entries_.end())
+		throw std::out_of_range("no font face named " + name);
+	entries_.erase(entry);
+	return *this;
+}
+
+FontRegistry& FontRegistry::Clear() {
+	entries_.clear();
+	return *this;
+}
+
+bool FontRegistry::Has(const std::string& name) const {
+	return entries_.find(name) != entries_.end();
+}
+
+Font& FontRegistry::Get(const std::string& name, int ptsize, long index) {
+	Entry& entry = GetEntry(name);
+
+	auto key = std::make_pair(index, ptsize);
+	auto font = entry.fonts.find(key);
+	if (font == entry.fonts.end())
+		font = entry.fonts.emplace(key, entry.face->Open(ptsize, index)).first;
+
+	return font->second;
+}
+
+Font FontRegistry::Open(const std::string& name, int ptsize, long index) {
+	return GetEntry(name).face->Open(ptsize, index);
+}
+
+FontFace& FontRegistry::GetFace(const std::string& name) {
+	return *GetEntry(name).face;
+}
+
+FontRegistry& FontRegistry::CloseFonts(const std::string& name) {
+	GetEntry(name).fonts.clear();
+	return *this;
+}
+
+std::vector<std::string> FontRegistry::GetNames() const {
+	std::vector<std::string> names;
+	names.reserve(entries_.size());
+	for (const auto& entry : entries_)
+		names.push_back(entry.first);
+	return names;
+}
+
+size_t FontRegistry::GetNumFonts(const std::string& name) const {
+	return GetEntry(name).fonts.size();
+}
+
+size_t FontRegistry::GetDataSize(const std::string& name) const {
+	return GetEntry(name).face->GetDataSize();
+}
+
+size_t FontRegistry::GetTotalDataSize() const {
+	size_t total = 0;
+	for (const auto& entry : entries_)
+		total += entry.second.face->GetDataSize();
+	return total;
+}
+
+}
@@ -0,0 +1,304 @@
+/*
+  libSDL2pp - C++11 bindings/wrapper for SDL2
+  Copyright (C) 2013-2016 Dmitry Marakasov <amdmi3@amdmi3.ru>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef SDL2PP_FONTREGISTRY_HH
+#define SDL2PP_FONTREGISTRY_HH
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <SDL2pp/Font.hh>
+#include <SDL2pp/FontFace.hh>
+#include <SDL2pp/Export.hh>
+
+namespace SDL2pp {
+
+class RWops;
+
+////////////////////////////////////////////////////////////
+/// \brief Named collection of in-memory font files with fonts
+///        opened on demand
+///
+/// \ingroup ttf
+///
+/// \headerfile SDL2pp/FontRegistry.hh
+///
+/// Constructing a Font from file reads and parses the file
+/// each time, so an application which uses a number of point
+/// sizes of a number of faces keeps many copies of the same
+/// data. FontRegistry reads each font file (or RWops) once
+/// into a FontFace, and opens fonts of any point size or face
+/// index from that single copy. Fonts are opened lazily on
+/// first request and kept until the face is removed.
+///
+/// References returned by Get() stay valid until the font's
+/// face is removed or the registry is cleared or destroyed.
+/// The registry is not thread safe.
+///
+/// Usage example:
+/// \code
+/// {
+///     SDL2pp::FontRegistry fonts;
+///     fonts.Add("sans", "DejaVuSans.ttf");
+///     fonts.Add("mono", "DejaVuSansMono.ttf");
+///
+///     renderer.Copy(SDL2pp::Texture(renderer, fonts.Get("sans", 24).RenderUTF8_Blended("Title", SDL2pp::Color(255, 255, 255))));
+///     renderer.Copy(SDL2pp::Texture(renderer, fonts.Get("mono", 12).RenderUTF8_Blended("Body", SDL2pp::Color(255, 255, 255))));
+/// }
+/// \endcode
+///
+////////////////////////////////////////////////////////////
+class SDL2PP_EXPORT FontRegistry {
+private:
+	struct Entry {
+		std::unique_ptr<FontFace> face;               ///< Font file data
+		std::map<std::pair<long, int>, Font> fonts;   ///< Fonts opened by Get(), by face index and point size
+	};
+
+	std::map<std::string, Entry> entries_;            ///< Faces by name
+
+private:
+	////////////////////////////////////////////////////////////
+	/// \brief Find entry by name
+	///
+	/// \param[in] name Name of face
+	///
+	/// \returns Entry registered under name
+	///
+	/// \throws std::out_of_range if there's no such face
+	///
+	////////////////////////////////////////////////////////////
+	Entry& GetEntry(const std::string& name);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Find entry by name
+	///
+	/// \param[in] name Name of face
+	///
+	/// \returns Entry registered under name
+	///
+	/// \throws std::out_of_range if there's no such face
+	///
+	////////////////////////////////////////////////////////////
+	const Entry& GetEntry(const std::string& name) const;
+
+public:
+	////////////////////////////////////////////////////////////
+	/// \brief Construct empty registry
+	///
+	////////////////////////////////////////////////////////////
+	FontRegistry();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Destructor
+	///
+	/// Closes all fonts and frees font data
+	///
+	////////////////////////////////////////////////////////////
+	virtual ~FontRegistry();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Deleted copy constructor
+	///
+	/// This class is not copyable
+	///
+	////////////////////////////////////////////////////////////
+	FontRegistry(const FontRegistry& other) = delete;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Deleted assignment operator
+	///
+	/// This class is not copyable
+	///
+	////////////////////////////////////////////////////////////
+	FontRegistry& operator=(const FontRegistry& other) = delete;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Read font file and register it under given name
+	///
+	/// \param[in] name Name to register face under
+	/// \param[in] file Name of .ttf or .fon file
+	///
+	/// \returns Reference to self
+	///
+	/// \throws SDL2pp::Exception
+	/// \throws std::invalid_argument if name is already taken
+	///
+	////////////////////////////////////////////////////////////
+	FontRegistry& Add(const std::string& name, const std::string& file);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Read font from RWops and register it under given name
+	///
+	/// Everything from current position to the end of RWops is
+	/// read, RWops may be closed afterwards
+	///
+	/// \param[in] name Name to register face under
+	/// \param[in] rwops RWops to read font from
+	///
+	/// \returns Reference to self
+	///
+	/// \throws std::invalid_argument if name is already taken
+	///
+	////////////////////////////////////////////////////////////
+	FontRegistry& Add(const std::string& name, RWops& rwops);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Remove face, closing all its fonts
+	///
+	/// \param[in] name Name of face
+	///
+	/// \returns Reference to self
+	///
+	/// \throws std::out_of_range if there's no such face
+	///
+	////////////////////////////////////////////////////////////
+	FontRegistry& Remove(const std::string& name);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Remove all faces, closing all fonts
+	///
+	/// \returns Reference to self
+	///
+	////////////////////////////////////////////////////////////
+	FontRegistry& Clear();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Check whether face is registered
+	///
+	/// \param[in] name Name of face
+	///
+	/// \returns True if face with given name is registered
+	///
+	////////////////////////////////////////////////////////////
+	bool Has(const std::string& name) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get font of given size, opening it on first use
+	///
+	/// \param[in] name Name of face
+	/// \param[in] ptsize %Point size (based on 72DPI) of font
+	/// \param[in] index Index of face in font file
+	///
+	/// \returns Reference to font owned by registry
+	///
+	/// \throws SDL2pp::Exception
+	/// \throws std::out_of_range if there's no such face
+	///
+	////////////////////////////////////////////////////////////
+	Font& Get(const std::string& name, int ptsize, long index = 0);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Open new font from registered face
+	///
+	/// Unlike Get(), returns a separate font not kept by
+	/// registry, which is useful if font style needs to be
+	/// changed or font is to be used on another thread. The
+	/// font must be destroyed before its face is removed.
+	///
+	/// \param[in] name Name of face
+	/// \param[in] ptsize %Point size (based on 72DPI) of font
+	/// \param[in] index Index of face in font file
+	///
+	/// \returns New font
+	///
+	/// \throws SDL2pp::Exception
+	/// \throws std::out_of_range if there's no such face
+	///
+	////////////////////////////////////////////////////////////
+	Font Open(const std::string& name, int ptsize, long index = 0);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get face holding font data
+	///
+	/// \param[in] name Name of face
+	///
+	/// \returns Reference to face owned by registry
+	///
+	/// \throws std::out_of_range if there's no such face
+	///
+	////////////////////////////////////////////////////////////
+	FontFace& GetFace(const std::string& name);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Close fonts opened by Get(), keeping font data
+	///
+	/// \param[in] name Name of face
+	///
+	/// \returns Reference to self
+	///
+	/// \throws std::out_of_range if there's no such face
+	///
+	////////////////////////////////////////////////////////////
+	FontRegistry& CloseFonts(const std::string& name);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get names of registered faces
+	///
+	/// \returns Names of faces in lexicographical order
+	///
+	////////////////////////////////////////////////////////////
+	std::vector<std::string> GetNames() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get number of fonts opened by Get() for given face
+	///
+	/// \param[in] name Name of face
+	///
+	/// \returns Number of point size and index combinations
+	///          currently open
+	///
+	/// \throws std::out_of_range if there's no such face
+	///
+	////////////////////////////////////////////////////////////
+	size_t GetNumFonts(const std::string& name) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get size of font data kept for given face
+	///
+	/// This is the memory shared by all fonts of the face.
+	/// Per-font FreeType structures and glyph caches are not
+	/// included, as SDL_ttf provides no way to query them.
+	///
+	/// \param[in] name Name of face
+	///
+	/// \returns Size of font file in bytes
+	///
+	/// \throws std::out_of_range if there's no such face
+	///
+	////////////////////////////////////////////////////////////
+	size_t GetDataSize(const std::string& name) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get total size of font data kept by registry
+	///
+	/// \returns Sum of GetDataSize() for all faces
+	///
+	////////////////////////////////////////////////////////////
+	size_t GetTotalDataSize() const;
+};
+
+}
+
+#endif
@@ -0,0 +1,126 @@
+/*
+  libSDL2pp - C++11 bindings/wrapper for SDL2
+  Copyright (C) 2013-2016 Dmitry Marakasov <amdmi3@amdmi3.ru>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include <SDL2pp/Font.hh>
+#include <SDL2pp/GlyphCache.hh>
+#include <SDL2pp/GlyphUtils.hh>
+#include <SDL2pp/UTF8.hh>
+
+namespace SDL2pp {
+
+GlyphCache::GlyphCache(Renderer& renderer, Font& font, int page_size)
+	: renderer_(renderer),
+	  font_(font),
+	  page_size_(page_size),
+	  atlas_(new Atlas(renderer, page_size, page_size)) {
+}
+
+const GlyphCache::Glyph& GlyphCache::GetGlyph(Uint16 ch) {
+	auto cached = glyphs_.find(ch);
+	if (cached != glyphs_.end())
+		return cached->second;
+
+	GlyphImage image = RenderGlyphImage(font_, ch, false);
+
+	Glyph glyph;
+	glyph.advance = image.advance;
+	if (image.surface) {
+		glyph.offset = image.origin;
+		glyph.region = atlas_->Add(*image.surface);
+	}
+
+	return glyphs_.emplace(ch, glyph).first->second;
+}
+
+Point GlyphCache::Layout(const std::string& text, const Point& pos, const Color& color, bool queue) {
+	int x = 0;
+	bool first = true;
+	Uint16 prev_ch = 0;
+
+	const char* it = text.data();
+	const char* end = it + text.size();
+	while (it != end) {
+		Uint16 ch = DecodeUTF8ToUCS2(it, end);
+
+		if (!first)
+			x += GetCachedKerning(font_, kerning_, prev_ch, ch);
+
+		const Glyph& glyph = GetGlyph(ch);
+		if (queue && glyph.region.IsValid()) {
+			Point size = glyph.region.GetSize();
+			queue_.push_back(QueuedGlyph{&glyph.region, Rect(pos.x + x + glyph.offset.x, pos.y + glyph.offset.y, size.x, size.y), color});
+		}
+
+		x += glyph.advance;
+		prev_ch = ch;
+		first = false;
+	}
+
+	return Point(x, font_.GetHeight());
+}
+
+GlyphCache& GlyphCache::PreloadUTF8(const std::string& text) {
+	const char* it = text.data();
+	const char* end = it + text.size();
+	while (it != end)
+		GetGlyph(DecodeUTF8ToUCS2(it, end));
+	return *this;
+}
+
+Point GlyphCache::QueueUTF8(const std::string& text, const Point& pos, const Color& color) {
+	return Layout(text, pos, color, true);
+}
+
+GlyphCache& GlyphCache::Flush(bool group_by_texture) {
+	FlushGlyphQueue(renderer_, queue_, commands_, group_by_texture);
+	return *this;
+}
+
+GlyphCache& GlyphCache::DrawUTF8(const std::string& text, const Point& pos, const Color& color) {
+	QueueUTF8(text, pos, color);
+	return Flush();
+}
+
+Point GlyphCache::GetSizeUTF8(const std::string& text) {
+	return Layout(text, Point(0, 0), Color(), false);
+}
+
+GlyphCache& GlyphCache::Clear() {
+	queue_.clear();
+	glyphs_.clear();
+	kerning_.clear();
+	atlas_.reset(new Atlas(renderer_, page_size_, page_size_));
+	return *this;
+}
+
+size_t GlyphCache::GetNumGlyphs() const {
+	return glyphs_.size();
+}
+
+size_t GlyphCache::GetNumQueued() const {
+	return queue_.size();
+}
+
+Atlas& GlyphCache::GetAtlas() {
+	return *atlas_;
+}
+
+}
@@ -0,0 +1,272 @@
+/*
+  libSDL2pp - C++11 bindings/wrapper for SDL2
+  Copyright (C) 2013-2016 Dmitry Marakasov <amdmi3@amdmi3.ru>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef SDL2PP_GLYPHCACHE_HH
+#define SDL2PP_GLYPHCACHE_HH
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <SDL_stdinc.h>
+
+#include <SDL2pp/Atlas.hh>
+#include <SDL2pp/Color.hh>
+#include <SDL2pp/Point.hh>
+#include <SDL2pp/Rect.hh>
+#include <SDL2pp/Renderer.hh>
+#include <SDL2pp/Export.hh>
+
+namespace SDL2pp {
+
+class Font;
+
+////////////////////////////////////////////////////////////
+/// \brief Cache of font glyphs in atlas textures
+///
+/// \ingroup ttf
+///
+/// \headerfile SDL2pp/GlyphCache.hh
+///
+/// Each glyph is rasterized once with Font::RenderGlyph_Blended
+/// in white and stored in SDL2pp::Atlas. Strings are then drawn
+/// as a batch of texture copies, with color applied through
+/// texture modulation, so drawing text does not involve any
+/// rasterization or texture uploads once all of its glyphs are
+/// cached.
+///
+/// Glyphs are placed according to Font::GetGlyphMetrics and
+/// kerning is applied if enabled on the font, which matches
+/// Font::RenderUTF8_Blended for hinted fonts. Cache must be
+/// cleared with Clear() after changing font style, outline or
+/// hinting. Font and renderer must outlive the cache.
+///
+////////////////////////////////////////////////////////////
+class SDL2PP_EXPORT GlyphCache {
+private:
+	////////////////////////////////////////////////////////////
+	/// \brief Cached glyph
+	///
+	////////////////////////////////////////////////////////////
+	struct Glyph {
+		AtlasRegion region; ///< Glyph image, invalid for blank glyphs
+		Point offset;       ///< Position of glyph image relative to pen position at the top of the line
+		int advance;        ///< Horizontal advance
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Queued glyph copy
+	///
+	/// Region is referenced instead of storing texture pointer,
+	/// as atlas may be repacked while adding glyphs
+	///
+	////////////////////////////////////////////////////////////
+	struct QueuedGlyph {
+		const AtlasRegion* region; ///< Glyph image
+		Rect dstrect;              ///< Destination rectangle
+		Color color;               ///< Text color
+	};
+
+private:
+	Renderer& renderer_;                               ///< Renderer to draw with
+	Font& font_;                                       ///< Font to take glyphs from
+	int page_size_;                                    ///< Size of atlas pages
+	std::unique_ptr<Atlas> atlas_;                     ///< Storage for glyph images
+	std::unordered_map<Uint16, Glyph> glyphs_;         ///< Cached glyphs
+	std::unordered_map<Uint32, int> kerning_;          ///< Cached kerning pairs
+	std::vector<QueuedGlyph> queue_;                   ///< Glyphs queued for drawing
+	std::vector<Renderer::CopyCommand> commands_;      ///< Reusable batch storage
+
+private:
+	////////////////////////////////////////////////////////////
+	/// \brief Get cached glyph, rasterizing it if needed
+	///
+	/// \param[in] ch UNICODE char
+	///
+	/// \returns Cached glyph
+	///
+	/// \throws SDL2pp::Exception
+	/// \throws std::invalid_argument if glyph does not fit into
+	///         atlas page
+	///
+	////////////////////////////////////////////////////////////
+	const Glyph& GetGlyph(Uint16 ch);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Lay out UTF-8 string
+	///
+	/// \param[in] text UTF-8 string
+	/// \param[in] pos Top left corner of text
+	/// \param[in] color Text color
+	/// \param[in] queue Whether to queue glyphs for drawing
+	///
+	/// \returns Size of the text
+	///
+	/// \throws SDL2pp::Exception
+	///
+	////////////////////////////////////////////////////////////
+	Point Layout(const std::string& text, const Point& pos, const Color& color, bool queue);
+
+public:
+	////////////////////////////////////////////////////////////
+	/// \brief Create empty glyph cache
+	///
+	/// \param[in] renderer Rendering context to draw text with
+	/// \param[in] font Font to take glyphs from
+	/// \param[in] page_size Width and height of atlas page textures
+	///
+	////////////////////////////////////////////////////////////
+	GlyphCache(Renderer& renderer, Font& font, int page_size = 512);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Deleted copy constructor
+	///
+	/// This class is not copyable, as it contains an atlas
+	///
+	////////////////////////////////////////////////////////////
+	GlyphCache(const GlyphCache& other) = delete;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Deleted assignment operator
+	///
+	/// This class is not copyable, as it contains an atlas
+	///
+	////////////////////////////////////////////////////////////
+	GlyphCache& operator=(const GlyphCache& other) = delete;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Rasterize glyphs for all chars of UTF-8 string
+	///
+	/// Useful to populate the cache in advance, before first
+	/// frame is drawn
+	///
+	/// \param[in] text UTF-8 string
+	///
+	/// \returns Reference to self
+	///
+	/// \throws SDL2pp::Exception
+	///
+	////////////////////////////////////////////////////////////
+	GlyphCache& PreloadUTF8(const std::string& text);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Queue UTF-8 string for drawing
+	///
+	/// Glyphs are not drawn until Flush() is called, which allows
+	/// many strings to be submitted as a single batch
+	///
+	/// \param[in] text UTF-8 string
+	/// \param[in] pos Top left corner of text
+	/// \param[in] color Text color
+	///
+	/// \returns Size of the text, same as returned by GetSizeUTF8()
+	///
+	/// \throws SDL2pp::Exception
+	///
+	////////////////////////////////////////////////////////////
+	Point QueueUTF8(const std::string& text, const Point& pos, const Color& color = Color(255, 255, 255));
+
+	////////////////////////////////////////////////////////////
+	/// \brief Draw all queued glyphs
+	///
+	/// \param[in] group_by_texture Whether to reorder copies so
+	///                             glyphs from the same atlas page
+	///                             are drawn together, see
+	///                             Renderer::CopyBatch
+	///
+	/// \returns Reference to self
+	///
+	/// \throws SDL2pp::Exception
+	///
+	////////////////////////////////////////////////////////////
+	GlyphCache& Flush(bool group_by_texture = false);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Draw UTF-8 string
+	///
+	/// Queues the string and flushes the queue immediately
+	///
+	/// \param[in] text UTF-8 string
+	/// \param[in] pos Top left corner of text
+	/// \param[in] color Text color
+	///
+	/// \returns Reference to self
+	///
+	/// \throws SDL2pp::Exception
+	///
+	////////////////////////////////////////////////////////////
+	GlyphCache& DrawUTF8(const std::string& text, const Point& pos, const Color& color = Color(255, 255, 255));
+
+	////////////////////////////////////////////////////////////
+	/// \brief Calculate size of UTF-8 string as drawn by the cache
+	///
+	/// Width is sum of glyph advances and kerning, height is font
+	/// height. Missing glyphs are rasterized and cached.
+	///
+	/// \param[in] text UTF-8 string
+	///
+	/// \returns Size of the text
+	///
+	/// \throws SDL2pp::Exception
+	///
+	////////////////////////////////////////////////////////////
+	Point GetSizeUTF8(const std::string& text);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Drop all cached glyphs and queued text
+	///
+	/// Must be called after changing font style, outline or
+	/// hinting, as cached glyphs are no longer valid then
+	///
+	/// \returns Reference to self
+	///
+	////////////////////////////////////////////////////////////
+	GlyphCache& Clear();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get number of cached glyphs
+	///
+	/// \returns Number of cached glyphs
+	///
+	////////////////////////////////////////////////////////////
+	size_t GetNumGlyphs() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get number of glyph copies waiting for Flush()
+	///
+	/// \returns Number of queued glyphs
+	///
+	////////////////////////////////////////////////////////////
+	size_t GetNumQueued() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get atlas holding glyph images
+	///
+	/// \returns Reference to glyph atlas
+	///
+	////////////////////////////////////////////////////////////
+	Atlas& GetAtlas();
+};
+
+}
+
+#endif
@@ -0,0 +1,111 @@
+/*
+  libSDL2pp - C++11 bindings/wrapper for SDL2
+  Copyright (C) 2013-2016 Dmitry Marakasov <amdmi3@amdmi3.ru>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#include <algorithm>
+
+#include <SDL_version.h>
+#include <SDL_ttf.h>
+
+#include <SDL2pp/Font.hh>
+#include <SDL2pp/GlyphUtils.hh>
+#include <SDL2pp/PixelView.hh>
+
+namespace SDL2pp {
+
+namespace {
+
+struct CoverageReader {
+	std::vector<Uint8>& coverage;
+
+	template<Uint32 Format>
+	void operator()(const PixelView<Format>& view) const {
+		typedef typename PixelView<Format>::Traits Traits;
+
+		for (int y = 0; y < view.GetHeight(); y++)
+			for (int x = 0; x < view.GetWidth(); x++)
+				coverage.push_back(Traits::GetAlpha(view.GetPixel(x, y)));
+	}
+};
+
+}
+
+GlyphImage RenderGlyphImage(Font& font, Uint16 ch, bool solid) {
+	int minx, maxx, miny, maxy;
+	GlyphImage image;
+	font.GetGlyphMetrics(ch, minx, maxx, miny, maxy, image.advance);
+
+	// whitespace has no image, and SDL_ttf may fail to render it
+	if (minx < maxx && miny < maxy) {
+		SDL_Color white = {255, 255, 255, 255};
+		Surface surface = solid ? font.RenderGlyph_Solid(ch, white) : font.RenderGlyph_Blended(ch, white);
+		if (surface.GetWidth() > 0 && surface.GetHeight() > 0) {
+#if SDL_VERSIONNUM(SDL_TTF_MAJOR_VERSION, SDL_TTF_MINOR_VERSION, SDL_TTF_PATCHLEVEL) >= SDL_VERSIONNUM(2, 0, 15)
+			// rendered the same way as a single char string: full
+			// line height, extended to the left by negative bearing
+			image.origin = Point(std::min(minx, 0), 0);
+#else
+			// rendered as a bare glyph bitmap
+			image.origin = Point(minx, font.GetAscent() - maxy);
+#endif
+			image.surface = std::move(surface);
+		}
+	}
+
+	return image;
+}
+
+void ReadGlyphCoverage(Surface& glyph, std::vector<Uint8>& coverage) {
+	int width = glyph.GetWidth();
+	int height = glyph.GetHeight();
+
+	coverage.clear();
+	coverage.reserve(static_cast<size_t>(width) * static_cast<size_t>(height));
+
+	Surface::LockHandle lock = glyph.Lock();
+	if (glyph.GetFormat() == SDL_PIXELFORMAT_INDEX8) {
+		// solid mode: color key index 0 is transparent
+		for (int y = 0; y < height; y++) {
+			const Uint8* row = static_cast<const Uint8*>(lock.GetPixels()) + y * lock.GetPitch();
+			for (int x = 0; x < width; x++)
+				coverage.push_back(row[x] != 0 ? 255 : 0);
+		}
+	} else {
+		VisitPixelView(glyph, lock, CoverageReader{coverage});
+	}
+}
+
+int GetCachedKerning(const Font& font, std::unordered_map<Uint32, int>& cache, Uint16 prev_ch, Uint16 ch) {
+	if (!font.GetKerning())
+		return 0;
+
+	Uint32 pair = (static_cast<Uint32>(prev_ch) << 16) | ch;
+
+	auto cached = cache.find(pair);
+	if (cached != cache.end())
+		return cached->second;
+
+	int kerning = font.GetKerningSize(prev_ch, ch);
+	cache.emplace(pair, kerning);
+	return kerning;
+}
+
+}
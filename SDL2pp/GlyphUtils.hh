@@ -0,0 +1,130 @@
+/*
+  libSDL2pp - C++11 bindings/wrapper for SDL2
+  Copyright (C) 2013-2016 Dmitry Marakasov <amdmi3@amdmi3.ru>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#ifndef SDL2PP_GLYPHUTILS_HH
+#define SDL2PP_GLYPHUTILS_HH
+
+// Internal helpers shared by Font, GlyphCache and
+// DistanceFieldCache; this header is not installed
+
+#include <unordered_map>
+#include <vector>
+
+#include <SDL_stdinc.h>
+
+#include <SDL2pp/Optional.hh>
+#include <SDL2pp/Point.hh>
+#include <SDL2pp/Renderer.hh>
+#include <SDL2pp/Surface.hh>
+
+namespace SDL2pp {
+
+class Font;
+
+////////////////////////////////////////////////////////////
+/// \brief Single glyph rendered by SDL_ttf
+///
+////////////////////////////////////////////////////////////
+struct GlyphImage {
+	Optional<Surface> surface; ///< Rendered glyph, unset for blank glyphs
+	Point origin;              ///< Position of surface relative to pen position at the top of the line
+	int advance;               ///< Horizontal advance
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Render single glyph in white and find where it goes
+///
+/// Glyphs without an image, such as whitespace, are not
+/// rendered at all, as SDL_ttf may fail on them.
+///
+/// \param[in] font Font to render glyph with
+/// \param[in] ch UNICODE char
+/// \param[in] solid Whether to use Font::RenderGlyph_Solid
+///                  instead of Font::RenderGlyph_Blended
+///
+/// \returns Rendered glyph with its placement
+///
+/// \throws SDL2pp::Exception
+///
+////////////////////////////////////////////////////////////
+GlyphImage RenderGlyphImage(Font& font, Uint16 ch, bool solid);
+
+////////////////////////////////////////////////////////////
+/// \brief Read coverage of glyph rendered by SDL_ttf
+///
+/// \param[in] glyph Glyph surface: indexed one as rendered in
+///                  solid mode, where nonzero index is fully
+///                  covered, or any format with alpha channel
+/// \param[out] coverage Coverage by pixel, row by row; previous
+///                      contents are discarded
+///
+/// \throws SDL2pp::Exception
+/// \throws std::invalid_argument if surface format is not supported
+///
+////////////////////////////////////////////////////////////
+void ReadGlyphCoverage(Surface& glyph, std::vector<Uint8>& coverage);
+
+////////////////////////////////////////////////////////////
+/// \brief Get kerning between two chars, caching it
+///
+/// \param[in] font Font to query kerning from
+/// \param[in,out] cache Kerning by pair of chars
+/// \param[in] prev_ch Preceding UNICODE char
+/// \param[in] ch Following UNICODE char
+///
+/// \returns Kerning in pixels, zero if font kerning is disabled
+///
+////////////////////////////////////////////////////////////
+int GetCachedKerning(const Font& font, std::unordered_map<Uint32, int>& cache, Uint16 prev_ch, Uint16 ch);
+
+////////////////////////////////////////////////////////////
+/// \brief Draw and empty queue of glyph copies
+///
+/// Textures are resolved only now, as adding glyphs may have
+/// repacked the atlas after they were queued
+///
+/// \param[in] renderer Renderer to draw with
+/// \param[in,out] queue Queued glyphs, each with region, which
+///                      points to AtlasRegion, dstrect and color
+/// \param[in,out] commands Reusable batch storage
+/// \param[in] group_by_texture Whether to group copies by atlas
+///                             page, see Renderer::CopyBatch
+///
+/// \throws SDL2pp::Exception
+///
+////////////////////////////////////////////////////////////
+template<typename QueuedGlyph>
+void FlushGlyphQueue(Renderer& renderer, std::vector<QueuedGlyph>& queue, std::vector<Renderer::CopyCommand>& commands, bool group_by_texture) {
+	commands.clear();
+	commands.reserve(queue.size());
+	for (const QueuedGlyph& queued : queue)
+		if (queued.region->IsValid())
+			commands.emplace_back(queued.region->GetTexture(), queued.region->GetRect(), queued.dstrect, queued.color);
+	queue.clear();
+
+	if (!commands.empty())
+		renderer.CopyBatch(commands.data(), static_cast<int>(commands.size()), group_by_texture);
+}
+
+}
+
+#endif
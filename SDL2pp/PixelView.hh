@@ -0,0 +1,921 @@
+/*
+  libSDL2pp - C++11 bindings/wrapper for SDL2
+  Copyright (C) 2013-2016 Dmitry Marakasov <amdmi3@amdmi3.ru>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef SDL2PP_PIXELVIEW_HH
+#define SDL2PP_PIXELVIEW_HH
+
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+#include <SDL_pixels.h>
+#include <SDL_stdinc.h>
+
+#include <SDL2pp/Color.hh>
+#include <SDL2pp/Optional.hh>
+#include <SDL2pp/Rect.hh>
+#include <SDL2pp/Surface.hh>
+#include <SDL2pp/Texture.hh>
+
+namespace SDL2pp {
+
+////////////////////////////////////////////////////////////
+/// \brief Compile-time helpers for SDL2pp::PixelChannel
+///
+/// \ingroup rendering
+///
+/// \headerfile SDL2pp/PixelView.hh
+///
+////////////////////////////////////////////////////////////
+class PixelChannelBase {
+protected:
+	////////////////////////////////////////////////////////////
+	/// \brief Get position of lowest set bit of a mask
+	///
+	////////////////////////////////////////////////////////////
+	static constexpr int GetMaskShift(Uint32 mask) {
+		return (mask == 0 || (mask & 1) != 0) ? 0 : 1 + GetMaskShift(mask >> 1);
+	}
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get number of set bits in a mask
+	///
+	////////////////////////////////////////////////////////////
+	static constexpr int GetMaskBits(Uint32 mask) {
+		return mask == 0 ? 0 : static_cast<int>(mask & 1) + GetMaskBits(mask >> 1);
+	}
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get multiplier which repeats value of given width
+	///        given number of times
+	///
+	////////////////////////////////////////////////////////////
+	static constexpr Uint32 GetRepeatMultiplier(int bits, int count) {
+		return count <= 0 ? 0 : (GetRepeatMultiplier(bits, count - 1) << bits) | 1;
+	}
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Single color channel of packed pixel format
+///
+/// \ingroup rendering
+///
+/// \headerfile SDL2pp/PixelView.hh
+///
+/// Converts channel values between packed pixels and 8 bit
+/// components. Narrow channels are expanded by bit replication
+/// (so full intensity always becomes 255) and values are
+/// narrowed by truncation, same as SDL_GetRGBA and SDL_MapRGBA
+/// do. Channels wider than 8 bits are handled the same way
+/// in reverse.
+///
+/// \tparam Mask Bit mask of the channel
+///
+////////////////////////////////////////////////////////////
+template<Uint32 Mask>
+class PixelChannel : private PixelChannelBase {
+public:
+	static constexpr int Shift = GetMaskShift(Mask); ///< Position of lowest bit of the channel
+	static constexpr int Bits = GetMaskBits(Mask);   ///< Width of the channel in bits
+
+private:
+	// bit replication is done with a single multiply and shift:
+	// value is repeated enough times to cover target width, and
+	// extra low bits are dropped
+	static constexpr int ExpandCount = Bits == 0 ? 1 : (8 + Bits - 1) / Bits;
+	static constexpr Uint32 ExpandMultiplier = GetRepeatMultiplier(Bits, ExpandCount);
+	static constexpr int ExpandShift = Bits == 0 ? 0 : ExpandCount * Bits - 8;
+
+	static constexpr int NarrowCount = (Bits + 7) / 8;
+	static constexpr Uint32 NarrowMultiplier = GetRepeatMultiplier(8, NarrowCount);
+	static constexpr int NarrowShift = NarrowCount * 8 - Bits;
+
+public:
+	////////////////////////////////////////////////////////////
+	/// \brief Extract channel value from a pixel
+	///
+	/// \param[in] pixel Packed pixel value
+	///
+	/// \returns Channel value expanded to 0..255 range
+	///
+	////////////////////////////////////////////////////////////
+	static constexpr Uint8 Extract(Uint32 pixel) {
+		return static_cast<Uint8>((((pixel & Mask) >> Shift) * ExpandMultiplier) >> ExpandShift);
+	}
+
+	////////////////////////////////////////////////////////////
+	/// \brief Place channel value into a pixel
+	///
+	/// \param[in] value Channel value in 0..255 range
+	///
+	/// \returns Channel value narrowed and shifted into its
+	///          position within packed pixel
+	///
+	////////////////////////////////////////////////////////////
+	static constexpr Uint32 Pack(Uint8 value) {
+		return (((value * NarrowMultiplier) >> NarrowShift) << Shift) & Mask;
+	}
+};
+
+template<Uint32 Mask> constexpr int PixelChannel<Mask>::Shift;
+template<Uint32 Mask> constexpr int PixelChannel<Mask>::Bits;
+template<Uint32 Mask> constexpr int PixelChannel<Mask>::ExpandCount;
+template<Uint32 Mask> constexpr Uint32 PixelChannel<Mask>::ExpandMultiplier;
+template<Uint32 Mask> constexpr int PixelChannel<Mask>::ExpandShift;
+template<Uint32 Mask> constexpr int PixelChannel<Mask>::NarrowCount;
+template<Uint32 Mask> constexpr Uint32 PixelChannel<Mask>::NarrowMultiplier;
+template<Uint32 Mask> constexpr int PixelChannel<Mask>::NarrowShift;
+
+////////////////////////////////////////////////////////////
+/// \brief Traits of packed pixel format
+///
+/// \ingroup rendering
+///
+/// \headerfile SDL2pp/PixelView.hh
+///
+/// \tparam T Integer type single pixel is stored in
+/// \tparam R Red channel mask
+/// \tparam G Green channel mask
+/// \tparam B Blue channel mask
+/// \tparam A Alpha channel mask, 0 if format has no alpha
+///
+////////////////////////////////////////////////////////////
+template<typename T, Uint32 R, Uint32 G, Uint32 B, Uint32 A>
+struct PackedPixelFormatTraits {
+	typedef T PixelType;          ///< Type of a single pixel
+
+	typedef PixelChannel<R> Red;   ///< Red channel
+	typedef PixelChannel<G> Green; ///< Green channel
+	typedef PixelChannel<B> Blue;  ///< Blue channel
+	typedef PixelChannel<A> Alpha; ///< Alpha channel
+
+	static constexpr bool HasAlpha = A != 0; ///< Whether format has alpha channel
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get red component of a pixel
+	///
+	/// \param[in] pixel Pixel value
+	///
+	/// \returns Red component in 0..255 range
+	///
+	////////////////////////////////////////////////////////////
+	static constexpr Uint8 GetRed(PixelType pixel) {
+		return Red::Extract(pixel);
+	}
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get green component of a pixel
+	///
+	/// \param[in] pixel Pixel value
+	///
+	/// \returns Green component in 0..255 range
+	///
+	////////////////////////////////////////////////////////////
+	static constexpr Uint8 GetGreen(PixelType pixel) {
+		return Green::Extract(pixel);
+	}
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get blue component of a pixel
+	///
+	/// \param[in] pixel Pixel value
+	///
+	/// \returns Blue component in 0..255 range
+	///
+	////////////////////////////////////////////////////////////
+	static constexpr Uint8 GetBlue(PixelType pixel) {
+		return Blue::Extract(pixel);
+	}
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get alpha component of a pixel
+	///
+	/// \param[in] pixel Pixel value
+	///
+	/// \returns Alpha component in 0..255 range, 255 for formats
+	///          without alpha
+	///
+	////////////////////////////////////////////////////////////
+	static constexpr Uint8 GetAlpha(PixelType pixel) {
+		return HasAlpha ? Alpha::Extract(pixel) : 255;
+	}
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get color of a pixel
+	///
+	/// \param[in] pixel Pixel value
+	///
+	/// \returns Color of the pixel
+	///
+	////////////////////////////////////////////////////////////
+	static constexpr Color GetColor(PixelType pixel) {
+		return Color(GetRed(pixel), GetGreen(pixel), GetBlue(pixel), GetAlpha(pixel));
+	}
+
+	////////////////////////////////////////////////////////////
+	/// \brief Map color components to a pixel
+	///
+	/// \param[in] r Red component
+	/// \param[in] g Green component
+	/// \param[in] b Blue component
+	/// \param[in] a Alpha component, ignored for formats without alpha
+	///
+	/// \returns Pixel value
+	///
+	/// \see http://wiki.libsdl.org/SDL_MapRGBA
+	///
+	////////////////////////////////////////////////////////////
+	static constexpr PixelType MapRGBA(Uint8 r, Uint8 g, Uint8 b, Uint8 a = 255) {
+		return static_cast<PixelType>(Red::Pack(r) | Green::Pack(g) | Blue::Pack(b) | Alpha::Pack(a));
+	}
+
+	////////////////////////////////////////////////////////////
+	/// \brief Map color to a pixel
+	///
+	/// \param[in] color Color to map
+	///
+	/// \returns Pixel value
+	///
+	////////////////////////////////////////////////////////////
+	static constexpr PixelType MapColor(const Color& color) {
+		return MapRGBA(color.GetRed(), color.GetGreen(), color.GetBlue(), color.GetAlpha());
+	}
+};
+
+template<typename T, Uint32 R, Uint32 G, Uint32 B, Uint32 A> constexpr bool PackedPixelFormatTraits<T, R, G, B, A>::HasAlpha;
+
+////////////////////////////////////////////////////////////
+/// \brief Pixel of 24 bit byte-ordered format
+///
+/// \ingroup rendering
+///
+/// \headerfile SDL2pp/PixelView.hh
+///
+////////////////////////////////////////////////////////////
+struct Pixel24 {
+	Uint8 bytes[3]; ///< Color components in memory order
+};
+
+static_assert(sizeof(Pixel24) == 3, "Pixel24 must not be padded");
+
+////////////////////////////////////////////////////////////
+/// \brief Traits of 24 bit byte-ordered pixel format
+///
+/// \ingroup rendering
+///
+/// \headerfile SDL2pp/PixelView.hh
+///
+/// \tparam RIndex Offset of red component in a pixel
+/// \tparam GIndex Offset of green component in a pixel
+/// \tparam BIndex Offset of blue component in a pixel
+///
+////////////////////////////////////////////////////////////
+template<int RIndex, int GIndex, int BIndex>
+struct BytePixelFormatTraits {
+	typedef Pixel24 PixelType;    ///< Type of a single pixel
+
+	static constexpr bool HasAlpha = false; ///< Whether format has alpha channel
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get red component of a pixel
+	///
+	/// \param[in] pixel Pixel value
+	///
+	/// \returns Red component
+	///
+	////////////////////////////////////////////////////////////
+	static constexpr Uint8 GetRed(const PixelType& pixel) {
+		return pixel.bytes[RIndex];
+	}
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get green component of a pixel
+	///
+	/// \param[in] pixel Pixel value
+	///
+	/// \returns Green component
+	///
+	////////////////////////////////////////////////////////////
+	static constexpr Uint8 GetGreen(const PixelType& pixel) {
+		return pixel.bytes[GIndex];
+	}
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get blue component of a pixel
+	///
+	/// \param[in] pixel Pixel value
+	///
+	/// \returns Blue component
+	///
+	////////////////////////////////////////////////////////////
+	static constexpr Uint8 GetBlue(const PixelType& pixel) {
+		return pixel.bytes[BIndex];
+	}
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get alpha component of a pixel
+	///
+	/// \returns Always 255
+	///
+	////////////////////////////////////////////////////////////
+	static constexpr Uint8 GetAlpha(const PixelType&) {
+		return 255;
+	}
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get color of a pixel
+	///
+	/// \param[in] pixel Pixel value
+	///
+	/// \returns Color of the pixel
+	///
+	////////////////////////////////////////////////////////////
+	static constexpr Color GetColor(const PixelType& pixel) {
+		return Color(GetRed(pixel), GetGreen(pixel), GetBlue(pixel));
+	}
+
+	////////////////////////////////////////////////////////////
+	/// \brief Map color components to a pixel
+	///
+	/// \param[in] r Red component
+	/// \param[in] g Green component
+	/// \param[in] b Blue component
+	/// \param[in] a Alpha component, ignored
+	///
+	/// \returns Pixel value
+	///
+	////////////////////////////////////////////////////////////
+	static constexpr PixelType MapRGBA(Uint8 r, Uint8 g, Uint8 b, Uint8 a = 255) {
+		return (void)a, PixelType{{
+				RIndex == 0 ? r : GIndex == 0 ? g : b,
+				RIndex == 1 ? r : GIndex == 1 ? g : b,
+				RIndex == 2 ? r : GIndex == 2 ? g : b,
+			}};
+	}
+
+	////////////////////////////////////////////////////////////
+	/// \brief Map color to a pixel
+	///
+	/// \param[in] color Color to map
+	///
+	/// \returns Pixel value
+	///
+	////////////////////////////////////////////////////////////
+	static constexpr PixelType MapColor(const Color& color) {
+		return MapRGBA(color.GetRed(), color.GetGreen(), color.GetBlue());
+	}
+};
+
+template<int RIndex, int GIndex, int BIndex> constexpr bool BytePixelFormatTraits<RIndex, GIndex, BIndex>::HasAlpha;
+
+////////////////////////////////////////////////////////////
+/// \brief Compile-time traits of SDL pixel format
+///
+/// \ingroup rendering
+///
+/// \headerfile SDL2pp/PixelView.hh
+///
+/// Specialized for all packed RGB formats and 24 bit RGB
+/// formats; indexed and FOURCC formats are not supported.
+///
+/// \tparam Format One of SDL_PixelFormatEnum values
+///
+////////////////////////////////////////////////////////////
+template<Uint32 Format>
+struct PixelFormatTraits;
+
+/// \cond
+template<> struct PixelFormatTraits<SDL_PIXELFORMAT_RGB332> : PackedPixelFormatTraits<Uint8, 0xe0, 0x1c, 0x03, 0x00> {};
+template<> struct PixelFormatTraits<SDL_PIXELFORMAT_RGB444> : PackedPixelFormatTraits<Uint16, 0x0f00, 0x00f0, 0x000f, 0x0000> {};
+template<> struct PixelFormatTraits<SDL_PIXELFORMAT_RGB555> : PackedPixelFormatTraits<Uint16, 0x7c00, 0x03e0, 0x001f, 0x0000> {};
+template<> struct PixelFormatTraits<SDL_PIXELFORMAT_BGR555> : PackedPixelFormatTraits<Uint16, 0x001f, 0x03e0, 0x7c00, 0x0000> {};
+template<> struct PixelFormatTraits<SDL_PIXELFORMAT_ARGB4444> : PackedPixelFormatTraits<Uint16, 0x0f00, 0x00f0, 0x000f, 0xf000> {};
+template<> struct PixelFormatTraits<SDL_PIXELFORMAT_RGBA4444> : PackedPixelFormatTraits<Uint16, 0xf000, 0x0f00, 0x00f0, 0x000f> {};
+template<> struct PixelFormatTraits<SDL_PIXELFORMAT_ABGR4444> : PackedPixelFormatTraits<Uint16, 0x000f, 0x00f0, 0x0f00, 0xf000> {};
+template<> struct PixelFormatTraits<SDL_PIXELFORMAT_BGRA4444> : PackedPixelFormatTraits<Uint16, 0x00f0, 0x0f00, 0xf000, 0x000f> {};
+template<> struct PixelFormatTraits<SDL_PIXELFORMAT_ARGB1555> : PackedPixelFormatTraits<Uint16, 0x7c00, 0x03e0, 0x001f, 0x8000> {};
+template<> struct PixelFormatTraits<SDL_PIXELFORMAT_RGBA5551> : PackedPixelFormatTraits<Uint16, 0xf800, 0x07c0, 0x003e, 0x0001> {};
+template<> struct PixelFormatTraits<SDL_PIXELFORMAT_ABGR1555> : PackedPixelFormatTraits<Uint16, 0x001f, 0x03e0, 0x7c00, 0x8000> {};
+template<> struct PixelFormatTraits<SDL_PIXELFORMAT_BGRA5551> : PackedPixelFormatTraits<Uint16, 0x003e, 0x07c0, 0xf800, 0x0001> {};
+template<> struct PixelFormatTraits<SDL_PIXELFORMAT_RGB565> : PackedPixelFormatTraits<Uint16, 0xf800, 0x07e0, 0x001f, 0x0000> {};
+template<> struct PixelFormatTraits<SDL_PIXELFORMAT_BGR565> : PackedPixelFormatTraits<Uint16, 0x001f, 0x07e0, 0xf800, 0x0000> {};
+template<> struct PixelFormatTraits<SDL_PIXELFORMAT_RGB24> : BytePixelFormatTraits<0, 1, 2> {};
+template<> struct PixelFormatTraits<SDL_PIXELFORMAT_BGR24> : BytePixelFormatTraits<2, 1, 0> {};
+template<> struct PixelFormatTraits<SDL_PIXELFORMAT_RGB888> : PackedPixelFormatTraits<Uint32, 0x00ff0000, 0x0000ff00, 0x000000ff, 0x00000000> {};
+template<> struct PixelFormatTraits<SDL_PIXELFORMAT_RGBX8888> : PackedPixelFormatTraits<Uint32, 0xff000000, 0x00ff0000, 0x0000ff00, 0x00000000> {};
+template<> struct PixelFormatTraits<SDL_PIXELFORMAT_BGR888> : PackedPixelFormatTraits<Uint32, 0x000000ff, 0x0000ff00, 0x00ff0000, 0x00000000> {};
+template<> struct PixelFormatTraits<SDL_PIXELFORMAT_BGRX8888> : PackedPixelFormatTraits<Uint32, 0x0000ff00, 0x00ff0000, 0xff000000, 0x00000000> {};
+template<> struct PixelFormatTraits<SDL_PIXELFORMAT_ARGB8888> : PackedPixelFormatTraits<Uint32, 0x00ff0000, 0x0000ff00, 0x000000ff, 0xff000000> {};
+template<> struct PixelFormatTraits<SDL_PIXELFORMAT_RGBA8888> : PackedPixelFormatTraits<Uint32, 0xff000000, 0x00ff0000, 0x0000ff00, 0x000000ff> {};
+template<> struct PixelFormatTraits<SDL_PIXELFORMAT_ABGR8888> : PackedPixelFormatTraits<Uint32, 0x000000ff, 0x0000ff00, 0x00ff0000, 0xff000000> {};
+template<> struct PixelFormatTraits<SDL_PIXELFORMAT_BGRA8888> : PackedPixelFormatTraits<Uint32, 0x0000ff00, 0x00ff0000, 0xff000000, 0x000000ff> {};
+template<> struct PixelFormatTraits<SDL_PIXELFORMAT_ARGB2101010> : PackedPixelFormatTraits<Uint32, 0x3ff00000, 0x000ffc00, 0x000003ff, 0xc0000000> {};
+/// \endcond
+
+////////////////////////////////////////////////////////////
+/// \brief Typed view of locked pixel data
+///
+/// \ingroup rendering
+///
+/// \headerfile SDL2pp/PixelView.hh
+///
+/// Gives typed access to pixels of a locked surface or texture
+/// with pixel format known at compile time. Rows are exposed
+/// as plain arrays of PixelType, and channel extraction and
+/// packing are constexpr functions of PixelFormatTraits, so
+/// loops over pixels contain no per-pixel format branching
+/// and are open to compiler vectorization.
+///
+/// When format is only known at run time, use VisitPixelView()
+/// to pick the right instantiation once per image.
+///
+/// Usage example:
+/// \code
+/// {
+///     SDL2pp::Surface::LockHandle lock = surface.Lock();
+///     SDL2pp::PixelView<SDL_PIXELFORMAT_ARGB8888> view(surface, lock);
+///     typedef decltype(view)::Traits Traits;
+///
+///     for (auto row : view)
+///         for (auto& pixel : row)
+///             pixel = Traits::MapRGBA(Traits::GetBlue(pixel), Traits::GetGreen(pixel), Traits::GetRed(pixel), Traits::GetAlpha(pixel));
+/// }
+/// \endcode
+///
+/// \tparam Format One of SDL_PixelFormatEnum values which
+///                PixelFormatTraits is specialized for
+///
+////////////////////////////////////////////////////////////
+template<Uint32 Format>
+class PixelView {
+public:
+	typedef PixelFormatTraits<Format> Traits;         ///< Pixel format traits
+	typedef typename Traits::PixelType PixelType;     ///< Type of a single pixel
+
+	////////////////////////////////////////////////////////////
+	/// \brief Single row of pixels
+	///
+	/// Can be iterated with range-based for; iterators are plain
+	/// pointers to PixelType
+	///
+	////////////////////////////////////////////////////////////
+	class Row {
+	private:
+		PixelType* begin_; ///< First pixel of the row
+		PixelType* end_;   ///< Past the last pixel of the row
+
+	public:
+		////////////////////////////////////////////////////////////
+		/// \brief Construct row from pixel range
+		///
+		/// \param[in] begin First pixel of the row
+		/// \param[in] width Number of pixels in the row
+		///
+		////////////////////////////////////////////////////////////
+		Row(PixelType* begin, int width) : begin_(begin), end_(begin + width) {
+		}
+
+		////////////////////////////////////////////////////////////
+		/// \brief Get pointer to first pixel
+		///
+		/// \returns Iterator to the beginning of the row
+		///
+		////////////////////////////////////////////////////////////
+		PixelType* begin() const {
+			return begin_;
+		}
+
+		////////////////////////////////////////////////////////////
+		/// \brief Get pointer past the last pixel
+		///
+		/// \returns Iterator to the end of the row
+		///
+		////////////////////////////////////////////////////////////
+		PixelType* end() const {
+			return end_;
+		}
+
+		////////////////////////////////////////////////////////////
+		/// \brief Get number of pixels in the row
+		///
+		/// \returns Row width
+		///
+		////////////////////////////////////////////////////////////
+		int GetWidth() const {
+			return static_cast<int>(end_ - begin_);
+		}
+
+		////////////////////////////////////////////////////////////
+		/// \brief Access pixel by index
+		///
+		/// \param[in] x Pixel index
+		///
+		/// \returns Reference to the pixel
+		///
+		////////////////////////////////////////////////////////////
+		PixelType& operator[](int x) const {
+			return begin_[x];
+		}
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Iterator over rows of the view
+	///
+	////////////////////////////////////////////////////////////
+	class RowIterator {
+	private:
+		Uint8* row_;  ///< First byte of current row
+		int pitch_;   ///< Distance between rows in bytes
+		int width_;   ///< Number of pixels in a row
+
+	public:
+		typedef std::input_iterator_tag iterator_category; ///< Iterator category
+		typedef Row value_type;                            ///< Type of dereferenced iterator
+		typedef std::ptrdiff_t difference_type;            ///< Distance between iterators
+		typedef const Row* pointer;                        ///< Pointer to dereferenced iterator
+		typedef Row reference;                             ///< Reference to dereferenced iterator
+
+		////////////////////////////////////////////////////////////
+		/// \brief Construct iterator pointing to specific row
+		///
+		/// \param[in] row First byte of the row
+		/// \param[in] pitch Distance between rows in bytes
+		/// \param[in] width Number of pixels in a row
+		///
+		////////////////////////////////////////////////////////////
+		RowIterator(Uint8* row, int pitch, int width) : row_(row), pitch_(pitch), width_(width) {
+		}
+
+		////////////////////////////////////////////////////////////
+		/// \brief Get current row
+		///
+		/// \returns Row the iterator points to
+		///
+		////////////////////////////////////////////////////////////
+		Row operator*() const {
+			return Row(reinterpret_cast<PixelType*>(row_), width_);
+		}
+
+		////////////////////////////////////////////////////////////
+		/// \brief Advance to the next row
+		///
+		/// \returns Reference to self
+		///
+		////////////////////////////////////////////////////////////
+		RowIterator& operator++() {
+			row_ += pitch_;
+			return *this;
+		}
+
+		////////////////////////////////////////////////////////////
+		/// \brief Advance to the next row
+		///
+		/// \returns Iterator pointing to previous row
+		///
+		////////////////////////////////////////////////////////////
+		RowIterator operator++(int) {
+			RowIterator prev(*this);
+			row_ += pitch_;
+			return prev;
+		}
+
+		////////////////////////////////////////////////////////////
+		/// \brief Equality operator
+		///
+		/// \param[in] other Iterator to compare with
+		///
+		/// \returns True if iterators point to the same row
+		///
+		////////////////////////////////////////////////////////////
+		bool operator==(const RowIterator& other) const {
+			return row_ == other.row_;
+		}
+
+		////////////////////////////////////////////////////////////
+		/// \brief Inequality operator
+		///
+		/// \param[in] other Iterator to compare with
+		///
+		/// \returns True if iterators point to different rows
+		///
+		////////////////////////////////////////////////////////////
+		bool operator!=(const RowIterator& other) const {
+			return row_ != other.row_;
+		}
+	};
+
+private:
+	Uint8* pixels_; ///< First byte of pixel data
+	int pitch_;     ///< Distance between rows in bytes
+	int width_;     ///< Width of the view
+	int height_;    ///< Height of the view
+
+public:
+	////////////////////////////////////////////////////////////
+	/// \brief Construct view of raw pixel data
+	///
+	/// \param[in] pixels Pointer to first pixel
+	/// \param[in] pitch Distance between rows in bytes
+	/// \param[in] width Width of the view
+	/// \param[in] height Height of the view
+	///
+	////////////////////////////////////////////////////////////
+	PixelView(void* pixels, int pitch, int width, int height) : pixels_(static_cast<Uint8*>(pixels)), pitch_(pitch), width_(width), height_(height) {
+	}
+
+	////////////////////////////////////////////////////////////
+	/// \brief Construct view of locked surface
+	///
+	/// \param[in] surface Surface to access
+	/// \param[in] lock Lock of the surface
+	///
+	/// \throws std::invalid_argument if surface format does not
+	///         match view format
+	///
+	////////////////////////////////////////////////////////////
+	PixelView(Surface& surface, Surface::LockHandle& lock) : pixels_(static_cast<Uint8*>(lock.GetPixels())), pitch_(lock.GetPitch()), width_(surface.GetWidth()), height_(surface.GetHeight()) {
+		if (surface.GetFormat() != Format)
+			throw std::invalid_argument("surface format does not match pixel view format");
+	}
+
+	////////////////////////////////////////////////////////////
+	/// \brief Construct view of locked texture
+	///
+	/// \param[in] texture Texture to access
+	/// \param[in] lock Lock of the texture
+	/// \param[in] rect Rectangle the texture was locked with
+	///
+	/// \throws std::invalid_argument if texture format does not
+	///         match view format
+	///
+	////////////////////////////////////////////////////////////
+	PixelView(Texture& texture, Texture::LockHandle& lock, const Optional<Rect>& rect = NullOpt) : pixels_(static_cast<Uint8*>(lock.GetPixels())), pitch_(lock.GetPitch()), width_(rect ? rect->w : texture.GetWidth()), height_(rect ? rect->h : texture.GetHeight()) {
+		if (texture.GetFormat() != Format)
+			throw std::invalid_argument("texture format does not match pixel view format");
+	}
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get pixel format of the view
+	///
+	/// \returns Pixel format
+	///
+	////////////////////////////////////////////////////////////
+	Uint32 GetFormat() const {
+		return Format;
+	}
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get width of the view
+	///
+	/// \returns Width in pixels
+	///
+	////////////////////////////////////////////////////////////
+	int GetWidth() const {
+		return width_;
+	}
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get height of the view
+	///
+	/// \returns Height in pixels
+	///
+	////////////////////////////////////////////////////////////
+	int GetHeight() const {
+		return height_;
+	}
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get distance between rows
+	///
+	/// \returns Pitch in bytes
+	///
+	////////////////////////////////////////////////////////////
+	int GetPitch() const {
+		return pitch_;
+	}
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get row of pixels
+	///
+	/// \param[in] y Row index
+	///
+	/// \returns Pointer to first pixel of the row
+	///
+	////////////////////////////////////////////////////////////
+	PixelType* GetRow(int y) const {
+		return reinterpret_cast<PixelType*>(pixels_ + y * pitch_);
+	}
+
+	////////////////////////////////////////////////////////////
+	/// \brief Access single pixel
+	///
+	/// \param[in] x Column index
+	/// \param[in] y Row index
+	///
+	/// \returns Reference to the pixel
+	///
+	////////////////////////////////////////////////////////////
+	PixelType& GetPixel(int x, int y) const {
+		return GetRow(y)[x];
+	}
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get iterator to the first row
+	///
+	/// \returns Row iterator
+	///
+	////////////////////////////////////////////////////////////
+	RowIterator begin() const {
+		return RowIterator(pixels_, pitch_, width_);
+	}
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get iterator past the last row
+	///
+	/// \returns Row iterator
+	///
+	////////////////////////////////////////////////////////////
+	RowIterator end() const {
+		return RowIterator(pixels_ + height_ * pitch_, pitch_, width_);
+	}
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Check whether PixelView supports given format
+///
+/// \ingroup rendering
+///
+/// \param[in] format One of SDL_PixelFormatEnum values
+///
+/// \returns True if PixelFormatTraits is specialized for format
+///
+////////////////////////////////////////////////////////////
+inline bool IsPixelViewFormatSupported(Uint32 format) {
+	switch (format) {
+	case SDL_PIXELFORMAT_RGB332:
+	case SDL_PIXELFORMAT_RGB444:
+	case SDL_PIXELFORMAT_RGB555:
+	case SDL_PIXELFORMAT_BGR555:
+	case SDL_PIXELFORMAT_ARGB4444:
+	case SDL_PIXELFORMAT_RGBA4444:
+	case SDL_PIXELFORMAT_ABGR4444:
+	case SDL_PIXELFORMAT_BGRA4444:
+	case SDL_PIXELFORMAT_ARGB1555:
+	case SDL_PIXELFORMAT_RGBA5551:
+	case SDL_PIXELFORMAT_ABGR1555:
+	case SDL_PIXELFORMAT_BGRA5551:
+	case SDL_PIXELFORMAT_RGB565:
+	case SDL_PIXELFORMAT_BGR565:
+	case SDL_PIXELFORMAT_RGB24:
+	case SDL_PIXELFORMAT_BGR24:
+	case SDL_PIXELFORMAT_RGB888:
+	case SDL_PIXELFORMAT_RGBX8888:
+	case SDL_PIXELFORMAT_BGR888:
+	case SDL_PIXELFORMAT_BGRX8888:
+	case SDL_PIXELFORMAT_ARGB8888:
+	case SDL_PIXELFORMAT_RGBA8888:
+	case SDL_PIXELFORMAT_ABGR8888:
+	case SDL_PIXELFORMAT_BGRA8888:
+	case SDL_PIXELFORMAT_ARGB2101010:
+		return true;
+	default:
+		return false;
+	}
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Call function with PixelView of format known at run time
+///
+/// \ingroup rendering
+///
+/// Dispatches on pixel format once and calls function with
+/// PixelView of matching instantiation, so per-pixel code is
+/// compiled separately for each format. Function must accept
+/// any PixelView, for instance be a functor with templated
+/// call operator:
+///
+/// \code
+/// struct Invert {
+///     template<Uint32 Format>
+///     void operator()(SDL2pp::PixelView<Format> view) const {
+///         typedef typename SDL2pp::PixelView<Format>::Traits Traits;
+///         for (auto row : view)
+///             for (auto& pixel : row)
+///                 pixel = Traits::MapRGBA(~Traits::GetRed(pixel), ~Traits::GetGreen(pixel), ~Traits::GetBlue(pixel), Traits::GetAlpha(pixel));
+///     }
+/// };
+///
+/// SDL2pp::VisitPixelView(surface.GetFormat(), lock.GetPixels(), lock.GetPitch(), surface.GetWidth(), surface.GetHeight(), Invert());
+/// \endcode
+///
+/// Results of all instantiations must have the same type.
+///
+/// \param[in] format Pixel format of the data
+/// \param[in] pixels Pointer to first pixel
+/// \param[in] pitch Distance between rows in bytes
+/// \param[in] width Width of pixel data
+/// \param[in] height Height of pixel data
+/// \param[in] function Function to call
+///
+/// \returns Whatever function returns
+///
+/// \throws std::invalid_argument if format is not supported
+///
+////////////////////////////////////////////////////////////
+template<typename Function>
+auto VisitPixelView(Uint32 format, void* pixels, int pitch, int width, int height, Function&& function) -> decltype(function(std::declval<PixelView<SDL_PIXELFORMAT_ARGB8888>>())) {
+	switch (format) {
+	case SDL_PIXELFORMAT_RGB332: return function(PixelView<SDL_PIXELFORMAT_RGB332>(pixels, pitch, width, height));
+	case SDL_PIXELFORMAT_RGB444: return function(PixelView<SDL_PIXELFORMAT_RGB444>(pixels, pitch, width, height));
+	case SDL_PIXELFORMAT_RGB555: return function(PixelView<SDL_PIXELFORMAT_RGB555>(pixels, pitch, width, height));
+	case SDL_PIXELFORMAT_BGR555: return function(PixelView<SDL_PIXELFORMAT_BGR555>(pixels, pitch, width, height));
+	case SDL_PIXELFORMAT_ARGB4444: return function(PixelView<SDL_PIXELFORMAT_ARGB4444>(pixels, pitch, width, height));
+	case SDL_PIXELFORMAT_RGBA4444: return function(PixelView<SDL_PIXELFORMAT_RGBA4444>(pixels, pitch, width, height));
+	case SDL_PIXELFORMAT_ABGR4444: return function(PixelView<SDL_PIXELFORMAT_ABGR4444>(pixels, pitch, width, height));
+	case SDL_PIXELFORMAT_BGRA4444: return function(PixelView<SDL_PIXELFORMAT_BGRA4444>(pixels, pitch, width, height));
+	case SDL_PIXELFORMAT_ARGB1555: return function(PixelView<SDL_PIXELFORMAT_ARGB1555>(pixels, pitch, width, height));
+	case SDL_PIXELFORMAT_RGBA5551: return function(PixelView<SDL_PIXELFORMAT_RGBA5551>(pixels, pitch, width, height));
+	case SDL_PIXELFORMAT_ABGR1555: return function(PixelView<SDL_PIXELFORMAT_ABGR1555>(pixels, pitch, width, height));
+	case SDL_PIXELFORMAT_BGRA5551: return function(PixelView<SDL_PIXELFORMAT_BGRA5551>(pixels, pitch, width, height));
+	case SDL_PIXELFORMAT_RGB565: return function(PixelView<SDL_PIXELFORMAT_RGB565>(pixels, pitch, width, height));
+	case SDL_PIXELFORMAT_BGR565: return function(PixelView<SDL_PIXELFORMAT_BGR565>(pixels, pitch, width, height));
+	case SDL_PIXELFORMAT_RGB24: return function(PixelView<SDL_PIXELFORMAT_RGB24>(pixels, pitch, width, height));
+	case SDL_PIXELFORMAT_BGR24: return function(PixelView<SDL_PIXELFORMAT_BGR24>(pixels, pitch, width, height));
+	case SDL_PIXELFORMAT_RGB888: return function(PixelView<SDL_PIXELFORMAT_RGB888>(pixels, pitch, width, height));
+	case SDL_PIXELFORMAT_RGBX8888: return function(PixelView<SDL_PIXELFORMAT_RGBX8888>(pixels, pitch, width, height));
+	case SDL_PIXELFORMAT_BGR888: return function(PixelView<SDL_PIXELFORMAT_BGR888>(pixels, pitch, width, height));
+	case SDL_PIXELFORMAT_BGRX8888: return function(PixelView<SDL_PIXELFORMAT_BGRX8888>(pixels, pitch, width, height));
+	case SDL_PIXELFORMAT_ARGB8888: return function(PixelView<SDL_PIXELFORMAT_ARGB8888>(pixels, pitch, width, height));
+	case SDL_PIXELFORMAT_RGBA8888: return function(PixelView<SDL_PIXELFORMAT_RGBA8888>(pixels, pitch, width, height));
+	case SDL_PIXELFORMAT_ABGR8888: return function(PixelView<SDL_PIXELFORMAT_ABGR8888>(pixels, pitch, width, height));
+	case SDL_PIXELFORMAT_BGRA8888: return function(PixelView<SDL_PIXELFORMAT_BGRA8888>(pixels, pitch, width, height));
+	case SDL_PIXELFORMAT_ARGB2101010: return function(PixelView<SDL_PIXELFORMAT_ARGB2101010>(pixels, pitch, width, height));
+	default:
+		throw std::invalid_argument("pixel format is not supported by pixel view");
+	}
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Call function with PixelView of locked surface
+///
+/// \ingroup rendering
+///
+/// \param[in] surface Surface to access
+/// \param[in] lock Lock of the surface
+/// \param[in] function Function to call
+///
+/// \returns Whatever function returns
+///
+/// \throws std::invalid_argument if surface format is not supported
+///
+/// \see VisitPixelView(Uint32, void*, int, int, int, Function&&)
+///
+////////////////////////////////////////////////////////////
+template<typename Function>
+auto VisitPixelView(Surface& surface, Surface::LockHandle& lock, Function&& function) -> decltype(function(std::declval<PixelView<SDL_PIXELFORMAT_ARGB8888>>())) {
+	return VisitPixelView(surface.GetFormat(), lock.GetPixels(), lock.GetPitch(), surface.GetWidth(), surface.GetHeight(), std::forward<Function>(function));
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Call function with PixelView of locked texture
+///
+/// \ingroup rendering
+///
+/// \param[in] texture Texture to access
+/// \param[in] lock Lock of the texture
+/// \param[in] rect Rectangle the texture was locked with
+/// \param[in] function Function to call
+///
+/// \returns Whatever function returns
+///
+/// \throws std::invalid_argument if texture format is not supported
+///
+/// \see VisitPixelView(Uint32, void*, int, int, int, Function&&)
+///
+////////////////////////////////////////////////////////////
+template<typename Function>
+auto VisitPixelView(Texture& texture, Texture::LockHandle& lock, const Optional<Rect>& rect, Function&& function) -> decltype(function(std::declval<PixelView<SDL_PIXELFORMAT_ARGB8888>>())) {
+	return VisitPixelView(texture.GetFormat(), lock.GetPixels(), lock.GetPitch(), rect ? rect->w : texture.GetWidth(), rect ? rect->h : texture.GetHeight(), std::forward<Function>(function));
+}
+
+}
+
+#endif
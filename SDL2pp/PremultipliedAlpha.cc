@@ -0,0 +1,265 @@
+/*
+  libSDL2pp - C++11 bindings/wrapper for SDL2
+  Copyright (C) 2013-2016 Dmitry Marakasov <amdmi3@amdmi3.ru>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include <stdexcept>
+#include <vector>
+
+#include <SDL_endian.h>
+#include <SDL_pixels.h>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#	define SDL2PP_PREMULTIPLY_X86
+#	include <emmintrin.h>
+#endif
+
+#if defined(__GNUC__)
+#	define SDL2PP_TARGET(isa) __attribute__((target(isa)))
+#else
+#	define SDL2PP_TARGET(isa)
+#endif
+
+#include <SDL2pp/PremultipliedAlpha.hh>
+
+namespace SDL2pp {
+
+namespace {
+
+bool IsByteMask(Uint32 mask) {
+	return mask == 0x000000ff || mask == 0x0000ff00 || mask == 0x00ff0000 || mask == 0xff000000;
+}
+
+// index of alpha byte within pixel in memory, or -1 if unsupported
+int GetAlphaIndex(Uint32 format) {
+	if (SDL_ISPIXELFORMAT_INDEXED(format) || SDL_ISPIXELFORMAT_FOURCC(format))
+		return -1;
+
+	int bpp;
+	Uint32 rmask, gmask, bmask, amask;
+	if (!SDL_PixelFormatEnumToMasks(format, &bpp, &rmask, &gmask, &bmask, &amask))
+		return -1;
+
+	if (bpp != 32 || !IsByteMask(rmask) || !IsByteMask(gmask) || !IsByteMask(bmask) || !IsByteMask(amask))
+		return -1;
+
+	int shift = 0;
+	while ((amask >> shift) != 0xff)
+		shift += 8;
+
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+	return shift / 8;
+#else
+	return 3 - shift / 8;
+#endif
+}
+
+// c * a / 255, rounded to nearest
+inline Uint8 MultiplyByAlpha(int c, int a) {
+	int t = c * a + 128;
+	return static_cast<Uint8>((t + (t >> 8)) >> 8);
+}
+
+void PremultiplyRowScalar(const Uint8* src, Uint8* dst, int count, int alpha_index) {
+	for (int x = 0; x < count; x++, src += 4, dst += 4) {
+		int a = src[alpha_index];
+		for (int c = 0; c < 4; c++)
+			dst[c] = c == alpha_index ? static_cast<Uint8>(a) : MultiplyByAlpha(src[c], a);
+	}
+}
+
+#ifdef SDL2PP_PREMULTIPLY_X86
+// Same arithmetic as MultiplyByAlpha() in 16 bit lanes; alpha
+// lane itself is multiplied by 255, which leaves it unchanged
+template <int A>
+SDL2PP_TARGET("sse2") inline __m128i MultiplyByAlphaSSE2(__m128i pixels, __m128i alpha_lanes) {
+	const __m128i round = _mm_set1_epi16(128);
+	const __m128i opaque = _mm_set1_epi16(255);
+
+	__m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(pixels, _MM_SHUFFLE(A, A, A, A)), _MM_SHUFFLE(A, A, A, A));
+	alpha = _mm_or_si128(_mm_andnot_si128(alpha_lanes, alpha), _mm_and_si128(alpha_lanes, opaque));
+
+	__m128i t = _mm_add_epi16(_mm_mullo_epi16(pixels, alpha), round);
+	return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+}
+
+template <int A>
+SDL2PP_TARGET("sse2") void PremultiplyRowSSE2(const Uint8* src, Uint8* dst, int count) {
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i alpha_lanes = _mm_set_epi16(
+			A == 3 ? -1 : 0, A == 2 ? -1 : 0, A == 1 ? -1 : 0, A == 0 ? -1 : 0,
+			A == 3 ? -1 : 0, A == 2 ? -1 : 0, A == 1 ? -1 : 0, A == 0 ? -1 : 0
+		);
+
+	int x = 0;
+	for (; x + 4 <= count; x += 4) {
+		__m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x * 4));
+
+		__m128i lo = MultiplyByAlphaSSE2<A>(_mm_unpacklo_epi8(pixels, zero), alpha_lanes);
+		__m128i hi = MultiplyByAlphaSSE2<A>(_mm_unpackhi_epi8(pixels, zero), alpha_lanes);
+
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x * 4), _mm_packus_epi16(lo, hi));
+	}
+
+	PremultiplyRowScalar(src + x * 4, dst + x * 4, count - x, A);
+}
+#endif
+
+std::vector<Uint8> BuildUnpremultiplyTable() {
+	std::vector<Uint8> table(256 * 256, 0);
+	for (int a = 1; a < 256; a++) {
+		for (int c = 0; c < 256; c++) {
+			int value = (c * 255 + a / 2) / a;
+			table[a * 256 + c] = static_cast<Uint8>(value > 255 ? 255 : value);
+		}
+	}
+	return table;
+}
+
+// lookup table indexed by alpha and channel value
+const std::vector<Uint8>& GetUnpremultiplyTable() {
+	static const std::vector<Uint8> table = BuildUnpremultiplyTable();
+	return table;
+}
+
+void UnpremultiplyRowScalar(const Uint8* src, Uint8* dst, int count, int alpha_index, const Uint8* table) {
+	for (int x = 0; x < count; x++, src += 4, dst += 4) {
+		int a = src[alpha_index];
+		const Uint8* row_table = table + a * 256;
+		for (int c = 0; c < 4; c++)
+			dst[c] = c == alpha_index ? static_cast<Uint8>(a) : row_table[src[c]];
+	}
+}
+
+#ifdef SDL2PP_PREMULTIPLY_X86
+// (c * 255 + a / 2) / a for single pixel in 32 bit lanes. Both
+// operands are exact in float and quotient is below 2^16, so
+// truncated float division gives exact integer quotient. For
+// zero alpha, conversion of inf or NaN produces 0x80000000,
+// which later saturates to 0; values above 255 saturate to 255.
+template <int A>
+SDL2PP_TARGET("sse2") inline __m128i DivideByAlphaSSE2(__m128i channels, __m128i alpha_lanes) {
+	__m128i alpha = _mm_shuffle_epi32(channels, _MM_SHUFFLE(A, A, A, A));
+	__m128i numerator = _mm_add_epi32(_mm_sub_epi32(_mm_slli_epi32(channels, 8), channels), _mm_srli_epi32(alpha, 1));
+	__m128i quotient = _mm_cvttps_epi32(_mm_div_ps(_mm_cvtepi32_ps(numerator), _mm_cvtepi32_ps(alpha)));
+	return _mm_or_si128(_mm_andnot_si128(alpha_lanes, quotient), _mm_and_si128(alpha_lanes, channels));
+}
+
+template <int A>
+SDL2PP_TARGET("sse2") void UnpremultiplyRowSSE2(const Uint8* src, Uint8* dst, int count, const Uint8* table) {
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i alpha_lanes = _mm_set_epi32(A == 3 ? -1 : 0, A == 2 ? -1 : 0, A == 1 ? -1 : 0, A == 0 ? -1 : 0);
+
+	int x = 0;
+	for (; x + 4 <= count; x += 4) {
+		__m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x * 4));
+
+		__m128i lo = _mm_unpacklo_epi8(pixels, zero);
+		__m128i hi = _mm_unpackhi_epi8(pixels, zero);
+
+		__m128i p0 = DivideByAlphaSSE2<A>(_mm_unpacklo_epi16(lo, zero), alpha_lanes);
+		__m128i p1 = DivideByAlphaSSE2<A>(_mm_unpackhi_epi16(lo, zero), alpha_lanes);
+		__m128i p2 = DivideByAlphaSSE2<A>(_mm_unpacklo_epi16(hi, zero), alpha_lanes);
+		__m128i p3 = DivideByAlphaSSE2<A>(_mm_unpackhi_epi16(hi, zero), alpha_lanes);
+
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x * 4), _mm_packus_epi16(_mm_packs_epi32(p0, p1), _mm_packs_epi32(p2, p3)));
+	}
+
+	UnpremultiplyRowScalar(src + x * 4, dst + x * 4, count - x, A, table);
+}
+#endif
+
+}
+
+bool PremultipliedAlpha::IsFormatSupported(Uint32 format) {
+	return GetAlphaIndex(format) != -1;
+}
+
+void PremultipliedAlpha::Premultiply(int w, int h, Uint32 format, const void* src, int src_pitch, void* dst, int dst_pitch, BlitKernels::Isa isa) {
+	int alpha_index = GetAlphaIndex(format);
+	if (alpha_index == -1)
+		throw std::invalid_argument("pixel format not supported for alpha premultiplication");
+
+	const Uint8* src_row = static_cast<const Uint8*>(src);
+	Uint8* dst_row = static_cast<Uint8*>(dst);
+
+#ifdef SDL2PP_PREMULTIPLY_X86
+	if (isa != BlitKernels::Isa::Scalar) {
+		void (*row_function)(const Uint8*, Uint8*, int);
+		switch (alpha_index) {
+		case 0: row_function = &PremultiplyRowSSE2<0>; break;
+		case 1: row_function = &PremultiplyRowSSE2<1>; break;
+		case 2: row_function = &PremultiplyRowSSE2<2>; break;
+		default: row_function = &PremultiplyRowSSE2<3>; break;
+		}
+
+		for (int y = 0; y < h; y++, src_row += src_pitch, dst_row += dst_pitch)
+			row_function(src_row, dst_row, w);
+		return;
+	}
+#else
+	(void)isa;
+#endif
+
+	for (int y = 0; y < h; y++, src_row += src_pitch, dst_row += dst_pitch)
+		PremultiplyRowScalar(src_row, dst_row, w, alpha_index);
+}
+
+void PremultipliedAlpha::Unpremultiply(int w, int h, Uint32 format, const void* src, int src_pitch, void* dst, int dst_pitch, BlitKernels::Isa isa) {
+	int alpha_index = GetAlphaIndex(format);
+	if (alpha_index == -1)
+		throw std::invalid_argument("pixel format not supported for alpha premultiplication");
+
+	const Uint8* table = GetUnpremultiplyTable().data();
+
+	const Uint8* src_row = static_cast<const Uint8*>(src);
+	Uint8* dst_row = static_cast<Uint8*>(dst);
+
+#ifdef SDL2PP_PREMULTIPLY_X86
+	if (isa != BlitKernels::Isa::Scalar) {
+		void (*row_function)(const Uint8*, Uint8*, int, const Uint8*);
+		switch (alpha_index) {
+		case 0: row_function = &UnpremultiplyRowSSE2<0>; break;
+		case 1: row_function = &UnpremultiplyRowSSE2<1>; break;
+		case 2: row_function = &UnpremultiplyRowSSE2<2>; break;
+		default: row_function = &UnpremultiplyRowSSE2<3>; break;
+		}
+
+		for (int y = 0; y < h; y++, src_row += src_pitch, dst_row += dst_pitch)
+			row_function(src_row, dst_row, w, table);
+		return;
+	}
+#else
+	(void)isa;
+#endif
+
+	for (int y = 0; y < h; y++, src_row += src_pitch, dst_row += dst_pitch)
+		UnpremultiplyRowScalar(src_row, dst_row, w, alpha_index, table);
+}
+
+#if SDL_VERSION_ATLEAST(2, 0, 6)
+SDL_BlendMode PremultipliedAlpha::GetBlendMode() {
+	return SDL_ComposeCustomBlendMode(
+			SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+			SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD
+		);
+}
+#endif
+
+}
@@ -0,0 +1,143 @@
+/*
+  libSDL2pp - C++11 bindings/wrapper for SDL2
+  Copyright (C) 2013-2016 Dmitry Marakasov <amdmi3@amdmi3.ru>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef SDL2PP_PREMULTIPLIEDALPHA_HH
+#define SDL2PP_PREMULTIPLIEDALPHA_HH
+
+#include <SDL_version.h>
+#include <SDL_stdinc.h>
+#include <SDL_blendmode.h>
+
+#include <SDL2pp/BlitKernels.hh>
+#include <SDL2pp/Export.hh>
+
+namespace SDL2pp {
+
+////////////////////////////////////////////////////////////
+/// \brief Conversion between straight and premultiplied alpha
+///
+/// \ingroup graphics
+///
+/// \headerfile SDL2pp/PremultipliedAlpha.hh
+///
+/// With premultiplied alpha, color channels of each pixel are
+/// stored already multiplied by its alpha. Such images may be
+/// filtered without dark or light fringes around transparent
+/// areas, and blended with a single multiply-add.
+///
+/// Conversion works on 32 bit formats with 8 bit channels
+/// and alpha (such as SDL_PIXELFORMAT_ARGB8888). Both directions
+/// use SSE2 when available and produce the same output on every
+/// instruction set. Each channel is computed
+/// as c * a / 255 rounded to nearest, and back as
+/// c * 255 / a rounded to nearest and clamped to 255.
+///
+/// SDL2pp::Surface::PremultiplyAlpha() and SDL2pp::Texture
+/// constructor with premultiply_alpha flag are built on this
+/// class.
+///
+/// Usage example:
+/// \code
+/// {
+///     SDL2pp::Texture sprite(renderer, surface, true);
+///     sprite.SetBlendMode(SDL2pp::PremultipliedAlpha::GetBlendMode());
+/// }
+/// \endcode
+///
+////////////////////////////////////////////////////////////
+class SDL2PP_EXPORT PremultipliedAlpha {
+public:
+	////////////////////////////////////////////////////////////
+	/// \brief Deleted constructor
+	///
+	/// This class only has static members
+	///
+	////////////////////////////////////////////////////////////
+	PremultipliedAlpha() = delete;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Check whether pixel format may be converted
+	///
+	/// \param[in] format One of the enumerated values in SDL_PixelFormatEnum
+	///
+	/// \returns True if format has 32 bit pixels with 8 bit
+	///          color and alpha channels
+	///
+	////////////////////////////////////////////////////////////
+	static bool IsFormatSupported(Uint32 format);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Multiply color channels of pixels by alpha
+	///
+	/// \param[in] w Width of the image
+	/// \param[in] h Height of the image
+	/// \param[in] format Pixel format, see IsFormatSupported()
+	/// \param[in] src Source pixels
+	/// \param[in] src_pitch Length of source row in bytes
+	/// \param[out] dst Destination pixels, may be the same as src
+	/// \param[in] dst_pitch Length of destination row in bytes
+	/// \param[in] isa Instruction set to use; must be supported
+	///                (see SDL2pp::BlitKernels::IsIsaSupported())
+	///
+	/// \throws std::invalid_argument if format is not supported
+	///
+	////////////////////////////////////////////////////////////
+	static void Premultiply(int w, int h, Uint32 format, const void* src, int src_pitch, void* dst, int dst_pitch, BlitKernels::Isa isa = BlitKernels::GetBestIsa());
+
+	////////////////////////////////////////////////////////////
+	/// \brief Divide color channels of pixels by alpha
+	///
+	/// Color of fully transparent pixels becomes black.
+	///
+	/// \param[in] w Width of the image
+	/// \param[in] h Height of the image
+	/// \param[in] format Pixel format, see IsFormatSupported()
+	/// \param[in] src Source pixels
+	/// \param[in] src_pitch Length of source row in bytes
+	/// \param[out] dst Destination pixels, may be the same as src
+	/// \param[in] dst_pitch Length of destination row in bytes
+	/// \param[in] isa Instruction set to use; must be supported
+	///                (see SDL2pp::BlitKernels::IsIsaSupported())
+	///
+	/// \throws std::invalid_argument if format is not supported
+	///
+	////////////////////////////////////////////////////////////
+	static void Unpremultiply(int w, int h, Uint32 format, const void* src, int src_pitch, void* dst, int dst_pitch, BlitKernels::Isa isa = BlitKernels::GetBestIsa());
+
+#if SDL_VERSION_ATLEAST(2, 0, 6)
+	////////////////////////////////////////////////////////////
+	/// \brief Get blend mode for drawing premultiplied images
+	///
+	/// \returns Custom blend mode with dstRGBA = srcRGBA + dstRGBA * (1 - srcA)
+	///
+	/// \note Custom blend modes are not supported by all renderers,
+	///       in which case SDL2pp::Texture::SetBlendMode() throws
+	///
+	/// \see http://wiki.libsdl.org/SDL_ComposeCustomBlendMode
+	///
+	////////////////////////////////////////////////////////////
+	static SDL_BlendMode GetBlendMode();
+#endif
+};
+
+}
+
+#endif
@@ -0,0 +1,135 @@
+/*
+  libSDL2pp - C++11 bindings/wrapper for SDL2
+  Copyright (C) 2013-2016 Dmitry Marakasov <amdmi3@amdmi3.ru>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include <cstddef>
+
+#include <SDL2pp/RectPacker.hh>
+
+namespace SDL2pp {
+
+RectPacker::RectPacker(int width, int height) : width_(width), height_(height), used_area_(0) {
+	Clear();
+}
+
+int RectPacker::Fit(size_t index, int w, int h) const {
+	int x = skyline_[index].x;
+	if (x + w > width_)
+		return -1;
+
+	// rectangle rests on the highest segment it spans
+	int y = 0;
+	int remaining = w;
+	for (size_t i = index; remaining > 0; ++i) {
+		if (i == skyline_.size())
+			return -1;
+		if (skyline_[i].y > y)
+			y = skyline_[i].y;
+		if (y + h > height_)
+			return -1;
+		remaining -= skyline_[i].w;
+	}
+
+	return y;
+}
+
+Optional<Rect> RectPacker::Pack(const Point& size) {
+	if (size.x <= 0 || size.y <= 0)
+		return NullOpt;
+
+	// bottom-left: lowest resulting top edge, then narrowest segment
+	size_t best_index = 0;
+	int best_y = -1;
+	int best_w = 0;
+
+	for (size_t i = 0; i < skyline_.size(); ++i) {
+		int y = Fit(i, size.x, size.y);
+		if (y < 0)
+			continue;
+
+		if (best_y < 0 || y < best_y || (y == best_y && skyline_[i].w < best_w)) {
+			best_index = i;
+			best_y = y;
+			best_w = skyline_[i].w;
+		}
+	}
+
+	if (best_y < 0)
+		return NullOpt;
+
+	Rect result(skyline_[best_index].x, best_y, size.x, size.y);
+
+	// raise skyline under the new rectangle
+	Segment segment = { result.x, result.y + result.h, result.w };
+	skyline_.insert(skyline_.begin() + static_cast<std::ptrdiff_t>(best_index), segment);
+
+	for (size_t i = best_index + 1; i < skyline_.size(); ) {
+		const Segment& prev = skyline_[i - 1];
+		Segment& cur = skyline_[i];
+
+		int overlap = prev.x + prev.w - cur.x;
+		if (overlap <= 0)
+			break;
+
+		if (overlap >= cur.w) {
+			skyline_.erase(skyline_.begin() + static_cast<std::ptrdiff_t>(i));
+		} else {
+			cur.x += overlap;
+			cur.w -= overlap;
+			break;
+		}
+	}
+
+	// merge neighbour segments of the same height
+	for (size_t i = 1; i < skyline_.size(); ) {
+		if (skyline_[i - 1].y == skyline_[i].y) {
+			skyline_[i - 1].w += skyline_[i].w;
+			skyline_.erase(skyline_.begin() + static_cast<std::ptrdiff_t>(i));
+		} else {
+			++i;
+		}
+	}
+
+	used_area_ += static_cast<Uint64>(size.x) * static_cast<Uint64>(size.y);
+
+	return result;
+}
+
+void RectPacker::Clear() {
+	skyline_.clear();
+	skyline_.push_back(Segment{0, 0, width_});
+	used_area_ = 0;
+}
+
+int RectPacker::GetWidth() const {
+	return width_;
+}
+
+int RectPacker::GetHeight() const {
+	return height_;
+}
+
+float RectPacker::GetOccupancy() const {
+	if (width_ <= 0 || height_ <= 0)
+		return 0.0f;
+	return static_cast<float>(static_cast<double>(used_area_) / (static_cast<double>(width_) * static_cast<double>(height_)));
+}
+
+}
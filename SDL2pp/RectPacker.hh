@@ -0,0 +1,137 @@
+/*
+  libSDL2pp - C++11 bindings/wrapper for SDL2
+  Copyright (C) 2013-2016 Dmitry Marakasov <amdmi3@amdmi3.ru>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef SDL2PP_RECTPACKER_HH
+#define SDL2PP_RECTPACKER_HH
+
+#include <vector>
+
+#include <SDL_stdinc.h>
+
+#include <SDL2pp/Optional.hh>
+#include <SDL2pp/Point.hh>
+#include <SDL2pp/Rect.hh>
+#include <SDL2pp/Export.hh>
+
+namespace SDL2pp {
+
+////////////////////////////////////////////////////////////
+/// \brief Rectangle packer
+///
+/// \ingroup geometry
+///
+/// \headerfile SDL2pp/RectPacker.hh
+///
+/// Places rectangles into a fixed size area without overlapping,
+/// using skyline bottom-left heuristic. Rectangles may be added
+/// incrementally; packing quality improves if rectangles are
+/// inserted in order of decreasing height.
+///
+/// This class only deals with geometry, and is used by
+/// SDL2pp::Atlas to lay out images in textures.
+///
+////////////////////////////////////////////////////////////
+class SDL2PP_EXPORT RectPacker {
+private:
+	////////////////////////////////////////////////////////////
+	/// \brief Horizontal segment of the skyline
+	///
+	////////////////////////////////////////////////////////////
+	struct Segment {
+		int x; ///< Left coordinate of the segment
+		int y; ///< Height of the skyline at this segment
+		int w; ///< Width of the segment
+	};
+
+	int width_;                     ///< Width of packing area
+	int height_;                    ///< Height of packing area
+	std::vector<Segment> skyline_;  ///< Skyline segments, ordered by x
+	Uint64 used_area_;              ///< Total area of packed rectangles
+
+private:
+	////////////////////////////////////////////////////////////
+	/// \brief Check whether rectangle fits at given skyline segment
+	///
+	/// \param[in] index Index of first segment under the rectangle
+	/// \param[in] w Width of the rectangle
+	/// \param[in] h Height of the rectangle
+	///
+	/// \returns Y coordinate where the rectangle may be placed,
+	///          or -1 if it does not fit
+	///
+	////////////////////////////////////////////////////////////
+	int Fit(size_t index, int w, int h) const;
+
+public:
+	////////////////////////////////////////////////////////////
+	/// \brief Construct packer for empty area
+	///
+	/// \param[in] width Width of packing area
+	/// \param[in] height Height of packing area
+	///
+	////////////////////////////////////////////////////////////
+	RectPacker(int width, int height);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Place rectangle of given size
+	///
+	/// \param[in] size Size of rectangle to place
+	///
+	/// \returns Rectangle occupied by placed rectangle or
+	///          NullOpt if there's no free space for it
+	///
+	////////////////////////////////////////////////////////////
+	Optional<Rect> Pack(const Point& size);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Remove all packed rectangles
+	///
+	////////////////////////////////////////////////////////////
+	void Clear();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get width of packing area
+	///
+	/// \returns Width of packing area
+	///
+	////////////////////////////////////////////////////////////
+	int GetWidth() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get height of packing area
+	///
+	/// \returns Height of packing area
+	///
+	////////////////////////////////////////////////////////////
+	int GetHeight() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get fraction of packing area occupied by rectangles
+	///
+	/// \returns Value in [0, 1] range
+	///
+	////////////////////////////////////////////////////////////
+	float GetOccupancy() const;
+};
+
+}
+
+#endif
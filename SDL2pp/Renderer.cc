@@ -20,6 +20,9 @@
 */
 
 #include <vector>
+#include <algorithm>
+#include <functional>
+#include <utility>
 #include <cassert>
 
 #include <SDL.h>
@@ -28,9 +31,39 @@
 #include <SDL2pp/Window.hh>
 #include <SDL2pp/Exception.hh>
 #include <SDL2pp/Texture.hh>
+#include <SDL2pp/Atlas.hh>
 
 namespace SDL2pp {
 
+Renderer::CopyCommand::CopyCommand(Texture& texture, const Optional<Rect>& srcrect, const Optional<Rect>& dstrect, const Optional<Color>& mod)
+	: texture(&texture),
+	  srcrect(srcrect),
+	  dstrect(dstrect),
+	  angle(0.0),
+	  center(NullOpt),
+	  flip(0),
+	  mod(mod) {
+}
+
+Renderer::CopyCommand::CopyCommand(Texture& texture, const Optional<Rect>& srcrect, const Optional<Rect>& dstrect, double angle, const Optional<Point>& center, int flip, const Optional<Color>& mod)
+	: texture(&texture),
+	  srcrect(srcrect),
+	  dstrect(dstrect),
+	  angle(angle),
+	  center(center),
+	  flip(flip),
+	  mod(mod) {
+}
+
+void Renderer::StateCache::Invalidate() {
+	draw_color_valid = false;
+	blend_mode_valid = false;
+	target_valid = false;
+	clip_rect_valid = false;
+	viewport_valid = false;
+	scale_valid = false;
+}
+
 Renderer::Renderer(SDL_Renderer* renderer) : renderer_(renderer) {
 	assert(renderer);
 }
@@ -45,7 +78,18 @@ Renderer::~Renderer() {
 		SDL_DestroyRenderer(renderer_);
 }
 
-Renderer::Renderer(Renderer&& other) noexcept : renderer_(other.renderer_) {
+Renderer::Renderer(Renderer&& other) noexcept
+	: renderer_(other.renderer_),
+	  state_cache_(other.state_cache_),
+	  state_cache_stats_(other.state_cache_stats_),
+	  frame_stats_(other.frame_stats_),
+	  last_frame_stats_(other.last_frame_stats_),
+	  frame_stats_history_(std::move(other.frame_stats_history_)),
+	  frame_stats_history_pos_(other.frame_stats_history_pos_),
+	  frame_stats_history_size_(other.frame_stats_history_size_),
+	  last_copy_texture_(other.last_copy_texture_),
+	  frame_output_size_(other.frame_output_size_),
+	  batch_order_(std::move(other.batch_order_)) {
 	other.renderer_ = nullptr;
 }
 
@@ -55,6 +99,16 @@ Renderer& Renderer::operator=(Renderer&& other) noexcept {
 	if (renderer_ != nullptr)
 		SDL_DestroyRenderer(renderer_);
 	renderer_ = other.renderer_;
+	state_cache_ = other.state_cache_;
+	state_cache_stats_ = other.state_cache_stats_;
+	frame_stats_ = other.frame_stats_;
+	last_frame_stats_ = other.last_frame_stats_;
+	frame_stats_history_ = std::move(other.frame_stats_history_);
+	frame_stats_history_pos_ = other.frame_stats_history_pos_;
+	frame_stats_history_size_ = other.frame_stats_history_size_;
+	last_copy_texture_ = other.last_copy_texture_;
+	frame_output_size_ = other.frame_output_size_;
+	batch_order_ = std::move(other.batch_order_);
 	other.renderer_ = nullptr;
 	return *this;
 }
@@ -63,12 +117,61 @@ SDL_Renderer* Renderer::Get() const {
 	return renderer_;
 }
 
+void Renderer::CountCopy(SDL_Texture* texture, const SDL_Rect* dstrect, bool ex) {
+	if (ex)
+		frame_stats_.copy_ex_calls++;
+	else
+		frame_stats_.copy_calls++;
+
+	if (texture != last_copy_texture_) {
+		frame_stats_.texture_switches++;
+		last_copy_texture_ = texture;
+	}
+
+	if (dstrect != nullptr) {
+		if (dstrect->w > 0 && dstrect->h > 0)
+			frame_stats_.pixels_covered += static_cast<Uint64>(dstrect->w) * static_cast<Uint64>(dstrect->h);
+	} else {
+		// query output size once per frame and render target
+		if (!frame_output_size_) {
+			int w, h;
+			if (SDL_GetRendererOutputSize(renderer_, &w, &h) != 0)
+				return;
+			frame_output_size_ = Point(w, h);
+		}
+		frame_stats_.pixels_covered += static_cast<Uint64>(frame_output_size_->x) * static_cast<Uint64>(frame_output_size_->y);
+	}
+}
+
+void Renderer::CountFill(const SDL_Rect* rects, int count) {
+	frame_stats_.fill_rect_calls++;
+	for (const SDL_Rect* rect = rects; rect != rects + count; ++rect)
+		if (rect->w > 0 && rect->h > 0)
+			frame_stats_.pixels_covered += static_cast<Uint64>(rect->w) * static_cast<Uint64>(rect->h);
+}
+
 Renderer& Renderer::Present() {
+	Uint64 start = SDL_GetPerformanceCounter();
 	SDL_RenderPresent(renderer_);
+	frame_stats_.present_time = static_cast<double>(SDL_GetPerformanceCounter() - start) / static_cast<double>(SDL_GetPerformanceFrequency());
+
+	if (frame_stats_history_.size() < frame_stats_history_size_) {
+		frame_stats_history_.push_back(frame_stats_);
+	} else if (frame_stats_history_size_ > 0) {
+		// overwrite oldest frame
+		frame_stats_history_[frame_stats_history_pos_] = frame_stats_;
+		frame_stats_history_pos_ = (frame_stats_history_pos_ + 1) % frame_stats_history_size_;
+	}
+
+	last_frame_stats_ = frame_stats_;
+	frame_stats_ = FrameStats();
+	frame_output_size_ = NullOpt;
+
 	return *this;
 }
 
 Renderer& Renderer::Clear() {
+	frame_stats_.clear_calls++;
 	if (SDL_RenderClear(renderer_) != 0)
 		throw Exception("SDL_RenderClear");
 	return *this;
@@ -80,6 +183,7 @@ void Renderer::GetInfo(SDL_RendererInfo& info) {
 }
 
 Renderer& Renderer::Copy(Texture& texture, const Optional<Rect>& srcrect, const Optional<Rect>& dstrect) {
+	CountCopy(texture.Get(), dstrect ? &*dstrect : nullptr, false);
 	if (SDL_RenderCopy(renderer_, texture.Get(), srcrect ? &*srcrect : nullptr, dstrect ? &*dstrect : nullptr) != 0)
 		throw Exception("SDL_RenderCopy");
 	return *this;
@@ -96,6 +200,7 @@ Renderer& Renderer::Copy(Texture& texture, const Optional<Rect>& srcrect, const
 }
 
 Renderer& Renderer::Copy(Texture& texture, const Optional<Rect>& srcrect, const Optional<Rect>& dstrect, double angle, const Optional<Point>& center, int flip) {
+	CountCopy(texture.Get(), dstrect ? &*dstrect : nullptr, true);
 	if (SDL_RenderCopyEx(renderer_, texture.Get(), srcrect ? &*srcrect : nullptr, dstrect ? &*dstrect : nullptr, angle, center ? &*center : nullptr, static_cast<SDL_RendererFlip>(flip)) != 0)
 		throw Exception("SDL_RenderCopyEx");
 	return *this;
@@ -111,10 +216,23 @@ Renderer& Renderer::Copy(Texture& texture, const Optional<Rect>& srcrect, const
 	return Copy(texture, srcrect, dstrect, angle, center, flip);
 }
 
+Renderer& Renderer::Copy(const AtlasRegion& region, const Optional<Rect>& dstrect) {
+	return Copy(region.GetTexture(), region.GetRect(), dstrect);
+}
+
+Renderer& Renderer::Copy(const AtlasRegion& region, const Point& dstpoint) {
+	Rect srcrect = region.GetRect();
+	return Copy(region.GetTexture(), srcrect, Rect(dstpoint, srcrect.GetSize()));
+}
+
+Renderer& Renderer::Copy(const AtlasRegion& region, const Optional<Rect>& dstrect, double angle, const Optional<Point>& center, int flip) {
+	return Copy(region.GetTexture(), region.GetRect(), dstrect, angle, center, flip);
+}
+
 Renderer& Renderer::FillCopy(Texture& texture, const Optional<Rect>& srcrect, const Optional<Rect>& dstrect, const Point& offset, int flip) {
 	// resolve rectangles
-	Rect src = srcrect ? *srcrect : Rect(0, 0, texture.GetWidth(), texture.GetHeight());
-	Rect dst = dstrect ? *dstrect : Rect(0, 0, GetOutputWidth(), GetOutputHeight());
+	Rect src = srcrect ? *srcrect : Rect(Point(0, 0), texture.GetSize());
+	Rect dst = dstrect ? *dstrect : Rect(Point(0, 0), GetOutputSize());
 
 	// rectangle for single tile
 	Rect start_tile(
@@ -191,9 +309,94 @@ Renderer& Renderer::FillCopy(Texture& texture, const Optional<Rect>& srcrect, co
 	return *this;
 }
 
+Renderer& Renderer::CopyBatch(const CopyCommand* commands, int count, bool group_by_texture) {
+	Optional<Exception> error;
+
+	// modulation last set on the current texture by this batch
+	Texture* mod_texture = nullptr;
+	Optional<Color> mod_color;
+
+	auto submit = [&](const CopyCommand& command) {
+		SDL_Texture* texture = command.texture->Get();
+
+		if (command.texture != mod_texture) {
+			mod_texture = command.texture;
+			mod_color = NullOpt;
+		}
+
+		if (command.mod && (!mod_color || *mod_color != *command.mod)) {
+			const Color& mod = *command.mod;
+			if (SDL_SetTextureColorMod(texture, mod.r, mod.g, mod.b) != 0) {
+				if (!error)
+					error.emplace("SDL_SetTextureColorMod");
+			} else if (SDL_SetTextureAlphaMod(texture, mod.a) != 0) {
+				if (!error)
+					error.emplace("SDL_SetTextureAlphaMod");
+			} else {
+				mod_color = mod;
+			}
+		}
+
+		const SDL_Rect* srcrect = command.srcrect ? &*command.srcrect : nullptr;
+		const SDL_Rect* dstrect = command.dstrect ? &*command.dstrect : nullptr;
+
+		if (command.angle == 0.0 && !command.center && command.flip == 0) {
+			CountCopy(texture, dstrect, false);
+			if (SDL_RenderCopy(renderer_, texture, srcrect, dstrect) != 0 && !error)
+				error.emplace("SDL_RenderCopy");
+		} else {
+			CountCopy(texture, dstrect, true);
+			if (SDL_RenderCopyEx(renderer_, texture, srcrect, dstrect, command.angle, command.center ? &*command.center : nullptr, static_cast<SDL_RendererFlip>(command.flip)) != 0 && !error)
+				error.emplace("SDL_RenderCopyEx");
+		}
+	};
+
+	if (group_by_texture) {
+		// order commands by texture, then find first appearance of
+		// each texture and order groups by it; command index breaks
+		// ties, which keeps relative order inside each group
+		batch_order_.clear();
+		for (int i = 0; i < count; ++i)
+			batch_order_.push_back(BatchEntry{commands[i].texture, i, i});
+
+		std::sort(batch_order_.begin(), batch_order_.end(), [](const BatchEntry& a, const BatchEntry& b) {
+			return std::less<Texture*>()(a.texture, b.texture) || (a.texture == b.texture && a.index < b.index);
+		});
+
+		for (size_t i = 1; i < batch_order_.size(); ++i)
+			if (batch_order_[i].texture == batch_order_[i - 1].texture)
+				batch_order_[i].first = batch_order_[i - 1].first;
+
+		std::sort(batch_order_.begin(), batch_order_.end(), [](const BatchEntry& a, const BatchEntry& b) {
+			return a.first < b.first || (a.first == b.first && a.index < b.index);
+		});
+
+		for (const BatchEntry& entry : batch_order_)
+			submit(commands[entry.index]);
+	} else {
+		for (const CopyCommand* command = commands; command != commands + count; ++command)
+			submit(*command);
+	}
+
+	if (error)
+		throw *error;
+
+	return *this;
+}
+
 Renderer& Renderer::SetDrawColor(Uint8 r, Uint8 g, Uint8 b, Uint8 a) {
+	Color color(r, g, b, a);
+	if (state_cache_.enabled && state_cache_.draw_color_valid && state_cache_.draw_color == color) {
+		state_cache_stats_.skipped++;
+		return *this;
+	}
+
+	state_cache_stats_.submitted++;
+	state_cache_.draw_color_valid = false;
 	if (SDL_SetRenderDrawColor(renderer_, r, g, b, a) != 0)
 		throw Exception("SDL_SetRenderDrawColor");
+	state_cache_.draw_color = color;
+	state_cache_.draw_color_valid = true;
 	return *this;
 }
 
@@ -202,24 +405,53 @@ Renderer& Renderer::SetDrawColor(const Color& color) {
 }
 
 Renderer& Renderer::SetTarget() {
-	if (SDL_SetRenderTarget(renderer_, nullptr) != 0)
-		throw Exception("SDL_SetRenderTarget");
-	return *this;
+	return SetRawTarget(nullptr);
 }
 
 Renderer& Renderer::SetTarget(Texture& texture) {
-	if (SDL_SetRenderTarget(renderer_, texture.Get()) != 0)
+	return SetRawTarget(texture.Get());
+}
+
+Renderer& Renderer::SetRawTarget(SDL_Texture* texture) {
+	if (state_cache_.enabled && state_cache_.target_valid && state_cache_.target == texture) {
+		state_cache_stats_.skipped++;
+		return *this;
+	}
+
+	state_cache_stats_.submitted++;
+	frame_stats_.target_switches++;
+	frame_output_size_ = NullOpt;
+
+	// viewport, clipping and scale are per-target in SDL
+	state_cache_.target_valid = false;
+	state_cache_.clip_rect_valid = false;
+	state_cache_.viewport_valid = false;
+	state_cache_.scale_valid = false;
+
+	if (SDL_SetRenderTarget(renderer_, texture) != 0)
 		throw Exception("SDL_SetRenderTarget");
+	state_cache_.target = texture;
+	state_cache_.target_valid = true;
 	return *this;
 }
 
 Renderer& Renderer::SetDrawBlendMode(SDL_BlendMode blendMode) {
+	if (state_cache_.enabled && state_cache_.blend_mode_valid && state_cache_.blend_mode == blendMode) {
+		state_cache_stats_.skipped++;
+		return *this;
+	}
+
+	state_cache_stats_.submitted++;
+	state_cache_.blend_mode_valid = false;
 	if (SDL_SetRenderDrawBlendMode(renderer_, blendMode) != 0)
 		throw Exception("SDL_SetRenderDrawBlendMode");
+	state_cache_.blend_mode = blendMode;
+	state_cache_.blend_mode_valid = true;
 	return *this;
 }
 
 Renderer& Renderer::DrawPoint(int x, int y) {
+	frame_stats_.draw_point_calls++;
 	if (SDL_RenderDrawPoint(renderer_, x, y) != 0)
 		throw Exception("SDL_RenderDrawPoint");
 	return *this;
@@ -236,6 +468,7 @@ Renderer& Renderer::DrawPoints(const Point* points, int count) {
 	for (const Point* p = points; p != points + count; ++p)
 		sdl_points.emplace_back(*p);
 
+	frame_stats_.draw_point_calls++;
 	if (SDL_RenderDrawPoints(renderer_, sdl_points.data(), count) != 0)
 		throw Exception("SDL_RenderDrawPoints");
 
@@ -243,6 +476,7 @@ Renderer& Renderer::DrawPoints(const Point* points, int count) {
 }
 
 Renderer& Renderer::DrawLine(int x1, int y1, int x2, int y2) {
+	frame_stats_.draw_line_calls++;
 	if (SDL_RenderDrawLine(renderer_, x1, y1, x2, y2) != 0)
 		throw Exception("SDL_RenderDrawLine");
 	return *this;
@@ -259,6 +493,7 @@ Renderer& Renderer::DrawLines(const Point* points, int count) {
 	for (const Point* p = points; p != points + count; ++p)
 		sdl_points.emplace_back(*p);
 
+	frame_stats_.draw_line_calls++;
 	if (SDL_RenderDrawLines(renderer_, sdl_points.data(), count) != 0)
 		throw Exception("SDL_RenderDrawLines");
 
@@ -267,6 +502,7 @@ Renderer& Renderer::DrawLines(const Point* points, int count) {
 
 Renderer& Renderer::DrawRect(int x1, int y1, int x2, int y2) {
 	SDL_Rect rect = {x1, y1, x2 - x1 + 1, y2 - y1 + 1};
+	frame_stats_.draw_rect_calls++;
 	if (SDL_RenderDrawRect(renderer_, &rect) != 0)
 		throw Exception("SDL_RenderDrawRect");
 	return *this;
@@ -278,6 +514,7 @@ Renderer& Renderer::DrawRect(const Point& p1, const Point& p2) {
 }
 
 Renderer& Renderer::DrawRect(const Rect& r) {
+	frame_stats_.draw_rect_calls++;
 	if (SDL_RenderDrawRect(renderer_, &r) != 0)
 		throw Exception("SDL_RenderDrawRect");
 	return *this;
@@ -289,6 +526,7 @@ Renderer& Renderer::DrawRects(const Rect* rects, int count) {
 	for (const Rect* r = rects; r != rects + count; ++r)
 		sdl_rects.emplace_back(*r);
 
+	frame_stats_.draw_rect_calls++;
 	if (SDL_RenderDrawRects(renderer_, sdl_rects.data(), count) != 0)
 		throw Exception("SDL_RenderDrawRects");
 
@@ -297,6 +535,7 @@ Renderer& Renderer::DrawRects(const Rect* rects, int count) {
 
 Renderer& Renderer::FillRect(int x1, int y1, int x2, int y2) {
 	SDL_Rect rect = {x1, y1, x2 - x1 + 1, y2 - y1 + 1};
+	CountFill(&rect, 1);
 	if (SDL_RenderFillRect(renderer_, &rect) != 0)
 		throw Exception("SDL_RenderFillRect");
 	return *this;
@@ -308,6 +547,7 @@ Renderer& Renderer::FillRect(const Point& p1, const Point& p2) {
 }
 
 Renderer& Renderer::FillRect(const Rect& r) {
+	CountFill(&r, 1);
 	if (SDL_RenderFillRect(renderer_, &r) != 0)
 		throw Exception("SDL_RenderFillRect");
 	return *this;
@@ -319,6 +559,7 @@ Renderer& Renderer::FillRects(const Rect* rects, int count) {
 	for (const Rect* r = rects; r != rects + count; ++r)
 		sdl_rects.emplace_back(*r);
 
+	CountFill(sdl_rects.data(), count);
 	if (SDL_RenderFillRects(renderer_, sdl_rects.data(), count) != 0)
 		throw Exception("SDL_RenderFillRects");
 
@@ -331,29 +572,118 @@ void Renderer::ReadPixels(const Optional<Rect>& rect, Uint32 format, void* pixel
 }
 
 Renderer& Renderer::SetClipRect(const Optional<Rect>& rect) {
+	if (state_cache_.enabled && state_cache_.clip_rect_valid && state_cache_.clip_rect == rect) {
+		state_cache_stats_.skipped++;
+		return *this;
+	}
+
+	state_cache_stats_.submitted++;
+	state_cache_.clip_rect_valid = false;
 	if (SDL_RenderSetClipRect(renderer_, rect ? &*rect : nullptr) != 0)
 		throw Exception("SDL_RenderSetClipRect");
+	state_cache_.clip_rect = rect;
+	state_cache_.clip_rect_valid = true;
 	return *this;
 }
 
 Renderer& Renderer::SetLogicalSize(int w, int h) {
+	// SDL recalculates viewport and scale
+	state_cache_.viewport_valid = false;
+	state_cache_.scale_valid = false;
+
 	if (SDL_RenderSetLogicalSize(renderer_, w, h) != 0)
 		throw Exception("SDL_RenderSetLogicalSize");
 	return *this;
 }
 
 Renderer& Renderer::SetScale(float scaleX, float scaleY) {
+	if (state_cache_.enabled && state_cache_.scale_valid && state_cache_.scale_x == scaleX && state_cache_.scale_y == scaleY) {
+		state_cache_stats_.skipped++;
+		return *this;
+	}
+
+	state_cache_stats_.submitted++;
+	state_cache_.scale_valid = false;
 	if (SDL_RenderSetScale(renderer_, scaleX, scaleY) != 0)
 		throw Exception("SDL_RenderSetScale");
+	state_cache_.scale_x = scaleX;
+	state_cache_.scale_y = scaleY;
+	state_cache_.scale_valid = true;
 	return *this;
 }
 
 Renderer& Renderer::SetViewport(const Optional<Rect>& rect) {
+	if (state_cache_.enabled && state_cache_.viewport_valid && state_cache_.viewport == rect) {
+		state_cache_stats_.skipped++;
+		return *this;
+	}
+
+	state_cache_stats_.submitted++;
+	state_cache_.viewport_valid = false;
 	if (SDL_RenderSetViewport(renderer_, rect ? &*rect : nullptr) != 0)
 		throw Exception("SDL_RenderSetViewport");
+	state_cache_.viewport = rect;
+	state_cache_.viewport_valid = true;
+	return *this;
+}
+
+Renderer& Renderer::SetStateCacheEnabled(bool enabled) {
+	if (enabled != state_cache_.enabled)
+		state_cache_.Invalidate();
+	state_cache_.enabled = enabled;
 	return *this;
 }
 
+bool Renderer::IsStateCacheEnabled() const {
+	return state_cache_.enabled;
+}
+
+Renderer& Renderer::InvalidateStateCache() {
+	state_cache_.Invalidate();
+	return *this;
+}
+
+Renderer::StateCacheStats Renderer::GetStateCacheStats() const {
+	return state_cache_stats_;
+}
+
+Renderer& Renderer::ResetStateCacheStats() {
+	state_cache_stats_ = StateCacheStats();
+	return *this;
+}
+
+Renderer::FrameStats Renderer::GetFrameStats() const {
+	return last_frame_stats_;
+}
+
+Renderer::FrameStats Renderer::GetCurrentFrameStats() const {
+	return frame_stats_;
+}
+
+std::vector<Renderer::FrameStats> Renderer::GetFrameStatsHistory() const {
+	std::vector<FrameStats> history;
+	history.reserve(frame_stats_history_.size());
+	history.insert(history.end(), frame_stats_history_.begin() + frame_stats_history_pos_, frame_stats_history_.end());
+	history.insert(history.end(), frame_stats_history_.begin(), frame_stats_history_.begin() + frame_stats_history_pos_);
+	return history;
+}
+
+Renderer& Renderer::SetFrameStatsHistorySize(size_t size) {
+	// restore chronological order, so new frames may be appended
+	std::rotate(frame_stats_history_.begin(), frame_stats_history_.begin() + frame_stats_history_pos_, frame_stats_history_.end());
+	frame_stats_history_pos_ = 0;
+
+	if (frame_stats_history_.size() > size)
+		frame_stats_history_.erase(frame_stats_history_.begin(), frame_stats_history_.end() - size);
+
+	frame_stats_history_size_ = size;
+	return *this;
+}
+
+size_t Renderer::GetFrameStatsHistorySize() const {
+	return frame_stats_history_size_;
+}
+
 bool Renderer::TargetSupported() const {
 	return SDL_RenderTargetSupported(renderer_) == SDL_TRUE;
 }
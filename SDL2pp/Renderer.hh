@@ -22,6 +22,8 @@
 #ifndef SDL2PP_RENDERER_HH
 #define SDL2PP_RENDERER_HH
 
+#include <vector>
+
 #include <SDL_stdinc.h>
 #include <SDL_blendmode.h>
 
@@ -34,12 +36,15 @@
 
 struct SDL_RendererInfo;
 struct SDL_Renderer;
+struct SDL_Texture;
+struct SDL_Rect;
 
 namespace SDL2pp {
 
 class Window;
 class Texture;
 class Point;
+class AtlasRegion;
 
 ////////////////////////////////////////////////////////////
 /// \brief 2D rendering context
@@ -53,6 +58,189 @@ class SDL2PP_EXPORT Renderer {
 private:
 	SDL_Renderer* renderer_; ///< Managed SDL_Renderer object
 
+public:
+	////////////////////////////////////////////////////////////
+	/// \brief Render state cache counters
+	///
+	/// \ingroup rendering
+	///
+	/// \headerfile SDL2pp/Renderer.hh
+	///
+	/// \see Renderer::GetStateCacheStats
+	///
+	////////////////////////////////////////////////////////////
+	struct StateCacheStats {
+		Uint64 submitted = 0; ///< Number of state changes passed to SDL
+		Uint64 skipped = 0;   ///< Number of state changes skipped as redundant
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Rendering statistics for a single frame
+	///
+	/// \ingroup rendering
+	///
+	/// \headerfile SDL2pp/Renderer.hh
+	///
+	/// Counts work submitted through Renderer between two
+	/// Present() calls.
+	///
+	/// \see Renderer::GetFrameStats
+	///
+	////////////////////////////////////////////////////////////
+	struct FrameStats {
+		Uint32 clear_calls = 0;      ///< Number of Clear() calls
+		Uint32 copy_calls = 0;       ///< Number of textures copied with SDL_RenderCopy
+		Uint32 copy_ex_calls = 0;    ///< Number of textures copied with SDL_RenderCopyEx
+		Uint32 fill_rect_calls = 0;  ///< Number of FillRect() and FillRects() calls
+		Uint32 draw_rect_calls = 0;  ///< Number of DrawRect() and DrawRects() calls
+		Uint32 draw_line_calls = 0;  ///< Number of DrawLine() and DrawLines() calls
+		Uint32 draw_point_calls = 0; ///< Number of DrawPoint() and DrawPoints() calls
+		Uint32 texture_switches = 0; ///< Number of copies using different texture than the previous copy
+		Uint32 target_switches = 0;  ///< Number of render target changes
+		Uint64 pixels_covered = 0;   ///< Total area of copy and fill destination rectangles
+		double present_time = 0.0;   ///< Time spent in Present(), in seconds
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Single texture copy operation for Renderer::CopyBatch
+	///
+	/// \ingroup rendering
+	///
+	/// \headerfile SDL2pp/Renderer.hh
+	///
+	/// Describes one Renderer::Copy call. If angle is zero, center
+	/// is not set and flip is zero, the command is submitted with
+	/// SDL_RenderCopy, otherwise SDL_RenderCopyEx is used.
+	///
+	////////////////////////////////////////////////////////////
+	struct CopyCommand {
+		Texture* texture;        ///< Source texture
+		Optional<Rect> srcrect;  ///< Source rectangle, NullOpt for the entire texture
+		Optional<Rect> dstrect;  ///< Destination rectangle, NullOpt for the entire rendering target
+		double angle;            ///< Rotation angle in degrees
+		Optional<Point> center;  ///< Rotation center, NullOpt to rotate around dstrect center
+		int flip;                ///< SDL_RendererFlip value
+		Optional<Color> mod;     ///< Color and alpha modulation to set on the texture, NullOpt to leave it untouched
+
+		////////////////////////////////////////////////////////////
+		/// \brief Construct plain copy command
+		///
+		/// \param[in] texture Source texture
+		/// \param[in] srcrect Source rectangle, NullOpt for the entire texture
+		/// \param[in] dstrect Destination rectangle, NullOpt for the entire
+		///                    rendering target
+		/// \param[in] mod Color and alpha modulation, NullOpt to leave
+		///                texture modulation untouched
+		///
+		////////////////////////////////////////////////////////////
+		CopyCommand(Texture& texture, const Optional<Rect>& srcrect = NullOpt, const Optional<Rect>& dstrect = NullOpt, const Optional<Color>& mod = NullOpt);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Construct copy command with rotating or flipping
+		///
+		/// \param[in] texture Source texture
+		/// \param[in] srcrect Source rectangle, NullOpt for the entire texture
+		/// \param[in] dstrect Destination rectangle, NullOpt for the entire
+		///                    rendering target
+		/// \param[in] angle Angle in degrees that indicates the rotation that
+		///                  will be applied to dstrect
+		/// \param[in] center Point indicating the point around which dstrect
+		///                   will be rotated (NullOpt to rotate around dstrect
+		///                   center)
+		/// \param[in] flip SDL_RendererFlip value stating which flipping
+		///                 actions should be performed on the texture
+		/// \param[in] mod Color and alpha modulation, NullOpt to leave
+		///                texture modulation untouched
+		///
+		////////////////////////////////////////////////////////////
+		CopyCommand(Texture& texture, const Optional<Rect>& srcrect, const Optional<Rect>& dstrect, double angle, const Optional<Point>& center = NullOpt, int flip = 0, const Optional<Color>& mod = NullOpt);
+	};
+
+private:
+	////////////////////////////////////////////////////////////
+	/// \brief Shadow copy of render state
+	///
+	////////////////////////////////////////////////////////////
+	struct StateCache {
+		bool enabled = false;          ///< Whether redundant state changes are skipped
+
+		bool draw_color_valid = false; ///< Whether draw_color is known
+		Color draw_color;              ///< Last set draw color
+
+		bool blend_mode_valid = false; ///< Whether blend_mode is known
+		SDL_BlendMode blend_mode = SDL_BLENDMODE_NONE; ///< Last set draw blend mode
+
+		bool target_valid = false;     ///< Whether target is known
+		SDL_Texture* target = nullptr; ///< Last set render target
+
+		bool clip_rect_valid = false;  ///< Whether clip_rect is known
+		Optional<Rect> clip_rect;      ///< Last set clipping rectangle
+
+		bool viewport_valid = false;   ///< Whether viewport is known
+		Optional<Rect> viewport;       ///< Last set viewport
+
+		bool scale_valid = false;      ///< Whether scale_x and scale_y are known
+		float scale_x = 1.0f;          ///< Last set horizontal scale
+		float scale_y = 1.0f;          ///< Last set vertical scale
+
+		void Invalidate();
+	};
+
+	StateCache state_cache_;            ///< Render state shadow copy
+	StateCacheStats state_cache_stats_; ///< Render state cache counters
+
+	FrameStats frame_stats_;                     ///< Statistics for the frame being rendered
+	FrameStats last_frame_stats_;                ///< Statistics for the last presented frame
+	std::vector<FrameStats> frame_stats_history_; ///< Ring buffer of statistics for recently presented frames
+	size_t frame_stats_history_pos_ = 0;          ///< Index of the oldest frame in full history ring buffer
+	size_t frame_stats_history_size_ = 120;       ///< Maximal number of frames kept in history
+	SDL_Texture* last_copy_texture_ = nullptr;   ///< Texture used by the last copy operation
+	Optional<Point> frame_output_size_;         ///< Output size queried during the frame being rendered
+
+	////////////////////////////////////////////////////////////
+	/// \brief Position of a command in grouped CopyBatch order
+	///
+	////////////////////////////////////////////////////////////
+	struct BatchEntry {
+		Texture* texture; ///< Texture used by the command
+		int first;        ///< Index of the first command using the same texture
+		int index;        ///< Index of the command
+	};
+
+	std::vector<BatchEntry> batch_order_; ///< Reusable storage for CopyBatch grouping
+
+	////////////////////////////////////////////////////////////
+	/// \brief Account single texture copy in frame statistics
+	///
+	/// \param[in] texture Source texture
+	/// \param[in] dstrect Destination rectangle or nullptr for
+	///                    the entire rendering target
+	/// \param[in] ex Whether copy is done with SDL_RenderCopyEx
+	///
+	////////////////////////////////////////////////////////////
+	void CountCopy(SDL_Texture* texture, const SDL_Rect* dstrect, bool ex);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Account filled rectangles in frame statistics
+	///
+	/// \param[in] rects Array of rectangles
+	/// \param[in] count Number of rectangles
+	///
+	////////////////////////////////////////////////////////////
+	void CountFill(const SDL_Rect* rects, int count);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set current render target, going through state cache
+	///
+	/// \param[in] texture Target texture or nullptr for default target
+	///
+	/// \returns Reference to self
+	///
+	/// \throws SDL2pp::Exception
+	///
+	////////////////////////////////////////////////////////////
+	Renderer& SetRawTarget(SDL_Texture* texture);
+
 public:
 	////////////////////////////////////////////////////////////
 	/// \brief Construct from existing SDL_Renderer structure
@@ -262,6 +450,63 @@ public:
 	////////////////////////////////////////////////////////////
 	Renderer& Copy(Texture& texture, const Optional<Rect>& srcrect, const SDL2pp::Point& dstpoint, double angle, const Optional<Point>& center = NullOpt, int flip = 0);
 
+	////////////////////////////////////////////////////////////
+	/// \brief Copy an atlas image to the current rendering target
+	///
+	/// \param[in] region Source image
+	/// \param[in] dstrect Destination rectangle, NullOpt for the entire
+	///                    rendering target
+	///
+	/// \returns Reference to self
+	///
+	/// \throws SDL2pp::Exception
+	///
+	/// \see http://wiki.libsdl.org/SDL_RenderCopy
+	///
+	////////////////////////////////////////////////////////////
+	Renderer& Copy(const AtlasRegion& region, const Optional<Rect>& dstrect = NullOpt);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Copy an atlas image to the current rendering target
+	///        (preserve image dimensions)
+	///
+	/// \param[in] region Source image
+	/// \param[in] dstpoint Target point for image top left corner
+	///
+	/// \returns Reference to self
+	///
+	/// \throws SDL2pp::Exception
+	///
+	/// \see http://wiki.libsdl.org/SDL_RenderCopy
+	///
+	////////////////////////////////////////////////////////////
+	Renderer& Copy(const AtlasRegion& region, const Point& dstpoint);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Copy an atlas image to the current rendering target
+	///        with optional rotating or flipping
+	///
+	/// \param[in] region Source image
+	/// \param[in] dstrect Destination rectangle, NullOpt for the entire
+	///                    rendering target
+	/// \param[in] angle Angle in degrees that indicates the rotation that
+	///                  will be applied to dstrect
+	/// \param[in] center Point indicating the point around which dstrect
+	///                   will be rotated (NullOpt to rotate around dstrect
+	///                   center)
+	/// \param[in] flip SDL_RendererFlip value stating which flipping
+	///                 actions should be performed on the image
+	///
+	/// \returns Reference to self
+	///
+	/// \throws SDL2pp::Exception
+	///
+	/// \see http://wiki.libsdl.org/SDL_RendererFlip
+	/// \see http://wiki.libsdl.org/SDL_RenderCopyEx
+	///
+	////////////////////////////////////////////////////////////
+	Renderer& Copy(const AtlasRegion& region, const Optional<Rect>& dstrect, double angle, const Optional<Point>& center = NullOpt, int flip = 0);
+
 	////////////////////////////////////////////////////////////
 	/// \brief Fill the target with repeated source texture
 	///
@@ -285,6 +530,39 @@ public:
 	////////////////////////////////////////////////////////////
 	Renderer& FillCopy(Texture& texture, const Optional<Rect>& srcrect = NullOpt, const Optional<Rect>& dstrect = NullOpt, const Point& offset = Point(0, 0), int flip = 0);
 
+	////////////////////////////////////////////////////////////
+	/// \brief Copy multiple textures to the current rendering target
+	///
+	/// Submits all commands in a single pass. Texture modulation
+	/// is only changed when it differs from the one set by the
+	/// previous command for the same texture, and is left in place
+	/// after the batch is finished.
+	///
+	/// When group_by_texture is set, commands are reordered so all
+	/// commands using the same texture are submitted together (in
+	/// order of first appearance of each texture, preserving the
+	/// relative order of commands using the same texture). This
+	/// reduces texture switches, but changes painting order of
+	/// overlapping commands which use different textures.
+	///
+	/// A failing command does not abort the batch: remaining
+	/// commands are still submitted, and an exception describing
+	/// the first failure is thrown afterwards.
+	///
+	/// \param[in] commands Array of copy commands
+	/// \param[in] count Number of commands
+	/// \param[in] group_by_texture Whether to group commands by texture
+	///
+	/// \returns Reference to self
+	///
+	/// \throws SDL2pp::Exception
+	///
+	/// \see http://wiki.libsdl.org/SDL_RenderCopy
+	/// \see http://wiki.libsdl.org/SDL_RenderCopyEx
+	///
+	////////////////////////////////////////////////////////////
+	Renderer& CopyBatch(const CopyCommand* commands, int count, bool group_by_texture = false);
+
 	////////////////////////////////////////////////////////////
 	/// \brief Set color user for drawing operations
 	///
@@ -650,6 +928,115 @@ public:
 	////////////////////////////////////////////////////////////
 	Renderer& SetViewport(const Optional<Rect>& rect = NullOpt);
 
+	////////////////////////////////////////////////////////////
+	/// \brief Enable or disable skipping of redundant state changes
+	///
+	/// When enabled, renderer keeps a shadow copy of draw color,
+	/// draw blend mode, render target, clipping rectangle, viewport
+	/// and scale, and SetDrawColor(), SetDrawBlendMode(), SetTarget(),
+	/// SetClipRect(), SetViewport() and SetScale() calls which would
+	/// not change anything are not passed to %SDL.
+	///
+	/// The cache only knows about changes done through this object.
+	/// %SDL may also change render state on its own: resizing the
+	/// window resets the viewport, and destroying a texture which
+	/// is the current render target resets the target. Call
+	/// InvalidateStateCache() after such events, or after calling
+	/// %SDL functions directly on Get().
+	///
+	/// The cache is disabled by default.
+	///
+	/// \param[in] enabled Whether to skip redundant state changes
+	///
+	/// \returns Reference to self
+	///
+	////////////////////////////////////////////////////////////
+	Renderer& SetStateCacheEnabled(bool enabled = true);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Check whether redundant state changes are skipped
+	///
+	/// \returns True if render state cache is enabled
+	///
+	////////////////////////////////////////////////////////////
+	bool IsStateCacheEnabled() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Forget cached render state
+	///
+	/// Next call of each state setting method will be passed to
+	/// %SDL unconditionally. Use this after changing render state
+	/// with %SDL functions directly.
+	///
+	/// \returns Reference to self
+	///
+	////////////////////////////////////////////////////////////
+	Renderer& InvalidateStateCache();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get render state cache counters
+	///
+	/// \returns Numbers of submitted and skipped state changes
+	///          since construction or last ResetStateCacheStats()
+	///
+	////////////////////////////////////////////////////////////
+	StateCacheStats GetStateCacheStats() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Reset render state cache counters
+	///
+	/// \returns Reference to self
+	///
+	////////////////////////////////////////////////////////////
+	Renderer& ResetStateCacheStats();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get statistics for the last presented frame
+	///
+	/// \returns Statistics collected between the two last
+	///          Present() calls, or empty statistics if no
+	///          frame was presented yet
+	///
+	////////////////////////////////////////////////////////////
+	FrameStats GetFrameStats() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get statistics for the frame being rendered
+	///
+	/// \returns Statistics collected since the last Present() call
+	///
+	////////////////////////////////////////////////////////////
+	FrameStats GetCurrentFrameStats() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get statistics for recently presented frames
+	///
+	/// \returns Statistics for up to GetFrameStatsHistorySize()
+	///          last presented frames, oldest first
+	///
+	////////////////////////////////////////////////////////////
+	std::vector<FrameStats> GetFrameStatsHistory() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set number of frames kept in statistics history
+	///
+	/// Default is 120 frames.
+	///
+	/// \param[in] size Maximal number of frames to keep
+	///
+	/// \returns Reference to self
+	///
+	////////////////////////////////////////////////////////////
+	Renderer& SetFrameStatsHistorySize(size_t size);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get number of frames kept in statistics history
+	///
+	/// \returns Maximal number of frames kept in history
+	///
+	////////////////////////////////////////////////////////////
+	size_t GetFrameStatsHistorySize() const;
+
 	////////////////////////////////////////////////////////////
 	/// \brief Determine whether a window supports the use of
 	///        render targets
@@ -0,0 +1,352 @@
+/*
+  libSDL2pp - C++11 bindings/wrapper for SDL2
+  Copyright (C) 2013-2016 Dmitry Marakasov <amdmi3@amdmi3.ru>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#	define SDL2PP_RESAMPLER_X86
+#	include <emmintrin.h>
+#endif
+
+#if defined(__GNUC__)
+#	define SDL2PP_TARGET(isa) __attribute__((target(isa)))
+#else
+#	define SDL2PP_TARGET(isa)
+#endif
+
+#include <SDL2pp/Resampler.hh>
+#include <SDL2pp/ThreadPool.hh>
+
+namespace SDL2pp {
+
+namespace {
+
+// fixed point precision of filter weights; with 14 bits weights
+// up to 2.0 fit into Sint16, which is enough for all filters
+const int WEIGHT_BITS = 14;
+const int WEIGHT_ONE = 1 << WEIGHT_BITS;
+const int WEIGHT_HALF = 1 << (WEIGHT_BITS - 1);
+
+// minimal number of rows processed by a single thread
+const int MIN_ROWS_PER_TASK = 16;
+
+const double PI = 3.14159265358979323846;
+
+double BilinearFilter(double x) {
+	x = std::fabs(x);
+	return x < 1.0 ? 1.0 - x : 0.0;
+}
+
+double BicubicFilter(double x) {
+	const double a = -0.5;
+	x = std::fabs(x);
+	if (x < 1.0)
+		return ((a + 2.0) * x - (a + 3.0)) * x * x + 1.0;
+	if (x < 2.0)
+		return (((x - 5.0) * x + 8.0) * x - 4.0) * a;
+	return 0.0;
+}
+
+double Sinc(double x) {
+	if (x == 0.0)
+		return 1.0;
+	x *= PI;
+	return std::sin(x) / x;
+}
+
+double Lanczos3Filter(double x) {
+	if (x <= -3.0 || x >= 3.0)
+		return 0.0;
+	return Sinc(x) * Sinc(x / 3.0);
+}
+
+inline Uint8 ClampToByte(int value) {
+	return static_cast<Uint8>(value < 0 ? 0 : value > 255 ? 255 : value);
+}
+
+void HorizontalRowScalar(const Uint8* src, Uint8* dst, int width, const int* starts, const int* counts, const Sint16* coefficients, int taps) {
+	for (int x = 0; x < width; x++) {
+		const Uint8* pixels = src + starts[x] * 4;
+		const Sint16* weights = coefficients + x * taps;
+
+		int acc[4] = { WEIGHT_HALF, WEIGHT_HALF, WEIGHT_HALF, WEIGHT_HALF };
+		for (int i = 0; i < counts[x]; i++)
+			for (int c = 0; c < 4; c++)
+				acc[c] += pixels[i * 4 + c] * weights[i];
+
+		for (int c = 0; c < 4; c++)
+			dst[x * 4 + c] = ClampToByte(acc[c] >> WEIGHT_BITS);
+	}
+}
+
+void VerticalRowScalar(const Uint8* src, int src_pitch, Uint8* dst, int row_bytes, int count, const Sint16* weights) {
+	for (int x = 0; x < row_bytes; x++) {
+		int acc = WEIGHT_HALF;
+		for (int i = 0; i < count; i++)
+			acc += src[i * src_pitch + x] * weights[i];
+		dst[x] = ClampToByte(acc >> WEIGHT_BITS);
+	}
+}
+
+#ifdef SDL2PP_RESAMPLER_X86
+// Pairs of source values are interleaved into 16 bit lanes and
+// multiplied by matching pair of weights with _mm_madd_epi16,
+// which yields 32 bit sums of two products per channel
+
+SDL2PP_TARGET("sse2") inline __m128i WeightPairSSE2(Sint16 first, Sint16 second) {
+	return _mm_set1_epi32(static_cast<int>((static_cast<Uint32>(static_cast<Uint16>(second)) << 16) | static_cast<Uint16>(first)));
+}
+
+SDL2PP_TARGET("sse2") inline __m128i LoadPixelSSE2(const Uint8* pixel) {
+	int value;
+	std::memcpy(&value, pixel, 4);
+	return _mm_cvtsi32_si128(value);
+}
+
+SDL2PP_TARGET("sse2") void HorizontalRowSSE2(const Uint8* src, Uint8* dst, int width, const int* starts, const int* counts, const Sint16* coefficients, int taps) {
+	const __m128i zero = _mm_setzero_si128();
+
+	for (int x = 0; x < width; x++) {
+		const Uint8* pixels = src + starts[x] * 4;
+		const Sint16* weights = coefficients + x * taps;
+		int count = counts[x];
+
+		__m128i acc = _mm_set1_epi32(WEIGHT_HALF);
+
+		int i = 0;
+		for (; i + 1 < count; i += 2) {
+			__m128i pair = _mm_unpacklo_epi8(_mm_unpacklo_epi8(LoadPixelSSE2(pixels + i * 4), LoadPixelSSE2(pixels + i * 4 + 4)), zero);
+			acc = _mm_add_epi32(acc, _mm_madd_epi16(pair, WeightPairSSE2(weights[i], weights[i + 1])));
+		}
+		if (i < count) {
+			__m128i single = _mm_unpacklo_epi8(_mm_unpacklo_epi8(LoadPixelSSE2(pixels + i * 4), zero), zero);
+			acc = _mm_add_epi32(acc, _mm_madd_epi16(single, WeightPairSSE2(weights[i], 0)));
+		}
+
+		acc = _mm_srai_epi32(acc, WEIGHT_BITS);
+		acc = _mm_packs_epi32(acc, acc);
+		acc = _mm_packus_epi16(acc, acc);
+
+		int result = _mm_cvtsi128_si32(acc);
+		std::memcpy(dst + x * 4, &result, 4);
+	}
+}
+
+SDL2PP_TARGET("sse2") void VerticalRowSSE2(const Uint8* src, int src_pitch, Uint8* dst, int row_bytes, int count, const Sint16* weights) {
+	const __m128i zero = _mm_setzero_si128();
+
+	int x = 0;
+	for (; x + 16 <= row_bytes; x += 16) {
+		__m128i acc0 = _mm_set1_epi32(WEIGHT_HALF);
+		__m128i acc1 = acc0, acc2 = acc0, acc3 = acc0;
+
+		for (int i = 0; i < count; i += 2) {
+			__m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * src_pitch + x));
+			__m128i second = i + 1 < count ? _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + (i + 1) * src_pitch + x)) : zero;
+			__m128i weight = WeightPairSSE2(weights[i], i + 1 < count ? weights[i + 1] : 0);
+
+			__m128i lo = _mm_unpacklo_epi8(first, second);
+			__m128i hi = _mm_unpackhi_epi8(first, second);
+
+			acc0 = _mm_add_epi32(acc0, _mm_madd_epi16(_mm_unpacklo_epi8(lo, zero), weight));
+			acc1 = _mm_add_epi32(acc1, _mm_madd_epi16(_mm_unpackhi_epi8(lo, zero), weight));
+			acc2 = _mm_add_epi32(acc2, _mm_madd_epi16(_mm_unpacklo_epi8(hi, zero), weight));
+			acc3 = _mm_add_epi32(acc3, _mm_madd_epi16(_mm_unpackhi_epi8(hi, zero), weight));
+		}
+
+		__m128i lo = _mm_packs_epi32(_mm_srai_epi32(acc0, WEIGHT_BITS), _mm_srai_epi32(acc1, WEIGHT_BITS));
+		__m128i hi = _mm_packs_epi32(_mm_srai_epi32(acc2, WEIGHT_BITS), _mm_srai_epi32(acc3, WEIGHT_BITS));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x), _mm_packus_epi16(lo, hi));
+	}
+
+	if (x < row_bytes)
+		VerticalRowScalar(src + x, src_pitch, dst + x, row_bytes - x, count, weights);
+}
+#endif
+
+}
+
+void Resampler::ComputeAxis(Axis& axis, int in_size, int out_size, ResizeFilter filter) {
+	double (*function)(double);
+	double radius;
+	switch (filter) {
+	case ResizeFilter::Bilinear: function = &BilinearFilter; radius = 1.0; break;
+	case ResizeFilter::Bicubic: function = &BicubicFilter; radius = 2.0; break;
+	case ResizeFilter::Lanczos3: function = &Lanczos3Filter; radius = 3.0; break;
+	default: throw std::invalid_argument("unknown resize filter");
+	}
+
+	// when downscaling, filter is stretched to cover all source
+	// pixels contributing to an output pixel
+	double scale = static_cast<double>(in_size) / out_size;
+	double filter_scale = std::max(scale, 1.0);
+	double support = radius * filter_scale;
+
+	axis.taps = static_cast<int>(std::ceil(support)) * 2 + 1;
+	axis.starts.resize(out_size);
+	axis.counts.resize(out_size);
+	axis.coefficients.assign(static_cast<size_t>(out_size) * axis.taps, 0);
+
+	std::vector<double> weights(axis.taps);
+
+	for (int out = 0; out < out_size; out++) {
+		double center = (out + 0.5) * scale;
+		int start = std::max(static_cast<int>(center - support + 0.5), 0);
+		int count = std::min(std::min(static_cast<int>(center + support + 0.5), in_size) - start, axis.taps);
+
+		double total = 0.0;
+		for (int i = 0; i < count; i++) {
+			weights[i] = function((start + i - center + 0.5) / filter_scale);
+			total += weights[i];
+		}
+		if (total == 0.0)
+			total = 1.0;
+
+		// quantize, making weights sum to exactly one so flat
+		// areas are preserved
+		Sint16* coefficients = axis.coefficients.data() + static_cast<size_t>(out) * axis.taps;
+		int sum = 0, largest = 0;
+		for (int i = 0; i < count; i++) {
+			long value = std::lround(weights[i] / total * WEIGHT_ONE);
+			coefficients[i] = static_cast<Sint16>(std::max(std::min(value, 32767L), -32768L));
+			sum += coefficients[i];
+			if (std::abs(coefficients[i]) > std::abs(coefficients[largest]))
+				largest = i;
+		}
+		coefficients[largest] = static_cast<Sint16>(coefficients[largest] + WEIGHT_ONE - sum);
+
+		// skip zero weights at both ends
+		int first = 0;
+		while (first < count - 1 && coefficients[first] == 0)
+			first++;
+		while (count > first + 1 && coefficients[count - 1] == 0)
+			count--;
+
+		if (first > 0) {
+			std::copy(coefficients + first, coefficients + count, coefficients);
+			std::fill(coefficients + count - first, coefficients + count, 0);
+		}
+
+		axis.starts[out] = start + first;
+		axis.counts[out] = count - first;
+	}
+}
+
+Resampler::Resampler(int src_w, int src_h, int dst_w, int dst_h, ResizeFilter filter, BlitKernels::Isa isa) : src_w_(src_w), src_h_(src_h), dst_w_(dst_w), dst_h_(dst_h), filter_(filter), isa_(isa) {
+	if (src_w <= 0 || src_h <= 0 || dst_w <= 0 || dst_h <= 0)
+		throw std::invalid_argument("image sizes must be positive");
+
+	ComputeAxis(horizontal_, src_w, dst_w, filter);
+	ComputeAxis(vertical_, src_h, dst_h, filter);
+}
+
+void Resampler::HorizontalPass(const Uint8* src, int src_pitch, Uint8* dst, int dst_pitch, int begin, int end) const {
+	auto row_function = &HorizontalRowScalar;
+#ifdef SDL2PP_RESAMPLER_X86
+	if (isa_ != BlitKernels::Isa::Scalar)
+		row_function = &HorizontalRowSSE2;
+#endif
+
+	for (int y = begin; y < end; y++)
+		row_function(src + y * src_pitch, dst + y * dst_pitch, dst_w_, horizontal_.starts.data(), horizontal_.counts.data(), horizontal_.coefficients.data(), horizontal_.taps);
+}
+
+void Resampler::VerticalPass(const Uint8* src, int src_pitch, Uint8* dst, int dst_pitch, int begin, int end) const {
+	auto row_function = &VerticalRowScalar;
+#ifdef SDL2PP_RESAMPLER_X86
+	if (isa_ != BlitKernels::Isa::Scalar)
+		row_function = &VerticalRowSSE2;
+#endif
+
+	for (int y = begin; y < end; y++)
+		row_function(src + vertical_.starts[y] * src_pitch, src_pitch, dst + y * dst_pitch, dst_w_ * 4, vertical_.counts[y], vertical_.coefficients.data() + static_cast<size_t>(y) * vertical_.taps);
+}
+
+void Resampler::Resample(const void* src, int src_pitch, void* dst, int dst_pitch, ThreadPool* pool) {
+	const Uint8* src_pixels = static_cast<const Uint8*>(src);
+	Uint8* dst_pixels = static_cast<Uint8*>(dst);
+
+	auto run = [pool](int count, const ThreadPool::RangeFunction& function) {
+		if (pool)
+			pool->ParallelFor(0, count, MIN_ROWS_PER_TASK, function);
+		else
+			function(0, count);
+	};
+
+	// filters are exact identity when size does not change,
+	// so corresponding pass may be skipped
+	if (src_w_ == dst_w_ && src_h_ == dst_h_) {
+		for (int y = 0; y < dst_h_; y++)
+			std::memcpy(dst_pixels + y * dst_pitch, src_pixels + y * src_pitch, static_cast<size_t>(dst_w_) * 4);
+	} else if (src_h_ == dst_h_) {
+		run(dst_h_, [&](int begin, int end) {
+				HorizontalPass(src_pixels, src_pitch, dst_pixels, dst_pitch, begin, end);
+			});
+	} else if (src_w_ == dst_w_) {
+		run(dst_h_, [&](int begin, int end) {
+				VerticalPass(src_pixels, src_pitch, dst_pixels, dst_pitch, begin, end);
+			});
+	} else {
+		int intermediate_pitch = dst_w_ * 4;
+		intermediate_.resize(static_cast<size_t>(intermediate_pitch) * src_h_);
+
+		run(src_h_, [&](int begin, int end) {
+				HorizontalPass(src_pixels, src_pitch, intermediate_.data(), intermediate_pitch, begin, end);
+			});
+		run(dst_h_, [&](int begin, int end) {
+				VerticalPass(intermediate_.data(), intermediate_pitch, dst_pixels, dst_pitch, begin, end);
+			});
+	}
+}
+
+void Resampler::Resample(const void* src, int src_pitch, void* dst, int dst_pitch) {
+	Resample(src, src_pitch, dst, dst_pitch, nullptr);
+}
+
+void Resampler::Resample(const void* src, int src_pitch, void* dst, int dst_pitch, ThreadPool& pool) {
+	Resample(src, src_pitch, dst, dst_pitch, &pool);
+}
+
+int Resampler::GetSrcWidth() const {
+	return src_w_;
+}
+
+int Resampler::GetSrcHeight() const {
+	return src_h_;
+}
+
+int Resampler::GetDstWidth() const {
+	return dst_w_;
+}
+
+int Resampler::GetDstHeight() const {
+	return dst_h_;
+}
+
+ResizeFilter Resampler::GetFilter() const {
+	return filter_;
+}
+
+}
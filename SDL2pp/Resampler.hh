@@ -0,0 +1,211 @@
+/*
+  libSDL2pp - C++11 bindings/wrapper for SDL2
+  Copyright (C) 2013-2016 Dmitry Marakasov <amdmi3@amdmi3.ru>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef SDL2PP_RESAMPLER_HH
+#define SDL2PP_RESAMPLER_HH
+
+#include <vector>
+
+#include <SDL_stdinc.h>
+
+#include <SDL2pp/BlitKernels.hh>
+#include <SDL2pp/Surface.hh>
+#include <SDL2pp/Export.hh>
+
+namespace SDL2pp {
+
+class ThreadPool;
+
+////////////////////////////////////////////////////////////
+/// \brief Filtered image scaler for 32 bit pixels
+///
+/// \ingroup graphics
+///
+/// \headerfile SDL2pp/Resampler.hh
+///
+/// Scales images of 32 bit pixels with four 8 bit channels
+/// (such as SDL_PIXELFORMAT_ARGB8888) in two separable passes,
+/// horizontal then vertical, processing each channel
+/// independently. Filter weights for given pair of sizes are
+/// computed once on construction, and buffer for intermediate
+/// rows is allocated on first use and kept, so a single
+/// Resampler may be reused for scaling any number of same-sized
+/// images without allocating memory. As it keeps that buffer,
+/// Resampler must not be used from several threads at once;
+/// use the ThreadPool overload of Resample() instead.
+///
+/// Weights are applied in 14 bit fixed point. SSE2 inner loops
+/// are picked at runtime based on CPU features, with scalar
+/// fallback producing identical output.
+///
+/// SDL2pp::Surface::Resize() is a convenience wrapper around
+/// this class.
+///
+/// Usage example:
+/// \code
+/// {
+///     SDL2pp::Resampler resampler(1920, 1080, 480, 270, SDL2pp::ResizeFilter::Bicubic);
+///
+///     while (...) {
+///         // decode frame
+///         resampler.Resample(frame_pixels, frame_pitch, thumbnail_pixels, thumbnail_pitch);
+///     }
+/// }
+/// \endcode
+///
+////////////////////////////////////////////////////////////
+class SDL2PP_EXPORT Resampler {
+private:
+	////////////////////////////////////////////////////////////
+	/// \brief Filter weights for a single dimension
+	///
+	////////////////////////////////////////////////////////////
+	struct Axis {
+		int taps;                          ///< Maximal number of source pixels per output pixel
+		std::vector<int> starts;           ///< First source pixel for each output pixel
+		std::vector<int> counts;           ///< Number of source pixels for each output pixel
+		std::vector<Sint16> coefficients;  ///< Fixed point weights, taps per output pixel
+	};
+
+private:
+	int src_w_;            ///< Source image width
+	int src_h_;            ///< Source image height
+	int dst_w_;            ///< Destination image width
+	int dst_h_;            ///< Destination image height
+	ResizeFilter filter_;  ///< Filter used
+	BlitKernels::Isa isa_; ///< Instruction set used
+	Axis horizontal_;      ///< Weights for horizontal pass
+	Axis vertical_;        ///< Weights for vertical pass
+
+	std::vector<Uint8> intermediate_; ///< Horizontally scaled rows, if both passes are needed
+
+private:
+	////////////////////////////////////////////////////////////
+	/// \brief Compute filter weights for a single dimension
+	///
+	////////////////////////////////////////////////////////////
+	static void ComputeAxis(Axis& axis, int in_size, int out_size, ResizeFilter filter);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Scale [begin, end) rows horizontally
+	///
+	////////////////////////////////////////////////////////////
+	void HorizontalPass(const Uint8* src, int src_pitch, Uint8* dst, int dst_pitch, int begin, int end) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Produce [begin, end) output rows from horizontally
+	///        scaled source rows
+	///
+	////////////////////////////////////////////////////////////
+	void VerticalPass(const Uint8* src, int src_pitch, Uint8* dst, int dst_pitch, int begin, int end) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Perform resampling, optionally using thread pool
+	///
+	////////////////////////////////////////////////////////////
+	void Resample(const void* src, int src_pitch, void* dst, int dst_pitch, ThreadPool* pool);
+
+public:
+	////////////////////////////////////////////////////////////
+	/// \brief Prepare resampling between given sizes
+	///
+	/// \param[in] src_w Source image width
+	/// \param[in] src_h Source image height
+	/// \param[in] dst_w Destination image width
+	/// \param[in] dst_h Destination image height
+	/// \param[in] filter Filter to use
+	/// \param[in] isa Instruction set to use; must be supported
+	///                (see SDL2pp::BlitKernels::IsIsaSupported())
+	///
+	/// \throws std::invalid_argument if any size is not positive
+	///
+	////////////////////////////////////////////////////////////
+	Resampler(int src_w, int src_h, int dst_w, int dst_h, ResizeFilter filter, BlitKernels::Isa isa = BlitKernels::GetBestIsa());
+
+	////////////////////////////////////////////////////////////
+	/// \brief Scale image
+	///
+	/// \param[in] src Source pixels, src_w by src_h
+	/// \param[in] src_pitch Length of source row in bytes
+	/// \param[out] dst Destination pixels, dst_w by dst_h
+	/// \param[in] dst_pitch Length of destination row in bytes
+	///
+	////////////////////////////////////////////////////////////
+	void Resample(const void* src, int src_pitch, void* dst, int dst_pitch);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Scale image, splitting rows between threads of the pool
+	///
+	/// Result is identical to single threaded Resample()
+	///
+	/// \param[in] src Source pixels, src_w by src_h
+	/// \param[in] src_pitch Length of source row in bytes
+	/// \param[out] dst Destination pixels, dst_w by dst_h
+	/// \param[in] dst_pitch Length of destination row in bytes
+	/// \param[in] pool Thread pool to use
+	///
+	////////////////////////////////////////////////////////////
+	void Resample(const void* src, int src_pitch, void* dst, int dst_pitch, ThreadPool& pool);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get source image width
+	///
+	/// \returns Source image width
+	///
+	////////////////////////////////////////////////////////////
+	int GetSrcWidth() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get source image height
+	///
+	/// \returns Source image height
+	///
+	////////////////////////////////////////////////////////////
+	int GetSrcHeight() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get destination image width
+	///
+	/// \returns Destination image width
+	///
+	////////////////////////////////////////////////////////////
+	int GetDstWidth() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get destination image height
+	///
+	/// \returns Destination image height
+	///
+	////////////////////////////////////////////////////////////
+	int GetDstHeight() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get filter used
+	///
+	/// \returns Filter used
+	///
+	////////////////////////////////////////////////////////////
+	ResizeFilter GetFilter() const;
+};
+
+}
+
+#endif
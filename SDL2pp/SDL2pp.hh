@@ -34,6 +34,7 @@
 #include <SDL2pp/SDL.hh>
 #include <SDL2pp/Exception.hh>
 #include <SDL2pp/Optional.hh>
+#include <SDL2pp/ThreadPool.hh>
 
 ////////////////////////////////////////////////////////////
 /// \defgroup audio Audio
@@ -72,7 +73,19 @@
 ////////////////////////////////////////////////////////////
 #include <SDL2pp/Renderer.hh>
 #include <SDL2pp/Surface.hh>
+#include <SDL2pp/BlitKernels.hh>
+#include <SDL2pp/Resampler.hh>
+#include <SDL2pp/PremultipliedAlpha.hh>
+#include <SDL2pp/SurfaceCanvas.hh>
+#include <SDL2pp/SurfacePool.hh>
+#include <SDL2pp/PixelView.hh>
 #include <SDL2pp/Texture.hh>
+#include <SDL2pp/TextureCache.hh>
+#include <SDL2pp/StreamingTextureRing.hh>
+#include <SDL2pp/YUVFrame.hh>
+#include <SDL2pp/YUVFramePool.hh>
+#include <SDL2pp/AsyncLoader.hh>
+#include <SDL2pp/Atlas.hh>
 #include <SDL2pp/Color.hh>
 
 ////////////////////////////////////////////////////////////
@@ -85,6 +98,7 @@
 ////////////////////////////////////////////////////////////
 #include <SDL2pp/Rect.hh>
 #include <SDL2pp/Point.hh>
+#include <SDL2pp/RectPacker.hh>
 
 ////////////////////////////////////////////////////////////
 /// \defgroup io I/O abstraction
@@ -105,7 +119,14 @@
 ///
 ////////////////////////////////////////////////////////////
 #	include <SDL2pp/SDLTTF.hh>
+#	include <SDL2pp/DistanceFieldCache.hh>
 #	include <SDL2pp/Font.hh>
+#	include <SDL2pp/FontFace.hh>
+#	include <SDL2pp/FontRegistry.hh>
+#	include <SDL2pp/GlyphCache.hh>
+#	include <SDL2pp/TextCache.hh>
+#	include <SDL2pp/TextLayout.hh>
+#	include <SDL2pp/UTF8.hh>
 #endif
 
 #ifdef SDL2PP_WITH_IMAGE
@@ -0,0 +1,92 @@
+/*
+  libSDL2pp - C++11 bindings/wrapper for SDL2
+  Copyright (C) 2013-2016 Dmitry Marakasov <amdmi3@amdmi3.ru>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include <stdexcept>
+
+#include <SDL_render.h>
+
+#include <SDL2pp/StreamingTextureRing.hh>
+#include <SDL2pp/Renderer.hh>
+
+namespace SDL2pp {
+
+StreamingTextureRing::StreamingTextureRing(Renderer& renderer, Uint32 format, int w, int h, size_t count) : next_(0) {
+	if (count < 2)
+		throw std::invalid_argument("streaming texture ring needs at least 2 textures");
+
+	textures_.reserve(count);
+	for (size_t i = 0; i < count; i++)
+		textures_.emplace_back(renderer, format, SDL_TEXTUREACCESS_STREAMING, w, h);
+}
+
+StreamingTextureRing::StreamingTextureRing(Renderer& renderer, Uint32 format, const Point& size, size_t count) : StreamingTextureRing(renderer, format, size.x, size.y, count) {
+}
+
+Texture::LockHandle StreamingTextureRing::Lock(const Optional<Rect>& rect) {
+	return textures_[next_].Lock(rect);
+}
+
+StreamingTextureRing& StreamingTextureRing::Update(const void* pixels, int pitch) {
+	textures_[next_].Update(NullOpt, pixels, pitch);
+	return Commit();
+}
+
+StreamingTextureRing& StreamingTextureRing::Commit() {
+	current_ = next_;
+	next_ = (next_ + 1) % textures_.size();
+	return *this;
+}
+
+bool StreamingTextureRing::HasCurrent() const {
+	return !!current_;
+}
+
+Texture& StreamingTextureRing::GetCurrent() {
+	if (!current_)
+		throw std::logic_error("no texture in streaming texture ring was completed yet");
+	return textures_[*current_];
+}
+
+Texture& StreamingTextureRing::GetNext() {
+	return textures_[next_];
+}
+
+Texture& StreamingTextureRing::GetTexture(size_t index) {
+	return textures_[index];
+}
+
+size_t StreamingTextureRing::GetNumTextures() const {
+	return textures_.size();
+}
+
+int StreamingTextureRing::GetWidth() const {
+	return textures_.front().GetWidth();
+}
+
+int StreamingTextureRing::GetHeight() const {
+	return textures_.front().GetHeight();
+}
+
+Point StreamingTextureRing::GetSize() const {
+	return textures_.front().GetSize();
+}
+
+}
@@ -0,0 +1,245 @@
+/*
+  libSDL2pp - C++11 bindings/wrapper for SDL2
+  Copyright (C) 2013-2016 Dmitry Marakasov <amdmi3@amdmi3.ru>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef SDL2PP_STREAMINGTEXTURERING_HH
+#define SDL2PP_STREAMINGTEXTURERING_HH
+
+#include <vector>
+
+#include <SDL_stdinc.h>
+
+#include <SDL2pp/Optional.hh>
+#include <SDL2pp/Point.hh>
+#include <SDL2pp/Rect.hh>
+#include <SDL2pp/Texture.hh>
+#include <SDL2pp/Export.hh>
+
+namespace SDL2pp {
+
+class Renderer;
+
+////////////////////////////////////////////////////////////
+/// \brief Ring of streaming textures for per-frame uploads
+///
+/// \ingroup rendering
+///
+/// \headerfile SDL2pp/StreamingTextureRing.hh
+///
+/// Updating single streaming texture every frame may stall
+/// on some drivers until GPU has finished reading previous
+/// texture contents. This class rotates through several
+/// same-sized streaming textures instead, so new data is
+/// always written into a texture other than one most recently
+/// completed, which is the one being drawn.
+///
+/// Usage example:
+/// \code
+/// {
+///     SDL2pp::StreamingTextureRing ring(renderer, SDL_PIXELFORMAT_ARGB8888, 320, 240);
+///
+///     while (...) {
+///         {
+///             SDL2pp::Texture::LockHandle lock = ring.Lock();
+///             // fill lock.GetPixels()
+///         }
+///         ring.Commit();
+///
+///         renderer.Copy(ring.GetCurrent());
+///     }
+/// }
+/// \endcode
+///
+////////////////////////////////////////////////////////////
+class SDL2PP_EXPORT StreamingTextureRing {
+private:
+	std::vector<Texture> textures_; ///< Textures in the ring
+	size_t next_;                   ///< Index of texture to be written next
+	Optional<size_t> current_;      ///< Index of most recently completed texture
+
+public:
+	////////////////////////////////////////////////////////////
+	/// \brief Create ring of streaming textures
+	///
+	/// \param[in] renderer Rendering context to create textures for
+	/// \param[in] format One of the enumerated values in SDL_PixelFormatEnum
+	/// \param[in] w Width of the textures
+	/// \param[in] h Height of the textures
+	/// \param[in] count Number of textures in the ring
+	///
+	/// \throws SDL2pp::Exception
+	/// \throws std::invalid_argument if count is less than 2
+	///
+	/// \see http://wiki.libsdl.org/SDL_CreateTexture
+	///
+	////////////////////////////////////////////////////////////
+	StreamingTextureRing(Renderer& renderer, Uint32 format, int w, int h, size_t count = 3);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Create ring of streaming textures
+	///
+	/// \param[in] renderer Rendering context to create textures for
+	/// \param[in] format One of the enumerated values in SDL_PixelFormatEnum
+	/// \param[in] size Size of the textures
+	/// \param[in] count Number of textures in the ring
+	///
+	/// \throws SDL2pp::Exception
+	/// \throws std::invalid_argument if count is less than 2
+	///
+	/// \see http://wiki.libsdl.org/SDL_CreateTexture
+	///
+	////////////////////////////////////////////////////////////
+	StreamingTextureRing(Renderer& renderer, Uint32 format, const Point& size, size_t count = 3);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Deleted copy constructor
+	///
+	/// This class is not copyable
+	///
+	////////////////////////////////////////////////////////////
+	StreamingTextureRing(const StreamingTextureRing& other) = delete;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Deleted assignment operator
+	///
+	/// This class is not copyable
+	///
+	////////////////////////////////////////////////////////////
+	StreamingTextureRing& operator=(const StreamingTextureRing& other) = delete;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Lock texture to be written next
+	///
+	/// Written data becomes current after the lock is released
+	/// and Commit() is called.
+	///
+	/// \param[in] rect Specifies region to lock
+	///
+	/// \returns Lock handle used to access pixel data
+	///
+	/// \throws SDL2pp::Exception
+	///
+	/// \see http://wiki.libsdl.org/SDL_LockTexture
+	///
+	////////////////////////////////////////////////////////////
+	Texture::LockHandle Lock(const Optional<Rect>& rect = NullOpt);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Update texture to be written next and commit it
+	///
+	/// \param[in] pixels Raw pixel data
+	/// \param[in] pitch Number of bytes in a row of pixel data,
+	///                  including padding between lines
+	///
+	/// \returns Reference to self
+	///
+	/// \throws SDL2pp::Exception
+	///
+	/// \see http://wiki.libsdl.org/SDL_UpdateTexture
+	///
+	////////////////////////////////////////////////////////////
+	StreamingTextureRing& Update(const void* pixels, int pitch);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Mark texture written next as completed
+	///
+	/// It becomes current, and writing moves to the following
+	/// texture in the ring.
+	///
+	/// \returns Reference to self
+	///
+	////////////////////////////////////////////////////////////
+	StreamingTextureRing& Commit();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Check whether any texture was completed yet
+	///
+	/// \returns True if Commit() was called at least once
+	///
+	////////////////////////////////////////////////////////////
+	bool HasCurrent() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get most recently completed texture
+	///
+	/// \returns Reference to texture to draw
+	///
+	/// \throws std::logic_error if no texture was completed yet
+	///
+	////////////////////////////////////////////////////////////
+	Texture& GetCurrent();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get texture to be written next
+	///
+	/// \returns Reference to texture to write to
+	///
+	////////////////////////////////////////////////////////////
+	Texture& GetNext();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get texture from the ring by index
+	///
+	/// Useful to apply blend mode or color modulation to all
+	/// textures.
+	///
+	/// \param[in] index Index of texture
+	///
+	/// \returns Reference to texture
+	///
+	////////////////////////////////////////////////////////////
+	Texture& GetTexture(size_t index);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get number of textures in the ring
+	///
+	/// \returns Number of textures
+	///
+	////////////////////////////////////////////////////////////
+	size_t GetNumTextures() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get width of the textures
+	///
+	/// \returns Texture width in pixels
+	///
+	////////////////////////////////////////////////////////////
+	int GetWidth() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get height of the textures
+	///
+	/// \returns Texture height in pixels
+	///
+	////////////////////////////////////////////////////////////
+	int GetHeight() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get size of the textures
+	///
+	/// \returns Texture size in pixels
+	///
+	////////////////////////////////////////////////////////////
+	Point GetSize() const;
+};
+
+}
+
+#endif
@@ -21,6 +21,7 @@
 
 #include <vector>
 #include <cassert>
+#include <stdexcept>
 
 #include <SDL2pp/Config.hh>
 
@@ -30,6 +31,10 @@
 #endif
 
 #include <SDL2pp/Surface.hh>
+#include <SDL2pp/BlitKernels.hh>
+#include <SDL2pp/PremultipliedAlpha.hh>
+#include <SDL2pp/Resampler.hh>
+#include <SDL2pp/ThreadPool.hh>
 #include <SDL2pp/Exception.hh>
 #ifdef SDL2PP_WITH_IMAGE
 #	include <SDL2pp/RWops.hh>
@@ -100,12 +105,211 @@ Surface Surface::Convert(Uint32 pixel_format) {
 	return SDL2pp::Surface(surface);
 }
 
+Surface Surface::Convert(Uint32 pixel_format, ThreadPool& pool, int min_rows_per_task) {
+	Uint32 src_format = surface_->format->format;
+
+	// palettes, color keys and RLE need full SDL_ConvertSurface
+	// machinery, as well as surfaces too small to split
+	Uint32 colorkey;
+	if (SDL_ISPIXELFORMAT_INDEXED(src_format) || SDL_ISPIXELFORMAT_INDEXED(pixel_format) ||
+			SDL_ISPIXELFORMAT_FOURCC(src_format) || SDL_ISPIXELFORMAT_FOURCC(pixel_format) ||
+			(surface_->flags & SDL_RLEACCEL) || SDL_GetColorKey(surface_, &colorkey) == 0 ||
+			pool.GetConcurrency() < 2 || surface_->h < min_rows_per_task * 2)
+		return Convert(pixel_format);
+
+	int bpp;
+	Uint32 rmask, gmask, bmask, amask;
+	if (!SDL_PixelFormatEnumToMasks(pixel_format, &bpp, &rmask, &gmask, &bmask, &amask))
+		throw Exception("SDL_PixelFormatEnumToMasks");
+
+	Surface converted(0, surface_->w, surface_->h, bpp, rmask, gmask, bmask, amask);
+
+	{
+		LockHandle src_lock = Lock();
+		LockHandle dst_lock = converted.Lock();
+
+		const Uint8* src_pixels = static_cast<const Uint8*>(src_lock.GetPixels());
+		Uint8* dst_pixels = static_cast<Uint8*>(dst_lock.GetPixels());
+		int src_pitch = src_lock.GetPitch();
+		int dst_pitch = dst_lock.GetPitch();
+		int width = surface_->w;
+
+		pool.ParallelFor(0, surface_->h, min_rows_per_task, [=](int begin, int end) {
+				if (SDL_ConvertPixels(width, end - begin, src_format, src_pixels + begin * src_pitch, src_pitch, pixel_format, dst_pixels + begin * dst_pitch, dst_pitch) != 0)
+					throw Exception("SDL_ConvertPixels");
+			});
+	}
+
+	// replicate surface properties set by SDL_ConvertSurface
+	Uint8 r, g, b, alpha;
+	SDL_BlendMode blend_mode;
+	GetColorMod(r, g, b);
+	alpha = GetAlphaMod();
+	blend_mode = GetBlendMode();
+
+	converted.SetColorMod(r, g, b);
+	converted.SetAlphaMod(alpha);
+
+	if ((surface_->format->Amask && amask) || alpha != 255)
+		converted.SetBlendMode(SDL_BLENDMODE_BLEND);
+	else if (blend_mode == SDL_BLENDMODE_ADD || blend_mode == SDL_BLENDMODE_MOD)
+		converted.SetBlendMode(blend_mode);
+	else
+		converted.SetBlendMode(SDL_BLENDMODE_NONE);
+
+	return converted;
+}
+
+namespace {
+
+bool HasByteChannels(const SDL_PixelFormat* format) {
+	if (format->BitsPerPixel != 32 || SDL_ISPIXELFORMAT_INDEXED(format->format) || SDL_ISPIXELFORMAT_FOURCC(format->format))
+		return false;
+
+	const Uint32 masks[] = { format->Rmask, format->Gmask, format->Bmask, format->Amask };
+	for (Uint32 mask : masks)
+		if (mask != 0 && mask != 0x000000ff && mask != 0x0000ff00 && mask != 0x00ff0000 && mask != 0xff000000)
+			return false;
+
+	return true;
+}
+
+void ResizeSurface(Surface& src, Surface& dst, ResizeFilter filter, ThreadPool* pool) {
+	Resampler resampler(src.GetWidth(), src.GetHeight(), dst.GetWidth(), dst.GetHeight(), filter);
+
+	// resampler works on 8 bit channels, other formats
+	// are converted to and from ARGB8888
+	Optional<Surface> converted_src;
+	Surface* input = &src;
+	if (!HasByteChannels(src.Get()->format)) {
+		converted_src.emplace(src.Convert(SDL_PIXELFORMAT_ARGB8888));
+		input = &*converted_src;
+	}
+
+	Optional<Surface> converted_dst;
+	Surface* output = &dst;
+	if (dst.GetFormat() != input->GetFormat()) {
+		const SDL_PixelFormat* format = input->Get()->format;
+		converted_dst.emplace(0, dst.GetWidth(), dst.GetHeight(), 32, format->Rmask, format->Gmask, format->Bmask, format->Amask);
+		output = &*converted_dst;
+	}
+
+	{
+		Surface::LockHandle src_lock = input->Lock();
+		Surface::LockHandle dst_lock = output->Lock();
+
+		if (pool)
+			resampler.Resample(src_lock.GetPixels(), src_lock.GetPitch(), dst_lock.GetPixels(), dst_lock.GetPitch(), *pool);
+		else
+			resampler.Resample(src_lock.GetPixels(), src_lock.GetPitch(), dst_lock.GetPixels(), dst_lock.GetPitch());
+	}
+
+	if (converted_dst) {
+		// SDL_LowerBlit skips clipping against dst clip rect
+		SDL_Rect rect = { 0, 0, dst.GetWidth(), dst.GetHeight() };
+		converted_dst->SetBlendMode(SDL_BLENDMODE_NONE);
+		if (SDL_LowerBlit(converted_dst->Get(), &rect, dst.Get(), &rect) != 0)
+			throw Exception("SDL_LowerBlit");
+	}
+}
+
+Surface ResizeToNewSurface(Surface& src, int w, int h, ResizeFilter filter, ThreadPool* pool) {
+	if (w <= 0 || h <= 0)
+		throw std::invalid_argument("surface size must be positive");
+
+	const SDL_PixelFormat* format = src.Get()->format;
+	Surface resized = SDL_ISPIXELFORMAT_INDEXED(format->format)
+		? Surface(0, w, h, 32, 0x00ff0000, 0x0000ff00, 0x000000ff, 0xff000000)
+		: Surface(0, w, h, format->BitsPerPixel, format->Rmask, format->Gmask, format->Bmask, format->Amask);
+
+	ResizeSurface(src, resized, filter, pool);
+
+	Uint8 r, g, b;
+	src.GetColorMod(r, g, b);
+	resized.SetColorMod(r, g, b);
+	resized.SetAlphaMod(src.GetAlphaMod());
+	resized.SetBlendMode(src.GetBlendMode());
+
+	return resized;
+}
+
+void ConvertAlpha(Surface& surface, bool premultiply) {
+	const SDL_PixelFormat* format = surface.Get()->format;
+	if (format->Amask == 0)
+		return;
+
+	Surface::LockHandle lock = surface.Lock();
+	Uint8* pixels = static_cast<Uint8*>(lock.GetPixels());
+	int pitch = lock.GetPitch();
+	int width = surface.GetWidth(), height = surface.GetHeight();
+
+	if (PremultipliedAlpha::IsFormatSupported(format->format)) {
+		if (premultiply)
+			PremultipliedAlpha::Premultiply(width, height, format->format, pixels, pitch, pixels, pitch);
+		else
+			PremultipliedAlpha::Unpremultiply(width, height, format->format, pixels, pitch, pixels, pitch);
+		return;
+	}
+
+	// other formats with alpha (such as ARGB4444) are
+	// processed through ARGB8888 row by row
+	std::vector<Uint8> row(static_cast<size_t>(width) * 4);
+	for (int y = 0; y < height; y++, pixels += pitch) {
+		if (SDL_ConvertPixels(width, 1, format->format, pixels, pitch, SDL_PIXELFORMAT_ARGB8888, row.data(), width * 4) != 0)
+			throw Exception("SDL_ConvertPixels");
+
+		if (premultiply)
+			PremultipliedAlpha::Premultiply(width, 1, SDL_PIXELFORMAT_ARGB8888, row.data(), width * 4, row.data(), width * 4);
+		else
+			PremultipliedAlpha::Unpremultiply(width, 1, SDL_PIXELFORMAT_ARGB8888, row.data(), width * 4, row.data(), width * 4);
+
+		if (SDL_ConvertPixels(width, 1, SDL_PIXELFORMAT_ARGB8888, row.data(), width * 4, format->format, pixels, pitch) != 0)
+			throw Exception("SDL_ConvertPixels");
+	}
+}
+
+}
+
+Surface Surface::Resize(int w, int h, ResizeFilter filter) {
+	return ResizeToNewSurface(*this, w, h, filter, nullptr);
+}
+
+Surface Surface::Resize(int w, int h, ResizeFilter filter, ThreadPool& pool) {
+	return ResizeToNewSurface(*this, w, h, filter, &pool);
+}
+
+void Surface::Resize(Surface& dst, ResizeFilter filter) {
+	ResizeSurface(*this, dst, filter, nullptr);
+}
+
+void Surface::Resize(Surface& dst, ResizeFilter filter, ThreadPool& pool) {
+	ResizeSurface(*this, dst, filter, &pool);
+}
+
+Surface& Surface::PremultiplyAlpha() {
+	ConvertAlpha(*this, true);
+	return *this;
+}
+
+Surface& Surface::UnpremultiplyAlpha() {
+	ConvertAlpha(*this, false);
+	return *this;
+}
+
 void Surface::Blit(const Optional<Rect>& srcrect, Surface& dst, const Rect& dstrect) {
 	SDL_Rect tmpdstrect = dstrect; // 4th argument is non-const; does it modify rect?
 	if (SDL_BlitSurface(surface_, srcrect ? &*srcrect : nullptr, dst.Get(), &tmpdstrect) != 0)
 		throw Exception("SDL_BlitSurface");
 }
 
+void Surface::BlitFast(const Optional<Rect>& srcrect, Surface& dst, const Rect& dstrect) {
+	SDL_Rect tmpdstrect = dstrect;
+	if (BlitKernels::Blit(surface_, srcrect ? &*srcrect : nullptr, dst.Get(), &tmpdstrect))
+		return;
+	if (SDL_BlitSurface(surface_, srcrect ? &*srcrect : nullptr, dst.Get(), &tmpdstrect) != 0)
+		throw Exception("SDL_BlitSurface");
+}
+
 void Surface::BlitScaled(const Optional<Rect>& srcrect, Surface& dst, const Optional<Rect>& dstrect) {
 	SDL_Rect tmpdstrect; // 4th argument is non-const; does it modify rect?
 	if (dstrect)
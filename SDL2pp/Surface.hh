@@ -38,6 +38,22 @@ struct SDL_PixelFormat;
 namespace SDL2pp {
 
 class RWops;
+class ThreadPool;
+
+////////////////////////////////////////////////////////////
+/// \brief Filter used for resampling images
+///
+/// \ingroup rendering
+///
+/// \see SDL2pp::Surface::Resize
+/// \see SDL2pp::Resampler
+///
+////////////////////////////////////////////////////////////
+enum class ResizeFilter {
+	Bilinear, ///< Triangle filter, support of 1 source pixel
+	Bicubic,  ///< Cubic convolution with a = -0.5, support of 2 source pixels
+	Lanczos3, ///< Lanczos windowed sinc, support of 3 source pixels
+};
 
 ////////////////////////////////////////////////////////////
 /// \brief Image stored in system memory with direct access
@@ -309,6 +325,139 @@ public:
 	////////////////////////////////////////////////////////////
 	Surface Convert(Uint32 pixel_format);
 
+	////////////////////////////////////////////////////////////
+	/// \brief Copy an existing surface to a new surface of the specified
+	///        format, converting pixels in parallel
+	///
+	/// Rows are split into bands converted on threads of the pool.
+	/// Result is identical to Convert(Uint32). Surfaces with palette,
+	/// color key or RLE acceleration, and surfaces with fewer than
+	/// 2 * min_rows_per_task rows are converted on the calling thread.
+	///
+	/// \param[in] pixel_format One of the enumerated values in SDL_PixelFormatEnum
+	/// \param[in] pool Thread pool to use
+	/// \param[in] min_rows_per_task Minimal number of rows converted by a single thread
+	///
+	/// \throws SDL2pp::Exception
+	///
+	/// \see http://wiki.libsdl.org/SDL_PixelFormatEnum
+	/// \see http://wiki.libsdl.org/SDL_ConvertPixels
+	///
+	////////////////////////////////////////////////////////////
+	Surface Convert(Uint32 pixel_format, ThreadPool& pool, int min_rows_per_task = 64);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Copy an existing surface to a new surface of different size
+	///
+	/// Unlike BlitScaled(), which uses nearest neighbour sampling,
+	/// this applies given filter to each pixel channel separately.
+	/// New surface has the same format, blend mode, color and alpha
+	/// modulation as this one; surfaces with palette are resized
+	/// into SDL_PIXELFORMAT_ARGB8888. Color key is not preserved.
+	///
+	/// \param[in] w Width of the new surface
+	/// \param[in] h Height of the new surface
+	/// \param[in] filter Filter to use
+	///
+	/// \throws SDL2pp::Exception
+	/// \throws std::invalid_argument if w or h is not positive
+	///
+	/// \see SDL2pp::Resampler
+	///
+	////////////////////////////////////////////////////////////
+	Surface Resize(int w, int h, ResizeFilter filter);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Copy an existing surface to a new surface of different
+	///        size, resampling in parallel
+	///
+	/// Result is identical to Resize(int, int, ResizeFilter).
+	///
+	/// \param[in] w Width of the new surface
+	/// \param[in] h Height of the new surface
+	/// \param[in] filter Filter to use
+	/// \param[in] pool Thread pool to use
+	///
+	/// \throws SDL2pp::Exception
+	/// \throws std::invalid_argument if w or h is not positive
+	///
+	/// \see SDL2pp::Resampler
+	///
+	////////////////////////////////////////////////////////////
+	Surface Resize(int w, int h, ResizeFilter filter, ThreadPool& pool);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Resample surface into existing surface
+	///
+	/// Whole contents of this surface is scaled to cover whole
+	/// dst, ignoring clip rectangles and blend modes. No surfaces
+	/// are allocated if both have the same 32 bit format with 8
+	/// bit channels (such as SDL_PIXELFORMAT_ARGB8888), but filter
+	/// weights and intermediate rows are still allocated on each
+	/// call. To scale many same-sized images without allocating,
+	/// use SDL2pp::Resampler directly.
+	///
+	/// \param[in] dst Surface to write resampled pixels into
+	/// \param[in] filter Filter to use
+	///
+	/// \throws SDL2pp::Exception
+	/// \throws std::invalid_argument if dst has zero size
+	///
+	/// \see SDL2pp::Resampler
+	///
+	////////////////////////////////////////////////////////////
+	void Resize(Surface& dst, ResizeFilter filter);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Resample surface into existing surface in parallel
+	///
+	/// Result is identical to Resize(Surface&, ResizeFilter).
+	///
+	/// \param[in] dst Surface to write resampled pixels into
+	/// \param[in] filter Filter to use
+	/// \param[in] pool Thread pool to use
+	///
+	/// \throws SDL2pp::Exception
+	/// \throws std::invalid_argument if dst has zero size
+	///
+	/// \see SDL2pp::Resampler
+	///
+	////////////////////////////////////////////////////////////
+	void Resize(Surface& dst, ResizeFilter filter, ThreadPool& pool);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Multiply color channels of all pixels by their alpha
+	///
+	/// Surfaces without alpha channel are left unchanged.
+	/// 32 bit formats with 8 bit channels are processed
+	/// directly with SIMD code, other formats go through
+	/// SDL_PIXELFORMAT_ARGB8888 row by row.
+	///
+	/// \returns Reference to self
+	///
+	/// \throws SDL2pp::Exception
+	///
+	/// \see SDL2pp::PremultipliedAlpha
+	///
+	////////////////////////////////////////////////////////////
+	Surface& PremultiplyAlpha();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Divide color channels of all pixels by their alpha
+	///
+	/// Reverses PremultiplyAlpha(), up to rounding errors. Fully
+	/// transparent pixels become black. Surfaces without alpha
+	/// channel are left unchanged.
+	///
+	/// \returns Reference to self
+	///
+	/// \throws SDL2pp::Exception
+	///
+	/// \see SDL2pp::PremultipliedAlpha
+	///
+	////////////////////////////////////////////////////////////
+	Surface& UnpremultiplyAlpha();
+
 	////////////////////////////////////////////////////////////
 	/// \brief Fast surface copy to a destination surface
 	///
@@ -323,6 +472,28 @@ public:
 	////////////////////////////////////////////////////////////
 	void Blit(const Optional<Rect>& srcrect, Surface& dst, const Rect& dstrect);
 
+	////////////////////////////////////////////////////////////
+	/// \brief Fast surface copy to a destination surface using
+	///        SIMD kernels where possible
+	///
+	/// Same as Blit(), but copying and alpha blending of ARGB8888
+	/// and ABGR8888 surfaces onto ARGB8888 surfaces is done with
+	/// SDL2pp::BlitKernels. Copies are exact, while alpha blended
+	/// pixels may differ from what SDL_BlitSurface produces by
+	/// up to 2 per channel, as SDL picks different blitters
+	/// depending on CPU and pixel formats.
+	///
+	/// \param[in] srcrect Rectangle to be copied, or NullOpt to copy the entire surface
+	/// \param[in] dst Blit target surface
+	/// \param[in] dstrect Rectangle that is copied into
+	///
+	/// \throws SDL2pp::Exception
+	///
+	/// \see http://wiki.libsdl.org/SDL_BlitSurface
+	///
+	////////////////////////////////////////////////////////////
+	void BlitFast(const Optional<Rect>& srcrect, Surface& dst, const Rect& dstrect);
+
 	////////////////////////////////////////////////////////////
 	/// \brief Scaled surface copy to a destination surface
 	///
@@ -332,6 +503,8 @@ public:
 	///
 	/// \throws SDL2pp::Exception
 	///
+	/// \see Resize() for filtered scaling
+	///
 	/// \see http://wiki.libsdl.org/SDL_BlitScaled
 	///
 	////////////////////////////////////////////////////////////
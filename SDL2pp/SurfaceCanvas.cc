@@ -0,0 +1,349 @@
+/*
+  libSDL2pp - C++11 bindings/wrapper for SDL2
+  Copyright (C) 2013-2016 Dmitry Marakasov <amdmi3@amdmi3.ru>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <utility>
+
+#include <SDL_surface.h>
+
+#include <SDL2pp/SurfaceCanvas.hh>
+#include <SDL2pp/BlitKernels.hh>
+#include <SDL2pp/Exception.hh>
+#include <SDL2pp/ThreadPool.hh>
+
+namespace SDL2pp {
+
+namespace {
+
+// surface sharing pixels and blit settings with src, but having
+// its own blit mapping
+Surface CreateSourceView(SDL_Surface* src) {
+	const SDL_PixelFormat* format = src->format;
+
+	Surface view(src->pixels, src->w, src->h, format->BitsPerPixel, src->pitch, format->Rmask, format->Gmask, format->Bmask, format->Amask);
+
+	if (format->palette != nullptr && SDL_SetSurfacePalette(view.Get(), format->palette) != 0)
+		throw Exception("SDL_SetSurfacePalette");
+
+	Uint32 colorkey;
+	if (SDL_GetColorKey(src, &colorkey) == 0 && SDL_SetColorKey(view.Get(), SDL_TRUE, colorkey) != 0)
+		throw Exception("SDL_SetColorKey");
+
+	Uint8 r, g, b, a;
+	SDL_BlendMode blend_mode;
+	if (SDL_GetSurfaceColorMod(src, &r, &g, &b) != 0 || SDL_SetSurfaceColorMod(view.Get(), r, g, b) != 0)
+		throw Exception("SDL_SetSurfaceColorMod");
+	if (SDL_GetSurfaceAlphaMod(src, &a) != 0 || SDL_SetSurfaceAlphaMod(view.Get(), a) != 0)
+		throw Exception("SDL_SetSurfaceAlphaMod");
+	if (SDL_GetSurfaceBlendMode(src, &blend_mode) != 0 || SDL_SetSurfaceBlendMode(view.Get(), blend_mode) != 0)
+		throw Exception("SDL_SetSurfaceBlendMode");
+
+	return view;
+}
+
+}
+
+SurfaceCanvas::SurfaceCanvas(Surface& target, int tile_size) : target_(target), tile_size_(tile_size), tile_views_pixels_(nullptr), tile_views_w_(0), tile_views_h_(0) {
+	if (tile_size <= 0)
+		throw std::invalid_argument("tile size must be positive");
+}
+
+SurfaceCanvas::~SurfaceCanvas() {
+}
+
+bool SurfaceCanvas::IsParallelizable(const Operation& operation) const {
+	SDL_Surface* target = target_.Get();
+
+	// tiles must start at byte boundary, and RLE surfaces have
+	// no pixels to share between tiles
+	if (target->format->BitsPerPixel < 8 || SDL_MUSTLOCK(target))
+		return false;
+
+	if (operation.src != nullptr && (operation.src == target || SDL_MUSTLOCK(operation.src)))
+		return false;
+
+	return true;
+}
+
+void SurfaceCanvas::RunSerial(const Operation& operation) {
+	SDL_Surface* target = target_.Get();
+
+	if (operation.src == nullptr) {
+		if (SDL_FillRect(target, &operation.dstrect, operation.color) != 0)
+			throw Exception("SDL_FillRect");
+	} else {
+		// same as Surface::BlitFast
+		SDL_Rect srcrect = operation.srcrect;
+		SDL_Rect dstrect = operation.dstrect;
+		if (BlitKernels::Blit(operation.src, &srcrect, target, &dstrect))
+			return;
+		if (SDL_BlitSurface(operation.src, &srcrect, target, &dstrect) != 0)
+			throw Exception("SDL_BlitSurface");
+	}
+}
+
+void SurfaceCanvas::UpdateTileViews() {
+	SDL_Surface* target = target_.Get();
+
+	if (!tile_views_.empty() && tile_views_pixels_ == target->pixels && tile_views_w_ == target->w && tile_views_h_ == target->h)
+		return;
+
+	tile_views_.clear();
+	tile_views_pixels_ = nullptr;
+
+	const SDL_PixelFormat* format = target->format;
+
+	for (int y = 0; y < target->h; y += tile_size_) {
+		for (int x = 0; x < target->w; x += tile_size_) {
+			Uint8* pixels = static_cast<Uint8*>(target->pixels) + y * target->pitch + x * format->BytesPerPixel;
+			tile_views_.emplace_back(pixels, std::min(tile_size_, target->w - x), std::min(tile_size_, target->h - y), format->BitsPerPixel, target->pitch, format->Rmask, format->Gmask, format->Bmask, format->Amask);
+
+			if (format->palette != nullptr && SDL_SetSurfacePalette(tile_views_.back().Get(), format->palette) != 0)
+				throw Exception("SDL_SetSurfacePalette");
+		}
+	}
+
+	tile_views_pixels_ = target->pixels;
+	tile_views_w_ = target->w;
+	tile_views_h_ = target->h;
+}
+
+void SurfaceCanvas::RunParallel(const Operation* begin, const Operation* end, ThreadPool& pool) {
+	struct TileItem {
+		const Operation* operation;
+		BlitKernels::RowKernel kernel;
+		int src_view; ///< Index of source view among ones of a thread, or -1
+	};
+
+	SDL_Surface* target = target_.Get();
+
+	UpdateTileViews();
+
+	int tiles_x = (target->w + tile_size_ - 1) / tile_size_;
+	std::vector<std::vector<TileItem>> tiles(tile_views_.size());
+
+	// SDL_BlitSurface caches blit mapping inside source surface,
+	// so unless blit kernel which touches no surface state may
+	// be used, each thread blits from its own view of source
+	// surface
+	std::vector<SDL_Surface*> view_sources;
+
+	for (const Operation* operation = begin; operation != end; ++operation) {
+		BlitKernels::RowKernel kernel = nullptr;
+		if (operation->src != nullptr)
+			kernel = BlitKernels::GetSurfaceKernel(operation->src, target);
+
+		int src_view = -1;
+		if (operation->src != nullptr && kernel == nullptr) {
+			src_view = static_cast<int>(view_sources.size());
+			view_sources.push_back(operation->src);
+		}
+
+		const SDL_Rect& rect = operation->dstrect;
+		for (int ty = rect.y / tile_size_; ty <= (rect.y + rect.h - 1) / tile_size_; ty++)
+			for (int tx = rect.x / tile_size_; tx <= (rect.x + rect.w - 1) / tile_size_; tx++)
+				tiles[ty * tiles_x + tx].push_back(TileItem{operation, kernel, src_view});
+	}
+
+	std::vector<int> active_tiles;
+	for (size_t tile = 0; tile < tiles.size(); tile++)
+		if (!tiles[tile].empty())
+			active_tiles.push_back(static_cast<int>(tile));
+
+	int num_threads = static_cast<int>(std::min<size_t>(pool.GetConcurrency(), active_tiles.size()));
+
+	// views are created here, as creating surfaces is not
+	// guaranteed to be thread safe
+	std::vector<Surface> src_views;
+	src_views.reserve(static_cast<size_t>(num_threads) * view_sources.size());
+	for (int thread = 0; thread < num_threads; thread++)
+		for (SDL_Surface* src : view_sources)
+			src_views.push_back(CreateSourceView(src));
+
+	auto rasterize_tile = [&](int tile, int thread) {
+		SDL_Surface* tile_view = tile_views_[tile].Get();
+
+		SDL_Rect tile_rect;
+		tile_rect.x = (tile % tiles_x) * tile_size_;
+		tile_rect.y = (tile / tiles_x) * tile_size_;
+		tile_rect.w = tile_view->w;
+		tile_rect.h = tile_view->h;
+
+		for (const auto& item : tiles[tile]) {
+			const Operation& operation = *item.operation;
+
+			SDL_Rect rect;
+			SDL_IntersectRect(&operation.dstrect, &tile_rect, &rect);
+
+			int srcx = operation.srcrect.x + rect.x - operation.dstrect.x;
+			int srcy = operation.srcrect.y + rect.y - operation.dstrect.y;
+
+			if (item.kernel != nullptr) {
+				const Uint8* srcrow = static_cast<const Uint8*>(operation.src->pixels) + srcy * operation.src->pitch + srcx * 4;
+				Uint8* dstrow = static_cast<Uint8*>(target->pixels) + rect.y * target->pitch + rect.x * 4;
+
+				for (int y = 0; y < rect.h; y++) {
+					item.kernel(reinterpret_cast<const Uint32*>(srcrow), reinterpret_cast<Uint32*>(dstrow), rect.w);
+					srcrow += operation.src->pitch;
+					dstrow += target->pitch;
+				}
+				continue;
+			}
+
+			SDL_Rect dstrect = rect;
+			dstrect.x -= tile_rect.x;
+			dstrect.y -= tile_rect.y;
+
+			if (item.src_view == -1) {
+				if (SDL_FillRect(tile_view, &dstrect, operation.color) != 0)
+					throw Exception("SDL_FillRect");
+			} else {
+				SDL_Surface* src_view = src_views[static_cast<size_t>(thread) * view_sources.size() + static_cast<size_t>(item.src_view)].Get();
+				SDL_Rect srcrect = { srcx, srcy, rect.w, rect.h };
+				if (SDL_BlitSurface(src_view, &srcrect, tile_view, &dstrect) != 0)
+					throw Exception("SDL_BlitSurface");
+			}
+		}
+	};
+
+	// tiles differ in amount of work, so instead of splitting
+	// them into fixed ranges, each participating thread keeps
+	// picking next unprocessed tile until none are left; first
+	// item of its chunk identifies the thread, as chunks are
+	// processed by one thread each
+	std::atomic<size_t> next_tile(0);
+
+	pool.ParallelFor(0, num_threads, 1, [&](int thread, int) {
+			size_t index;
+			while ((index = next_tile++) < active_tiles.size())
+				rasterize_tile(active_tiles[index], thread);
+		});
+}
+
+SurfaceCanvas& SurfaceCanvas::FillRect(const Optional<Rect>& rect, Uint32 color) {
+	SDL_Surface* target = target_.Get();
+
+	Operation operation;
+	operation.src = nullptr;
+	operation.color = color;
+
+	// same as SDL_FillRect
+	if (rect) {
+		SDL_Rect tmprect = *rect;
+		if (!SDL_IntersectRect(&tmprect, &target->clip_rect, &operation.dstrect))
+			return *this;
+	} else {
+		operation.dstrect = target->clip_rect;
+		if (operation.dstrect.w <= 0 || operation.dstrect.h <= 0)
+			return *this;
+	}
+
+	operations_.push_back(operation);
+	return *this;
+}
+
+SurfaceCanvas& SurfaceCanvas::FillRects(const Rect* rects, int count, Uint32 color) {
+	for (int i = 0; i < count; i++)
+		FillRect(rects[i], color);
+	return *this;
+}
+
+SurfaceCanvas& SurfaceCanvas::Blit(Surface& src, const Optional<Rect>& srcrect, const Rect& dstrect) {
+	Operation operation;
+	operation.src = src.Get();
+	operation.color = 0;
+	operation.dstrect = dstrect;
+
+	SDL_Rect tmpsrcrect;
+	if (srcrect)
+		tmpsrcrect = *srcrect;
+
+	if (!BlitKernels::ClipBlit(operation.src, srcrect ? &tmpsrcrect : nullptr, target_.Get(), &operation.dstrect, &operation.srcrect))
+		return *this;
+
+	operations_.push_back(operation);
+	return *this;
+}
+
+SurfaceCanvas& SurfaceCanvas::Flush(ThreadPool& pool) {
+	std::vector<Operation> operations;
+	operations.swap(operations_);
+
+	if (operations.empty())
+		return *this;
+
+	SDL_Surface* target = target_.Get();
+	bool parallel = pool.GetConcurrency() > 1;
+
+	// operations are already clipped against clip rectangles
+	// in effect at the time they were recorded
+	SDL_Rect cliprect;
+	SDL_GetClipRect(target, &cliprect);
+	SDL_SetClipRect(target, nullptr);
+
+	try {
+		const Operation* begin = operations.data();
+		const Operation* end = begin + operations.size();
+
+		while (begin != end) {
+			const Operation* batch_end = begin;
+			while (parallel && batch_end != end && IsParallelizable(*batch_end))
+				++batch_end;
+
+			if (batch_end != begin) {
+				RunParallel(begin, batch_end, pool);
+			} else {
+				RunSerial(*begin);
+				++batch_end;
+			}
+
+			begin = batch_end;
+		}
+	} catch (...) {
+		SDL_SetClipRect(target, &cliprect);
+		throw;
+	}
+
+	SDL_SetClipRect(target, &cliprect);
+
+	return *this;
+}
+
+SurfaceCanvas& SurfaceCanvas::Clear() {
+	operations_.clear();
+	return *this;
+}
+
+size_t SurfaceCanvas::GetNumPending() const {
+	return operations_.size();
+}
+
+Surface& SurfaceCanvas::GetTarget() const {
+	return target_;
+}
+
+int SurfaceCanvas::GetTileSize() const {
+	return tile_size_;
+}
+
+}
@@ -0,0 +1,259 @@
+/*
+  libSDL2pp - C++11 bindings/wrapper for SDL2
+  Copyright (C) 2013-2016 Dmitry Marakasov <amdmi3@amdmi3.ru>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef SDL2PP_SURFACECANVAS_HH
+#define SDL2PP_SURFACECANVAS_HH
+
+#include <vector>
+
+#include <SDL_stdinc.h>
+#include <SDL_rect.h>
+
+#include <SDL2pp/Optional.hh>
+#include <SDL2pp/Rect.hh>
+#include <SDL2pp/Surface.hh>
+#include <SDL2pp/Export.hh>
+
+struct SDL_Surface;
+
+namespace SDL2pp {
+
+class ThreadPool;
+
+////////////////////////////////////////////////////////////
+/// \brief Deferred parallel drawing onto SDL2pp::Surface
+///
+/// \ingroup rendering
+///
+/// \headerfile SDL2pp/SurfaceCanvas.hh
+///
+/// Records fill and blit operations targeting a surface and
+/// performs them on Flush(). Target is split into square tiles,
+/// each tile receives operations overlapping it, and tiles are
+/// rasterized in parallel using SDL2pp::ThreadPool, each one
+/// applying its operations in the order they were recorded.
+/// As fills and blits only touch pixels they cover, result is
+/// identical to performing the operations one by one with
+/// Surface::FillRect() and Surface::BlitFast().
+///
+/// Operations are clipped to the target clip rectangle in effect
+/// when they are recorded. Pixels and properties (blend mode,
+/// color and alpha modulation, color key) of source surfaces
+/// are read at Flush() time, so source surfaces must stay alive
+/// and unchanged until then, and target surface must not be
+/// used directly before pending operations are flushed.
+///
+/// Usage example:
+/// \code
+/// {
+///     SDL2pp::ThreadPool pool;
+///     SDL2pp::SurfaceCanvas canvas(framebuffer);
+///
+///     canvas.FillRect(SDL2pp::NullOpt, background);
+///     for (auto& sprite : sprites)
+///         canvas.Blit(sprite.surface, SDL2pp::NullOpt, sprite.rect);
+///
+///     canvas.Flush(pool);
+/// }
+/// \endcode
+///
+////////////////////////////////////////////////////////////
+class SDL2PP_EXPORT SurfaceCanvas {
+private:
+	////////////////////////////////////////////////////////////
+	/// \brief Recorded operation
+	///
+	////////////////////////////////////////////////////////////
+	struct Operation {
+		SDL_Surface* src;  ///< Source surface for blit, nullptr for fill
+		SDL_Rect srcrect;  ///< Clipped source rectangle (blit only)
+		SDL_Rect dstrect;  ///< Clipped destination rectangle
+		Uint32 color;      ///< Fill color (fill only)
+	};
+
+private:
+	Surface& target_;                   ///< Surface operations are applied to
+	int tile_size_;                     ///< Width and height of a tile
+	std::vector<Operation> operations_; ///< Pending operations
+
+	std::vector<Surface> tile_views_;   ///< Surfaces sharing pixels with target, one per tile
+	void* tile_views_pixels_;           ///< Target pixels tile views were created for
+	int tile_views_w_;                  ///< Target width tile views were created for
+	int tile_views_h_;                  ///< Target height tile views were created for
+
+private:
+	////////////////////////////////////////////////////////////
+	/// \brief Check whether operation may be run on tiles in parallel
+	///
+	////////////////////////////////////////////////////////////
+	bool IsParallelizable(const Operation& operation) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Perform operation directly on target surface
+	///
+	////////////////////////////////////////////////////////////
+	void RunSerial(const Operation& operation);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Perform range of operations tile by tile in parallel
+	///
+	////////////////////////////////////////////////////////////
+	void RunParallel(const Operation* begin, const Operation* end, ThreadPool& pool);
+
+	////////////////////////////////////////////////////////////
+	/// \brief (Re)create tile views if target has changed
+	///
+	////////////////////////////////////////////////////////////
+	void UpdateTileViews();
+
+public:
+	////////////////////////////////////////////////////////////
+	/// \brief Create canvas for given surface
+	///
+	/// \param[in] target Surface to draw on
+	/// \param[in] tile_size Width and height of a tile in pixels
+	///
+	/// \throws std::invalid_argument if tile_size is not positive
+	///
+	////////////////////////////////////////////////////////////
+	SurfaceCanvas(Surface& target, int tile_size = 64);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Destructor
+	///
+	/// Operations not yet flushed are discarded
+	///
+	////////////////////////////////////////////////////////////
+	virtual ~SurfaceCanvas();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Deleted copy constructor
+	///
+	/// This class is not copyable
+	///
+	////////////////////////////////////////////////////////////
+	SurfaceCanvas(const SurfaceCanvas& other) = delete;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Deleted assignment operator
+	///
+	/// This class is not copyable
+	///
+	////////////////////////////////////////////////////////////
+	SurfaceCanvas& operator=(const SurfaceCanvas& other) = delete;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Record fill of a rectangle with given color
+	///
+	/// \param[in] rect Rectangle to fill, NullOpt to fill whole target
+	/// \param[in] color Color to fill with, in target pixel format
+	///
+	/// \returns Reference to self
+	///
+	/// \see http://wiki.libsdl.org/SDL_FillRect
+	///
+	////////////////////////////////////////////////////////////
+	SurfaceCanvas& FillRect(const Optional<Rect>& rect, Uint32 color);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Record fill of a set of rectangles with given color
+	///
+	/// \param[in] rects Array of rectangles to fill
+	/// \param[in] count Number of rectangles in the array
+	/// \param[in] color Color to fill with, in target pixel format
+	///
+	/// \returns Reference to self
+	///
+	/// \see http://wiki.libsdl.org/SDL_FillRects
+	///
+	////////////////////////////////////////////////////////////
+	SurfaceCanvas& FillRects(const Rect* rects, int count, Uint32 color);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Record fast surface copy to target
+	///
+	/// Blit is performed the same way as Surface::BlitFast() does.
+	///
+	/// \param[in] src Surface to copy from
+	/// \param[in] srcrect Rectangle to be copied, or NullOpt to copy whole surface
+	/// \param[in] dstrect Position to copy to
+	///
+	/// \returns Reference to self
+	///
+	/// \see http://wiki.libsdl.org/SDL_BlitSurface
+	///
+	////////////////////////////////////////////////////////////
+	SurfaceCanvas& Blit(Surface& src, const Optional<Rect>& srcrect, const Rect& dstrect);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Perform all recorded operations
+	///
+	/// \param[in] pool Thread pool to rasterize tiles on
+	///
+	/// \returns Reference to self
+	///
+	/// \throws SDL2pp::Exception
+	///
+	/// Operations which cannot be safely split between tiles
+	/// (blits of a surface onto itself and blits involving RLE
+	/// encoded surfaces) are performed serially, in order with
+	/// the rest. Pending operations are discarded even if an
+	/// exception is thrown.
+	///
+	////////////////////////////////////////////////////////////
+	SurfaceCanvas& Flush(ThreadPool& pool);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Discard all recorded operations
+	///
+	/// \returns Reference to self
+	///
+	////////////////////////////////////////////////////////////
+	SurfaceCanvas& Clear();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get number of recorded operations
+	///
+	/// \returns Number of operations pending until next Flush()
+	///
+	////////////////////////////////////////////////////////////
+	size_t GetNumPending() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get target surface
+	///
+	/// \returns Surface operations are applied to
+	///
+	////////////////////////////////////////////////////////////
+	Surface& GetTarget() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get tile size
+	///
+	/// \returns Width and height of a tile in pixels
+	///
+	////////////////////////////////////////////////////////////
+	int GetTileSize() const;
+};
+
+}
+
+#endif
@@ -0,0 +1,193 @@
+/*
+  libSDL2pp - C++11 bindings/wrapper for SDL2
+  Copyright (C) 2013-2016 Dmitry Marakasov <amdmi3@amdmi3.ru>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include <cassert>
+#include <stdexcept>
+#include <utility>
+
+#include <SDL_pixels.h>
+#include <SDL_surface.h>
+
+#include <SDL2pp/SurfacePool.hh>
+#include <SDL2pp/Exception.hh>
+
+namespace SDL2pp {
+
+SurfacePool::SurfaceHandle::SurfaceHandle(SurfacePool* pool, Entry&& entry) : pool_(pool), entry_(std::move(entry)) {
+}
+
+SurfacePool::SurfaceHandle::SurfaceHandle() : pool_(nullptr) {
+}
+
+SurfacePool::SurfaceHandle::~SurfaceHandle() {
+	Release();
+}
+
+SurfacePool::SurfaceHandle::SurfaceHandle(SurfaceHandle&& other) noexcept : pool_(other.pool_), entry_(std::move(other.entry_)) {
+	other.pool_ = nullptr;
+	other.entry_ = NullOpt;
+}
+
+SurfacePool::SurfaceHandle& SurfacePool::SurfaceHandle::operator=(SurfaceHandle&& other) noexcept {
+	if (&other == this)
+		return *this;
+
+	Release();
+
+	pool_ = other.pool_;
+	entry_ = std::move(other.entry_);
+
+	other.pool_ = nullptr;
+	other.entry_ = NullOpt;
+
+	return *this;
+}
+
+void SurfacePool::SurfaceHandle::Release() {
+	if (!entry_)
+		return;
+
+	pool_->Recycle(std::move(*entry_));
+	entry_ = NullOpt;
+	pool_ = nullptr;
+}
+
+bool SurfacePool::SurfaceHandle::IsValid() const {
+	return static_cast<bool>(entry_);
+}
+
+Surface& SurfacePool::SurfaceHandle::GetSurface() {
+	assert(entry_);
+	return entry_->surface;
+}
+
+Surface& SurfacePool::SurfaceHandle::operator*() {
+	return GetSurface();
+}
+
+Surface* SurfacePool::SurfaceHandle::operator->() {
+	return &GetSurface();
+}
+
+SurfacePool::Entry SurfacePool::CreateEntry(const Key& key) {
+	if (key.width < 0 || key.height < 0)
+		throw std::invalid_argument("surface size must not be negative");
+
+	int bpp;
+	Uint32 Rmask, Gmask, Bmask, Amask;
+	if (!SDL_PixelFormatEnumToMasks(key.format, &bpp, &Rmask, &Gmask, &Bmask, &Amask))
+		throw Exception("SDL_PixelFormatEnumToMasks");
+
+	// same pitch SDL_CreateRGBSurface would use
+	int pitch = ((key.width * bpp + 7) / 8 + 3) & ~3;
+
+	std::unique_ptr<Uint8[]> pixels(new Uint8[static_cast<size_t>(pitch) * key.height]);
+	Surface surface(pixels.get(), key.width, key.height, bpp, pitch, Rmask, Gmask, Bmask, Amask);
+
+	return Entry{key, std::move(pixels), std::move(surface)};
+}
+
+void SurfacePool::Recycle(Entry&& entry) noexcept {
+	SDL_Surface* surface = entry.surface.Get();
+
+	// restore state SDL_CreateRGBSurfaceFrom leaves surface in;
+	// none of these may fail on a valid surface
+	SDL_SetSurfaceRLE(surface, 0);
+	SDL_SetColorKey(surface, SDL_FALSE, 0);
+	SDL_SetSurfaceColorMod(surface, 255, 255, 255);
+	SDL_SetSurfaceAlphaMod(surface, 255);
+	SDL_SetSurfaceBlendMode(surface, surface->format->Amask ? SDL_BLENDMODE_BLEND : SDL_BLENDMODE_NONE);
+	SDL_SetClipRect(surface, nullptr);
+
+	try {
+		FreeList& list = free_[entry.key];
+
+		// reserve for all surfaces of this kind so steady state never reallocates
+		if (list.entries.capacity() < list.num_allocated)
+			list.entries.reserve(list.num_allocated);
+
+		list.entries.emplace_back(std::move(entry));
+		num_free_++;
+	} catch (...) {
+		// may only happen after Clear(); just drop the surface
+	}
+}
+
+SurfacePool::SurfacePool() : num_free_(0), num_allocated_(0) {
+}
+
+SurfacePool::SurfaceHandle SurfacePool::Acquire(int w, int h, Uint32 format) {
+	Key key{w, h, format};
+
+	auto list = free_.find(key);
+	if (list != free_.end() && !list->second.entries.empty()) {
+		SurfaceHandle handle(this, std::move(list->second.entries.back()));
+		list->second.entries.pop_back();
+		num_free_--;
+		return handle;
+	}
+
+	SurfaceHandle handle(this, CreateEntry(key));
+	free_[key].num_allocated++;
+	num_allocated_++;
+	return handle;
+}
+
+SurfacePool::SurfaceHandle SurfacePool::Convert(Surface& surface, Uint32 format) {
+	SurfaceHandle converted = Acquire(surface.GetWidth(), surface.GetHeight(), format);
+
+	{
+		Surface::LockHandle src_lock = surface.Lock();
+		Surface::LockHandle dst_lock = converted->Lock();
+		if (SDL_ConvertPixels(surface.GetWidth(), surface.GetHeight(), surface.GetFormat(), src_lock.GetPixels(), src_lock.GetPitch(), converted->GetFormat(), dst_lock.GetPixels(), dst_lock.GetPitch()) != 0)
+			throw Exception("SDL_ConvertPixels");
+	}
+
+	return converted;
+}
+
+void SurfacePool::Reserve(int w, int h, Uint32 format, size_t count) {
+	Key key{w, h, format};
+	FreeList& list = free_[key];
+
+	list.entries.reserve(count);
+	while (list.entries.size() < count) {
+		list.entries.emplace_back(CreateEntry(key));
+		list.num_allocated++;
+		num_allocated_++;
+		num_free_++;
+	}
+}
+
+void SurfacePool::Clear() {
+	free_.clear();
+	num_free_ = 0;
+}
+
+size_t SurfacePool::GetNumFree() const {
+	return num_free_;
+}
+
+size_t SurfacePool::GetNumAllocated() const {
+	return num_allocated_;
+}
+
+}
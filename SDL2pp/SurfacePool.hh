@@ -0,0 +1,389 @@
+/*
+  libSDL2pp - C++11 bindings/wrapper for SDL2
+  Copyright (C) 2013-2016 Dmitry Marakasov <amdmi3@amdmi3.ru>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef SDL2PP_SURFACEPOOL_HH
+#define SDL2PP_SURFACEPOOL_HH
+
+#include <cstddef>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <SDL_stdinc.h>
+
+#include <SDL2pp/Optional.hh>
+#include <SDL2pp/Surface.hh>
+#include <SDL2pp/Export.hh>
+
+namespace SDL2pp {
+
+////////////////////////////////////////////////////////////
+/// \brief Pool of reusable surfaces
+///
+/// \ingroup rendering
+///
+/// \headerfile SDL2pp/SurfacePool.hh
+///
+/// Hands out surfaces of given size and pixel format for
+/// transient per-frame use (text rendering, format conversion,
+/// scratch buffers for effects) and takes them back as soon
+/// as the returned handle is destroyed. Pixel data lives in
+/// buffers owned by the pool, and surfaces are created over
+/// them with SDL_CreateRGBSurfaceFrom. Both buffer and
+/// SDL_Surface object are recycled, so once the pool has
+/// warmed up, acquiring and releasing surfaces does no
+/// allocations at all.
+///
+/// Released surfaces are reset to their initial state: clip
+/// rectangle, color key, RLE, color and alpha modulation and
+/// blend mode are restored to defaults. Palettes of indexed
+/// surfaces and pixel contents are not reset.
+///
+/// Pool must outlive all handles it has given out. The pool
+/// is not thread safe.
+///
+/// Usage example:
+/// \code
+/// {
+///     SDL2pp::SurfacePool pool;
+///
+///     while (...) {
+///         SDL2pp::SurfacePool::SurfaceHandle scratch = pool.Acquire(256, 256, SDL_PIXELFORMAT_ARGB8888);
+///         scratch->FillRect(SDL2pp::NullOpt, 0);
+///         ...
+///     } // surface is returned to the pool here
+/// }
+/// \endcode
+///
+////////////////////////////////////////////////////////////
+class SDL2PP_EXPORT SurfacePool {
+private:
+	////////////////////////////////////////////////////////////
+	/// \brief Surface size and format pool is keyed by
+	///
+	////////////////////////////////////////////////////////////
+	struct Key {
+		int width;     ///< Surface width
+		int height;    ///< Surface height
+		Uint32 format; ///< Surface pixel format
+
+		bool operator==(const Key& other) const {
+			return width == other.width && height == other.height && format == other.format;
+		}
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Hash function for pool keys
+	///
+	////////////////////////////////////////////////////////////
+	struct KeyHash {
+		size_t operator()(const Key& key) const {
+			return (static_cast<size_t>(key.width) * 2654435761U) ^ (static_cast<size_t>(key.height) * 40503U) ^ static_cast<size_t>(key.format);
+		}
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Pooled surface along with its pixel buffer
+	///
+	////////////////////////////////////////////////////////////
+	struct Entry {
+		Key key;                         ///< Size and format surface was requested with
+		std::unique_ptr<Uint8[]> pixels; ///< Pixel data owned by the pool
+		Surface surface;                 ///< Surface created over pixel data
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Free surfaces of a single size and format
+	///
+	////////////////////////////////////////////////////////////
+	struct FreeList {
+		std::vector<Entry> entries;  ///< Surfaces available for reuse
+		size_t num_allocated = 0;    ///< Number of surfaces ever allocated for this key
+	};
+
+public:
+	////////////////////////////////////////////////////////////
+	/// \brief Surface borrowed from SDL2pp::SurfacePool
+	///
+	/// \ingroup rendering
+	///
+	/// \headerfile SDL2pp/SurfacePool.hh
+	///
+	/// Gives access to pooled surface and returns it to the
+	/// pool as soon as the handle is destroyed.
+	///
+	////////////////////////////////////////////////////////////
+	class SurfaceHandle {
+		friend class SurfacePool;
+	private:
+		SurfacePool* pool_;     ///< Pool surface belongs to
+		Optional<Entry> entry_; ///< Borrowed surface
+
+	private:
+		////////////////////////////////////////////////////////////
+		/// \brief Create handle for surface taken from the pool
+		///
+		/// \param[in] pool Pool surface belongs to
+		/// \param[in] entry Surface taken from the pool
+		///
+		////////////////////////////////////////////////////////////
+		SurfaceHandle(SurfacePool* pool, Entry&& entry);
+
+	public:
+		////////////////////////////////////////////////////////////
+		/// \brief Create empty handle
+		///
+		/// This may be initialized with pooled surface later via
+		/// move assignment
+		///
+		////////////////////////////////////////////////////////////
+		SurfaceHandle();
+
+		////////////////////////////////////////////////////////////
+		/// \brief Destructor
+		///
+		/// Returns surface to the pool
+		///
+		////////////////////////////////////////////////////////////
+		~SurfaceHandle();
+
+		////////////////////////////////////////////////////////////
+		/// \brief Move constructor
+		///
+		/// \param[in] other SDL2pp::SurfacePool::SurfaceHandle to move data from
+		///
+		////////////////////////////////////////////////////////////
+		SurfaceHandle(SurfaceHandle&& other) noexcept;
+
+		////////////////////////////////////////////////////////////
+		/// \brief Move assignment operator
+		///
+		/// Surface previously held by this handle is returned
+		/// to the pool
+		///
+		/// \param[in] other SDL2pp::SurfacePool::SurfaceHandle to move data from
+		///
+		/// \returns Reference to self
+		///
+		////////////////////////////////////////////////////////////
+		SurfaceHandle& operator=(SurfaceHandle&& other) noexcept;
+
+		////////////////////////////////////////////////////////////
+		/// \brief Deleted copy constructor
+		///
+		/// This class is not copyable
+		///
+		////////////////////////////////////////////////////////////
+		SurfaceHandle(const SurfaceHandle& other) = delete;
+
+		////////////////////////////////////////////////////////////
+		/// \brief Deleted assignment operator
+		///
+		/// This class is not copyable
+		///
+		////////////////////////////////////////////////////////////
+		SurfaceHandle& operator=(const SurfaceHandle& other) = delete;
+
+		////////////////////////////////////////////////////////////
+		/// \brief Return surface to the pool before the handle
+		///        is destroyed
+		///
+		/// Handle becomes empty. Does nothing if handle is
+		/// already empty.
+		///
+		////////////////////////////////////////////////////////////
+		void Release();
+
+		////////////////////////////////////////////////////////////
+		/// \brief Check whether handle holds a surface
+		///
+		/// \returns True if handle is not empty
+		///
+		////////////////////////////////////////////////////////////
+		bool IsValid() const;
+
+		////////////////////////////////////////////////////////////
+		/// \brief Get borrowed surface
+		///
+		/// Must not be called on empty handle
+		///
+		/// \returns Reference to pooled SDL2pp::Surface
+		///
+		////////////////////////////////////////////////////////////
+		Surface& GetSurface();
+
+		////////////////////////////////////////////////////////////
+		/// \brief Get borrowed surface
+		///
+		/// Must not be called on empty handle
+		///
+		/// \returns Reference to pooled SDL2pp::Surface
+		///
+		////////////////////////////////////////////////////////////
+		Surface& operator*();
+
+		////////////////////////////////////////////////////////////
+		/// \brief Access borrowed surface members
+		///
+		/// Must not be called on empty handle
+		///
+		/// \returns Pointer to pooled SDL2pp::Surface
+		///
+		////////////////////////////////////////////////////////////
+		Surface* operator->();
+	};
+
+private:
+	std::unordered_map<Key, FreeList, KeyHash> free_; ///< Free surfaces by size and format
+	size_t num_free_;                                 ///< Total number of free surfaces
+	size_t num_allocated_;                            ///< Total number of surfaces ever allocated
+
+private:
+	////////////////////////////////////////////////////////////
+	/// \brief Allocate new surface and its pixel buffer
+	///
+	/// \param[in] key Size and format of surface
+	///
+	/// \returns Newly allocated surface
+	///
+	/// \throws SDL2pp::Exception
+	///
+	////////////////////////////////////////////////////////////
+	static Entry CreateEntry(const Key& key);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Reset surface state and put it into free list
+	///
+	/// \param[in] entry Surface to recycle
+	///
+	////////////////////////////////////////////////////////////
+	void Recycle(Entry&& entry) noexcept;
+
+public:
+	////////////////////////////////////////////////////////////
+	/// \brief Create empty pool
+	///
+	////////////////////////////////////////////////////////////
+	SurfacePool();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Deleted copy constructor
+	///
+	/// This class is not copyable
+	///
+	////////////////////////////////////////////////////////////
+	SurfacePool(const SurfacePool& other) = delete;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Deleted assignment operator
+	///
+	/// This class is not copyable
+	///
+	////////////////////////////////////////////////////////////
+	SurfacePool& operator=(const SurfacePool& other) = delete;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get surface from the pool
+	///
+	/// Reuses previously released surface of the same size and
+	/// format if there is one, otherwise allocates new one.
+	/// Contents of reused surfaces are undefined.
+	///
+	/// \param[in] w Surface width
+	/// \param[in] h Surface height
+	/// \param[in] format Surface pixel format, one of non-FOURCC
+	///                   SDL_PixelFormatEnum values
+	///
+	/// \returns Handle to pooled surface
+	///
+	/// \throws SDL2pp::Exception
+	/// \throws std::invalid_argument if size is negative
+	///
+	/// \see http://wiki.libsdl.org/SDL_CreateRGBSurfaceFrom
+	///
+	////////////////////////////////////////////////////////////
+	SurfaceHandle Acquire(int w, int h, Uint32 format);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Copy surface into pooled surface of another format
+	///
+	/// Pooled counterpart of Surface::Convert for transient
+	/// conversions. Only pixel data is converted, properties
+	/// of the resulting surface are left at their defaults.
+	///
+	/// \param[in] surface Surface to convert
+	/// \param[in] format Target pixel format
+	///
+	/// \returns Handle to pooled surface with converted pixels
+	///
+	/// \throws SDL2pp::Exception
+	///
+	/// \see http://wiki.libsdl.org/SDL_ConvertPixels
+	///
+	////////////////////////////////////////////////////////////
+	SurfaceHandle Convert(Surface& surface, Uint32 format);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Allocate surfaces upfront
+	///
+	/// Ensures that at least given number of free surfaces of
+	/// given size and format are available.
+	///
+	/// \param[in] w Surface width
+	/// \param[in] h Surface height
+	/// \param[in] format Surface pixel format
+	/// \param[in] count Number of free surfaces to have
+	///
+	/// \throws SDL2pp::Exception
+	/// \throws std::invalid_argument if size is negative
+	///
+	////////////////////////////////////////////////////////////
+	void Reserve(int w, int h, Uint32 format, size_t count);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Free all surfaces available for reuse
+	///
+	/// Surfaces currently borrowed are not affected and will
+	/// be returned to the pool as usual.
+	///
+	////////////////////////////////////////////////////////////
+	void Clear();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get number of surfaces available for reuse
+	///
+	/// \returns Number of free surfaces
+	///
+	////////////////////////////////////////////////////////////
+	size_t GetNumFree() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get number of surfaces allocated by the pool
+	///
+	/// \returns Number of surfaces ever allocated
+	///
+	////////////////////////////////////////////////////////////
+	size_t GetNumAllocated() const;
+};
+
+}
+
+#endif
@@ -0,0 +1,234 @@
+/*
+  libSDL2pp - C++11 bindings/wrapper for SDL2
+  Copyright (C) 2013-2016 Dmitry Marakasov <amdmi3@amdmi3.ru>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#include <SDL_pixels.h>
+
+#include <SDL2pp/Font.hh>
+#include <SDL2pp/Renderer.hh>
+#include <SDL2pp/TextCache.hh>
+
+namespace SDL2pp {
+
+namespace {
+
+// FNV-1a
+class Hasher {
+private:
+	Uint64 state_ = 14695981039346656037ULL;
+
+public:
+	void Add(const void* data, size_t length) {
+		const unsigned char* bytes = static_cast<const unsigned char*>(data);
+		for (size_t i = 0; i < length; i++) {
+			state_ ^= bytes[i];
+			state_ *= 1099511628211ULL;
+		}
+	}
+
+	template <class T>
+	void Add(const T& value) {
+		Add(&value, sizeof(value));
+	}
+
+	size_t Get() const {
+		return static_cast<size_t>(state_);
+	}
+};
+
+}
+
+size_t TextCache::KeyHash::operator()(const Key& key) const {
+	Hasher hasher;
+	hasher.Add(key.font);
+	hasher.Add(key.style);
+	hasher.Add(key.outline);
+	hasher.Add(key.hinting);
+	hasher.Add(key.kerning);
+	hasher.Add(key.mode);
+	hasher.Add(key.fg.r);
+	hasher.Add(key.fg.g);
+	hasher.Add(key.fg.b);
+	hasher.Add(key.fg.a);
+	hasher.Add(key.bg.r);
+	hasher.Add(key.bg.g);
+	hasher.Add(key.bg.b);
+	hasher.Add(key.bg.a);
+	hasher.Add(key.text, key.length);
+	return hasher.Get();
+}
+
+bool TextCache::KeyEqual::operator()(const Key& a, const Key& b) const {
+	return a.font == b.font &&
+		a.style == b.style &&
+		a.outline == b.outline &&
+		a.hinting == b.hinting &&
+		a.kerning == b.kerning &&
+		a.mode == b.mode &&
+		a.fg == b.fg &&
+		a.bg == b.bg &&
+		a.length == b.length &&
+		std::memcmp(a.text, b.text, a.length) == 0;
+}
+
+TextCache::TextCache(size_t byte_budget) : renderer_(nullptr), byte_budget_(byte_budget) {
+}
+
+TextCache::TextCache(Renderer& renderer, size_t byte_budget) : renderer_(&renderer), byte_budget_(byte_budget) {
+}
+
+TextCache::Entry& TextCache::Lookup(Font& font, const std::string& text, TextRenderMode mode, const Color& fg, const Color& bg) {
+	Key key;
+	key.font = font.Get();
+	key.style = font.GetStyle();
+	key.outline = font.GetOutline();
+	key.hinting = font.GetHinting();
+	key.kerning = font.GetKerning();
+	key.mode = mode;
+	key.fg = fg;
+	key.bg = mode == TextRenderMode::Shaded ? bg : Color(0, 0, 0, 0);
+	key.text = text.data();
+	key.length = text.size();
+
+	auto cached = index_.find(key);
+	if (cached != index_.end()) {
+		entries_.splice(entries_.begin(), entries_, cached->second);
+		frame_stats_.hits++;
+		return entries_.front();
+	}
+
+	frame_stats_.misses++;
+
+	Optional<Surface> surface(font.RenderUTF8(text, mode, fg, bg));
+
+	Optional<Texture> texture;
+	size_t bytes;
+	if (renderer_) {
+		texture.emplace(*renderer_, *surface);
+		surface = NullOpt;
+		bytes = static_cast<size_t>(texture->GetWidth()) * static_cast<size_t>(texture->GetHeight()) * SDL_BYTESPERPIXEL(texture->GetFormat());
+	} else {
+		bytes = static_cast<size_t>(surface->Get()->pitch) * static_cast<size_t>(surface->GetHeight());
+	}
+
+	entries_.emplace_front();
+	Entry& entry = entries_.front();
+	try {
+		entry.text = text;
+		entry.key = key;
+		entry.key.text = entry.text.data();
+		index_.emplace(entry.key, entries_.begin());
+	} catch (...) {
+		entries_.pop_front();
+		throw;
+	}
+
+	entry.surface = std::move(surface);
+	entry.texture = std::move(texture);
+	entry.bytes = bytes;
+
+	used_bytes_ += bytes;
+	frame_stats_.bytes_rendered += bytes;
+
+	Evict(1);
+
+	return entry;
+}
+
+void TextCache::Evict(size_t keep) {
+	while (used_bytes_ > byte_budget_ && entries_.size() > keep) {
+		Entry& victim = entries_.back();
+		index_.erase(victim.key);
+		used_bytes_ -= victim.bytes;
+		entries_.pop_back();
+		frame_stats_.evictions++;
+	}
+}
+
+Surface& TextCache::GetSurfaceUTF8(Font& font, const std::string& text, TextRenderMode mode, const Color& fg, const Color& bg) {
+	if (renderer_)
+		throw std::logic_error("text cache created with a renderer holds textures");
+	return *Lookup(font, text, mode, fg, bg).surface;
+}
+
+Texture& TextCache::GetTextureUTF8(Font& font, const std::string& text, TextRenderMode mode, const Color& fg, const Color& bg) {
+	if (!renderer_)
+		throw std::logic_error("text cache created without a renderer holds surfaces");
+	return *Lookup(font, text, mode, fg, bg).texture;
+}
+
+TextCache& TextCache::Remove(const Font& font) {
+	TTF_Font* ttf_font = font.Get();
+	for (auto entry = entries_.begin(); entry != entries_.end(); ) {
+		if (entry->key.font == ttf_font) {
+			index_.erase(entry->key);
+			used_bytes_ -= entry->bytes;
+			entry = entries_.erase(entry);
+		} else {
+			++entry;
+		}
+	}
+	return *this;
+}
+
+TextCache& TextCache::Clear() {
+	index_.clear();
+	entries_.clear();
+	used_bytes_ = 0;
+	return *this;
+}
+
+TextCache& TextCache::SetByteBudget(size_t byte_budget) {
+	byte_budget_ = byte_budget;
+	Evict(0);
+	return *this;
+}
+
+size_t TextCache::GetByteBudget() const {
+	return byte_budget_;
+}
+
+size_t TextCache::GetUsedBytes() const {
+	return used_bytes_;
+}
+
+size_t TextCache::GetNumEntries() const {
+	return entries_.size();
+}
+
+TextCache& TextCache::NextFrame() {
+	last_frame_stats_ = frame_stats_;
+	frame_stats_ = FrameStats();
+	return *this;
+}
+
+TextCache::FrameStats TextCache::GetFrameStats() const {
+	return last_frame_stats_;
+}
+
+TextCache::FrameStats TextCache::GetCurrentFrameStats() const {
+	return frame_stats_;
+}
+
+}
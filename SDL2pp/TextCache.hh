@@ -0,0 +1,338 @@
+/*
+  libSDL2pp - C++11 bindings/wrapper for SDL2
+  Copyright (C) 2013-2016 Dmitry Marakasov <amdmi3@amdmi3.ru>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef SDL2PP_TEXTCACHE_HH
+#define SDL2PP_TEXTCACHE_HH
+
+#include <list>
+#include <string>
+#include <unordered_map>
+
+#include <SDL_stdinc.h>
+#include <SDL_ttf.h>
+
+#include <SDL2pp/Color.hh>
+#include <SDL2pp/Font.hh>
+#include <SDL2pp/Optional.hh>
+#include <SDL2pp/Surface.hh>
+#include <SDL2pp/Texture.hh>
+#include <SDL2pp/Export.hh>
+
+namespace SDL2pp {
+
+class Renderer;
+
+////////////////////////////////////////////////////////////
+/// \brief Least recently used cache of rendered text
+///
+/// \ingroup ttf
+///
+/// \headerfile SDL2pp/TextCache.hh
+///
+/// Maps font, its style, outline, hinting and kerning settings,
+/// render mode, UTF-8 string and colors to rendered text, which
+/// is kept as Surface, or as Texture if cache was created with
+/// a renderer. When total size of cached images exceeds byte
+/// budget, least recently used ones are dropped.
+///
+/// Lookup of a cached string does not allocate memory.
+///
+/// Fonts are identified by their TTF_Font pointer, so text
+/// rendered with a font must be removed with Remove() before
+/// the font is destroyed, otherwise a new font which happens
+/// to get the same address would get stale images.
+///
+////////////////////////////////////////////////////////////
+class SDL2PP_EXPORT TextCache {
+public:
+	////////////////////////////////////////////////////////////
+	/// \brief Cache statistics for a single frame
+	///
+	/// \ingroup ttf
+	///
+	/// \headerfile SDL2pp/TextCache.hh
+	///
+	/// \see TextCache::GetFrameStats
+	///
+	////////////////////////////////////////////////////////////
+	struct FrameStats {
+		Uint32 hits = 0;           ///< Number of lookups which found cached text
+		Uint32 misses = 0;         ///< Number of lookups which had to render text
+		Uint32 evictions = 0;      ///< Number of images dropped to fit into byte budget
+		Uint64 bytes_rendered = 0; ///< Total size of images rendered on misses
+	};
+
+private:
+	////////////////////////////////////////////////////////////
+	/// \brief Everything rendered image depends on
+	///
+	/// Text is referenced, not owned, so a key may be built
+	/// for lookup without allocating memory
+	///
+	////////////////////////////////////////////////////////////
+	struct Key {
+		TTF_Font* font;      ///< Font used for rendering
+		int style;           ///< Font style
+		int outline;         ///< Font outline
+		int hinting;         ///< Font hinting
+		bool kerning;        ///< Whether font kerning was enabled
+		TextRenderMode mode; ///< Render mode
+		Color fg;            ///< Text color
+		Color bg;            ///< Background color, transparent black unless mode is Shaded
+		const char* text;    ///< UTF-8 string
+		size_t length;       ///< Length of UTF-8 string in bytes
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Hash function for Key
+	///
+	////////////////////////////////////////////////////////////
+	struct KeyHash {
+		size_t operator()(const Key& key) const;
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Equality predicate for Key
+	///
+	////////////////////////////////////////////////////////////
+	struct KeyEqual {
+		bool operator()(const Key& a, const Key& b) const;
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Cached image
+	///
+	////////////////////////////////////////////////////////////
+	struct Entry {
+		Key key;                   ///< Key, referencing text below
+		std::string text;          ///< Owned copy of UTF-8 string
+		Optional<Surface> surface; ///< Rendered text, if caching surfaces
+		Optional<Texture> texture; ///< Rendered text, if caching textures
+		size_t bytes;              ///< Size of image in bytes
+	};
+
+	typedef std::list<Entry> EntryList;
+	typedef std::unordered_map<Key, EntryList::iterator, KeyHash, KeyEqual> EntryMap;
+
+private:
+	Renderer* renderer_;           ///< Renderer to create textures with, nullptr to cache surfaces
+	size_t byte_budget_;           ///< Maximal total size of cached images
+	size_t used_bytes_ = 0;        ///< Current total size of cached images
+	EntryList entries_;            ///< Cached images, most recently used first
+	EntryMap index_;               ///< Cached images by key
+	FrameStats frame_stats_;       ///< Statistics for the current frame
+	FrameStats last_frame_stats_;  ///< Statistics for the last completed frame
+
+private:
+	////////////////////////////////////////////////////////////
+	/// \brief Find cached text or render it
+	///
+	/// \param[in] font Font to render text with
+	/// \param[in] text UTF-8 string
+	/// \param[in] mode Render mode
+	/// \param[in] fg Text color
+	/// \param[in] bg Background color, used in Shaded mode only
+	///
+	/// \returns Cache entry, moved to the front of LRU list
+	///
+	/// \throws SDL2pp::Exception
+	///
+	////////////////////////////////////////////////////////////
+	Entry& Lookup(Font& font, const std::string& text, TextRenderMode mode, const Color& fg, const Color& bg);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Drop least recently used images over byte budget
+	///
+	/// \param[in] keep Number of most recently used images to
+	///                 keep regardless of budget
+	///
+	////////////////////////////////////////////////////////////
+	void Evict(size_t keep);
+
+public:
+	////////////////////////////////////////////////////////////
+	/// \brief Create cache of rendered surfaces
+	///
+	/// \param[in] byte_budget Maximal total size of cached surfaces
+	///
+	////////////////////////////////////////////////////////////
+	explicit TextCache(size_t byte_budget);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Create cache of rendered textures
+	///
+	/// \param[in] renderer Rendering context to create textures for
+	/// \param[in] byte_budget Maximal total size of cached textures
+	///
+	////////////////////////////////////////////////////////////
+	TextCache(Renderer& renderer, size_t byte_budget);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Deleted copy constructor
+	///
+	/// This class is not copyable, as its index refers to
+	/// strings owned by entries
+	///
+	////////////////////////////////////////////////////////////
+	TextCache(const TextCache& other) = delete;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Deleted assignment operator
+	///
+	/// This class is not copyable, as its index refers to
+	/// strings owned by entries
+	///
+	////////////////////////////////////////////////////////////
+	TextCache& operator=(const TextCache& other) = delete;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get rendered UTF-8 text as surface
+	///
+	/// Returned reference is valid until next lookup which
+	/// renders text, or until the cache is cleared
+	///
+	/// \param[in] font Font to render text with
+	/// \param[in] text UTF-8 string
+	/// \param[in] mode Render mode
+	/// \param[in] fg Text color
+	/// \param[in] bg Background color, used in Shaded mode only
+	///
+	/// \returns Cached surface
+	///
+	/// \throws SDL2pp::Exception
+	/// \throws std::logic_error if cache was created with a renderer
+	///
+	////////////////////////////////////////////////////////////
+	Surface& GetSurfaceUTF8(Font& font, const std::string& text, TextRenderMode mode, const Color& fg, const Color& bg = Color(0, 0, 0, 0));
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get rendered UTF-8 text as texture
+	///
+	/// Returned reference is valid until next lookup which
+	/// renders text, or until the cache is cleared
+	///
+	/// \param[in] font Font to render text with
+	/// \param[in] text UTF-8 string
+	/// \param[in] mode Render mode
+	/// \param[in] fg Text color
+	/// \param[in] bg Background color, used in Shaded mode only
+	///
+	/// \returns Cached texture
+	///
+	/// \throws SDL2pp::Exception
+	/// \throws std::logic_error if cache was created without
+	///         a renderer
+	///
+	////////////////////////////////////////////////////////////
+	Texture& GetTextureUTF8(Font& font, const std::string& text, TextRenderMode mode, const Color& fg, const Color& bg = Color(0, 0, 0, 0));
+
+	////////////////////////////////////////////////////////////
+	/// \brief Drop all text rendered with given font
+	///
+	/// \param[in] font Font to drop text for
+	///
+	/// \returns Reference to self
+	///
+	////////////////////////////////////////////////////////////
+	TextCache& Remove(const Font& font);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Drop all cached text
+	///
+	/// \returns Reference to self
+	///
+	////////////////////////////////////////////////////////////
+	TextCache& Clear();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set byte budget
+	///
+	/// Least recently used images are dropped immediately if
+	/// they no longer fit
+	///
+	/// \param[in] byte_budget Maximal total size of cached images
+	///
+	/// \returns Reference to self
+	///
+	////////////////////////////////////////////////////////////
+	TextCache& SetByteBudget(size_t byte_budget);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get byte budget
+	///
+	/// \returns Maximal total size of cached images
+	///
+	////////////////////////////////////////////////////////////
+	size_t GetByteBudget() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get total size of cached images
+	///
+	/// May exceed byte budget if the most recently rendered
+	/// image alone does not fit into it, as it is always kept
+	///
+	/// \returns Total size of cached images in bytes
+	///
+	////////////////////////////////////////////////////////////
+	size_t GetUsedBytes() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get number of cached images
+	///
+	/// \returns Number of cached images
+	///
+	////////////////////////////////////////////////////////////
+	size_t GetNumEntries() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Finish collecting statistics for the current frame
+	///
+	/// Should be called once per frame, e.g. next to
+	/// Renderer::Present()
+	///
+	/// \returns Reference to self
+	///
+	////////////////////////////////////////////////////////////
+	TextCache& NextFrame();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get statistics for the last completed frame
+	///
+	/// \returns Statistics collected between the two last
+	///          NextFrame() calls, or empty statistics if no
+	///          frame was completed yet
+	///
+	////////////////////////////////////////////////////////////
+	FrameStats GetFrameStats() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get statistics for the current frame
+	///
+	/// \returns Statistics collected since the last NextFrame()
+	///          call
+	///
+	////////////////////////////////////////////////////////////
+	FrameStats GetCurrentFrameStats() const;
+};
+
+}
+
+#endif
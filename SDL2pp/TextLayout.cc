@@ -0,0 +1,400 @@
+/*
+  libSDL2pp - C++11 bindings/wrapper for SDL2
+  Copyright (C) 2013-2016 Dmitry Marakasov <amdmi3@amdmi3.ru>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+#include <SDL2pp/Font.hh>
+#include <SDL2pp/TextLayout.hh>
+#include <SDL2pp/UTF8.hh>
+
+namespace SDL2pp {
+
+namespace {
+
+// tabs and carriage returns are measured as spaces
+bool IsSpace(Uint16 ch) {
+	return ch == ' ' || ch == '\t' || ch == '\r';
+}
+
+}
+
+TextLayout::TextLayout(const Font& font, int width, TextAlignment alignment, LineBreaking breaking)
+	: font_(font),
+	  width_(width),
+	  alignment_(alignment),
+	  breaking_(breaking),
+	  line_height_(font.GetLineSkip()) {
+	Relayout(0, 0, 0, 0, 0);
+}
+
+void TextLayout::Measure(size_t begin, size_t end, std::vector<Segment>& segments) const {
+	const bool use_kerning = font_.GetKerning();
+
+	Segment segment{0, 0, 0, 0};
+	bool in_space = false;
+	Uint16 prev_ch = 0;
+	bool first = true;
+
+	const char* text = text_.data() + begin;
+	const char* it = text;
+	const char* text_end = text_.data() + end;
+	while (it != text_end) {
+		size_t offset = static_cast<size_t>(it - text);
+		Uint16 ch = DecodeUTF8ToUCS2(it, text_end);
+
+		bool space = IsSpace(ch);
+		if (space)
+			ch = ' ';
+
+		int kerning = (use_kerning && !first) ? font_.GetKerningSize(prev_ch, ch) : 0;
+		int advance = font_.GetGlyphAdvance(ch);
+
+		if (space) {
+			if (!in_space) {
+				segment.word_end = offset;
+				in_space = true;
+			}
+			segment.space += kerning + advance;
+		} else if (in_space) {
+			// word after whitespace starts new segment; kerning
+			// into it belongs to the whitespace
+			segment.space += kerning;
+			segments.push_back(segment);
+			segment = Segment{offset, offset, advance, 0};
+			in_space = false;
+		} else {
+			segment.width += kerning + advance;
+		}
+
+		prev_ch = ch;
+		first = false;
+	}
+
+	if (!in_space)
+		segment.word_end = end - begin;
+	segments.push_back(segment);
+}
+
+void TextLayout::Break(const Paragraph& paragraph, std::vector<Line>& lines) const {
+	const std::vector<Segment>& segments = paragraph.segments;
+	const size_t count = segments.size();
+
+	// line ends, as indexes past last segment of each line
+	std::vector<size_t> ends;
+
+	if (width_ <= 0) {
+		ends.push_back(count);
+	} else if (breaking_ == LineBreaking::Greedy) {
+		int width = segments[0].width;
+		for (size_t i = 1; i < count; i++) {
+			int extended = width + segments[i - 1].space + segments[i].width;
+			if (extended > width_) {
+				ends.push_back(i);
+				width = segments[i].width;
+			} else {
+				width = extended;
+			}
+		}
+		ends.push_back(count);
+	} else {
+		// minimal raggedness: cost of line is square of its free
+		// space, last line is free
+		const long long infinity = std::numeric_limits<long long>::max();
+		std::vector<long long> cost(count + 1, infinity);
+		std::vector<size_t> from(count + 1, 0);
+		cost[0] = 0;
+
+		for (size_t j = 1; j <= count; j++) {
+			long long width = 0;
+			for (size_t i = j; i-- > 0; ) {
+				width += segments[i].width;
+				if (i != j - 1)
+					width += segments[i].space;
+
+				// single overflowing word is allowed
+				if (width > width_ && i != j - 1)
+					break;
+
+				if (cost[i] == infinity)
+					continue;
+
+				long long free = width_ - width;
+				long long line_cost = cost[i] + (j == count ? 0 : free * free);
+				if (line_cost < cost[j]) {
+					cost[j] = line_cost;
+					from[j] = i;
+				}
+			}
+		}
+
+		for (size_t j = count; j > 0; j = from[j])
+			ends.push_back(j);
+		std::reverse(ends.begin(), ends.end());
+	}
+
+	size_t start = 0;
+	for (size_t end : ends) {
+		int width = 0;
+		for (size_t i = start; i < end; i++)
+			width += segments[i].width + (i + 1 == end ? 0 : segments[i].space);
+
+		lines.push_back(Line{
+				paragraph.begin + segments[start].begin,
+				paragraph.begin + segments[end - 1].word_end,
+				Rect(0, 0, width, line_height_)
+			});
+
+		start = end;
+	}
+}
+
+void TextLayout::Place(size_t index, Line& line) const {
+	int x = 0;
+	if (width_ > 0) {
+		switch (alignment_) {
+		case TextAlignment::Left:
+			break;
+		case TextAlignment::Center:
+			x = (width_ - line.rect.w) / 2;
+			break;
+		case TextAlignment::Right:
+			x = width_ - line.rect.w;
+			break;
+		}
+	}
+
+	line.rect.x = x;
+	line.rect.y = static_cast<int>(index) * line_height_;
+	line.rect.h = line_height_;
+}
+
+void TextLayout::Relayout(size_t first_paragraph, size_t num_paragraphs, size_t begin, size_t end, size_t shift) {
+	// split new content into paragraphs and lay them out
+	std::vector<Paragraph> paragraphs;
+	std::vector<Line> lines;
+
+	size_t first_line = first_paragraph < paragraphs_.size() ? paragraphs_[first_paragraph].first_line : lines_.size();
+
+	size_t start = begin;
+	while (true) {
+		size_t newline = text_.find('\n', start);
+		size_t paragraph_end = (newline == std::string::npos || newline >= end) ? end : newline;
+
+		Paragraph paragraph{start, first_line + lines.size(), 0, std::vector<Segment>()};
+		Measure(start, paragraph_end, paragraph.segments);
+
+		size_t num_lines = lines.size();
+		Break(paragraph, lines);
+		paragraph.num_lines = lines.size() - num_lines;
+
+		paragraphs.push_back(std::move(paragraph));
+
+		if (paragraph_end == end)
+			break;
+
+		start = paragraph_end + 1;
+
+		// newline ending replaced content starts a paragraph only
+		// at the end of text, elsewhere it already exists
+		if (start == end && end != text_.size())
+			break;
+	}
+
+	// replace old paragraphs and lines
+	size_t old_num_lines = 0;
+	for (size_t i = first_paragraph; i < first_paragraph + num_paragraphs; i++)
+		old_num_lines += paragraphs_[i].num_lines;
+
+	paragraphs_.erase(paragraphs_.begin() + first_paragraph, paragraphs_.begin() + first_paragraph + num_paragraphs);
+	paragraphs_.insert(paragraphs_.begin() + first_paragraph, std::make_move_iterator(paragraphs.begin()), std::make_move_iterator(paragraphs.end()));
+
+	lines_.erase(lines_.begin() + first_line, lines_.begin() + first_line + old_num_lines);
+	lines_.insert(lines_.begin() + first_line, lines.begin(), lines.end());
+
+	// move following paragraphs and lines
+	for (size_t i = first_paragraph + paragraphs.size(); i < paragraphs_.size(); i++) {
+		paragraphs_[i].begin += shift;
+		paragraphs_[i].first_line = paragraphs_[i].first_line + lines.size() - old_num_lines;
+	}
+
+	for (size_t i = first_line + lines.size(); i < lines_.size(); i++) {
+		lines_[i].begin += shift;
+		lines_[i].end += shift;
+	}
+
+	for (size_t i = first_line; i < lines_.size(); i++)
+		Place(i, lines_[i]);
+}
+
+void TextLayout::Rebreak() {
+	lines_.clear();
+	for (Paragraph& paragraph : paragraphs_) {
+		paragraph.first_line = lines_.size();
+		Break(paragraph, lines_);
+		paragraph.num_lines = lines_.size() - paragraph.first_line;
+	}
+
+	for (size_t i = 0; i < lines_.size(); i++)
+		Place(i, lines_[i]);
+}
+
+TextLayout& TextLayout::SetText(const std::string& text) {
+	text_ = text;
+	Relayout(0, paragraphs_.size(), 0, text_.size(), 0);
+	return *this;
+}
+
+TextLayout& TextLayout::Append(const std::string& text) {
+	text_ += text;
+	Relayout(paragraphs_.size() - 1, 1, paragraphs_.back().begin, text_.size(), text.size());
+	return *this;
+}
+
+TextLayout& TextLayout::Insert(size_t offset, const std::string& text) {
+	if (offset > text_.size())
+		throw std::out_of_range("insertion offset is past the end of text");
+
+	// last paragraph starting at or before offset
+	auto paragraph = std::upper_bound(paragraphs_.begin(), paragraphs_.end(), offset, [](size_t offset, const Paragraph& paragraph) {
+			return offset < paragraph.begin;
+		}) - 1;
+
+	size_t index = static_cast<size_t>(paragraph - paragraphs_.begin());
+	size_t end = index + 1 < paragraphs_.size() ? paragraphs_[index + 1].begin : text_.size();
+
+	text_.insert(offset, text);
+	Relayout(index, 1, paragraph->begin, end + text.size(), text.size());
+	return *this;
+}
+
+const std::string& TextLayout::GetText() const {
+	return text_;
+}
+
+TextLayout& TextLayout::SetWidth(int width) {
+	width_ = width;
+	Rebreak();
+	return *this;
+}
+
+int TextLayout::GetWidth() const {
+	return width_;
+}
+
+TextLayout& TextLayout::SetAlignment(TextAlignment alignment) {
+	alignment_ = alignment;
+	for (size_t i = 0; i < lines_.size(); i++)
+		Place(i, lines_[i]);
+	return *this;
+}
+
+TextAlignment TextLayout::GetAlignment() const {
+	return alignment_;
+}
+
+TextLayout& TextLayout::SetLineBreaking(LineBreaking breaking) {
+	breaking_ = breaking;
+	Rebreak();
+	return *this;
+}
+
+LineBreaking TextLayout::GetLineBreaking() const {
+	return breaking_;
+}
+
+TextLayout& TextLayout::SetLineHeight(int line_height) {
+	if (line_height <= 0)
+		throw std::invalid_argument("line height must be positive");
+	line_height_ = line_height;
+	for (size_t i = 0; i < lines_.size(); i++)
+		Place(i, lines_[i]);
+	return *this;
+}
+
+int TextLayout::GetLineHeight() const {
+	return line_height_;
+}
+
+size_t TextLayout::GetNumLines() const {
+	return lines_.size();
+}
+
+const TextLayout::Line& TextLayout::GetLine(size_t index) const {
+	return lines_[index];
+}
+
+const std::vector<TextLayout::Line>& TextLayout::GetLines() const {
+	return lines_;
+}
+
+Point TextLayout::GetSize() const {
+	int width = 0;
+	for (const Line& line : lines_)
+		width = std::max(width, line.rect.w);
+	return Point(width, static_cast<int>(lines_.size()) * line_height_);
+}
+
+Optional<size_t> TextLayout::GetLineAt(const Point& point) const {
+	if (point.y < 0)
+		return NullOpt;
+
+	size_t index = static_cast<size_t>(point.y / line_height_);
+	if (index >= lines_.size() || !lines_[index].rect.Contains(point))
+		return NullOpt;
+
+	return index;
+}
+
+size_t TextLayout::GetOffsetAt(const Point& point) const {
+	size_t index = point.y < 0 ? 0 : std::min(static_cast<size_t>(point.y / line_height_), lines_.size() - 1);
+	const Line& line = lines_[index];
+
+	const bool use_kerning = font_.GetKerning();
+
+	int x = point.x - line.rect.x;
+	int pen = 0;
+	Uint16 prev_ch = 0;
+	bool first = true;
+
+	const char* text = text_.data();
+	const char* it = text + line.begin;
+	const char* end = text + line.end;
+	while (it != end) {
+		size_t offset = static_cast<size_t>(it - text);
+		Uint16 ch = DecodeUTF8ToUCS2(it, end);
+		if (IsSpace(ch))
+			ch = ' ';
+
+		int step = ((use_kerning && !first) ? font_.GetKerningSize(prev_ch, ch) : 0) + font_.GetGlyphAdvance(ch);
+		if (x < pen + step / 2)
+			return offset;
+
+		pen += step;
+		prev_ch = ch;
+		first = false;
+	}
+
+	return line.end;
+}
+
+}
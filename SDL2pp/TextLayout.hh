@@ -0,0 +1,404 @@
+/*
+  libSDL2pp - C++11 bindings/wrapper for SDL2
+  Copyright (C) 2013-2016 Dmitry Marakasov <amdmi3@amdmi3.ru>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef SDL2PP_TEXTLAYOUT_HH
+#define SDL2PP_TEXTLAYOUT_HH
+
+#include <string>
+#include <vector>
+
+#include <SDL2pp/Optional.hh>
+#include <SDL2pp/Point.hh>
+#include <SDL2pp/Rect.hh>
+#include <SDL2pp/Export.hh>
+
+namespace SDL2pp {
+
+class Font;
+
+////////////////////////////////////////////////////////////
+/// \brief Horizontal alignment of lines in SDL2pp::TextLayout
+///
+/// \ingroup ttf
+///
+////////////////////////////////////////////////////////////
+enum class TextAlignment {
+	Left,   ///< Lines start at the left edge
+	Center, ///< Lines are centered
+	Right,  ///< Lines end at the right edge
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Line breaking algorithm of SDL2pp::TextLayout
+///
+/// \ingroup ttf
+///
+////////////////////////////////////////////////////////////
+enum class LineBreaking {
+	Greedy,  ///< Put as many words on each line as fit
+	Optimal, ///< Minimize sum of squared free space on all lines but last
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Multi-line word wrapped text layout
+///
+/// \ingroup ttf
+///
+/// \headerfile SDL2pp/TextLayout.hh
+///
+/// Splits UTF-8 text into paragraphs at newlines and into
+/// lines at runs of spaces and tabs, so that lines fit into
+/// given width. Words wider than the layout are not split
+/// and overflow it.
+///
+/// Each word is measured once, by summing glyph advances and
+/// kerning from Font (which is fast if font has a metrics
+/// table, see Font::BuildMetricsTable), so line widths are pen
+/// advances rather than exact bounding boxes. Text edits
+/// remeasure and rebreak only the affected paragraphs, while
+/// changing width or breaking algorithm rebreaks all lines
+/// without remeasuring.
+///
+/// Font must outlive the layout, and its settings must not be
+/// changed while the layout is in use, or text has to be set
+/// anew with SetText().
+///
+////////////////////////////////////////////////////////////
+class SDL2PP_EXPORT TextLayout {
+public:
+	////////////////////////////////////////////////////////////
+	/// \brief Single laid out line
+	///
+	/// \ingroup ttf
+	///
+	/// \headerfile SDL2pp/TextLayout.hh
+	///
+	////////////////////////////////////////////////////////////
+	struct Line {
+		size_t begin; ///< Offset of the first byte of the line in text
+		size_t end;   ///< Offset past the last byte of the line, excluding trailing whitespace
+		Rect rect;    ///< Line box relative to layout origin, as wide as line text and as high as line height
+	};
+
+private:
+	////////////////////////////////////////////////////////////
+	/// \brief Word followed by whitespace
+	///
+	/// Offsets are relative to the paragraph
+	///
+	////////////////////////////////////////////////////////////
+	struct Segment {
+		size_t begin;    ///< Offset of the word
+		size_t word_end; ///< Offset past the word
+		int width;       ///< Width of the word
+		int space;       ///< Width of the whitespace, including kerning into the next word
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Text between newlines
+	///
+	////////////////////////////////////////////////////////////
+	struct Paragraph {
+		size_t begin;                  ///< Offset of the paragraph in text
+		size_t first_line;             ///< Index of the first line of the paragraph
+		size_t num_lines;              ///< Number of lines in the paragraph
+		std::vector<Segment> segments; ///< Words of the paragraph, never empty
+	};
+
+private:
+	const Font& font_;                   ///< Font to measure text with
+	std::string text_;                   ///< UTF-8 text
+	int width_;                          ///< Maximal line width, 0 to disable wrapping
+	TextAlignment alignment_;            ///< Horizontal line alignment
+	LineBreaking breaking_;              ///< Line breaking algorithm
+	int line_height_;                    ///< Distance between line tops
+	std::vector<Paragraph> paragraphs_;  ///< Paragraphs of text
+	std::vector<Line> lines_;            ///< Laid out lines
+
+private:
+	////////////////////////////////////////////////////////////
+	/// \brief Split paragraph text into words and measure them
+	///
+	/// \param[in] begin Offset of paragraph in text
+	/// \param[in] end Offset past paragraph in text, excluding
+	///                newline
+	/// \param[out] segments Vector to store words into
+	///
+	/// \throws SDL2pp::Exception
+	///
+	////////////////////////////////////////////////////////////
+	void Measure(size_t begin, size_t end, std::vector<Segment>& segments) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Break paragraph into lines
+	///
+	/// \param[in] paragraph Paragraph to break
+	/// \param[out] lines Vector to append lines to; line
+	///                   positions are not set
+	///
+	////////////////////////////////////////////////////////////
+	void Break(const Paragraph& paragraph, std::vector<Line>& lines) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set position of line box
+	///
+	/// \param[in] index Index of line
+	/// \param[in,out] line Line to place
+	///
+	////////////////////////////////////////////////////////////
+	void Place(size_t index, Line& line) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Lay out part of text anew
+	///
+	/// \param[in] first_paragraph Index of the first paragraph
+	///                            to replace
+	/// \param[in] num_paragraphs Number of paragraphs to replace
+	/// \param[in] begin Offset in text of the new content of
+	///                  replaced paragraphs
+	/// \param[in] end Offset in text past the new content of
+	///                replaced paragraphs
+	/// \param[in] shift Number of bytes inserted into replaced
+	///                  paragraphs
+	///
+	/// \throws SDL2pp::Exception
+	///
+	////////////////////////////////////////////////////////////
+	void Relayout(size_t first_paragraph, size_t num_paragraphs, size_t begin, size_t end, size_t shift);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Break all paragraphs into lines anew
+	///
+	////////////////////////////////////////////////////////////
+	void Rebreak();
+
+public:
+	////////////////////////////////////////////////////////////
+	/// \brief Create empty layout
+	///
+	/// Line height defaults to Font::GetLineSkip()
+	///
+	/// \param[in] font Font to measure text with
+	/// \param[in] width Maximal line width, 0 to disable wrapping
+	/// \param[in] alignment Horizontal line alignment
+	/// \param[in] breaking Line breaking algorithm
+	///
+	////////////////////////////////////////////////////////////
+	TextLayout(const Font& font, int width, TextAlignment alignment = TextAlignment::Left, LineBreaking breaking = LineBreaking::Greedy);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Replace whole text
+	///
+	/// \param[in] text UTF-8 text
+	///
+	/// \returns Reference to self
+	///
+	/// \throws SDL2pp::Exception
+	///
+	////////////////////////////////////////////////////////////
+	TextLayout& SetText(const std::string& text);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Append text to the end
+	///
+	/// Only the last paragraph and appended ones are laid out
+	///
+	/// \param[in] text UTF-8 text
+	///
+	/// \returns Reference to self
+	///
+	/// \throws SDL2pp::Exception
+	///
+	////////////////////////////////////////////////////////////
+	TextLayout& Append(const std::string& text);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Insert text at given offset
+	///
+	/// Only the paragraph containing the offset and inserted
+	/// ones are laid out, following lines are just moved
+	///
+	/// \param[in] offset Byte offset in text, must be at UTF-8
+	///                   sequence boundary
+	/// \param[in] text UTF-8 text
+	///
+	/// \returns Reference to self
+	///
+	/// \throws SDL2pp::Exception
+	/// \throws std::out_of_range if offset is past the end of text
+	///
+	////////////////////////////////////////////////////////////
+	TextLayout& Insert(size_t offset, const std::string& text);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get text
+	///
+	/// \returns UTF-8 text
+	///
+	////////////////////////////////////////////////////////////
+	const std::string& GetText() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set maximal line width
+	///
+	/// \param[in] width Maximal line width, 0 to disable wrapping
+	///
+	/// \returns Reference to self
+	///
+	////////////////////////////////////////////////////////////
+	TextLayout& SetWidth(int width);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get maximal line width
+	///
+	/// \returns Maximal line width, 0 if wrapping is disabled
+	///
+	////////////////////////////////////////////////////////////
+	int GetWidth() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set horizontal line alignment
+	///
+	/// Alignment has no effect if wrapping is disabled
+	///
+	/// \param[in] alignment Horizontal line alignment
+	///
+	/// \returns Reference to self
+	///
+	////////////////////////////////////////////////////////////
+	TextLayout& SetAlignment(TextAlignment alignment);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get horizontal line alignment
+	///
+	/// \returns Horizontal line alignment
+	///
+	////////////////////////////////////////////////////////////
+	TextAlignment GetAlignment() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set line breaking algorithm
+	///
+	/// \param[in] breaking Line breaking algorithm
+	///
+	/// \returns Reference to self
+	///
+	////////////////////////////////////////////////////////////
+	TextLayout& SetLineBreaking(LineBreaking breaking);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get line breaking algorithm
+	///
+	/// \returns Line breaking algorithm
+	///
+	////////////////////////////////////////////////////////////
+	LineBreaking GetLineBreaking() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set distance between tops of adjacent lines
+	///
+	/// \param[in] line_height Line height in pixels
+	///
+	/// \returns Reference to self
+	///
+	/// \throws std::invalid_argument if line height is not positive
+	///
+	////////////////////////////////////////////////////////////
+	TextLayout& SetLineHeight(int line_height);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get distance between tops of adjacent lines
+	///
+	/// \returns Line height in pixels
+	///
+	////////////////////////////////////////////////////////////
+	int GetLineHeight() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get number of lines
+	///
+	/// Empty text, as well as text ending with a newline, has an
+	/// empty last line
+	///
+	/// \returns Number of lines
+	///
+	////////////////////////////////////////////////////////////
+	size_t GetNumLines() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get laid out line
+	///
+	/// \param[in] index Index of line
+	///
+	/// \returns Line offsets and box
+	///
+	////////////////////////////////////////////////////////////
+	const Line& GetLine(size_t index) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get all laid out lines
+	///
+	/// \returns Lines in order from top to bottom
+	///
+	////////////////////////////////////////////////////////////
+	const std::vector<Line>& GetLines() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get size of laid out text
+	///
+	/// \returns Width of the widest line and total height of
+	///          all lines
+	///
+	////////////////////////////////////////////////////////////
+	Point GetSize() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Find line box containing a point
+	///
+	/// \param[in] point Point relative to layout origin
+	///
+	/// \returns Index of line, or NullOpt if point is not inside
+	///          any line box
+	///
+	////////////////////////////////////////////////////////////
+	Optional<size_t> GetLineAt(const Point& point) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Find text offset nearest to a point
+	///
+	/// Suitable for placing text cursor with mouse: the line
+	/// is chosen vertically, clamping to the first and the last
+	/// one, and the offset is that of the char boundary nearest
+	/// to point horizontally
+	///
+	/// \param[in] point Point relative to layout origin
+	///
+	/// \returns Byte offset in text
+	///
+	/// \throws SDL2pp::Exception
+	///
+	////////////////////////////////////////////////////////////
+	size_t GetOffsetAt(const Point& point) const;
+};
+
+}
+
+#endif
@@ -21,11 +21,13 @@
 
 #include <utility>
 #include <algorithm>
+#include <vector>
 #include <cassert>
 
 #include <SDL2pp/Config.hh>
 
 #include <SDL_render.h>
+#include <SDL_surface.h>
 #ifdef SDL2PP_WITH_IMAGE
 #	include <SDL_image.h>
 #endif
@@ -36,36 +38,130 @@
 #include <SDL2pp/Exception.hh>
 #include <SDL2pp/Rect.hh>
 #include <SDL2pp/Surface.hh>
+#include <SDL2pp/PremultipliedAlpha.hh>
 #ifdef SDL2PP_WITH_IMAGE
 #	include <SDL2pp/RWops.hh>
 #endif
 
 namespace SDL2pp {
 
-Texture::Texture(SDL_Texture* texture) : texture_(texture) {
+Texture::Texture(SDL_Texture* texture) : texture_(texture), format_(0), access_(0), width_(0), height_(0) {
 	assert(texture);
+
+	// can only fail for invalid texture, which is caller's error,
+	// same as passing null pointer
+	int result = SDL_QueryTexture(texture_, &format_, &access_, &width_, &height_);
+	assert(result == 0);
+	(void)result;
 }
 
 Texture::Texture(Renderer& renderer, Uint32 format, int access, int w, int h) {
 	if ((texture_ = SDL_CreateTexture(renderer.Get(), format, access, w, h)) == nullptr)
 		throw Exception("SDL_CreateTexture");
+	QueryProperties();
 }
 
 #ifdef SDL2PP_WITH_IMAGE
 Texture::Texture(Renderer& renderer, RWops& rwops) {
 	if ((texture_ = IMG_LoadTexture_RW(renderer.Get(), rwops.Get(), 0)) == nullptr)
 		throw Exception("IMG_LoadTexture_RW");
+	QueryProperties();
 }
 
 Texture::Texture(Renderer& renderer, const std::string& path) {
 	if ((texture_ = IMG_LoadTexture(renderer.Get(), path.c_str())) == nullptr)
 		throw Exception("IMG_LoadTexture");
+	QueryProperties();
 }
 #endif
 
 Texture::Texture(Renderer& renderer, const Surface& surface) {
 	if ((texture_ = SDL_CreateTextureFromSurface(renderer.Get(), surface.Get())) == nullptr)
 		throw Exception("SDL_CreateTextureFromSurface");
+	QueryProperties();
+}
+
+Texture::Texture(Renderer& renderer, const Surface& surface, bool premultiply_alpha) {
+	SDL_Surface* src = surface.Get();
+
+	Uint32 colorkey;
+	bool indexed = SDL_ISPIXELFORMAT_INDEXED(src->format->format);
+	bool keyed = SDL_GetColorKey(src, &colorkey) == 0;
+
+	if (!premultiply_alpha || (src->format->Amask == 0 && !indexed && !keyed)) {
+		if ((texture_ = SDL_CreateTextureFromSurface(renderer.Get(), src)) == nullptr)
+			throw Exception("SDL_CreateTextureFromSurface");
+		QueryProperties();
+		return;
+	}
+
+	// turn palette and color key into alpha channel
+	Optional<Surface> converted;
+	if (indexed || keyed) {
+		SDL_Surface* tmp = SDL_ConvertSurfaceFormat(src, SDL_PIXELFORMAT_ARGB8888, 0);
+		if (tmp == nullptr)
+			throw Exception("SDL_ConvertSurfaceFormat");
+		converted.emplace(tmp);
+		src = tmp;
+	}
+
+	Uint32 src_format = src->format->format;
+	Uint32 format = PremultipliedAlpha::IsFormatSupported(src_format) ? src_format : static_cast<Uint32>(SDL_PIXELFORMAT_ARGB8888);
+
+	if ((texture_ = SDL_CreateTexture(renderer.Get(), format, SDL_TEXTUREACCESS_STATIC, src->w, src->h)) == nullptr)
+		throw Exception("SDL_CreateTexture");
+	QueryProperties();
+
+	if (SDL_MUSTLOCK(src) && SDL_LockSurface(src) != 0) {
+		SDL_DestroyTexture(texture_);
+		throw Exception("SDL_LockSurface");
+	}
+
+	try {
+		// process bands of rows small enough to stay in cache
+		// between conversion, premultiplication and upload
+		const int band_rows = 64;
+		int pitch = src->w * 4;
+		std::vector<unsigned char> band(static_cast<size_t>(pitch) * std::min(band_rows, src->h));
+
+		for (int y = 0; y < src->h; y += band_rows) {
+			int rows = std::min(band_rows, src->h - y);
+			const Uint8* src_pixels = static_cast<const Uint8*>(src->pixels) + y * src->pitch;
+
+			if (src_format == format) {
+				PremultipliedAlpha::Premultiply(src->w, rows, format, src_pixels, src->pitch, band.data(), pitch);
+			} else {
+				if (SDL_ConvertPixels(src->w, rows, src_format, src_pixels, src->pitch, format, band.data(), pitch) != 0)
+					throw Exception("SDL_ConvertPixels");
+				PremultipliedAlpha::Premultiply(src->w, rows, format, band.data(), pitch, band.data(), pitch);
+			}
+
+			Update(Rect(0, y, src->w, rows), band.data(), pitch);
+		}
+
+		// same as SDL_CreateTextureFromSurface
+		Uint8 r, g, b, a;
+		SDL_GetSurfaceColorMod(surface.Get(), &r, &g, &b);
+		SDL_GetSurfaceAlphaMod(surface.Get(), &a);
+		SetColorMod(r, g, b);
+		SetAlphaMod(a);
+	} catch (...) {
+		if (SDL_MUSTLOCK(src))
+			SDL_UnlockSurface(src);
+		SDL_DestroyTexture(texture_);
+		throw;
+	}
+
+	if (SDL_MUSTLOCK(src))
+		SDL_UnlockSurface(src);
+}
+
+void Texture::QueryProperties() {
+	if (SDL_QueryTexture(texture_, &format_, &access_, &width_, &height_) != 0) {
+		Exception e("SDL_QueryTexture");
+		SDL_DestroyTexture(texture_);
+		throw e;
+	}
 }
 
 Texture::~Texture() {
@@ -73,7 +169,7 @@ Texture::~Texture() {
 		SDL_DestroyTexture(texture_);
 }
 
-Texture::Texture(Texture&& other) noexcept : texture_(other.texture_) {
+Texture::Texture(Texture&& other) noexcept : texture_(other.texture_), format_(other.format_), access_(other.access_), width_(other.width_), height_(other.height_), conversion_buffer_(std::move(other.conversion_buffer_)) {
 	other.texture_ = nullptr;
 }
 
@@ -83,6 +179,11 @@ Texture& Texture::operator=(Texture&& other) noexcept {
 	if (texture_ != nullptr)
 		SDL_DestroyTexture(texture_);
 	texture_ = other.texture_;
+	format_ = other.format_;
+	access_ = other.access_;
+	width_ = other.width_;
+	height_ = other.height_;
+	conversion_buffer_ = std::move(other.conversion_buffer_);
 	other.texture_ = nullptr;
 	return *this;
 }
@@ -103,34 +204,41 @@ Texture& Texture::Update(const Optional<Rect>& rect, Surface& surface) {
 	real_rect.w = std::min(real_rect.w, surface.GetWidth());
 	real_rect.h = std::min(real_rect.h, surface.GetHeight());
 
-	if (GetFormat() == surface.GetFormat()) {
+	Uint32 surface_format = surface.GetFormat();
+
+	if (GetFormat() == surface_format) {
 		Surface::LockHandle lock = surface.Lock();
 
 		return Update(real_rect, lock.GetPixels(), lock.GetPitch());
-	} else {
+	}
+
+	// palette and color key are only handled by full surface conversion,
+	// and YUV targets are not supported by SDL_ConvertPixels everywhere
+	Uint32 colorkey;
+	if (SDL_ISPIXELFORMAT_INDEXED(surface_format) || SDL_ISPIXELFORMAT_FOURCC(GetFormat()) || SDL_GetColorKey(surface.Get(), &colorkey) == 0) {
 		Surface converted = surface.Convert(GetFormat());
 		Surface::LockHandle lock = converted.Lock();
 
 		return Update(real_rect, lock.GetPixels(), lock.GetPitch());
 	}
-}
 
-Texture& Texture::Update(const Optional<Rect>& rect, Surface&& surface) {
-	Rect real_rect = rect ? *rect : Rect(0, 0, GetWidth(), GetHeight());
+	Surface::LockHandle lock = surface.Lock();
 
-	real_rect.w = std::min(real_rect.w, surface.GetWidth());
-	real_rect.h = std::min(real_rect.h, surface.GetHeight());
+	// only convert the part being uploaded, into scratch buffer which
+	// is kept between calls
+	int pitch = real_rect.w * SDL_BYTESPERPIXEL(GetFormat());
+	size_t size = static_cast<size_t>(pitch) * static_cast<size_t>(real_rect.h);
+	if (conversion_buffer_.size() < size)
+		conversion_buffer_.resize(size);
 
-	if (GetFormat() == surface.GetFormat()) {
-		Surface::LockHandle lock = surface.Lock();
+	if (SDL_ConvertPixels(real_rect.w, real_rect.h, surface_format, lock.GetPixels(), lock.GetPitch(), GetFormat(), conversion_buffer_.data(), pitch) != 0)
+		throw Exception("SDL_ConvertPixels");
 
-		return Update(real_rect, lock.GetPixels(), lock.GetPitch());
-	} else {
-		Surface converted = surface.Convert(GetFormat());
-		Surface::LockHandle lock = converted.Lock();
+	return Update(real_rect, conversion_buffer_.data(), pitch);
+}
 
-		return Update(real_rect, lock.GetPixels(), lock.GetPitch());
-	}
+Texture& Texture::Update(const Optional<Rect>& rect, Surface&& surface) {
+	return Update(rect, surface);
 }
 
 Texture& Texture::UpdateYUV(const Optional<Rect>& rect, const Uint8* yplane, int ypitch, const Uint8* uplane, int upitch, const Uint8* vplane, int vpitch) {
@@ -166,38 +274,23 @@ Texture::LockHandle Texture::Lock(const Optional<Rect>& rect) {
 }
 
 Uint32 Texture::GetFormat() const {
-	Uint32 format;
-	if (SDL_QueryTexture(texture_, &format, nullptr, nullptr, nullptr) != 0)
-		throw Exception("SDL_QueryTexture");
-	return format;
+	return format_;
 }
 
 int Texture::GetAccess() const {
-	int access;
-	if (SDL_QueryTexture(texture_, nullptr, &access, nullptr, nullptr) != 0)
-		throw Exception("SDL_QueryTexture");
-	return access;
+	return access_;
 }
 
 int Texture::GetWidth() const {
-	int w;
-	if (SDL_QueryTexture(texture_, nullptr, nullptr, &w, nullptr) != 0)
-		throw Exception("SDL_QueryTexture");
-	return w;
+	return width_;
 }
 
 int Texture::GetHeight() const {
-	int h;
-	if (SDL_QueryTexture(texture_, nullptr, nullptr, nullptr, &h) != 0)
-		throw Exception("SDL_QueryTexture");
-	return h;
+	return height_;
 }
 
 Point Texture::GetSize() const {
-	int w, h;
-	if (SDL_QueryTexture(texture_, nullptr, nullptr, &w, &h) != 0)
-		throw Exception("SDL_QueryTexture");
-	return Point(w, h);
+	return Point(width_, height_);
 }
 
 Uint8 Texture::GetAlphaMod() const {
@@ -23,6 +23,7 @@
 #define SDL2PP_TEXTURE_HH
 
 #include <string>
+#include <vector>
 
 #include <SDL_stdinc.h>
 #include <SDL_blendmode.h>
@@ -54,6 +55,27 @@ class SDL2PP_EXPORT Texture {
 private:
 	SDL_Texture* texture_; ///< Managed SDL_Texture object
 
+	Uint32 format_;        ///< Cached texture format
+	int access_;           ///< Cached texture access mode
+	int width_;            ///< Cached texture width
+	int height_;           ///< Cached texture height
+
+	std::vector<unsigned char> conversion_buffer_; ///< Scratch space for pixel format conversion in Update()
+
+private:
+	////////////////////////////////////////////////////////////
+	/// \brief Query and cache immutable texture properties
+	///
+	/// Destroys the texture on failure, so constructors may call
+	/// this right after creating it.
+	///
+	/// \throws SDL2pp::Exception
+	///
+	/// \see http://wiki.libsdl.org/SDL_QueryTexture
+	///
+	////////////////////////////////////////////////////////////
+	void QueryProperties();
+
 public:
 	////////////////////////////////////////////////////////////
 	/// \brief SDL2pp::Texture lock
@@ -247,6 +269,34 @@ public:
 	////////////////////////////////////////////////////////////
 	Texture(Renderer& renderer, const Surface& surface);
 
+	////////////////////////////////////////////////////////////
+	/// \brief Create texture from surface, optionally premultiplying
+	///        alpha while uploading
+	///
+	/// With premultiply_alpha, pixels are converted and premultiplied
+	/// in bands into scratch buffer and uploaded from there, without
+	/// modifying or copying the surface as a whole. Palette and color
+	/// key are turned into alpha channel first. Texture gets the same
+	/// format as surface if it is a 32 bit format with 8 bit channels
+	/// and alpha, SDL_PIXELFORMAT_ARGB8888 otherwise. Texture blend
+	/// mode is left as SDL_BLENDMODE_NONE, set it to
+	/// SDL2pp::PremultipliedAlpha::GetBlendMode() to draw the texture.
+	///
+	/// Surfaces without any transparency, and all surfaces if
+	/// premultiply_alpha is false, are handled the same way as
+	/// Texture(Renderer&, const Surface&) does.
+	///
+	/// \param[in] renderer Rendering context to create texture for
+	/// \param[in] surface Surface containing pixel data used to fill the texture
+	/// \param[in] premultiply_alpha Whether to premultiply alpha
+	///
+	/// \throws SDL2pp::Exception
+	///
+	/// \see SDL2pp::PremultipliedAlpha
+	///
+	////////////////////////////////////////////////////////////
+	Texture(Renderer& renderer, const Surface& surface, bool premultiply_alpha);
+
 	////////////////////////////////////////////////////////////
 	/// \brief Destructor
 	///
@@ -324,8 +374,12 @@ public:
 	///
 	/// \note No scaling is performed in this routine, so if rect and surface
 	///       sizes do not match, cropping is performed as appropriate
-	/// \note If surface and texture pixel formats do not match, surface is
-	///       automatically converted to texture format
+	/// \note If surface and texture pixel formats do not match, the
+	///       uploaded part of the surface is converted into a scratch
+	///       buffer kept by the texture, so repeated updates of the same
+	///       size do not allocate. Indexed and color keyed surfaces and
+	///       FOURCC textures are still converted through a temporary
+	///       surface
 	///
 	/// \returns Reference to self
 	///
@@ -345,8 +399,12 @@ public:
 	///
 	/// \note No scaling is performed in this routine, so if rect and surface
 	///       sizes do not match, cropping is performed as appropriate
-	/// \note If surface and texture pixel formats do not match, surface is
-	///       automatically converted to texture format
+	/// \note If surface and texture pixel formats do not match, the
+	///       uploaded part of the surface is converted into a scratch
+	///       buffer kept by the texture, so repeated updates of the same
+	///       size do not allocate. Indexed and color keyed surfaces and
+	///       FOURCC textures are still converted through a temporary
+	///       surface
 	///
 	/// \returns Reference to self
 	///
@@ -457,7 +515,7 @@ public:
 	///
 	/// \return Texture raw format
 	///
-	/// \throws SDL2pp::Exception
+	/// \note Value is queried once on construction and cached
 	///
 	/// \see http://wiki.libsdl.org/SDL_QueryTexture
 	/// \see http://wiki.libsdl.org/SDL_QueryTexture#format
@@ -471,7 +529,7 @@ public:
 	///
 	/// \return Texture access pattern
 	///
-	/// \throws SDL2pp::Exception
+	/// \note Value is queried once on construction and cached
 	///
 	/// \see http://wiki.libsdl.org/SDL_QueryTexture
 	/// \see http://wiki.libsdl.org/SDL_TextureAccess
@@ -484,7 +542,7 @@ public:
 	///
 	/// \return Texture width in pixels
 	///
-	/// \throws SDL2pp::Exception
+	/// \note Value is queried once on construction and cached
 	///
 	/// \see http://wiki.libsdl.org/SDL_QueryTexture
 	///
@@ -496,7 +554,7 @@ public:
 	///
 	/// \return Texture height in pixels
 	///
-	/// \throws SDL2pp::Exception
+	/// \note Value is queried once on construction and cached
 	///
 	/// \see http://wiki.libsdl.org/SDL_QueryTexture
 	///
@@ -508,7 +566,7 @@ public:
 	///
 	/// \return SDL2pp::Point representing texture dimensions in pixels
 	///
-	/// \throws SDL2pp::Exception
+	/// \note Value is queried once on construction and cached
 	///
 	/// \see http://wiki.libsdl.org/SDL_QueryTexture
 	///
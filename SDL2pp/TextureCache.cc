@@ -0,0 +1,134 @@
+/*
+  libSDL2pp - C++11 bindings/wrapper for SDL2
+  Copyright (C) 2013-2016 Dmitry Marakasov <amdmi3@amdmi3.ru>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include <SDL2pp/Config.hh>
+
+#include <SDL_pixels.h>
+
+#include <SDL2pp/TextureCache.hh>
+#include <SDL2pp/Renderer.hh>
+#ifdef SDL2PP_WITH_IMAGE
+#	include <SDL2pp/RWops.hh>
+#endif
+
+namespace SDL2pp {
+
+TextureCache::TextureCache(Renderer& renderer, size_t budget) : renderer_(&renderer), budget_(budget), used_(0) {
+}
+
+void TextureCache::Trim() {
+	EntryList::iterator entry = entries_.end();
+	while (used_ > budget_ && entry != entries_.begin()) {
+		--entry;
+		if (entry->texture.use_count() > 1)
+			continue; // still in use; evicting won't free anything
+
+		used_ -= entry->bytes;
+		index_.erase(entry->key);
+		entry = entries_.erase(entry);
+	}
+}
+
+#ifdef SDL2PP_WITH_IMAGE
+std::shared_ptr<Texture> TextureCache::Get(const std::string& path) {
+	return Get(path, [&path](Renderer& renderer) {
+			return Texture(renderer, path);
+		});
+}
+
+std::shared_ptr<Texture> TextureCache::Get(const std::string& key, RWops& rwops) {
+	return Get(key, [&rwops](Renderer& renderer) {
+			return Texture(renderer, rwops);
+		});
+}
+#endif
+
+std::shared_ptr<Texture> TextureCache::Get(const std::string& key, const Loader& loader) {
+	auto existing = index_.find(key);
+	if (existing != index_.end()) {
+		// move to front
+		entries_.splice(entries_.begin(), entries_, existing->second);
+		return existing->second->texture;
+	}
+
+	std::shared_ptr<Texture> texture = std::make_shared<Texture>(loader(*renderer_));
+	size_t bytes = GetTextureBytes(*texture);
+
+	entries_.push_front(Entry{key, texture, bytes});
+	index_.emplace(key, entries_.begin());
+	used_ += bytes;
+
+	Trim();
+
+	return texture;
+}
+
+bool TextureCache::Contains(const std::string& key) const {
+	return index_.find(key) != index_.end();
+}
+
+bool TextureCache::Remove(const std::string& key) {
+	auto existing = index_.find(key);
+	if (existing == index_.end())
+		return false;
+
+	used_ -= existing->second->bytes;
+	entries_.erase(existing->second);
+	index_.erase(existing);
+	return true;
+}
+
+void TextureCache::Clear() {
+	index_.clear();
+	entries_.clear();
+	used_ = 0;
+}
+
+void TextureCache::SetBudget(size_t budget) {
+	budget_ = budget;
+	Trim();
+}
+
+size_t TextureCache::GetBudget() const {
+	return budget_;
+}
+
+size_t TextureCache::GetUsedBytes() const {
+	return used_;
+}
+
+size_t TextureCache::GetNumEntries() const {
+	return entries_.size();
+}
+
+size_t TextureCache::GetTextureBytes(const Texture& texture) {
+	size_t pixels = static_cast<size_t>(texture.GetWidth()) * static_cast<size_t>(texture.GetHeight());
+	Uint32 format = texture.GetFormat();
+
+	// planar YUV formats: full resolution luma plus subsampled chroma,
+	// 2 bytes per pixel is an upper bound for all of them
+	if (SDL_ISPIXELFORMAT_FOURCC(format))
+		return pixels * 2;
+
+	return pixels * SDL_BYTESPERPIXEL(format);
+}
+
+}
@@ -0,0 +1,260 @@
+/*
+  libSDL2pp - C++11 bindings/wrapper for SDL2
+  Copyright (C) 2013-2016 Dmitry Marakasov <amdmi3@amdmi3.ru>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef SDL2PP_TEXTURECACHE_HH
+#define SDL2PP_TEXTURECACHE_HH
+
+#include <functional>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include <SDL2pp/Config.hh>
+#include <SDL2pp/Texture.hh>
+#include <SDL2pp/Export.hh>
+
+namespace SDL2pp {
+
+class Renderer;
+class RWops;
+
+////////////////////////////////////////////////////////////
+/// \brief Least recently used cache of textures
+///
+/// \ingroup rendering
+///
+/// \headerfile SDL2pp/TextureCache.hh
+///
+/// Loads each texture once and hands out shared handles to it
+/// on subsequent requests with the same key (usually, an asset
+/// path).
+///
+/// Cache keeps track of approximate video memory used by each
+/// texture (width * height * bytes per pixel), and once the
+/// total exceeds configured budget, least recently used textures
+/// are dropped from the cache. Textures still referenced from
+/// outside of the cache are never evicted, as this would not
+/// free any memory.
+///
+/// Usage example:
+/// \code
+/// {
+///     SDL2pp::TextureCache cache(renderer, 64 * 1024 * 1024);
+///
+///     std::shared_ptr<SDL2pp::Texture> a = cache.Get("crate.png");
+///     std::shared_ptr<SDL2pp::Texture> b = cache.Get("crate.png");
+///
+///     // a and b refer to the same texture
+/// }
+/// \endcode
+///
+////////////////////////////////////////////////////////////
+class SDL2PP_EXPORT TextureCache {
+public:
+	////////////////////////////////////////////////////////////
+	/// \brief Function which creates texture on cache miss
+	///
+	////////////////////////////////////////////////////////////
+	typedef std::function<Texture(Renderer&)> Loader;
+
+private:
+	////////////////////////////////////////////////////////////
+	/// \brief Cached texture
+	///
+	////////////////////////////////////////////////////////////
+	struct Entry {
+		std::string key;                  ///< Key the texture is stored under
+		std::shared_ptr<Texture> texture; ///< Cached texture
+		size_t bytes;                     ///< Approximate memory used by the texture
+	};
+
+	typedef std::list<Entry> EntryList;
+
+	Renderer* renderer_;        ///< Renderer to create textures with
+	size_t budget_;             ///< Memory budget in bytes
+	size_t used_;               ///< Memory used by cached textures in bytes
+
+	EntryList entries_;         ///< Cached textures, most recently used first
+	std::unordered_map<std::string, EntryList::iterator> index_; ///< Key to entry mapping
+
+private:
+	////////////////////////////////////////////////////////////
+	/// \brief Evict least recently used unreferenced textures
+	///        until memory usage fits the budget
+	///
+	////////////////////////////////////////////////////////////
+	void Trim();
+
+public:
+	////////////////////////////////////////////////////////////
+	/// \brief Create empty cache
+	///
+	/// \param[in] renderer Rendering context to create textures for
+	/// \param[in] budget Memory budget in bytes
+	///
+	////////////////////////////////////////////////////////////
+	TextureCache(Renderer& renderer, size_t budget);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Deleted copy constructor
+	///
+	/// This class is not copyable
+	///
+	////////////////////////////////////////////////////////////
+	TextureCache(const TextureCache& other) = delete;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Deleted assignment operator
+	///
+	/// This class is not copyable
+	///
+	////////////////////////////////////////////////////////////
+	TextureCache& operator=(const TextureCache& other) = delete;
+
+#ifdef SDL2PP_WITH_IMAGE
+	////////////////////////////////////////////////////////////
+	/// \brief Get texture loaded from file
+	///
+	/// \param[in] path Path to image file, used as a cache key
+	///
+	/// \returns Shared handle to the texture
+	///
+	/// \throws SDL2pp::Exception
+	///
+	/// \see http://www.libsdl.org/projects/SDL_image/docs/SDL_image.html#SEC52
+	///
+	////////////////////////////////////////////////////////////
+	std::shared_ptr<Texture> Get(const std::string& path);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get texture loaded from RWops
+	///
+	/// RWops is only read on cache miss.
+	///
+	/// \param[in] key Cache key identifying the image
+	/// \param[in] rwops RWops used to access an image file
+	///
+	/// \returns Shared handle to the texture
+	///
+	/// \throws SDL2pp::Exception
+	///
+	/// \see http://www.libsdl.org/projects/SDL_image/docs/SDL_image.html#SEC52
+	///
+	////////////////////////////////////////////////////////////
+	std::shared_ptr<Texture> Get(const std::string& key, RWops& rwops);
+#endif
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get texture created by arbitrary function
+	///
+	/// \param[in] key Cache key identifying the texture
+	/// \param[in] loader Function which creates the texture, called
+	///                   on cache miss
+	///
+	/// \returns Shared handle to the texture
+	///
+	/// \throws Anything loader throws
+	///
+	////////////////////////////////////////////////////////////
+	std::shared_ptr<Texture> Get(const std::string& key, const Loader& loader);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Check whether texture is in the cache
+	///
+	/// Does not affect recently used order.
+	///
+	/// \param[in] key Cache key
+	///
+	/// \returns True if texture is cached
+	///
+	////////////////////////////////////////////////////////////
+	bool Contains(const std::string& key) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Remove texture from the cache
+	///
+	/// Texture is destroyed when last outside handle is released.
+	///
+	/// \param[in] key Cache key
+	///
+	/// \returns True if texture was in the cache
+	///
+	////////////////////////////////////////////////////////////
+	bool Remove(const std::string& key);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Remove all textures from the cache
+	///
+	////////////////////////////////////////////////////////////
+	void Clear();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set memory budget
+	///
+	/// Evicts textures if needed.
+	///
+	/// \param[in] budget Memory budget in bytes
+	///
+	////////////////////////////////////////////////////////////
+	void SetBudget(size_t budget);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get memory budget
+	///
+	/// \returns Memory budget in bytes
+	///
+	////////////////////////////////////////////////////////////
+	size_t GetBudget() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get memory used by cached textures
+	///
+	/// May exceed the budget if textures are referenced
+	/// from outside of the cache.
+	///
+	/// \returns Approximate memory usage in bytes
+	///
+	////////////////////////////////////////////////////////////
+	size_t GetUsedBytes() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get number of cached textures
+	///
+	/// \returns Number of cached textures
+	///
+	////////////////////////////////////////////////////////////
+	size_t GetNumEntries() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Estimate memory used by a texture
+	///
+	/// \param[in] texture Texture to estimate memory usage for
+	///
+	/// \returns Width * height * bytes per pixel
+	///
+	////////////////////////////////////////////////////////////
+	static size_t GetTextureBytes(const Texture& texture);
+};
+
+}
+
+#endif
@@ -0,0 +1,152 @@
+/*
+  libSDL2pp - C++11 bindings/wrapper for SDL2
+  Copyright (C) 2013-2016 Dmitry Marakasov <amdmi3@amdmi3.ru>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include <algorithm>
+#include <exception>
+#include <utility>
+
+#include <SDL2pp/ThreadPool.hh>
+
+namespace SDL2pp {
+
+ThreadPool::ThreadPool(unsigned int num_threads) : shutdown_(false) {
+	if (num_threads == 0) {
+		unsigned int hardware_threads = std::thread::hardware_concurrency();
+		num_threads = hardware_threads > 1 ? hardware_threads - 1 : 0;
+	}
+
+	workers_.reserve(num_threads);
+	for (unsigned int i = 0; i < num_threads; i++)
+		workers_.emplace_back(&ThreadPool::WorkerMain, this);
+}
+
+ThreadPool::~ThreadPool() {
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		shutdown_ = true;
+	}
+	cond_.notify_all();
+
+	for (auto& worker : workers_)
+		worker.join();
+}
+
+void ThreadPool::WorkerMain() {
+	std::unique_lock<std::mutex> lock(mutex_);
+	while (true) {
+		cond_.wait(lock, [this]{ return shutdown_ || !tasks_.empty(); });
+
+		if (shutdown_)
+			return;
+
+		std::function<void()> task = std::move(tasks_.front());
+		tasks_.pop_front();
+
+		lock.unlock();
+		task();
+		lock.lock();
+	}
+}
+
+unsigned int ThreadPool::GetConcurrency() const {
+	return static_cast<unsigned int>(workers_.size()) + 1;
+}
+
+void ThreadPool::ParallelFor(int begin, int end, int min_chunk, const RangeFunction& function) {
+	if (end <= begin)
+		return;
+
+	int count = end - begin;
+	int num_chunks = std::min(static_cast<int>(GetConcurrency()), count / std::max(min_chunk, 1));
+
+	if (num_chunks < 2) {
+		function(begin, end);
+		return;
+	}
+
+	// state shared by all chunks, protected by mutex_
+	int remaining = num_chunks;
+	std::exception_ptr error;
+
+	auto run_chunk = [&](int chunk) {
+		int chunk_begin = begin + static_cast<int>(static_cast<long long>(count) * chunk / num_chunks);
+		int chunk_end = begin + static_cast<int>(static_cast<long long>(count) * (chunk + 1) / num_chunks);
+
+		std::exception_ptr chunk_error;
+		try {
+			function(chunk_begin, chunk_end);
+		} catch (...) {
+			chunk_error = std::current_exception();
+		}
+
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (chunk_error && !error)
+			error = chunk_error;
+		if (--remaining == 0)
+			cond_.notify_all();
+	};
+
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		for (int chunk = 1; chunk < num_chunks; chunk++)
+			tasks_.emplace_back([&run_chunk, chunk]() { run_chunk(chunk); });
+	}
+	cond_.notify_all();
+
+	run_chunk(0);
+
+	// help with queued tasks (possibly of other operations) while
+	// waiting, so nested calls from worker threads can't deadlock
+	std::unique_lock<std::mutex> lock(mutex_);
+	while (remaining > 0) {
+		if (!tasks_.empty()) {
+			std::function<void()> task = std::move(tasks_.front());
+			tasks_.pop_front();
+
+			lock.unlock();
+			task();
+			lock.lock();
+		} else {
+			cond_.wait(lock);
+		}
+	}
+
+	if (error)
+		std::rethrow_exception(error);
+}
+
+void ThreadPool::Submit(std::function<void()> task) {
+	if (workers_.empty()) {
+		task();
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		tasks_.emplace_back(std::move(task));
+	}
+	// waiters in ParallelFor share the condition, so wake everyone
+	// to make sure the task is not left for a thread which is
+	// about to return
+	cond_.notify_all();
+}
+
+}
@@ -0,0 +1,165 @@
+/*
+  libSDL2pp - C++11 bindings/wrapper for SDL2
+  Copyright (C) 2013-2016 Dmitry Marakasov <amdmi3@amdmi3.ru>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef SDL2PP_THREADPOOL_HH
+#define SDL2PP_THREADPOOL_HH
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <SDL2pp/Export.hh>
+
+namespace SDL2pp {
+
+////////////////////////////////////////////////////////////
+/// \brief Pool of worker threads for data parallel operations
+///
+/// \ingroup general
+///
+/// \headerfile SDL2pp/ThreadPool.hh
+///
+/// Used by parallel variants of CPU heavy operations, such
+/// as SDL2pp::Surface::Convert(). Pool may be shared between
+/// any number of operations and threads.
+///
+/// Usage example:
+/// \code
+/// {
+///     SDL2pp::ThreadPool pool;
+///
+///     SDL2pp::Surface converted = screenshot.Convert(SDL_PIXELFORMAT_RGB24, pool);
+/// }
+/// \endcode
+///
+////////////////////////////////////////////////////////////
+class SDL2PP_EXPORT ThreadPool {
+public:
+	////////////////////////////////////////////////////////////
+	/// \brief Function processing range of items
+	///
+	/// \param[in] begin First item of the range
+	/// \param[in] end Item past the last one in the range
+	///
+	////////////////////////////////////////////////////////////
+	typedef std::function<void(int begin, int end)> RangeFunction;
+
+private:
+	std::vector<std::thread> workers_;           ///< Worker threads
+	std::mutex mutex_;                           ///< Mutex protecting everything below
+	std::condition_variable cond_;               ///< Signaled when a task is queued, finished, or on shutdown
+	std::deque<std::function<void()>> tasks_;    ///< Queued tasks
+	bool shutdown_;                              ///< Whether workers should terminate
+
+private:
+	////////////////////////////////////////////////////////////
+	/// \brief Worker thread main loop
+	///
+	////////////////////////////////////////////////////////////
+	void WorkerMain();
+
+public:
+	////////////////////////////////////////////////////////////
+	/// \brief Create pool and start worker threads
+	///
+	/// \param[in] num_threads Number of worker threads, 0 to use
+	///                        number of hardware threads minus one
+	///                        (as calling thread takes part in work)
+	///
+	////////////////////////////////////////////////////////////
+	ThreadPool(unsigned int num_threads = 0);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Destructor
+	///
+	/// Stops worker threads. Must not be called while any
+	/// operation is in progress.
+	///
+	////////////////////////////////////////////////////////////
+	virtual ~ThreadPool();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Deleted copy constructor
+	///
+	/// This class is not copyable
+	///
+	////////////////////////////////////////////////////////////
+	ThreadPool(const ThreadPool& other) = delete;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Deleted assignment operator
+	///
+	/// This class is not copyable
+	///
+	////////////////////////////////////////////////////////////
+	ThreadPool& operator=(const ThreadPool& other) = delete;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get number of threads taking part in work
+	///
+	/// \returns Number of worker threads plus one for the
+	///          calling thread
+	///
+	////////////////////////////////////////////////////////////
+	unsigned int GetConcurrency() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Process range of items in parallel
+	///
+	/// Splits [begin, end) into at most GetConcurrency() chunks
+	/// of at least min_chunk items and processes them on worker
+	/// threads and the calling thread, returning when all chunks
+	/// are done. Ranges shorter than two chunks are processed on
+	/// the calling thread only. May be called from within another
+	/// parallel operation.
+	///
+	/// \param[in] begin First item of the range
+	/// \param[in] end Item past the last one in the range
+	/// \param[in] min_chunk Minimal number of items in a chunk
+	/// \param[in] function Function to process chunk of items
+	///
+	/// \throws Anything function throws; if several chunks throw,
+	///         the first exception is rethrown after all chunks finish
+	///
+	////////////////////////////////////////////////////////////
+	void ParallelFor(int begin, int end, int min_chunk, const RangeFunction& function);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Run task asynchronously on a worker thread
+	///
+	/// Returns immediately. Queued tasks may also be picked up
+	/// by threads waiting in ParallelFor(). If the pool has no
+	/// worker threads, task is run on the calling thread before
+	/// returning. Tasks still queued when the pool is destroyed
+	/// are discarded without running.
+	///
+	/// \param[in] task Function to run; must not throw
+	///
+	////////////////////////////////////////////////////////////
+	void Submit(std::function<void()> task);
+};
+
+}
+
+#endif
@@ -0,0 +1,144 @@
+/*
+  libSDL2pp - C++11 bindings/wrapper for SDL2
+  Copyright (C) 2013-2016 Dmitry Marakasov <amdmi3@amdmi3.ru>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef SDL2PP_UTF8_HH
+#define SDL2PP_UTF8_HH
+
+#include <SDL_stdinc.h>
+
+namespace SDL2pp {
+
+////////////////////////////////////////////////////////////
+/// \brief Decode single code point from UTF-8 string
+///
+/// \ingroup ttf
+///
+/// Malformed and truncated sequences, as well as encoded
+/// surrogates, decode into U+FFFD REPLACEMENT CHARACTER, the
+/// same way SDL_ttf treats them. At least one byte is always
+/// consumed.
+///
+/// \param[in,out] it Pointer to the first byte of a sequence,
+///                   advanced past it
+/// \param[in] end Pointer past the end of the string
+///
+/// \returns Decoded code point
+///
+////////////////////////////////////////////////////////////
+inline Uint32 DecodeUTF8(const char*& it, const char* end) {
+	const Uint32 replacement = 0xFFFD;
+
+	Uint8 lead = static_cast<Uint8>(*it++);
+	if (lead < 0x80)
+		return lead;
+
+	Uint32 ch;
+	int left;
+	if (lead >= 0xF8) {
+		return replacement;
+	} else if (lead >= 0xF0) {
+		ch = lead & 0x07;
+		left = 3;
+	} else if (lead >= 0xE0) {
+		ch = lead & 0x0F;
+		left = 2;
+	} else if (lead >= 0xC0) {
+		ch = lead & 0x1F;
+		left = 1;
+	} else {
+		return replacement; // stray continuation byte
+	}
+
+	for (; left > 0; left--) {
+		if (it == end || (static_cast<Uint8>(*it) & 0xC0) != 0x80)
+			return replacement;
+		ch = (ch << 6) | (static_cast<Uint8>(*it++) & 0x3F);
+	}
+
+	if ((ch >= 0xD800 && ch <= 0xDFFF) || ch > 0x10FFFF)
+		return replacement;
+
+	return ch;
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Decode single UCS-2 character from UTF-8 string
+///
+/// \ingroup ttf
+///
+/// Same as DecodeUTF8(), but code points outside of Basic
+/// Multilingual Plane, which SDL_ttf glyph functions can't
+/// address, are replaced with U+FFFD as well.
+///
+/// \param[in,out] it Pointer to the first byte of a sequence,
+///                   advanced past it
+/// \param[in] end Pointer past the end of the string
+///
+/// \returns Decoded character
+///
+////////////////////////////////////////////////////////////
+inline Uint16 DecodeUTF8ToUCS2(const char*& it, const char* end) {
+	Uint32 ch = DecodeUTF8(it, end);
+	return static_cast<Uint16>(ch > 0xFFFF ? 0xFFFD : ch);
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Encode single code point as UTF-8
+///
+/// \ingroup ttf
+///
+/// Surrogates and values over U+10FFFF are encoded as U+FFFD
+///
+/// \param[in] ch Code point to encode
+/// \param[out] out Buffer of at least 4 bytes to write
+///                 encoded sequence into
+///
+/// \returns Number of bytes written
+///
+////////////////////////////////////////////////////////////
+inline int EncodeUTF8(Uint32 ch, char* out) {
+	if ((ch >= 0xD800 && ch <= 0xDFFF) || ch > 0x10FFFF)
+		ch = 0xFFFD;
+
+	if (ch < 0x80) {
+		out[0] = static_cast<char>(ch);
+		return 1;
+	} else if (ch < 0x800) {
+		out[0] = static_cast<char>(0xC0 | (ch >> 6));
+		out[1] = static_cast<char>(0x80 | (ch & 0x3F));
+		return 2;
+	} else if (ch < 0x10000) {
+		out[0] = static_cast<char>(0xE0 | (ch >> 12));
+		out[1] = static_cast<char>(0x80 | ((ch >> 6) & 0x3F));
+		out[2] = static_cast<char>(0x80 | (ch & 0x3F));
+		return 3;
+	} else {
+		out[0] = static_cast<char>(0xF0 | (ch >> 18));
+		out[1] = static_cast<char>(0x80 | ((ch >> 12) & 0x3F));
+		out[2] = static_cast<char>(0x80 | ((ch >> 6) & 0x3F));
+		out[3] = static_cast<char>(0x80 | (ch & 0x3F));
+		return 4;
+	}
+}
+
+}
+
+#endif
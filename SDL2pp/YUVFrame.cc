@@ -0,0 +1,190 @@
+/*
+  libSDL2pp - C++11 bindings/wrapper for SDL2
+  Copyright (C) 2013-2016 Dmitry Marakasov <amdmi3@amdmi3.ru>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#include <SDL_pixels.h>
+
+#include <SDL2pp/YUVFrame.hh>
+
+namespace SDL2pp {
+
+namespace {
+
+size_t AlignUp(size_t value, size_t alignment) {
+	return (value + alignment - 1) & ~(alignment - 1);
+}
+
+}
+
+size_t YUVFrame::Layout(Uint8* base, int luma_pitch, int chroma_pitch, size_t alignment) {
+	const size_t chroma_height = static_cast<size_t>((height_ + 1) / 2);
+
+	size_t offsets[3];
+	offsets[0] = 0;
+	offsets[1] = AlignUp(static_cast<size_t>(luma_pitch) * static_cast<size_t>(height_), alignment);
+	offsets[2] = AlignUp(offsets[1] + static_cast<size_t>(chroma_pitch) * chroma_height, alignment);
+
+	size_t size = (num_planes_ == 3) ? offsets[2] + static_cast<size_t>(chroma_pitch) * chroma_height : offsets[2];
+
+	if (base == nullptr)
+		return size;
+
+	pitches_[0] = luma_pitch;
+	pitches_[1] = chroma_pitch;
+	pitches_[2] = (num_planes_ == 3) ? chroma_pitch : 0;
+
+	planes_[0] = base;
+	planes_[1] = base + offsets[1];
+	planes_[2] = (num_planes_ == 3) ? base + offsets[2] : nullptr;
+
+	// YV12 stores V plane before U plane
+	if (format_ == SDL_PIXELFORMAT_YV12)
+		std::swap(planes_[1], planes_[2]);
+
+	return size;
+}
+
+YUVFrame::YUVFrame(Uint32 format, int w, int h, size_t alignment) : format_(format), width_(w), height_(h) {
+	if (!IsSupportedFormat(format))
+		throw std::invalid_argument("unsupported YUV frame format");
+	if (alignment == 0 || (alignment & (alignment - 1)) != 0)
+		throw std::invalid_argument("YUV frame alignment must be power of two");
+
+	num_planes_ = (format == SDL_PIXELFORMAT_NV12 || format == SDL_PIXELFORMAT_NV21) ? 2 : 3;
+
+	const int chroma_width = (w + 1) / 2;
+	int luma_pitch = static_cast<int>(AlignUp(static_cast<size_t>(w), alignment));
+	int chroma_pitch = static_cast<int>(AlignUp(static_cast<size_t>(num_planes_ == 2 ? chroma_width * 2 : chroma_width), alignment));
+
+	// compute size first, then lay planes out over aligned storage
+	size_t size = Layout(nullptr, luma_pitch, chroma_pitch, alignment);
+	storage_.resize(size + alignment);
+
+	std::uintptr_t address = reinterpret_cast<std::uintptr_t>(storage_.data());
+	Uint8* base = storage_.data() + (AlignUp(address, alignment) - address);
+
+	Layout(base, luma_pitch, chroma_pitch, alignment);
+}
+
+YUVFrame::YUVFrame(Texture::LockHandle& lock, Uint32 format, int w, int h) : format_(format), width_(w), height_(h) {
+	if (!IsSupportedFormat(format))
+		throw std::invalid_argument("unsupported YUV frame format");
+
+	num_planes_ = (format == SDL_PIXELFORMAT_NV12 || format == SDL_PIXELFORMAT_NV21) ? 2 : 3;
+
+	// SDL lays out locked YUV textures contiguously, with chroma pitch
+	// derived from luma pitch
+	int pitch = lock.GetPitch();
+	int chroma_pitch = (num_planes_ == 2) ? 2 * ((pitch + 1) / 2) : (pitch + 1) / 2;
+
+	Layout(static_cast<Uint8*>(lock.GetPixels()), pitch, chroma_pitch, 1);
+}
+
+YUVFrame::YUVFrame(YUVFrame&& other) noexcept : storage_(std::move(other.storage_)), format_(other.format_), width_(other.width_), height_(other.height_), num_planes_(other.num_planes_) {
+	// moving vector keeps its buffer, so plane pointers stay valid
+	std::copy(other.planes_, other.planes_ + 3, planes_);
+	std::copy(other.pitches_, other.pitches_ + 3, pitches_);
+	std::fill(other.planes_, other.planes_ + 3, nullptr);
+}
+
+YUVFrame& YUVFrame::operator=(YUVFrame&& other) noexcept {
+	if (&other == this)
+		return *this;
+
+	storage_ = std::move(other.storage_);
+	format_ = other.format_;
+	width_ = other.width_;
+	height_ = other.height_;
+	num_planes_ = other.num_planes_;
+	std::copy(other.planes_, other.planes_ + 3, planes_);
+	std::copy(other.pitches_, other.pitches_ + 3, pitches_);
+	std::fill(other.planes_, other.planes_ + 3, nullptr);
+
+	return *this;
+}
+
+void YUVFrame::Upload(Texture& texture) const {
+	if (texture.GetFormat() != format_ || texture.GetWidth() != width_ || texture.GetHeight() != height_)
+		throw std::invalid_argument("texture format or size does not match YUV frame");
+
+	if (!IsOwning())
+		return;
+
+	if (num_planes_ == 3) {
+		texture.UpdateYUV(NullOpt, planes_[0], pitches_[0], planes_[1], pitches_[1], planes_[2], pitches_[2]);
+		return;
+	}
+
+	// SDL_UpdateYUVTexture does not handle semi-planar formats
+	Texture::LockHandle lock = texture.Lock();
+	YUVFrame target(lock, format_, width_, height_);
+
+	const int chroma_height = (height_ + 1) / 2;
+	const size_t chroma_bytes = static_cast<size_t>((width_ + 1) / 2 * 2);
+
+	for (int y = 0; y < height_; y++)
+		std::memcpy(target.planes_[0] + y * target.pitches_[0], planes_[0] + y * pitches_[0], static_cast<size_t>(width_));
+	for (int y = 0; y < chroma_height; y++)
+		std::memcpy(target.planes_[1] + y * target.pitches_[1], planes_[1] + y * pitches_[1], chroma_bytes);
+}
+
+bool YUVFrame::IsOwning() const {
+	return !storage_.empty();
+}
+
+Uint32 YUVFrame::GetFormat() const {
+	return format_;
+}
+
+int YUVFrame::GetWidth() const {
+	return width_;
+}
+
+int YUVFrame::GetHeight() const {
+	return height_;
+}
+
+Point YUVFrame::GetSize() const {
+	return Point(width_, height_);
+}
+
+int YUVFrame::GetNumPlanes() const {
+	return num_planes_;
+}
+
+Uint8* YUVFrame::GetPlane(int plane) const {
+	return planes_[plane];
+}
+
+int YUVFrame::GetPitch(int plane) const {
+	return pitches_[plane];
+}
+
+bool YUVFrame::IsSupportedFormat(Uint32 format) {
+	return format == SDL_PIXELFORMAT_IYUV || format == SDL_PIXELFORMAT_YV12 || format == SDL_PIXELFORMAT_NV12 || format == SDL_PIXELFORMAT_NV21;
+}
+
+}
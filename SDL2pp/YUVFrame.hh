@@ -0,0 +1,266 @@
+/*
+  libSDL2pp - C++11 bindings/wrapper for SDL2
+  Copyright (C) 2013-2016 Dmitry Marakasov <amdmi3@amdmi3.ru>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef SDL2PP_YUVFRAME_HH
+#define SDL2PP_YUVFRAME_HH
+
+#include <vector>
+
+#include <SDL_stdinc.h>
+
+#include <SDL2pp/Point.hh>
+#include <SDL2pp/Texture.hh>
+#include <SDL2pp/Export.hh>
+
+namespace SDL2pp {
+
+////////////////////////////////////////////////////////////
+/// \brief Planar YUV image
+///
+/// \ingroup rendering
+///
+/// \headerfile SDL2pp/YUVFrame.hh
+///
+/// Holds pixel data of a video frame in one of the YUV
+/// formats supported by SDL textures: planar IYUV and YV12
+/// (separate Y, U and V planes) or semi-planar NV12 and NV21
+/// (Y plane followed by interleaved chroma plane).
+///
+/// Frame either owns its pixel data, in which case each plane
+/// starts at aligned address and has aligned pitch, suitable
+/// for decoders writing into it directly, or refers to pixel
+/// data of a locked streaming texture, which allows decoding
+/// right into texture memory with no intermediate copy.
+///
+/// Plane 0 is always luma; for planar formats plane 1 is U
+/// and plane 2 is V regardless of order in memory, for
+/// semi-planar formats plane 1 holds interleaved chroma.
+///
+/// Usage example:
+/// \code
+/// {
+///     SDL2pp::Texture texture(renderer, SDL_PIXELFORMAT_IYUV, SDL_TEXTUREACCESS_STREAMING, 640, 480);
+///
+///     {
+///         SDL2pp::Texture::LockHandle lock = texture.Lock();
+///         SDL2pp::YUVFrame frame(lock, SDL_PIXELFORMAT_IYUV, 640, 480);
+///
+///         decode_frame(frame.GetPlane(0), frame.GetPitch(0),
+///                      frame.GetPlane(1), frame.GetPitch(1),
+///                      frame.GetPlane(2), frame.GetPitch(2));
+///     }
+///     // at this point texture contains decoded frame
+/// }
+/// \endcode
+///
+////////////////////////////////////////////////////////////
+class SDL2PP_EXPORT YUVFrame {
+private:
+	std::vector<Uint8> storage_; ///< Owned pixel data, empty for frames referring to texture memory
+	Uint32 format_;              ///< Pixel format
+	int width_;                  ///< Frame width
+	int height_;                 ///< Frame height
+	int num_planes_;             ///< Number of planes
+	Uint8* planes_[3];           ///< Pointers to planes
+	int pitches_[3];             ///< Pitches of planes
+
+private:
+	////////////////////////////////////////////////////////////
+	/// \brief Compute plane layout for given luma and chroma pitches
+	///
+	/// \param[in] base Pointer to start of the first plane, or
+	///                 nullptr to only compute data size
+	/// \param[in] luma_pitch Pitch of luma plane
+	/// \param[in] chroma_pitch Pitch of chroma plane(s)
+	/// \param[in] alignment Alignment of plane start offsets
+	///
+	/// \returns Total size of pixel data in bytes
+	///
+	////////////////////////////////////////////////////////////
+	size_t Layout(Uint8* base, int luma_pitch, int chroma_pitch, size_t alignment);
+
+public:
+	////////////////////////////////////////////////////////////
+	/// \brief Create frame with owned pixel data
+	///
+	/// \param[in] format One of SDL_PIXELFORMAT_IYUV, SDL_PIXELFORMAT_YV12,
+	///                   SDL_PIXELFORMAT_NV12, SDL_PIXELFORMAT_NV21
+	/// \param[in] w Frame width
+	/// \param[in] h Frame height
+	/// \param[in] alignment Alignment of plane addresses and pitches,
+	///                      must be power of two
+	///
+	/// \throws std::invalid_argument if format or alignment is not supported
+	///
+	////////////////////////////////////////////////////////////
+	YUVFrame(Uint32 format, int w, int h, size_t alignment = 32);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Create frame referring to locked texture memory
+	///
+	/// Texture must be locked as a whole. Frame is only valid
+	/// while lock is held.
+	///
+	/// \param[in] lock Lock of the whole streaming texture
+	/// \param[in] format Pixel format of the texture
+	/// \param[in] w Texture width
+	/// \param[in] h Texture height
+	///
+	/// \throws std::invalid_argument if format is not supported
+	///
+	////////////////////////////////////////////////////////////
+	YUVFrame(Texture::LockHandle& lock, Uint32 format, int w, int h);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Move constructor
+	///
+	/// \param[in] other SDL2pp::YUVFrame object to move data from
+	///
+	////////////////////////////////////////////////////////////
+	YUVFrame(YUVFrame&& other) noexcept;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Move assignment operator
+	///
+	/// \param[in] other SDL2pp::YUVFrame object to move data from
+	///
+	/// \returns Reference to self
+	///
+	////////////////////////////////////////////////////////////
+	YUVFrame& operator=(YUVFrame&& other) noexcept;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Deleted copy constructor
+	///
+	/// This class is not copyable
+	///
+	////////////////////////////////////////////////////////////
+	YUVFrame(const YUVFrame& other) = delete;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Deleted assignment operator
+	///
+	/// This class is not copyable
+	///
+	////////////////////////////////////////////////////////////
+	YUVFrame& operator=(const YUVFrame& other) = delete;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Upload frame into texture
+	///
+	/// Uses SDL_UpdateYUVTexture for planar formats, and texture
+	/// lock for semi-planar ones. Does nothing for frames which
+	/// refer to texture memory.
+	///
+	/// \param[in] texture Texture of the same format and size
+	///
+	/// \throws SDL2pp::Exception
+	/// \throws std::invalid_argument if texture format or size does not match
+	///
+	/// \see http://wiki.libsdl.org/SDL_UpdateYUVTexture
+	///
+	////////////////////////////////////////////////////////////
+	void Upload(Texture& texture) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Check whether frame owns its pixel data
+	///
+	/// \returns False if frame refers to locked texture memory
+	///
+	////////////////////////////////////////////////////////////
+	bool IsOwning() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get pixel format
+	///
+	/// \returns One of SDL_PIXELFORMAT_IYUV, SDL_PIXELFORMAT_YV12,
+	///          SDL_PIXELFORMAT_NV12, SDL_PIXELFORMAT_NV21
+	///
+	////////////////////////////////////////////////////////////
+	Uint32 GetFormat() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get frame width
+	///
+	/// \returns Frame width in pixels
+	///
+	////////////////////////////////////////////////////////////
+	int GetWidth() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get frame height
+	///
+	/// \returns Frame height in pixels
+	///
+	////////////////////////////////////////////////////////////
+	int GetHeight() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get frame size
+	///
+	/// \returns SDL2pp::Point representing frame dimensions in pixels
+	///
+	////////////////////////////////////////////////////////////
+	Point GetSize() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get number of planes
+	///
+	/// \returns 3 for planar formats, 2 for semi-planar formats
+	///
+	////////////////////////////////////////////////////////////
+	int GetNumPlanes() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get pointer to plane data
+	///
+	/// \param[in] plane Plane index
+	///
+	/// \returns Pointer to first row of the plane
+	///
+	////////////////////////////////////////////////////////////
+	Uint8* GetPlane(int plane) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get plane pitch
+	///
+	/// \param[in] plane Plane index
+	///
+	/// \returns Number of bytes in a row of plane data, including
+	///          padding between lines
+	///
+	////////////////////////////////////////////////////////////
+	int GetPitch(int plane) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Check whether format is supported by YUVFrame
+	///
+	/// \param[in] format Pixel format
+	///
+	/// \returns True if format is IYUV, YV12, NV12 or NV21
+	///
+	////////////////////////////////////////////////////////////
+	static bool IsSupportedFormat(Uint32 format);
+};
+
+}
+
+#endif
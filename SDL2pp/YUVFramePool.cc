@@ -0,0 +1,83 @@
+/*
+  libSDL2pp - C++11 bindings/wrapper for SDL2
+  Copyright (C) 2013-2016 Dmitry Marakasov <amdmi3@amdmi3.ru>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include <stdexcept>
+#include <utility>
+
+#include <SDL2pp/YUVFramePool.hh>
+#include <SDL2pp/Texture.hh>
+
+namespace SDL2pp {
+
+YUVFramePool::YUVFramePool(Uint32 format, int w, int h, size_t alignment, size_t preallocate) : format_(format), width_(w), height_(h), alignment_(alignment), num_allocated_(0) {
+	if (!YUVFrame::IsSupportedFormat(format))
+		throw std::invalid_argument("unsupported YUV frame format");
+	if (alignment == 0 || (alignment & (alignment - 1)) != 0)
+		throw std::invalid_argument("YUV frame alignment must be power of two");
+
+	free_.reserve(preallocate);
+	while (num_allocated_ < preallocate) {
+		free_.emplace_back(format_, width_, height_, alignment_);
+		num_allocated_++;
+	}
+}
+
+YUVFrame YUVFramePool::Acquire() {
+	if (free_.empty()) {
+		num_allocated_++;
+		return YUVFrame(format_, width_, height_, alignment_);
+	}
+
+	YUVFrame frame(std::move(free_.back()));
+	free_.pop_back();
+	return frame;
+}
+
+void YUVFramePool::Release(YUVFrame&& frame) {
+	if (!frame.IsOwning() || frame.GetFormat() != format_ || frame.GetWidth() != width_ || frame.GetHeight() != height_)
+		return;
+
+	// reserve for all frames so steady state never reallocates
+	if (free_.capacity() < num_allocated_)
+		free_.reserve(num_allocated_);
+
+	free_.emplace_back(std::move(frame));
+}
+
+void YUVFramePool::Upload(YUVFrame&& frame, Texture& texture) {
+	try {
+		frame.Upload(texture);
+	} catch (...) {
+		Release(std::move(frame));
+		throw;
+	}
+	Release(std::move(frame));
+}
+
+size_t YUVFramePool::GetNumFree() const {
+	return free_.size();
+}
+
+size_t YUVFramePool::GetNumAllocated() const {
+	return num_allocated_;
+}
+
+}
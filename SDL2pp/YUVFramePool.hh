@@ -0,0 +1,148 @@
+/*
+  libSDL2pp - C++11 bindings/wrapper for SDL2
+  Copyright (C) 2013-2016 Dmitry Marakasov <amdmi3@amdmi3.ru>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef SDL2PP_YUVFRAMEPOOL_HH
+#define SDL2PP_YUVFRAMEPOOL_HH
+
+#include <vector>
+
+#include <SDL_stdinc.h>
+
+#include <SDL2pp/YUVFrame.hh>
+#include <SDL2pp/Export.hh>
+
+namespace SDL2pp {
+
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Pool of reusable YUV frames
+///
+/// \ingroup rendering
+///
+/// \headerfile SDL2pp/YUVFramePool.hh
+///
+/// Hands out same-sized YUV frames for decoders to write into
+/// and takes them back after upload, so video playback does
+/// no allocations per frame once the pool has warmed up.
+///
+/// Usage example:
+/// \code
+/// {
+///     SDL2pp::YUVFramePool pool(SDL_PIXELFORMAT_IYUV, 640, 480);
+///     SDL2pp::Texture texture(renderer, SDL_PIXELFORMAT_IYUV, SDL_TEXTUREACCESS_STREAMING, 640, 480);
+///
+///     while (...) {
+///         SDL2pp::YUVFrame frame = pool.Acquire();
+///         decode_frame(frame.GetPlane(0), frame.GetPitch(0), ...);
+///         pool.Upload(std::move(frame), texture);
+///
+///         renderer.Copy(texture);
+///         ...
+///     }
+/// }
+/// \endcode
+///
+////////////////////////////////////////////////////////////
+class SDL2PP_EXPORT YUVFramePool {
+private:
+	Uint32 format_;                 ///< Pixel format of frames
+	int width_;                     ///< Width of frames
+	int height_;                    ///< Height of frames
+	size_t alignment_;              ///< Alignment of frame planes
+	size_t num_allocated_;          ///< Number of frames ever allocated by the pool
+	std::vector<YUVFrame> free_;    ///< Frames available for reuse
+
+public:
+	////////////////////////////////////////////////////////////
+	/// \brief Create frame pool
+	///
+	/// \param[in] format One of SDL_PIXELFORMAT_IYUV, SDL_PIXELFORMAT_YV12,
+	///                   SDL_PIXELFORMAT_NV12, SDL_PIXELFORMAT_NV21
+	/// \param[in] w Frame width
+	/// \param[in] h Frame height
+	/// \param[in] alignment Alignment of plane addresses and pitches,
+	///                      must be power of two
+	/// \param[in] preallocate Number of frames to allocate upfront
+	///
+	/// \throws std::invalid_argument if format or alignment is not supported
+	///
+	////////////////////////////////////////////////////////////
+	YUVFramePool(Uint32 format, int w, int h, size_t alignment = 32, size_t preallocate = 0);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get frame from the pool
+	///
+	/// Reuses previously released frame if there is one, otherwise
+	/// allocates new frame. Contents of reused frames are undefined.
+	///
+	/// \returns Frame with owned pixel data
+	///
+	////////////////////////////////////////////////////////////
+	YUVFrame Acquire();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Return frame to the pool
+	///
+	/// Frames of different format or size, and frames which
+	/// refer to texture memory are silently dropped.
+	///
+	/// \param[in] frame Frame to recycle
+	///
+	////////////////////////////////////////////////////////////
+	void Release(YUVFrame&& frame);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Upload frame into texture and return it to the pool
+	///
+	/// Frame is returned to the pool even if upload fails.
+	///
+	/// \param[in] frame Frame to upload and recycle
+	/// \param[in] texture Texture of the same format and size
+	///
+	/// \throws SDL2pp::Exception
+	/// \throws std::invalid_argument if texture format or size does not match
+	///
+	/// \see http://wiki.libsdl.org/SDL_UpdateYUVTexture
+	///
+	////////////////////////////////////////////////////////////
+	void Upload(YUVFrame&& frame, Texture& texture);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get number of frames available for reuse
+	///
+	/// \returns Number of free frames
+	///
+	////////////////////////////////////////////////////////////
+	size_t GetNumFree() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get number of frames allocated by the pool
+	///
+	/// \returns Number of frames ever allocated
+	///
+	////////////////////////////////////////////////////////////
+	size_t GetNumAllocated() const;
+};
+
+}
+
+#endif
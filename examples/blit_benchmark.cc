@@ -0,0 +1,127 @@
+/*
+  libSDL2pp - C++11 bindings/wrapper for SDL2
+  Copyright (C) 2013-2016 Dmitry Marakasov <amdmi3@amdmi3.ru>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include <iostream>
+#include <iomanip>
+#include <functional>
+
+#include <SDL.h>
+
+#include <SDL2pp/SDL.hh>
+#include <SDL2pp/Surface.hh>
+#include <SDL2pp/BlitKernels.hh>
+
+using namespace SDL2pp;
+
+static const int size = 1024;
+static const int iterations = 50;
+
+static double Measure(const std::function<void()>& blit) {
+	blit(); // warm up
+
+	Uint64 start = SDL_GetPerformanceCounter();
+	for (int i = 0; i < iterations; i++)
+		blit();
+	Uint64 end = SDL_GetPerformanceCounter();
+
+	double seconds = static_cast<double>(end - start) / static_cast<double>(SDL_GetPerformanceFrequency());
+	return static_cast<double>(size) * size * iterations / seconds / 1000000.0;
+}
+
+static const char* IsaName(BlitKernels::Isa isa) {
+	switch (isa) {
+	case BlitKernels::Isa::Scalar: return "scalar";
+	case BlitKernels::Isa::SSE2: return "SSE2";
+	case BlitKernels::Isa::AVX2: return "AVX2";
+	}
+	return "?";
+}
+
+static int Run() {
+	SDL sdl(0);
+
+	Surface dst(0, size, size, 32, 0x00ff0000, 0x0000ff00, 0x000000ff, 0xff000000);
+
+	const Uint32 src_formats[] = { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ABGR8888 };
+	const SDL_BlendMode blend_modes[] = { SDL_BLENDMODE_NONE, SDL_BLENDMODE_BLEND };
+	const BlitKernels::Isa isas[] = { BlitKernels::Isa::Scalar, BlitKernels::Isa::SSE2, BlitKernels::Isa::AVX2 };
+
+	std::cout << "Blitting " << size << "x" << size << " surfaces, throughput in megapixels per second" << std::endl;
+	std::cout << "Surface::BlitFast() uses " << IsaName(BlitKernels::GetBestIsa()) << std::endl << std::endl;
+
+	for (Uint32 src_format : src_formats) {
+		Surface src = dst.Convert(src_format);
+
+		// semi-transparent gradient, so blending takes the slow path
+		{
+			Surface::LockHandle lock = src.Lock();
+			for (int y = 0; y < size; y++) {
+				Uint32* row = reinterpret_cast<Uint32*>(static_cast<Uint8*>(lock.GetPixels()) + y * lock.GetPitch());
+				for (int x = 0; x < size; x++)
+					row[x] = static_cast<Uint32>(((x + y) & 0xff) << 24 | (x & 0xff) << 16 | (y & 0xff) << 8 | 0x80);
+			}
+		}
+
+		for (SDL_BlendMode blend_mode : blend_modes) {
+			src.SetBlendMode(blend_mode);
+
+			std::cout << SDL_GetPixelFormatName(src_format) << " -> SDL_PIXELFORMAT_ARGB8888, "
+				<< (blend_mode == SDL_BLENDMODE_NONE ? "copy" : "blend") << ":" << std::endl;
+
+			std::cout << std::setw(12) << "SDL" << std::setw(10) << std::fixed << std::setprecision(1)
+				<< Measure([&]() {
+						SDL_Rect rect = { 0, 0, 0, 0 };
+						SDL_BlitSurface(src.Get(), nullptr, dst.Get(), &rect);
+					}) << std::endl;
+
+			for (BlitKernels::Isa isa : isas) {
+				if (!BlitKernels::IsIsaSupported(isa))
+					continue;
+
+				BlitKernels::RowKernel kernel = BlitKernels::GetRowKernel(src_format, SDL_PIXELFORMAT_ARGB8888, blend_mode, isa);
+
+				std::cout << std::setw(12) << IsaName(isa) << std::setw(10)
+					<< Measure([&]() {
+							for (int y = 0; y < size; y++)
+								kernel(
+									reinterpret_cast<const Uint32*>(static_cast<const Uint8*>(src.Get()->pixels) + y * src.Get()->pitch),
+									reinterpret_cast<Uint32*>(static_cast<Uint8*>(dst.Get()->pixels) + y * dst.Get()->pitch),
+									size
+								);
+						}) << std::endl;
+			}
+
+			std::cout << std::endl;
+		}
+	}
+
+	return 0;
+}
+
+int main(int, char*[]) {
+	try {
+		return Run();
+	} catch (std::exception& e) {
+		std::cerr << "Error: " << e.what() << std::endl;
+	}
+
+	return -1;
+}
@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <stdexcept>
 #include <vector>
 
 #include <SDL.h>
@@ -247,6 +249,33 @@ BEGIN_TEST(int, char*[])
 		SDL_Delay(1000);
 	}
 
+	{
+		// Frame statistics
+		renderer.SetDrawColor(0, 0, 0);
+		renderer.Clear();
+		renderer.FillRect(Rect(0, 0, 10, 10));
+		Rect rects[] = { {10, 10, 10, 10 }, { 20, 20, 5, 5 } };
+		renderer.FillRects(rects, 2);
+		renderer.DrawLine(0, 0, 10, 10);
+
+		EXPECT_EQUAL(renderer.GetCurrentFrameStats().fill_rect_calls, 2U);
+
+		renderer.Present();
+
+		Renderer::FrameStats stats = renderer.GetFrameStats();
+		EXPECT_EQUAL(stats.clear_calls, 1U);
+		EXPECT_EQUAL(stats.fill_rect_calls, 2U);
+		EXPECT_EQUAL(stats.draw_line_calls, 1U);
+		EXPECT_EQUAL(stats.pixels_covered, 225U);
+		EXPECT_TRUE(stats.present_time >= 0.0);
+
+		EXPECT_EQUAL(renderer.GetCurrentFrameStats().fill_rect_calls, 0U);
+		EXPECT_TRUE(!renderer.GetFrameStatsHistory().empty());
+
+		renderer.SetFrameStatsHistorySize(1);
+		EXPECT_EQUAL(renderer.GetFrameStatsHistory().size(), 1U);
+	}
+
 	{
 		// Clip rect
 		renderer.SetDrawColor(0, 0, 0);
@@ -298,6 +327,33 @@ BEGIN_TEST(int, char*[])
 		SDL_Delay(1000);
 	}
 
+	{
+		// State cache
+		renderer.SetStateCacheEnabled();
+		EXPECT_TRUE(renderer.IsStateCacheEnabled());
+		renderer.ResetStateCacheStats();
+
+		renderer.SetDrawColor(1, 2, 3);
+		renderer.SetDrawColor(1, 2, 3);
+		renderer.SetDrawBlendMode(SDL_BLENDMODE_BLEND);
+		renderer.SetDrawBlendMode(SDL_BLENDMODE_BLEND);
+
+		EXPECT_EQUAL(renderer.GetStateCacheStats().submitted, 2U);
+		EXPECT_EQUAL(renderer.GetStateCacheStats().skipped, 2U);
+
+		// raw SDL call behind renderer's back
+		SDL_SetRenderDrawColor(renderer.Get(), 4, 5, 6, 255);
+		renderer.InvalidateStateCache();
+
+		renderer.SetDrawColor(1, 2, 3);
+		EXPECT_EQUAL(renderer.GetDrawColor(), Color(1, 2, 3));
+		EXPECT_EQUAL(renderer.GetStateCacheStats().submitted, 3U);
+
+		renderer.SetDrawBlendMode();
+		renderer.SetStateCacheEnabled(false);
+		EXPECT_TRUE(!renderer.IsStateCacheEnabled());
+	}
+
 	if (renderer.TargetSupported()) {
 		// Render target
 		Texture target(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, 32, 32);
@@ -327,6 +383,132 @@ BEGIN_TEST(int, char*[])
 		EXPECT_TRUE(false, "render target is not supported here, some tests were skipped", NON_FATAL);
 	}
 
+	{
+		// Streaming texture ring
+		StreamingTextureRing ring(renderer, SDL_PIXELFORMAT_ARGB8888, 16, 16, 2);
+
+		EXPECT_EQUAL(ring.GetNumTextures(), 2U);
+		EXPECT_EQUAL(ring.GetSize(), Point(16, 16));
+		EXPECT_TRUE(!ring.HasCurrent());
+		EXPECT_EXCEPTION(ring.GetCurrent(), std::logic_error);
+
+		std::vector<Uint32> frame(16 * 16, 0xff0102ff);
+		ring.Update(frame.data(), 16 * 4);
+
+		Texture* first = &ring.GetCurrent();
+		EXPECT_TRUE(first != &ring.GetNext());
+
+		{
+			Texture::LockHandle lock = ring.Lock();
+			for (int y = 0; y < 16; y++)
+				std::fill_n(reinterpret_cast<Uint32*>(static_cast<Uint8*>(lock.GetPixels()) + y * lock.GetPitch()), 16, 0xff030405);
+		}
+		ring.Commit();
+
+		EXPECT_TRUE(first != &ring.GetCurrent());
+		EXPECT_TRUE(first == &ring.GetNext());
+
+		renderer.SetDrawColor(0, 0, 0);
+		renderer.Clear();
+		renderer.Copy(ring.GetCurrent(), NullOpt, Point(0, 0));
+
+		pixels.Retrieve(renderer);
+		EXPECT_TRUE(pixels.Test(0, 0, 3, 4, 5));
+
+		renderer.Present();
+		SDL_Delay(1000);
+	}
+
+	{
+		// YUV frames
+		Texture texture(renderer, SDL_PIXELFORMAT_IYUV, SDL_TEXTUREACCESS_STREAMING, 16, 16);
+		YUVFramePool pool(SDL_PIXELFORMAT_IYUV, 16, 16);
+
+		YUVFrame frame = pool.Acquire();
+		for (int plane = 0; plane < frame.GetNumPlanes(); plane++)
+			std::fill_n(frame.GetPlane(plane), frame.GetPitch(plane) * (plane == 0 ? 16 : 8), 128);
+
+		EXPECT_NO_EXCEPTION(pool.Upload(std::move(frame), texture));
+		EXPECT_EQUAL(pool.GetNumFree(), 1U);
+
+		{
+			// decode right into texture memory
+			Texture::LockHandle lock = texture.Lock();
+			YUVFrame view(lock, SDL_PIXELFORMAT_IYUV, 16, 16);
+			EXPECT_TRUE(!view.IsOwning());
+			for (int y = 0; y < 16; y++)
+				std::fill_n(view.GetPlane(0) + y * view.GetPitch(0), 16, 128);
+		}
+
+		renderer.Copy(texture);
+		renderer.Present();
+	}
+
+	{
+		// Texture update from surface of different format
+		Texture texture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, 16, 16);
+
+		// same pixel size: both lvalue and rvalue surfaces are
+		// converted through scratch buffer
+		Surface abgr(0, 16, 16, 32, 0x000000ff, 0x0000ff00, 0x00ff0000, 0xff000000);
+		abgr.FillRect(NullOpt, SDL_MapRGBA(abgr.Get()->format, 1, 2, 3, 255));
+
+		texture.Update(NullOpt, abgr);
+		renderer.Copy(texture, NullOpt, Point(0, 0));
+		texture.Update(NullOpt, std::move(abgr));
+		renderer.Copy(texture, NullOpt, Point(16, 0));
+
+		// different pixel size
+		Surface rgb(0, 16, 16, 24, 0xff0000, 0x00ff00, 0x0000ff, 0);
+		rgb.FillRect(NullOpt, SDL_MapRGB(rgb.Get()->format, 4, 5, 6));
+
+		texture.Update(NullOpt, std::move(rgb));
+		renderer.Copy(texture, NullOpt, Point(32, 0));
+
+		pixels.Retrieve(renderer);
+		EXPECT_TRUE(pixels.Test(1, 1, 1, 2, 3));
+		EXPECT_TRUE(pixels.Test(17, 1, 1, 2, 3));
+		EXPECT_TRUE(pixels.Test(33, 1, 4, 5, 6));
+
+		renderer.Present();
+	}
+
+	{
+		// Texture with premultiplied alpha
+		Surface straight(0, 16, 16, 32, 0x00ff0000, 0x0000ff00, 0x000000ff, 0xff000000);
+		straight.FillRect(NullOpt, SDL_MapRGBA(straight.Get()->format, 255, 128, 0, 128));
+
+		Texture texture(renderer, straight, true);
+		EXPECT_EQUAL(texture.GetFormat(), static_cast<Uint32>(SDL_PIXELFORMAT_ARGB8888));
+		EXPECT_EQUAL(texture.GetBlendMode(), SDL_BLENDMODE_NONE);
+
+		renderer.SetDrawColor(255, 255, 255);
+		renderer.Clear();
+		renderer.Copy(texture, NullOpt, Point(0, 0));
+
+#if SDL_VERSION_ATLEAST(2, 0, 6)
+		bool custom_blend_supported = true;
+		try {
+			texture.SetBlendMode(PremultipliedAlpha::GetBlendMode());
+			renderer.Copy(texture, NullOpt, Point(16, 0));
+		} catch (Exception&) {
+			custom_blend_supported = false;
+		}
+#endif
+
+		pixels.Retrieve(renderer);
+		EXPECT_TRUE(pixels.Test(1, 1, 128, 64, 0));
+
+#if SDL_VERSION_ATLEAST(2, 0, 6)
+		if (custom_blend_supported)
+			EXPECT_TRUE(pixels.Test(17, 1, 255, 191, 127), "depends on blending precision of the renderer", NON_FATAL);
+		else
+			EXPECT_TRUE(false, "custom blend modes are not supported here, some tests were skipped", NON_FATAL);
+#endif
+
+		renderer.Present();
+	}
+
 #ifdef SDL2PP_WITH_IMAGE
 	{
 		// Init
@@ -425,6 +607,232 @@ BEGIN_TEST(int, char*[])
 		EXPECT_EQUAL((int)r, 255);
 		EXPECT_EQUAL((int)g, 255);
 		EXPECT_EQUAL((int)b, 255);
+
+		// Texture: batch copy
+		renderer.SetDrawColor(0, 0, 0);
+		renderer.Clear();
+
+		Renderer::CopyCommand commands[] = {
+			{ texture, NullOpt, Rect(0, 0, 32, 32) },
+			{ texture, NullOpt, Rect(32, 0, 32, 32), Color(89, 241, 50) },
+			{ texture, NullOpt, Rect(64, 0, 32, 32), Color(255, 255, 255) },
+		};
+		renderer.CopyBatch(commands, 3, true);
+
+		pixels.Retrieve(renderer);
+
+		EXPECT_TRUE(pixels.Test3x3(1, 1, 0x032, 238, 199, 0));
+		EXPECT_TRUE(pixels.Test3x3(1+32, 1, 0x032, 83, 188, 0));
+		EXPECT_TRUE(pixels.Test3x3(1+64, 1, 0x032, 238, 199, 0));
+
+		renderer.Present();
+		SDL_Delay(1000);
+	}
+
+	{
+		// Atlas
+		renderer.SetDrawColor(0, 0, 0);
+		renderer.Clear();
+
+		Atlas atlas(renderer, 128, 64, 1, 1);
+
+		AtlasRegion crate1 = atlas.Add(Surface(TESTDATA_DIR "/crate.png"));
+		AtlasRegion crate2 = atlas.Add(Surface(TESTDATA_DIR "/crate.png"));
+
+		EXPECT_EQUAL(atlas.GetNumRegions(), 2U);
+		EXPECT_EQUAL(atlas.GetNumPages(), 1U);
+		EXPECT_EQUAL(crate1.GetSize(), Point(32, 32));
+		EXPECT_TRUE(!crate1.GetRect().Intersects(crate2.GetRect()));
+
+		// does not fit with padding and extrusion, needs new page
+		atlas.Add(Surface(TESTDATA_DIR "/crate.png"));
+		EXPECT_EQUAL(atlas.GetNumPages(), 2U);
+
+		renderer.Copy(crate2, Point(0, 0));
+
+		pixels.Retrieve(renderer);
+
+		EXPECT_TRUE(pixels.Test3x3(1, 1, 0x032, 238, 199, 0));
+
+		renderer.Present();
+		SDL_Delay(1000);
+	}
+	{
+		// Texture cache
+		const size_t crate_bytes = 32 * 32 * 4;
+		TextureCache cache(renderer, crate_bytes);
+
+		{
+			std::shared_ptr<Texture> a = cache.Get(TESTDATA_DIR "/crate.png");
+			std::shared_ptr<Texture> b = cache.Get(TESTDATA_DIR "/crate.png");
+			EXPECT_TRUE(a == b);
+			EXPECT_EQUAL(cache.GetNumEntries(), 1U);
+			EXPECT_EQUAL(cache.GetUsedBytes(), TextureCache::GetTextureBytes(*a));
+
+			// over budget, but first texture is still referenced
+			cache.Get("copy", [](Renderer& renderer) { return Texture(renderer, TESTDATA_DIR "/crate.png"); });
+			EXPECT_EQUAL(cache.GetNumEntries(), 2U);
+			EXPECT_TRUE(cache.Contains(TESTDATA_DIR "/crate.png"));
+		}
+
+		// first texture is now least recently used and unreferenced
+		cache.SetBudget(cache.GetUsedBytes() - 1);
+		EXPECT_EQUAL(cache.GetNumEntries(), 1U);
+		EXPECT_TRUE(!cache.Contains(TESTDATA_DIR "/crate.png"));
+		EXPECT_TRUE(cache.Contains("copy"));
+
+		cache.Clear();
+		EXPECT_EQUAL(cache.GetNumEntries(), 0U);
+		EXPECT_EQUAL(cache.GetUsedBytes(), 0U);
+	}
+	{
+		// Async loader
+		AsyncLoader loader(renderer, 2);
+
+		std::future<Surface> surface = loader.LoadSurface(TESTDATA_DIR "/crate.png");
+		std::future<Texture> texture = loader.Load(TESTDATA_DIR "/crate.png");
+
+		Point callback_size;
+		std::future<void> callback_done = loader.Load(TESTDATA_DIR "/crate.png", [&callback_size](Texture texture) {
+				callback_size = texture.GetSize();
+			});
+
+		std::future<Texture> missing = loader.Load(TESTDATA_DIR "/nonexistent.png");
+
+		EXPECT_EQUAL(surface.get().GetSize(), Point(32, 32));
+
+		// byte budget smaller than one image still lets one through per call
+		while (loader.GetNumPending() > 0)
+			EXPECT_TRUE(loader.Pump(1) <= 1);
+
+		EXPECT_EQUAL(texture.get().GetSize(), Point(32, 32));
+		callback_done.get();
+		EXPECT_EQUAL(callback_size, Point(32, 32));
+		EXPECT_EXCEPTION(missing.get(), Exception);
+	}
+	{
+		// Async loader on shared thread pool
+		ThreadPool pool(1);
+		AsyncLoader loader(renderer, pool);
+
+		std::future<Texture> texture = loader.Load(TESTDATA_DIR "/crate.png");
+
+		while (loader.GetNumPending() > 0)
+			loader.Pump();
+
+		EXPECT_EQUAL(texture.get().GetSize(), Point(32, 32));
 	}
 #endif // SDL2PP_WITH_IMAGE
+#ifdef SDL2PP_WITH_TTF
+	{
+		// Glyph cache
+		SDLTTF ttf;
+		Font font(TESTDATA_DIR "/Vera.ttf", 30);
+		GlyphCache cache(renderer, font, 128);
+
+		EXPECT_EQUAL(cache.GetSizeUTF8(u8"AA"), Point(font.GetGlyphAdvance(u'A') * 2 + font.GetKerningSize(u'A', u'A'), font.GetHeight()));
+		EXPECT_EQUAL(cache.GetNumGlyphs(), 1U);
+
+		renderer.SetDrawColor(0, 0, 0);
+		renderer.Clear();
+
+		// second string reuses glyphs; space takes no atlas room
+		cache.QueueUTF8(u8"lA", Point(0, 0), Color(255, 0, 0));
+		cache.QueueUTF8(u8"l l", Point(0, 100), Color(0, 255, 0));
+		EXPECT_EQUAL(cache.GetNumQueued(), 4U);
+		EXPECT_EQUAL(cache.GetNumGlyphs(), 3U);
+		EXPECT_EQUAL(cache.GetAtlas().GetNumRegions(), 2U);
+
+		cache.Flush();
+		EXPECT_EQUAL(cache.GetNumQueued(), 0U);
+
+		// middle of the stem of first l
+		int minx, maxx, miny, maxy, advance;
+		font.GetGlyphMetrics(u'l', minx, maxx, miny, maxy, advance);
+
+		pixels.Retrieve(renderer);
+		EXPECT_TRUE(pixels.Test((minx + maxx) / 2, font.GetAscent() - maxy / 2, 255, 0, 0));
+		EXPECT_TRUE(pixels.Test((minx + maxx) / 2, 100 + font.GetAscent() - maxy / 2, 0, 255, 0));
+		EXPECT_TRUE(pixels.Test((minx + maxx) / 2, 50 + font.GetAscent() - maxy / 2, 0, 0, 0));
+
+		renderer.Present();
+
+		cache.Clear();
+		EXPECT_EQUAL(cache.GetNumGlyphs(), 0U);
+		EXPECT_EQUAL(cache.GetAtlas().GetNumRegions(), 0U);
+	}
+	{
+		// Text cache
+		SDLTTF ttf;
+		Font font(TESTDATA_DIR "/Vera.ttf", 30);
+		TextCache cache(renderer, 1 << 20);
+
+		Texture& texture = cache.GetTextureUTF8(font, u8"AA", TextRenderMode::Blended, Color(255, 255, 255));
+		EXPECT_EQUAL(texture.GetSize(), Point(43, 36));
+		EXPECT_EQUAL(cache.GetUsedBytes(), 43U * 36U * SDL_BYTESPERPIXEL(texture.GetFormat()));
+		EXPECT_EQUAL(&cache.GetTextureUTF8(font, u8"AA", TextRenderMode::Blended, Color(255, 255, 255)), &texture);
+		EXPECT_EQUAL(cache.GetCurrentFrameStats().hits, 1U);
+		EXPECT_EXCEPTION(cache.GetSurfaceUTF8(font, u8"AA", TextRenderMode::Blended, Color(255, 255, 255)), std::logic_error);
+
+		renderer.SetDrawColor(0, 0, 0);
+		renderer.Clear();
+		renderer.Copy(texture, NullOpt, Point(0, 0));
+		renderer.Present();
+	}
+	{
+		// Distance field glyph cache
+		SDLTTF ttf;
+		Font font(TESTDATA_DIR "/Vera.ttf", 30);
+		DistanceFieldCache cache(renderer, font, 4, 256);
+
+		Point size = cache.GetSizeUTF8(u8"AA");
+		EXPECT_EQUAL(size, Point(font.GetGlyphAdvance(u'A') * 2 + font.GetKerningSize(u'A', u'A'), font.GetHeight()));
+		EXPECT_EQUAL(cache.GetSizeUTF8(u8"AA", 2.0f), Point(size.x * 2, size.y * 2));
+		EXPECT_EQUAL(cache.GetNumGlyphs(), 1U);
+
+		renderer.SetDrawColor(0, 0, 0);
+		renderer.Clear();
+
+		// only distance fields are made until glyphs are drawn
+		EXPECT_EQUAL(cache.GetAtlas().GetNumRegions(), 0U);
+
+		// then one image is made per scale step, and close
+		// scales share it
+		cache.QueueUTF8(u8"l", Point(0, 0), 2.0f, Color(255, 0, 0));
+		cache.QueueUTF8(u8"l", Point(0, 0), 2.05f, Color(255, 0, 0));
+		EXPECT_EQUAL(cache.GetNumGlyphs(), 2U);
+		EXPECT_EQUAL(cache.GetAtlas().GetNumRegions(), 1U);
+		cache.QueueUTF8(u8"l", Point(0, 0), 4.0f, Color(255, 0, 0));
+		EXPECT_EQUAL(cache.GetAtlas().GetNumRegions(), 2U);
+
+		// glyph images are kept when edge width changes
+		cache.SetEdgeWidth(0.5f);
+		EXPECT_EQUAL(cache.GetNumGlyphs(), 2U);
+		EXPECT_EQUAL(cache.GetAtlas().GetNumRegions(), 2U);
+		EXPECT_EXCEPTION(cache.SetEdgeWidth(0.0f), std::invalid_argument);
+
+		// and atlas is not rebuilt if it does not change
+		Atlas* atlas = &cache.GetAtlas();
+		cache.SetEdgeWidth(0.5f);
+		EXPECT_TRUE(&cache.GetAtlas() == atlas);
+
+		// queued glyphs survive the rebuild
+		EXPECT_EQUAL(cache.GetNumQueued(), 3U);
+		cache.Flush();
+		renderer.Clear();
+
+		cache.DrawUTF8(u8"l", Point(0, 0), 2.0f, Color(255, 0, 0));
+		EXPECT_EQUAL(cache.GetNumQueued(), 0U);
+
+		// middle of the stem of l, at double size
+		int minx, maxx, miny, maxy, advance;
+		font.GetGlyphMetrics(u'l', minx, maxx, miny, maxy, advance);
+
+		pixels.Retrieve(renderer);
+		EXPECT_TRUE(pixels.Test(minx + maxx, font.GetAscent() * 2 - maxy, 255, 0, 0));
+		EXPECT_TRUE(pixels.Test(minx + maxx, font.GetHeight() * 2 + 10, 0, 0, 0));
+
+		renderer.Present();
+	}
+#endif // SDL2PP_WITH_TTF
 END_TEST()
@@ -0,0 +1,172 @@
+#include <cstdlib>
+#include <vector>
+
+#include <SDL_main.h>
+
+#include <SDL2pp/BlitKernels.hh>
+#include <SDL2pp/Surface.hh>
+
+#include "testing.h"
+
+using namespace SDL2pp;
+
+static Uint32 random_state = 12345;
+
+static Uint32 RandomPixel() {
+	random_state = random_state * 1103515245 + 12345;
+	Uint32 pixel = random_state;
+	random_state = random_state * 1103515245 + 12345;
+
+	// make fully transparent and fully opaque pixels frequent,
+	// as kernels special-case them
+	switch ((random_state >> 16) % 4) {
+	case 0: return pixel & 0x00ffffff;
+	case 1: return pixel | 0xff000000;
+	default: return pixel;
+	}
+}
+
+static void FillRandom(Surface& surface) {
+	Surface::LockHandle lock = surface.Lock();
+	for (int y = 0; y < surface.GetHeight(); y++) {
+		Uint32* row = reinterpret_cast<Uint32*>(static_cast<Uint8*>(lock.GetPixels()) + y * lock.GetPitch());
+		for (int x = 0; x < surface.GetWidth(); x++)
+			row[x] = RandomPixel();
+	}
+}
+
+static bool SurfacesMatch(Surface& a, Surface& b, int tolerance) {
+	Surface::LockHandle alock = a.Lock();
+	Surface::LockHandle block = b.Lock();
+	for (int y = 0; y < a.GetHeight(); y++) {
+		const Uint8* arow = static_cast<const Uint8*>(alock.GetPixels()) + y * alock.GetPitch();
+		const Uint8* brow = static_cast<const Uint8*>(block.GetPixels()) + y * block.GetPitch();
+		for (int x = 0; x < a.GetWidth() * 4; x++)
+			if (std::abs(arow[x] - brow[x]) > tolerance)
+				return false;
+	}
+	return true;
+}
+
+BEGIN_TEST(int, char*[])
+	const Uint32 src_formats[] = { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ABGR8888 };
+	const SDL_BlendMode blend_modes[] = { SDL_BLENDMODE_NONE, SDL_BLENDMODE_BLEND };
+	const BlitKernels::Isa isas[] = { BlitKernels::Isa::SSE2, BlitKernels::Isa::AVX2 };
+
+	{
+		// Availability
+		EXPECT_TRUE(BlitKernels::IsIsaSupported(BlitKernels::Isa::Scalar));
+		EXPECT_TRUE(BlitKernels::IsIsaSupported(BlitKernels::GetBestIsa()));
+
+		EXPECT_TRUE(BlitKernels::GetRowKernel(SDL_PIXELFORMAT_RGB24, SDL_PIXELFORMAT_ARGB8888, SDL_BLENDMODE_NONE, BlitKernels::Isa::Scalar) == nullptr);
+		EXPECT_TRUE(BlitKernels::GetRowKernel(SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ABGR8888, SDL_BLENDMODE_NONE, BlitKernels::Isa::Scalar) == nullptr);
+		EXPECT_TRUE(BlitKernels::GetRowKernel(SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, SDL_BLENDMODE_ADD, BlitKernels::Isa::Scalar) == nullptr);
+	}
+
+	{
+		// Scalar blending
+		BlitKernels::RowKernel blend = BlitKernels::GetRowKernel(SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, SDL_BLENDMODE_BLEND, BlitKernels::Isa::Scalar);
+
+		Uint32 src[3] = { 0x00ffffff, 0xff102030, 0x80ff0000 };
+		Uint32 dst[3] = { 0xff0000ff, 0xff0000ff, 0xff0000ff };
+		blend(src, dst, 3);
+
+		EXPECT_EQUAL(dst[0], 0xff0000ffU); // transparent source
+		EXPECT_EQUAL(dst[1], 0xff102030U); // opaque source
+		EXPECT_EQUAL(dst[2], 0xfe7f007fU); // (s - d) * a >> 8 + d per channel
+	}
+
+	{
+		// SIMD kernels match scalar ones, including row tails
+		for (Uint32 src_format : src_formats) {
+			for (SDL_BlendMode blend_mode : blend_modes) {
+				BlitKernels::RowKernel reference = BlitKernels::GetRowKernel(src_format, SDL_PIXELFORMAT_ARGB8888, blend_mode, BlitKernels::Isa::Scalar);
+
+				for (BlitKernels::Isa isa : isas) {
+					if (!BlitKernels::IsIsaSupported(isa))
+						continue;
+
+					BlitKernels::RowKernel kernel = BlitKernels::GetRowKernel(src_format, SDL_PIXELFORMAT_ARGB8888, blend_mode, isa);
+
+					bool match = true;
+					for (int count = 0; count < 40; count++) {
+						std::vector<Uint32> src(count), dst_reference(count), dst(count);
+						for (int i = 0; i < count; i++) {
+							src[i] = RandomPixel();
+							dst_reference[i] = dst[i] = RandomPixel();
+						}
+
+						reference(src.data(), dst_reference.data(), count);
+						kernel(src.data(), dst.data(), count);
+
+						if (dst != dst_reference)
+							match = false;
+					}
+
+					EXPECT_TRUE(match, "SIMD kernel output differs from scalar");
+				}
+			}
+		}
+	}
+
+	{
+		// Fast path matches SDL generic blitter
+		for (Uint32 src_format : src_formats) {
+			for (SDL_BlendMode blend_mode : blend_modes) {
+				Surface src(0, 37, 29, 32,
+					src_format == SDL_PIXELFORMAT_ARGB8888 ? 0x00ff0000 : 0x000000ff,
+					0x0000ff00,
+					src_format == SDL_PIXELFORMAT_ARGB8888 ? 0x000000ff : 0x00ff0000,
+					0xff000000);
+				FillRandom(src);
+				src.SetBlendMode(blend_mode);
+
+				Surface dst_sdl(0, 53, 41, 32, 0x00ff0000, 0x0000ff00, 0x000000ff, 0xff000000);
+				FillRandom(dst_sdl);
+				dst_sdl.SetClipRect(Rect(3, 2, 40, 30));
+
+				Surface dst_fast = dst_sdl.Convert(SDL_PIXELFORMAT_ARGB8888);
+				dst_fast.SetClipRect(Rect(3, 2, 40, 30));
+
+				// partially clipped on all sides
+				SDL_Rect sdl_rect = { 1, -3, 0, 0 };
+				SDL_Rect srcrect = { -2, 1, 40, 40 };
+				EXPECT_EQUAL(SDL_BlitSurface(src.Get(), &srcrect, dst_sdl.Get(), &sdl_rect), 0);
+
+				SDL_Rect fast_rect = { 1, -3, 0, 0 };
+				EXPECT_TRUE(BlitKernels::Blit(src.Get(), &srcrect, dst_fast.Get(), &fast_rect));
+
+				EXPECT_EQUAL(Rect(fast_rect), Rect(sdl_rect));
+
+				// SDL may pick its MMX blitter instead of the scalar
+				// one, which rounds each term separately
+				EXPECT_TRUE(SurfacesMatch(dst_sdl, dst_fast, blend_mode == SDL_BLENDMODE_NONE ? 0 : 2));
+			}
+		}
+	}
+
+	{
+		// Unsupported blits are left to SDL
+		Surface src(0, 8, 8, 32, 0x00ff0000, 0x0000ff00, 0x000000ff, 0xff000000);
+		Surface dst(0, 8, 8, 32, 0x00ff0000, 0x0000ff00, 0x000000ff, 0xff000000);
+
+		SDL_Rect rect = { 0, 0, 0, 0 };
+
+		src.SetColorMod(128, 128, 128);
+		EXPECT_TRUE(!BlitKernels::Blit(src.Get(), nullptr, dst.Get(), &rect));
+		src.SetColorMod(255, 255, 255);
+
+		src.SetColorKey(true, 0);
+		EXPECT_TRUE(!BlitKernels::Blit(src.Get(), nullptr, dst.Get(), &rect));
+		src.SetColorKey(false, 0);
+
+		src.SetBlendMode(SDL_BLENDMODE_ADD);
+		EXPECT_TRUE(!BlitKernels::Blit(src.Get(), nullptr, dst.Get(), &rect));
+		src.SetBlendMode(SDL_BLENDMODE_BLEND);
+
+		EXPECT_TRUE(BlitKernels::Blit(src.Get(), nullptr, dst.Get(), &rect));
+
+		// through Surface interface
+		EXPECT_NO_EXCEPTION(src.BlitFast(NullOpt, dst, Rect(2, 2, 0, 0)));
+	}
+END_TEST()
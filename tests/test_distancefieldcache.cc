@@ -0,0 +1,78 @@
+#include <stdexcept>
+
+#include <SDL_main.h>
+
+#include <SDL2pp/DistanceFieldCache.hh>
+#include <SDL2pp/PixelView.hh>
+#include <SDL2pp/Surface.hh>
+
+#include "testing.h"
+
+using namespace SDL2pp;
+
+static Uint8 GetAlpha(Surface& surface, int x, int y) {
+	Surface::LockHandle lock = surface.Lock();
+	PixelView<SDL_PIXELFORMAT_ARGB8888> view(surface, lock);
+	return PixelFormatTraits<SDL_PIXELFORMAT_ARGB8888>::GetAlpha(view.GetPixel(x, y));
+}
+
+BEGIN_TEST(int, char*[])
+	{
+		// Distance field of a solid square
+		Surface glyph(0, 10, 10, 32, 0x00ff0000, 0x0000ff00, 0x000000ff, 0xff000000);
+		glyph.FillRect(NullOpt, 0x00ffffff);
+		glyph.FillRect(Rect(2, 2, 6, 6), 0xffffffff);
+
+		Surface field = DistanceFieldCache::GenerateDistanceField(glyph, 4);
+		EXPECT_EQUAL(field.GetSize(), Point(18, 18));
+		EXPECT_EQUAL(field.GetFormat(), (Uint32)SDL_PIXELFORMAT_ARGB8888);
+
+		// far outside the outline
+		EXPECT_EQUAL((int)GetAlpha(field, 0, 0), 0);
+		EXPECT_EQUAL((int)GetAlpha(field, 0, 9), 0);
+
+		// outline lies halfway between last outside and first
+		// inside pixels, one pixel is 128 / spread
+		EXPECT_EQUAL((int)GetAlpha(field, 5, 9), 128 - 16);
+		EXPECT_EQUAL((int)GetAlpha(field, 6, 9), 128 + 16);
+		EXPECT_EQUAL((int)GetAlpha(field, 11, 9), 128 + 16);
+		EXPECT_EQUAL((int)GetAlpha(field, 12, 9), 128 - 16);
+		EXPECT_EQUAL((int)GetAlpha(field, 4, 9), 128 - 48);
+		EXPECT_EQUAL((int)GetAlpha(field, 7, 9), 128 + 48);
+
+		// distance grows towards the center
+		for (int x = 1; x <= 8; x++)
+			EXPECT_TRUE(GetAlpha(field, x, 9) >= GetAlpha(field, x - 1, 9));
+		EXPECT_TRUE(GetAlpha(field, 8, 9) > GetAlpha(field, 7, 9));
+
+		// symmetry
+		for (int x = 0; x < 18; x++)
+			EXPECT_EQUAL((int)GetAlpha(field, x, 9), (int)GetAlpha(field, 17 - x, 9));
+		for (int y = 0; y < 18; y++)
+			EXPECT_EQUAL((int)GetAlpha(field, 9, y), (int)GetAlpha(field, 9, 17 - y));
+	}
+
+	{
+		// Antialiased pixel with half coverage lies on the outline
+		Surface glyph(0, 1, 1, 32, 0x00ff0000, 0x0000ff00, 0x000000ff, 0xff000000);
+		glyph.FillRect(NullOpt, 0x80ffffff);
+
+		Surface field = DistanceFieldCache::GenerateDistanceField(glyph, 2);
+		EXPECT_EQUAL(field.GetSize(), Point(5, 5));
+		EXPECT_EQUAL((int)GetAlpha(field, 2, 2), 128);
+		EXPECT_EQUAL((int)GetAlpha(field, 1, 2), 128 - 64);
+		EXPECT_EQUAL((int)GetAlpha(field, 0, 0), 0);
+	}
+
+	{
+		// Empty image
+		Surface glyph(0, 3, 2, 32, 0x00ff0000, 0x0000ff00, 0x000000ff, 0xff000000);
+		glyph.FillRect(NullOpt, 0x00ffffff);
+
+		Surface field = DistanceFieldCache::GenerateDistanceField(glyph, 1);
+		EXPECT_EQUAL(field.GetSize(), Point(5, 4));
+		EXPECT_EQUAL((int)GetAlpha(field, 2, 2), 0);
+
+		EXPECT_EXCEPTION(DistanceFieldCache::GenerateDistanceField(glyph, 0), std::invalid_argument);
+	}
+END_TEST()
@@ -1,15 +1,53 @@
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+
 #include <SDL_main.h>
 
 #include <SDL2pp/Exception.hh>
 #include <SDL2pp/Font.hh>
+#include <SDL2pp/PixelView.hh>
 #include <SDL2pp/RWops.hh>
 #include <SDL2pp/SDLTTF.hh>
+#include <SDL2pp/UTF8.hh>
 
 #include "testing.h"
 #include "movetest.hh"
 
 using namespace SDL2pp;
 
+static int CountPixels(Surface& surface, const Rect& rect, Uint32 value, bool equal) {
+	Surface::LockHandle lock = surface.Lock();
+	PixelView<SDL_PIXELFORMAT_ARGB8888> view(surface, lock);
+
+	int count = 0;
+	for (int y = rect.y; y < rect.y + rect.h; y++)
+		for (int x = rect.x; x < rect.x + rect.w; x++)
+			if ((view.GetPixel(x, y) == value) == equal)
+				count++;
+	return count;
+}
+
+static Uint32 GetPixel(Surface& surface, int x, int y) {
+	Surface::LockHandle lock = surface.Lock();
+	return PixelView<SDL_PIXELFORMAT_ARGB8888>(surface, lock).GetPixel(x, y);
+}
+
+static int GetMaxDifference(Surface& a, Surface& b) {
+	Surface::LockHandle lock_a = a.Lock();
+	Surface::LockHandle lock_b = b.Lock();
+	PixelView<SDL_PIXELFORMAT_ARGB8888> view_a(a, lock_a);
+	PixelView<SDL_PIXELFORMAT_ARGB8888> view_b(b, lock_b);
+
+	int difference = 0;
+	for (int y = 0; y < view_a.GetHeight(); y++)
+		for (int x = 0; x < view_a.GetWidth(); x++)
+			for (int shift = 0; shift < 32; shift += 8)
+				difference = std::max(difference, std::abs(static_cast<int>((view_a.GetPixel(x, y) >> shift) & 0xff) - static_cast<int>((view_b.GetPixel(x, y) >> shift) & 0xff)));
+	return difference;
+}
+
 BEGIN_TEST(int, char*[])
 	SDLTTF ttf;
 	Font font(TESTDATA_DIR "/Vera.ttf", 30);
@@ -68,6 +106,27 @@ BEGIN_TEST(int, char*[])
 		EXPECT_EQUAL(font.GetKerning(), true);
 	}
 
+	{
+		// UTF-8 decoding
+		const char text[] = "A\xd0\x96\xe2\x82\xac\xf0\x9f\x98\x80\x80\xe2\x82";
+		const char* it = text;
+		const char* end = text + sizeof(text) - 1;
+
+		EXPECT_EQUAL(DecodeUTF8(it, end), 0x41U);
+		EXPECT_EQUAL(DecodeUTF8(it, end), 0x416U);
+		EXPECT_EQUAL(DecodeUTF8(it, end), 0x20ACU);
+
+		const char* astral = it;
+		EXPECT_EQUAL(DecodeUTF8(it, end), 0x1F600U);
+		EXPECT_EQUAL(DecodeUTF8ToUCS2(astral, end), 0xFFFD);
+		EXPECT_EQUAL(astral, it);
+
+		// stray continuation byte, then truncated sequence
+		EXPECT_EQUAL(DecodeUTF8(it, end), 0xFFFDU);
+		EXPECT_EQUAL(DecodeUTF8(it, end), 0xFFFDU);
+		EXPECT_EQUAL(it, end);
+	}
+
 	{
 		// Metrics
 		EXPECT_EQUAL(font.GetHeight(), 36);
@@ -122,6 +181,7 @@ BEGIN_TEST(int, char*[])
 
 		EXPECT_EQUAL(font.GetGlyphRect(u'A'), Rect(0, 0, 20, 22));
 		EXPECT_EQUAL(font.GetGlyphAdvance(u'A'), 21);
+		EXPECT_TRUE(font.GetKerningSize(u'A', u'V') <= 0);
 
 		// Text size
 		EXPECT_EQUAL(font.GetSizeText("AA"), Point(43, 36));
@@ -129,6 +189,42 @@ BEGIN_TEST(int, char*[])
 		EXPECT_EQUAL(font.GetSizeUNICODE(u"AA"), Point(43, 36));
 	}
 
+	{
+		// Metrics table
+		const std::string texts[] = { u8"AA", u8"AVA To", u8"Hello, world!", u8"\u00c4\u00df\u20ac" };
+		Point sizes[4];
+		Point bold_sizes[4];
+		for (int i = 0; i < 4; i++)
+			sizes[i] = font.GetSizeUTF8(texts[i]);
+		font.SetStyle(TTF_STYLE_BOLD);
+		for (int i = 0; i < 4; i++)
+			bold_sizes[i] = font.GetSizeUTF8(texts[i]);
+		font.SetStyle();
+
+		EXPECT_TRUE(!font.HasMetricsTable());
+		font.BuildMetricsTable();
+		EXPECT_TRUE(font.HasMetricsTable());
+
+		// last text has a char outside of the table
+		for (int i = 0; i < 4; i++)
+			EXPECT_EQUAL(font.GetSizeUTF8(texts[i]), sizes[i]);
+
+		EXPECT_EQUAL(font.GetGlyphAdvance(u'A'), 21);
+		EXPECT_EQUAL(font.GetGlyphRect(u'A'), Rect(0, 0, 20, 22));
+
+		// table follows style changes
+		font.SetStyle(TTF_STYLE_BOLD);
+		for (int i = 0; i < 4; i++)
+			EXPECT_EQUAL(font.GetSizeUTF8(texts[i]), bold_sizes[i]);
+		font.SetStyle();
+
+		font.BuildMetricsTable(u"AV");
+		EXPECT_EQUAL(font.GetSizeUTF8(texts[1]), sizes[1]);
+
+		font.DropMetricsTable();
+		EXPECT_TRUE(!font.HasMetricsTable());
+	}
+
 	{
 		// Rendering
 		// XXX: add real pixel color tests
@@ -144,4 +240,92 @@ BEGIN_TEST(int, char*[])
 		EXPECT_EQUAL(font.RenderUTF8_Blended(u8"AA", SDL_Color{255, 255, 255, 255}).GetSize(), Point(43, 36));
 		EXPECT_EQUAL(font.RenderUNICODE_Blended(u"AA", SDL_Color{255, 255, 255, 255}).GetSize(), Point(43, 36));
 	}
+
+	{
+		// Rendering into existing surface
+		const Uint32 black = 0xff000000, white = 0xffffffff, red = 0xffff0000;
+		Surface dst(0, 120, 60, 32, 0x00ff0000, 0x0000ff00, 0x000000ff, 0xff000000);
+		Rect all(0, 0, 120, 60);
+
+		dst.FillRect(NullOpt, black);
+		Rect box = font.RenderUTF8_Blended(u8"AA", SDL_Color{255, 255, 255, 255}, dst, Point(10, 20));
+		EXPECT_EQUAL(box.GetTopLeft(), Point(10, 20));
+		EXPECT_EQUAL(box.h, font.GetHeight());
+		EXPECT_TRUE(box.w >= font.GetGlyphAdvance(u'A') * 2);
+
+		// text is drawn inside the box only, blended over opaque
+		// background
+		int lit = CountPixels(dst, box, black, false);
+		EXPECT_TRUE(lit > 0);
+		EXPECT_EQUAL(CountPixels(dst, all, black, false), lit);
+
+		// same text renders the same from cached glyphs
+		dst.FillRect(NullOpt, black);
+		EXPECT_EQUAL(font.RenderUTF8_Blended(u8"AA", SDL_Color{255, 255, 255, 255}, dst, Point(10, 20)), box);
+		EXPECT_EQUAL(CountPixels(dst, box, black, false), lit);
+
+		// without blending, whole box is replaced
+		dst.FillRect(NullOpt, black);
+		font.RenderUTF8_Blended(u8"AA", SDL_Color{255, 255, 255, 255}, dst, Point(10, 20), SDL_BLENDMODE_NONE);
+		EXPECT_EQUAL(GetPixel(dst, 10, 20), 0x00ffffffU);
+		EXPECT_EQUAL(CountPixels(dst, all, black, true), 120 * 60 - box.w * box.h);
+
+		// clipping
+		dst.FillRect(NullOpt, black);
+		dst.SetClipRect(Rect(0, 0, 30, 60));
+		font.RenderUTF8_Blended(u8"AA", SDL_Color{255, 255, 255, 255}, dst, Point(10, 20));
+		EXPECT_TRUE(CountPixels(dst, Rect(0, 0, 30, 60), black, false) > 0);
+		EXPECT_EQUAL(CountPixels(dst, Rect(30, 0, 90, 60), black, false), 0);
+		dst.SetClipRect();
+
+		// shaded mode fills the box with background
+		dst.FillRect(NullOpt, black);
+		font.RenderUTF8_Shaded(u8"AA", SDL_Color{255, 255, 255, 255}, SDL_Color{255, 0, 0, 255}, dst, Point(10, 20));
+		EXPECT_EQUAL(GetPixel(dst, 10, 20), red);
+		EXPECT_EQUAL(CountPixels(dst, all, black, false), box.w * box.h);
+
+		// solid mode has no antialiasing
+		dst.FillRect(NullOpt, black);
+		font.RenderUTF8_Solid(u8"AA", SDL_Color{255, 255, 255, 255}, dst, Point(10, 20));
+		EXPECT_TRUE(CountPixels(dst, all, white, true) > 0);
+		EXPECT_EQUAL(CountPixels(dst, all, white, true) + CountPixels(dst, all, black, true), 120 * 60);
+
+		// single glyph
+		dst.FillRect(NullOpt, black);
+		Rect glyph_box = font.RenderGlyph_Blended(u'A', SDL_Color{255, 255, 255, 255}, dst, Point(0, 0));
+		EXPECT_EQUAL(glyph_box.h, font.GetHeight());
+		EXPECT_TRUE(glyph_box.w >= font.GetGlyphAdvance(u'A'));
+		EXPECT_TRUE(CountPixels(dst, glyph_box, black, false) > 0);
+
+		EXPECT_EXCEPTION(font.RenderUTF8_Blended(u8"AA", SDL_Color{255, 255, 255, 255}, dst, Point(0, 0), static_cast<SDL_BlendMode>(0x12345)), std::invalid_argument);
+	}
+
+	{
+		// Rendering into existing surface matches blitting text
+		// rendered by SDL_ttf with SDL_BlitSurface; SDL blitters
+		// use approximate arithmetics, so channels may be off by
+		// a few units
+		const TextRenderMode modes[] = { TextRenderMode::Solid, TextRenderMode::Shaded, TextRenderMode::Blended };
+		const SDL_BlendMode blends[] = { SDL_BLENDMODE_NONE, SDL_BLENDMODE_BLEND, SDL_BLENDMODE_ADD, SDL_BLENDMODE_MOD };
+		const SDL_Color fg = {255, 192, 64, 255}, bg = {32, 64, 128, 255};
+		const Uint32 background = 0xff406080;
+
+		for (TextRenderMode mode : modes) {
+			for (SDL_BlendMode blend : blends) {
+				Surface text = font.RenderUTF8(u8"AA", mode, fg, bg);
+				text.SetBlendMode(blend);
+
+				Surface expected(0, 120, 60, 32, 0x00ff0000, 0x0000ff00, 0x000000ff, 0xff000000);
+				expected.FillRect(NullOpt, background);
+				text.Blit(NullOpt, expected, Rect(10, 20, text.GetWidth(), text.GetHeight()));
+
+				Surface actual(0, 120, 60, 32, 0x00ff0000, 0x0000ff00, 0x000000ff, 0xff000000);
+				actual.FillRect(NullOpt, background);
+				Rect box = font.RenderUTF8(u8"AA", mode, fg, bg, actual, Point(10, 20), blend);
+
+				EXPECT_EQUAL(box, Rect(10, 20, text.GetWidth(), text.GetHeight()));
+				EXPECT_TRUE(GetMaxDifference(actual, expected) <= 3);
+			}
+		}
+	}
 END_TEST()
@@ -0,0 +1,74 @@
+#include <string>
+#include <vector>
+
+#include <SDL_main.h>
+
+#include <SDL2pp/Font.hh>
+#include <SDL2pp/FontFace.hh>
+#include <SDL2pp/RWops.hh>
+#include <SDL2pp/SDLTTF.hh>
+#include <SDL2pp/ThreadPool.hh>
+
+#include "testing.h"
+
+using namespace SDL2pp;
+
+BEGIN_TEST(int, char*[])
+	SDLTTF ttf;
+
+	{
+		// Loading
+		FontFace face(TESTDATA_DIR "/Vera.ttf");
+
+		RWops rwops = RWops::FromFile(TESTDATA_DIR "/Vera.ttf");
+		EXPECT_EQUAL(face.GetDataSize(), static_cast<size_t>(rwops.Size()));
+		EXPECT_EQUAL(face.GetIndex(), 0L);
+
+		FontFace face_by_rw(rwops);
+		EXPECT_EQUAL(face_by_rw.GetDataSize(), face.GetDataSize());
+
+		// fonts are independent of the RWops it was read from
+		rwops.Close();
+
+		Font font = face_by_rw.Open(30);
+		EXPECT_EQUAL(font.GetHeight(), 36);
+		EXPECT_EQUAL(font.GetSizeUTF8(u8"AA"), Point(43, 36));
+
+		EXPECT_EXCEPTION(FontFace(TESTDATA_DIR "/nonexistent.ttf"), Exception);
+	}
+
+	{
+		// Parallel rendering
+		FontFace face(TESTDATA_DIR "/Vera.ttf");
+		Font reference(TESTDATA_DIR "/Vera.ttf", 30);
+		ThreadPool pool(3);
+
+		std::vector<std::string> texts;
+		for (int i = 0; i < 64; i++)
+			texts.push_back(std::string(static_cast<size_t>(i % 8 + 1), 'A'));
+
+		std::vector<Surface> surfaces = face.RenderUTF8(pool, 30, texts, TextRenderMode::Blended, SDL_Color{255, 255, 255, 255});
+		EXPECT_EQUAL(surfaces.size(), texts.size());
+		for (size_t i = 0; i < texts.size(); i++)
+			EXPECT_EQUAL(surfaces[i].GetSize(), reference.GetSizeUTF8(texts[i]));
+
+		EXPECT_TRUE(face.GetNumIdleFonts() >= 1);
+		EXPECT_TRUE(face.GetNumIdleFonts() <= pool.GetConcurrency());
+
+		// idle fonts are reused and get requested style
+		reference.SetStyle(TTF_STYLE_BOLD);
+		surfaces = face.RenderUTF8(pool, 30, texts, TextRenderMode::Shaded, SDL_Color{255, 255, 255, 255}, SDL_Color{0, 0, 0, 255}, TTF_STYLE_BOLD);
+		for (size_t i = 0; i < texts.size(); i++)
+			EXPECT_EQUAL(surfaces[i].GetSize(), reference.GetSizeUTF8(texts[i]));
+		EXPECT_TRUE(face.GetNumIdleFonts() <= pool.GetConcurrency());
+
+		// empty string can't be rendered; fonts are still returned
+		texts[10].clear();
+		EXPECT_EXCEPTION(face.RenderUTF8(pool, 30, texts, TextRenderMode::Blended, SDL_Color{255, 255, 255, 255}), Exception);
+		EXPECT_TRUE(face.GetNumIdleFonts() >= 1);
+		EXPECT_TRUE(face.GetNumIdleFonts() <= pool.GetConcurrency());
+
+		face.ClearIdleFonts();
+		EXPECT_EQUAL(face.GetNumIdleFonts(), 0U);
+	}
+END_TEST()
@@ -0,0 +1,89 @@
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <SDL_main.h>
+
+#include <SDL2pp/Font.hh>
+#include <SDL2pp/FontRegistry.hh>
+#include <SDL2pp/RWops.hh>
+#include <SDL2pp/SDLTTF.hh>
+
+#include "testing.h"
+
+using namespace SDL2pp;
+
+BEGIN_TEST(int, char*[])
+	SDLTTF ttf;
+
+	{
+		// Registration
+		FontRegistry fonts;
+		EXPECT_TRUE(!fonts.Has("vera"));
+		EXPECT_EQUAL(fonts.GetTotalDataSize(), 0U);
+
+		fonts.Add("vera", TESTDATA_DIR "/Vera.ttf");
+
+		RWops rwops = RWops::FromFile(TESTDATA_DIR "/Vera.ttf");
+		size_t file_size = static_cast<size_t>(rwops.Size());
+		fonts.Add("another", rwops);
+		rwops.Close();
+
+		EXPECT_TRUE(fonts.Has("vera"));
+		EXPECT_TRUE(fonts.Has("another"));
+		EXPECT_TRUE(fonts.GetNames() == std::vector<std::string>({"another", "vera"}));
+		EXPECT_EQUAL(fonts.GetDataSize("vera"), file_size);
+		EXPECT_EQUAL(fonts.GetDataSize("another"), file_size);
+		EXPECT_EQUAL(fonts.GetTotalDataSize(), file_size * 2);
+
+		EXPECT_EXCEPTION(fonts.Add("vera", TESTDATA_DIR "/Vera.ttf"), std::invalid_argument);
+		EXPECT_EXCEPTION(fonts.Add("missing", TESTDATA_DIR "/nonexistent.ttf"), Exception);
+		EXPECT_TRUE(!fonts.Has("missing"));
+		EXPECT_EXCEPTION(fonts.GetDataSize("missing"), std::out_of_range);
+
+		fonts.Remove("another");
+		EXPECT_TRUE(!fonts.Has("another"));
+		EXPECT_EQUAL(fonts.GetTotalDataSize(), file_size);
+		EXPECT_EXCEPTION(fonts.Remove("another"), std::out_of_range);
+
+		fonts.Clear();
+		EXPECT_TRUE(fonts.GetNames().empty());
+	}
+
+	{
+		// Lazily opened fonts
+		FontRegistry fonts;
+		fonts.Add("vera", TESTDATA_DIR "/Vera.ttf");
+		EXPECT_EQUAL(fonts.GetNumFonts("vera"), 0U);
+
+		Font& font30 = fonts.Get("vera", 30);
+		EXPECT_EQUAL(font30.GetHeight(), 36);
+		EXPECT_EQUAL(font30.GetSizeUTF8(u8"AA"), Point(43, 36));
+		EXPECT_EQUAL(fonts.GetNumFonts("vera"), 1U);
+
+		// same size is reused
+		EXPECT_EQUAL(&fonts.Get("vera", 30), &font30);
+		EXPECT_EQUAL(fonts.GetNumFonts("vera"), 1U);
+
+		// other sizes are opened from the same data
+		Font& font15 = fonts.Get("vera", 15);
+		EXPECT_TRUE(&font15 != &font30);
+		EXPECT_TRUE(font15.GetHeight() < font30.GetHeight());
+		EXPECT_EQUAL(fonts.GetNumFonts("vera"), 2U);
+		EXPECT_EQUAL(&fonts.Get("vera", 30), &font30);
+
+		// Open() returns fonts not kept by registry
+		{
+			Font font = fonts.Open("vera", 30);
+			EXPECT_EQUAL(font.GetHeight(), 36);
+			EXPECT_EQUAL(fonts.GetNumFonts("vera"), 2U);
+		}
+
+		EXPECT_EXCEPTION(fonts.Get("missing", 30), std::out_of_range);
+
+		fonts.CloseFonts("vera");
+		EXPECT_EQUAL(fonts.GetNumFonts("vera"), 0U);
+		EXPECT_TRUE(fonts.Has("vera"));
+		EXPECT_EQUAL(fonts.Get("vera", 30).GetHeight(), 36);
+	}
+END_TEST()
@@ -0,0 +1,222 @@
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include <SDL_main.h>
+#include <SDL_pixels.h>
+
+#include <SDL2pp/PixelView.hh>
+#include <SDL2pp/Surface.hh>
+
+#include "testing.h"
+
+using namespace SDL2pp;
+
+// channel extraction and mapping are usable at compile time
+typedef PixelFormatTraits<SDL_PIXELFORMAT_ARGB8888> ARGB8888;
+static_assert(ARGB8888::GetRed(0x80112233) == 0x11, "");
+static_assert(ARGB8888::GetGreen(0x80112233) == 0x22, "");
+static_assert(ARGB8888::GetBlue(0x80112233) == 0x33, "");
+static_assert(ARGB8888::GetAlpha(0x80112233) == 0x80, "");
+static_assert(ARGB8888::MapRGBA(0x11, 0x22, 0x33, 0x80) == 0x80112233, "");
+static_assert(ARGB8888::MapColor(Color(1, 2, 3)) == 0xff010203, "");
+
+typedef PixelFormatTraits<SDL_PIXELFORMAT_RGB565> RGB565;
+static_assert(RGB565::GetRed(0xf800) == 0xff, "");
+static_assert(RGB565::GetGreen(0x0020) == 0x04, "");
+static_assert(RGB565::GetBlue(0x0010) == 0x84, "");
+static_assert(RGB565::GetAlpha(0x0000) == 0xff, "");
+static_assert(RGB565::MapRGBA(0xff, 0x80, 0x07) == 0xfc00, "");
+
+typedef PixelFormatTraits<SDL_PIXELFORMAT_ARGB1555> ARGB1555;
+static_assert(ARGB1555::GetAlpha(0x8000) == 0xff, "");
+static_assert(ARGB1555::GetAlpha(0x7fff) == 0x00, "");
+static_assert(ARGB1555::MapRGBA(0, 0, 0, 0x80) == 0x8000, "");
+
+typedef PixelFormatTraits<SDL_PIXELFORMAT_RGB332> RGB332;
+static_assert(RGB332::GetRed(0x20) == 0x24, "");
+static_assert(RGB332::GetBlue(0x01) == 0x55, "");
+static_assert(RGB332::GetBlue(0x03) == 0xff, "");
+
+typedef PixelFormatTraits<SDL_PIXELFORMAT_ARGB2101010> ARGB2101010;
+static_assert(ARGB2101010::GetRed(0x3ff00000) == 0xff, "");
+static_assert(ARGB2101010::GetAlpha(0x40000000) == 0x55, "");
+static_assert(ARGB2101010::MapRGBA(0xff, 0, 0x80, 0xff) == 0xfff00202, "");
+
+typedef PixelFormatTraits<SDL_PIXELFORMAT_BGR24> BGR24;
+static_assert(BGR24::MapRGBA(1, 2, 3).bytes[0] == 3, "");
+static_assert(BGR24::GetRed(Pixel24{{3, 2, 1}}) == 1, "");
+
+static const Uint32 packed_formats[] = {
+	SDL_PIXELFORMAT_RGB332,
+	SDL_PIXELFORMAT_RGB444,
+	SDL_PIXELFORMAT_RGB555,
+	SDL_PIXELFORMAT_BGR555,
+	SDL_PIXELFORMAT_ARGB4444,
+	SDL_PIXELFORMAT_RGBA4444,
+	SDL_PIXELFORMAT_ABGR4444,
+	SDL_PIXELFORMAT_BGRA4444,
+	SDL_PIXELFORMAT_ARGB1555,
+	SDL_PIXELFORMAT_RGBA5551,
+	SDL_PIXELFORMAT_ABGR1555,
+	SDL_PIXELFORMAT_BGRA5551,
+	SDL_PIXELFORMAT_RGB565,
+	SDL_PIXELFORMAT_BGR565,
+	SDL_PIXELFORMAT_RGB888,
+	SDL_PIXELFORMAT_RGBX8888,
+	SDL_PIXELFORMAT_BGR888,
+	SDL_PIXELFORMAT_BGRX8888,
+	SDL_PIXELFORMAT_ARGB8888,
+	SDL_PIXELFORMAT_RGBA8888,
+	SDL_PIXELFORMAT_ABGR8888,
+	SDL_PIXELFORMAT_BGRA8888,
+};
+
+// compares view pixel mapping with SDL for every pixel of the view
+struct CompareWithSDL {
+	const SDL_PixelFormat* format;
+	bool check_get; // SDL_GetRGBA is only exact for channels of 4+ bits in older SDL versions
+
+	template<Uint32 Format>
+	bool operator()(PixelView<Format> view) const {
+		typedef typename PixelView<Format>::Traits Traits;
+
+		for (auto row : view) {
+			for (auto& pixel : row) {
+				Uint8 r, g, b, a;
+				SDL_GetRGBA(pixel, format, &r, &g, &b, &a);
+				if (check_get && (Traits::GetRed(pixel) != r || Traits::GetGreen(pixel) != g || Traits::GetBlue(pixel) != b || Traits::GetAlpha(pixel) != a))
+					return false;
+
+				Uint8 value = static_cast<Uint8>(pixel * 37 + 11);
+				if (Traits::MapRGBA(value, value ^ 0x5a, value + 101, value ^ 0xc3) != static_cast<typename Traits::PixelType>(SDL_MapRGBA(format, value, value ^ 0x5a, value + 101, value ^ 0xc3)))
+					return false;
+			}
+		}
+		return true;
+	}
+
+	// not packed formats, never visited
+	bool operator()(PixelView<SDL_PIXELFORMAT_RGB24>) const {
+		return false;
+	}
+
+	bool operator()(PixelView<SDL_PIXELFORMAT_BGR24>) const {
+		return false;
+	}
+};
+
+// returns format of the view it was called with
+struct GetViewFormat {
+	template<Uint32 Format>
+	Uint32 operator()(const PixelView<Format>& view) const {
+		return view.GetFormat();
+	}
+};
+
+BEGIN_TEST(int, char*[])
+	{
+		// Channel extraction and mapping match SDL
+		for (Uint32 format : packed_formats) {
+			SDL_PixelFormat* sdl_format = SDL_AllocFormat(format);
+			EXPECT_TRUE(sdl_format != nullptr);
+			if (sdl_format == nullptr)
+				continue;
+
+			bool check_get = sdl_format->Rloss <= 4 && sdl_format->Gloss <= 4 && sdl_format->Bloss <= 4 && (sdl_format->Amask == 0 || sdl_format->Aloss <= 4);
+
+			// every value of 8 and 16 bit formats, sample of 32 bit ones
+			std::vector<Uint32> pixels(65536);
+			for (size_t i = 0; i < pixels.size(); i++)
+				pixels[i] = sdl_format->BytesPerPixel == 4 ? static_cast<Uint32>(i * 2654435761U) : static_cast<Uint32>(i);
+
+			std::vector<Uint8> data(pixels.size() * sdl_format->BytesPerPixel);
+			for (size_t i = 0; i < pixels.size(); i++)
+				std::memcpy(data.data() + i * sdl_format->BytesPerPixel, &pixels[i], sdl_format->BytesPerPixel);
+
+			int width = sdl_format->BytesPerPixel == 1 ? 256 : 65536;
+			int height = static_cast<int>(pixels.size()) / width;
+			EXPECT_TRUE(VisitPixelView(format, data.data(), width * sdl_format->BytesPerPixel, width, height, CompareWithSDL{sdl_format, check_get}), SDL_GetPixelFormatName(format));
+
+			SDL_FreeFormat(sdl_format);
+		}
+	}
+
+	{
+		// Row iteration respects pitch
+		Uint16 data[4 * 3];
+		for (auto& pixel : data)
+			pixel = 0xdead;
+
+		PixelView<SDL_PIXELFORMAT_RGB565> view(data, 4 * sizeof(Uint16), 3, 3);
+		EXPECT_EQUAL(view.GetWidth(), 3);
+		EXPECT_EQUAL(view.GetHeight(), 3);
+		EXPECT_EQUAL(view.GetPitch(), 8);
+
+		int rows = 0;
+		for (auto row : view) {
+			EXPECT_EQUAL(row.GetWidth(), 3);
+			for (auto& pixel : row)
+				pixel = static_cast<Uint16>(rows);
+			rows++;
+		}
+		EXPECT_EQUAL(rows, 3);
+
+		EXPECT_EQUAL(data[0], 0);
+		EXPECT_EQUAL(data[2], 0);
+		EXPECT_EQUAL(data[3], 0xdead);
+		EXPECT_EQUAL(data[4], 1);
+		EXPECT_EQUAL(data[11], 0xdead);
+		EXPECT_EQUAL(view.GetPixel(1, 2), 2);
+		EXPECT_EQUAL(view.GetRow(1)[2], 1);
+		EXPECT_EQUAL((*view.begin())[1], 0);
+
+		view.GetPixel(2, 1) = 7;
+		EXPECT_EQUAL(data[6], 7);
+	}
+
+	{
+		// 24 bit formats
+		Uint8 data[3 * 2] = { 1, 2, 3, 4, 5, 6 };
+
+		PixelView<SDL_PIXELFORMAT_RGB24> rgb(data, sizeof(data), 2, 1);
+		EXPECT_EQUAL(rgb.GetPixel(1, 0).bytes[0], 4);
+		EXPECT_EQUAL(PixelFormatTraits<SDL_PIXELFORMAT_RGB24>::GetColor(rgb.GetPixel(1, 0)), Color(4, 5, 6));
+
+		PixelView<SDL_PIXELFORMAT_BGR24> bgr(data, sizeof(data), 2, 1);
+		EXPECT_EQUAL(PixelFormatTraits<SDL_PIXELFORMAT_BGR24>::GetColor(bgr.GetPixel(1, 0)), Color(6, 5, 4));
+
+		bgr.GetPixel(0, 0) = PixelFormatTraits<SDL_PIXELFORMAT_BGR24>::MapColor(Color(7, 8, 9));
+		EXPECT_EQUAL(data[0], 9);
+		EXPECT_EQUAL(data[2], 7);
+		EXPECT_EQUAL(data[3], 4);
+	}
+
+	{
+		// Run time dispatch
+		Uint32 pixel = 0;
+		EXPECT_EQUAL(VisitPixelView(SDL_PIXELFORMAT_ABGR8888, &pixel, 4, 1, 1, GetViewFormat()), (Uint32)SDL_PIXELFORMAT_ABGR8888);
+		EXPECT_EQUAL(VisitPixelView(SDL_PIXELFORMAT_BGR24, &pixel, 4, 1, 1, GetViewFormat()), (Uint32)SDL_PIXELFORMAT_BGR24);
+		EXPECT_EQUAL(VisitPixelView(SDL_PIXELFORMAT_ARGB2101010, &pixel, 4, 1, 1, GetViewFormat()), (Uint32)SDL_PIXELFORMAT_ARGB2101010);
+
+		EXPECT_TRUE(IsPixelViewFormatSupported(SDL_PIXELFORMAT_RGB565));
+		EXPECT_TRUE(!IsPixelViewFormatSupported(SDL_PIXELFORMAT_INDEX8));
+		EXPECT_TRUE(!IsPixelViewFormatSupported(SDL_PIXELFORMAT_IYUV));
+		EXPECT_EXCEPTION(VisitPixelView(SDL_PIXELFORMAT_INDEX8, &pixel, 4, 1, 1, GetViewFormat()), std::invalid_argument);
+	}
+
+	{
+		// Surface views
+		Surface surface(0, 4, 2, 32, 0x00ff0000, 0x0000ff00, 0x000000ff, 0xff000000);
+		Surface::LockHandle lock = surface.Lock();
+
+		PixelView<SDL_PIXELFORMAT_ARGB8888> view(surface, lock);
+		EXPECT_EQUAL(view.GetWidth(), 4);
+		EXPECT_EQUAL(view.GetHeight(), 2);
+		view.GetPixel(3, 1) = 0x12345678;
+		EXPECT_EQUAL(static_cast<Uint32*>(lock.GetPixels())[lock.GetPitch() / 4 + 3], 0x12345678U);
+
+		EXPECT_EQUAL(VisitPixelView(surface, lock, GetViewFormat()), (Uint32)SDL_PIXELFORMAT_ARGB8888);
+		EXPECT_EXCEPTION((PixelView<SDL_PIXELFORMAT_ABGR8888>(surface, lock)), std::invalid_argument);
+	}
+END_TEST()
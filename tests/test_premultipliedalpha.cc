@@ -0,0 +1,145 @@
+#include <cstdlib>
+#include <stdexcept>
+#include <vector>
+
+#include <SDL_main.h>
+#include <SDL_pixels.h>
+
+#include <SDL2pp/PremultipliedAlpha.hh>
+#include <SDL2pp/Surface.hh>
+
+#include "testing.h"
+
+using namespace SDL2pp;
+
+BEGIN_TEST(int, char*[])
+	EXPECT_TRUE(PremultipliedAlpha::IsFormatSupported(SDL_PIXELFORMAT_ARGB8888));
+	EXPECT_TRUE(PremultipliedAlpha::IsFormatSupported(SDL_PIXELFORMAT_ABGR8888));
+	EXPECT_TRUE(PremultipliedAlpha::IsFormatSupported(SDL_PIXELFORMAT_RGBA8888));
+	EXPECT_TRUE(PremultipliedAlpha::IsFormatSupported(SDL_PIXELFORMAT_BGRA8888));
+	EXPECT_TRUE(!PremultipliedAlpha::IsFormatSupported(SDL_PIXELFORMAT_RGB888));
+	EXPECT_TRUE(!PremultipliedAlpha::IsFormatSupported(SDL_PIXELFORMAT_ARGB4444));
+	EXPECT_TRUE(!PremultipliedAlpha::IsFormatSupported(SDL_PIXELFORMAT_ARGB2101010));
+	EXPECT_TRUE(!PremultipliedAlpha::IsFormatSupported(SDL_PIXELFORMAT_INDEX8));
+
+	{
+		// Known values
+		Uint32 pixels[] = { 0x80ff8000, 0xff123456, 0x00ffffff, 0x01ff7f00, 0x80808080 };
+		PremultipliedAlpha::Premultiply(5, 1, SDL_PIXELFORMAT_ARGB8888, pixels, sizeof(pixels), pixels, sizeof(pixels));
+
+		EXPECT_EQUAL(pixels[0], 0x80804000U);
+		EXPECT_EQUAL(pixels[1], 0xff123456U);
+		EXPECT_EQUAL(pixels[2], 0x00000000U);
+		EXPECT_EQUAL(pixels[3], 0x01010000U);
+		EXPECT_EQUAL(pixels[4], 0x80404040U);
+
+		PremultipliedAlpha::Unpremultiply(5, 1, SDL_PIXELFORMAT_ARGB8888, pixels, sizeof(pixels), pixels, sizeof(pixels));
+
+		EXPECT_EQUAL(pixels[0], 0x80ff8000U);
+		EXPECT_EQUAL(pixels[1], 0xff123456U);
+		EXPECT_EQUAL(pixels[2], 0x00000000U);
+		EXPECT_EQUAL(pixels[3], 0x01ff0000U);
+		EXPECT_EQUAL(pixels[4], 0x80808080U);
+	}
+
+	{
+		// All instruction sets produce identical output, for any alpha position
+		const Uint32 formats[] = { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGRA8888 };
+		const BlitKernels::Isa isas[] = { BlitKernels::Isa::SSE2, BlitKernels::Isa::AVX2 };
+
+		const int width = 37, height = 5, pitch = width * 4 + 8;
+		std::vector<Uint8> src(pitch * height);
+		std::srand(1);
+		for (auto& byte : src)
+			byte = static_cast<Uint8>(std::rand());
+
+		for (Uint32 format : formats) {
+			std::vector<Uint8> expected(src.size());
+			PremultipliedAlpha::Premultiply(width, height, format, src.data(), pitch, expected.data(), pitch, BlitKernels::Isa::Scalar);
+
+			for (BlitKernels::Isa isa : isas) {
+				if (!BlitKernels::IsIsaSupported(isa))
+					continue;
+
+				std::vector<Uint8> actual(src.size());
+				PremultipliedAlpha::Premultiply(width, height, format, src.data(), pitch, actual.data(), pitch, isa);
+
+				bool match = true;
+				for (int y = 0; y < height; y++)
+					for (int x = 0; x < width * 4; x++)
+						if (expected[y * pitch + x] != actual[y * pitch + x])
+							match = false;
+				EXPECT_TRUE(match, "SIMD output differs from scalar");
+			}
+
+			// in place gives the same result
+			std::vector<Uint8> in_place(src);
+			PremultipliedAlpha::Premultiply(width, height, format, in_place.data(), pitch, in_place.data(), pitch);
+			bool match = true;
+			for (int y = 0; y < height; y++)
+				for (int x = 0; x < width * 4; x++)
+					if (expected[y * pitch + x] != in_place[y * pitch + x])
+						match = false;
+			EXPECT_TRUE(match);
+
+			// same for the other direction; random input includes
+			// channels above alpha, which must saturate the same way
+			std::vector<Uint8> expected_back(src.size());
+			PremultipliedAlpha::Unpremultiply(width, height, format, src.data(), pitch, expected_back.data(), pitch, BlitKernels::Isa::Scalar);
+
+			for (BlitKernels::Isa isa : isas) {
+				if (!BlitKernels::IsIsaSupported(isa))
+					continue;
+
+				std::vector<Uint8> actual(src.size());
+				PremultipliedAlpha::Unpremultiply(width, height, format, src.data(), pitch, actual.data(), pitch, isa);
+
+				bool match = true;
+				for (int y = 0; y < height; y++)
+					for (int x = 0; x < width * 4; x++)
+						if (expected_back[y * pitch + x] != actual[y * pitch + x])
+							match = false;
+				EXPECT_TRUE(match, "SIMD output differs from scalar");
+			}
+		}
+	}
+
+	EXPECT_EXCEPTION(PremultipliedAlpha::Premultiply(1, 1, SDL_PIXELFORMAT_RGB565, nullptr, 2, nullptr, 2), std::invalid_argument);
+	EXPECT_EXCEPTION(PremultipliedAlpha::Unpremultiply(1, 1, SDL_PIXELFORMAT_RGB888, nullptr, 4, nullptr, 4), std::invalid_argument);
+
+	{
+		// Surface
+		Surface argb(0, 8, 8, 32, 0x00ff0000, 0x0000ff00, 0x000000ff, 0xff000000);
+		argb.FillRect(NullOpt, 0x80ff8000);
+		argb.PremultiplyAlpha();
+		{
+			Surface::LockHandle lock = argb.Lock();
+			EXPECT_EQUAL(static_cast<const Uint32*>(lock.GetPixels())[63], 0x80804000U);
+		}
+
+		argb.UnpremultiplyAlpha();
+		{
+			Surface::LockHandle lock = argb.Lock();
+			EXPECT_EQUAL(static_cast<const Uint32*>(lock.GetPixels())[63], 0x80ff8000U);
+		}
+
+		// formats without 8 bit channels go through ARGB8888
+		Surface argb4444(0, 8, 8, 16, 0x0f00, 0x00f0, 0x000f, 0xf000);
+		argb4444.FillRect(NullOpt, 0x0000); // color of fully transparent pixels is lost
+		argb4444.FillRect(Rect(0, 0, 1, 1), 0x8f80);
+		argb4444.PremultiplyAlpha();
+		{
+			Surface::LockHandle lock = argb4444.Lock();
+			EXPECT_EQUAL(static_cast<const Uint16*>(lock.GetPixels())[0], 0x8840);
+		}
+
+		// no alpha: unchanged
+		Surface rgb(0, 8, 8, 32, 0x00ff0000, 0x0000ff00, 0x000000ff, 0);
+		rgb.FillRect(NullOpt, 0x123456);
+		rgb.PremultiplyAlpha();
+		{
+			Surface::LockHandle lock = rgb.Lock();
+			EXPECT_EQUAL(static_cast<const Uint32*>(lock.GetPixels())[0] & 0xffffff, 0x123456U);
+		}
+	}
+END_TEST()
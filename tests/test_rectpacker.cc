@@ -0,0 +1,72 @@
+#include <vector>
+
+#include <SDL_main.h>
+
+#include <SDL2pp/RectPacker.hh>
+
+#include "testing.h"
+
+using namespace SDL2pp;
+
+BEGIN_TEST(int, char*[])
+	{
+		// Basic placement
+		RectPacker packer(64, 64);
+
+		EXPECT_EQUAL(packer.GetWidth(), 64);
+		EXPECT_EQUAL(packer.GetHeight(), 64);
+
+		Optional<Rect> a = packer.Pack(Point(32, 32));
+		EXPECT_TRUE(a && *a == Rect(0, 0, 32, 32));
+
+		Optional<Rect> b = packer.Pack(Point(32, 16));
+		EXPECT_TRUE(b && *b == Rect(32, 0, 32, 16));
+
+		Optional<Rect> c = packer.Pack(Point(32, 16));
+		EXPECT_TRUE(c && *c == Rect(32, 16, 32, 16));
+
+		Optional<Rect> d = packer.Pack(Point(64, 32));
+		EXPECT_TRUE(d && *d == Rect(0, 32, 64, 32));
+
+		EXPECT_EQUAL(packer.GetOccupancy(), 1.0f);
+
+		EXPECT_TRUE(!packer.Pack(Point(1, 1)));
+
+		packer.Clear();
+		EXPECT_EQUAL(packer.GetOccupancy(), 0.0f);
+		EXPECT_TRUE(!!packer.Pack(Point(64, 64)));
+	}
+
+	{
+		// Rejects
+		RectPacker packer(16, 16);
+
+		EXPECT_TRUE(!packer.Pack(Point(17, 1)));
+		EXPECT_TRUE(!packer.Pack(Point(1, 17)));
+		EXPECT_TRUE(!packer.Pack(Point(0, 1)));
+	}
+
+	{
+		// No overlaps, everything inside the area
+		RectPacker packer(128, 128);
+		std::vector<Rect> placed;
+
+		for (int i = 0; i < 200; i++) {
+			Optional<Rect> rect = packer.Pack(Point(1 + (i * 7) % 13, 1 + (i * 5) % 11));
+			if (rect)
+				placed.push_back(*rect);
+		}
+
+		EXPECT_TRUE(!placed.empty());
+
+		bool ok = true;
+		for (size_t i = 0; i < placed.size(); i++) {
+			if (placed[i].x < 0 || placed[i].y < 0 || placed[i].GetX2() >= 128 || placed[i].GetY2() >= 128)
+				ok = false;
+			for (size_t j = i + 1; j < placed.size(); j++)
+				if (placed[i].Intersects(placed[j]))
+					ok = false;
+		}
+		EXPECT_TRUE(ok);
+	}
+END_TEST()
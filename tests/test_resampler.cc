@@ -0,0 +1,143 @@
+#include <cstdlib>
+#include <stdexcept>
+#include <vector>
+
+#include <SDL_main.h>
+
+#include <SDL2pp/Resampler.hh>
+#include <SDL2pp/Surface.hh>
+#include <SDL2pp/ThreadPool.hh>
+
+#include "testing.h"
+
+using namespace SDL2pp;
+
+static std::vector<Uint8> MakeImage(int w, int h, int pitch, unsigned int seed) {
+	std::vector<Uint8> image(static_cast<size_t>(pitch) * h);
+	std::srand(seed);
+	for (int y = 0; y < h; y++)
+		for (int x = 0; x < w * 4; x++)
+			image[y * pitch + x] = static_cast<Uint8>(std::rand());
+	return image;
+}
+
+static bool ImagesEqual(const std::vector<Uint8>& a, const std::vector<Uint8>& b, int w, int h, int pitch) {
+	for (int y = 0; y < h; y++)
+		for (int x = 0; x < w * 4; x++)
+			if (a[y * pitch + x] != b[y * pitch + x])
+				return false;
+	return true;
+}
+
+BEGIN_TEST(int, char*[])
+	const ResizeFilter filters[] = { ResizeFilter::Bilinear, ResizeFilter::Bicubic, ResizeFilter::Lanczos3 };
+	const int sizes[][4] = {
+		{ 97, 61, 31, 17 },   // downscale
+		{ 13, 9, 101, 47 },   // upscale
+		{ 64, 64, 64, 21 },   // vertical only
+		{ 50, 70, 123, 70 },  // horizontal only
+		{ 200, 3, 7, 150 },   // mixed
+	};
+
+	ThreadPool pool(3);
+
+	for (ResizeFilter filter : filters) {
+		for (const auto& size : sizes) {
+			int src_pitch = size[0] * 4 + 12;
+			int dst_pitch = size[2] * 4 + 4;
+			std::vector<Uint8> src = MakeImage(size[0], size[1], src_pitch, static_cast<unsigned int>(size[0] * size[3]));
+
+			Resampler scalar(size[0], size[1], size[2], size[3], filter, BlitKernels::Isa::Scalar);
+			std::vector<Uint8> expected(static_cast<size_t>(dst_pitch) * size[3]);
+			scalar.Resample(src.data(), src_pitch, expected.data(), dst_pitch);
+
+			// SIMD and parallel variants are bit exact
+			Resampler best(size[0], size[1], size[2], size[3], filter);
+			std::vector<Uint8> actual(expected.size());
+			best.Resample(src.data(), src_pitch, actual.data(), dst_pitch);
+			EXPECT_TRUE(ImagesEqual(expected, actual, size[2], size[3], dst_pitch), "SIMD output differs from scalar");
+
+			std::vector<Uint8> parallel(expected.size());
+			best.Resample(src.data(), src_pitch, parallel.data(), dst_pitch, pool);
+			EXPECT_TRUE(ImagesEqual(expected, parallel, size[2], size[3], dst_pitch), "parallel output differs from single threaded");
+
+			// reused intermediate buffer does not affect output
+			std::vector<Uint8> reused(expected.size());
+			scalar.Resample(src.data(), src_pitch, reused.data(), dst_pitch);
+			EXPECT_TRUE(ImagesEqual(expected, reused, size[2], size[3], dst_pitch), "reused resampler output differs");
+		}
+
+		{
+			// flat image stays flat
+			std::vector<Uint8> flat(37 * 23 * 4);
+			for (size_t i = 0; i < flat.size(); i += 4) {
+				flat[i] = 0; flat[i + 1] = 77; flat[i + 2] = 200; flat[i + 3] = 255;
+			}
+
+			Resampler resampler(37, 23, 80, 9, filter);
+			std::vector<Uint8> out(80 * 9 * 4);
+			resampler.Resample(flat.data(), 37 * 4, out.data(), 80 * 4);
+
+			bool is_flat = true;
+			for (size_t i = 0; i < out.size(); i += 4)
+				if (out[i] != 0 || out[i + 1] != 77 || out[i + 2] != 200 || out[i + 3] != 255)
+					is_flat = false;
+			EXPECT_TRUE(is_flat);
+		}
+
+		{
+			// same size is exact copy
+			std::vector<Uint8> src = MakeImage(19, 11, 19 * 4, 1);
+			std::vector<Uint8> out(src.size());
+			Resampler(19, 11, 19, 11, filter).Resample(src.data(), 19 * 4, out.data(), 19 * 4);
+			EXPECT_TRUE(src == out);
+		}
+	}
+
+	{
+		// 2x bilinear upscale interpolates between pixels
+		const Uint8 src[] = { 0, 0, 0, 0, 100, 100, 100, 100 };
+		Uint8 out[16];
+		Resampler(2, 1, 4, 1, ResizeFilter::Bilinear).Resample(src, 8, out, 16);
+		EXPECT_EQUAL((int)out[0], 0);
+		EXPECT_EQUAL((int)out[4], 25);
+		EXPECT_EQUAL((int)out[8], 75);
+		EXPECT_EQUAL((int)out[12], 100);
+	}
+
+	EXPECT_EXCEPTION(Resampler(0, 1, 1, 1, ResizeFilter::Bilinear), std::invalid_argument);
+	EXPECT_EXCEPTION(Resampler(1, 1, 1, -1, ResizeFilter::Bilinear), std::invalid_argument);
+
+	{
+		// Surface::Resize
+		Surface src(0, 40, 30, 32, 0x00ff0000, 0x0000ff00, 0x000000ff, 0xff000000);
+		src.FillRect(NullOpt, 0x80402010);
+		src.SetBlendMode(SDL_BLENDMODE_ADD);
+
+		Surface resized = src.Resize(17, 55, ResizeFilter::Lanczos3);
+		EXPECT_EQUAL(resized.GetSize(), Point(17, 55));
+		EXPECT_EQUAL(resized.GetFormat(), src.GetFormat());
+		EXPECT_EQUAL(resized.GetBlendMode(), SDL_BLENDMODE_ADD);
+		{
+			Surface::LockHandle lock = resized.Lock();
+			EXPECT_EQUAL(static_cast<const Uint32*>(lock.GetPixels())[0], 0x80402010U);
+		}
+
+		Surface parallel = src.Resize(17, 55, ResizeFilter::Lanczos3, pool);
+		{
+			Surface::LockHandle lock1 = resized.Lock();
+			Surface::LockHandle lock2 = parallel.Lock();
+			EXPECT_EQUAL(static_cast<const Uint32*>(lock2.GetPixels())[17 * 55 - 1], static_cast<const Uint32*>(lock1.GetPixels())[17 * 55 - 1]);
+		}
+
+		// into existing surface of different format
+		Surface dst(0, 10, 10, 16, 0xf800, 0x07e0, 0x001f, 0);
+		src.Resize(dst, ResizeFilter::Bicubic);
+		{
+			Surface::LockHandle lock = dst.Lock();
+			EXPECT_EQUAL(static_cast<const Uint16*>(lock.GetPixels())[0], 0x4102);
+		}
+
+		EXPECT_EXCEPTION(src.Resize(0, 10, ResizeFilter::Bilinear), std::invalid_argument);
+	}
+END_TEST()
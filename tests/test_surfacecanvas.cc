@@ -0,0 +1,137 @@
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+
+#include <SDL_main.h>
+#include <SDL_pixels.h>
+
+#include <SDL2pp/SurfaceCanvas.hh>
+#include <SDL2pp/Surface.hh>
+#include <SDL2pp/ThreadPool.hh>
+
+#include "testing.h"
+
+using namespace SDL2pp;
+
+static void FillPattern(Surface& surface, int seed) {
+	Surface::LockHandle lock = surface.Lock();
+	size_t row_bytes = static_cast<size_t>(surface.GetWidth() * surface.Get()->format->BytesPerPixel);
+	for (int y = 0; y < surface.GetHeight(); y++) {
+		Uint8* row = static_cast<Uint8*>(lock.GetPixels()) + y * lock.GetPitch();
+		for (size_t x = 0; x < row_bytes; x++)
+			row[x] = static_cast<Uint8>(x * 7 + y * 13 + seed * 31);
+	}
+}
+
+static bool SurfacesIdentical(Surface& a, Surface& b) {
+	if (a.GetFormat() != b.GetFormat() || a.GetSize() != b.GetSize())
+		return false;
+
+	Surface::LockHandle alock = a.Lock();
+	Surface::LockHandle block = b.Lock();
+	size_t row_bytes = static_cast<size_t>(a.GetWidth() * a.Get()->format->BytesPerPixel);
+	for (int y = 0; y < a.GetHeight(); y++)
+		if (std::memcmp(static_cast<const Uint8*>(alock.GetPixels()) + y * alock.GetPitch(), static_cast<const Uint8*>(block.GetPixels()) + y * block.GetPitch(), row_bytes) != 0)
+			return false;
+
+	return true;
+}
+
+BEGIN_TEST(int, char*[])
+	ThreadPool pool(3);
+
+	// sources covering both blit kernel and SDL blitter paths
+	Surface blended(0, 50, 40, 32, 0x00ff0000, 0x0000ff00, 0x000000ff, 0xff000000);
+	FillPattern(blended, 1);
+	blended.SetBlendMode(SDL_BLENDMODE_BLEND);
+
+	Surface opaque(0, 70, 30, 24, 0x000000ff, 0x0000ff00, 0x00ff0000, 0);
+	FillPattern(opaque, 2);
+
+	Surface keyed(0, 33, 77, 16, 0xf800, 0x07e0, 0x001f, 0);
+	FillPattern(keyed, 3);
+	keyed.SetColorKey(true, 0x1234);
+
+	Surface modulated(0, 64, 64, 32, 0x00ff0000, 0x0000ff00, 0x000000ff, 0xff000000);
+	FillPattern(modulated, 4);
+	modulated.SetBlendMode(SDL_BLENDMODE_ADD);
+	modulated.SetColorMod(200, 100, 50);
+	modulated.SetAlphaMod(150);
+
+	const Uint32 target_formats[] = { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB565 };
+	for (Uint32 target_format : target_formats) {
+		int bpp;
+		Uint32 rmask, gmask, bmask, amask;
+		SDL_PixelFormatEnumToMasks(target_format, &bpp, &rmask, &gmask, &bmask, &amask);
+
+		Surface expected(0, 301, 203, bpp, rmask, gmask, bmask, amask);
+		Surface actual(0, 301, 203, bpp, rmask, gmask, bmask, amask);
+		FillPattern(expected, 5);
+		FillPattern(actual, 5);
+
+		SurfaceCanvas canvas(actual, 32);
+
+		// same sequence applied directly and through canvas
+		auto draw = [&](std::function<void(const Optional<Rect>&, Uint32)> fill, std::function<void(Surface&, const Optional<Rect>&, const Rect&)> blit, Surface& target) {
+			fill(NullOpt, 0x11223344);
+			fill(Rect(-10, 20, 100, 50), 0x55667788);
+			for (int i = 0; i < 40; i++) {
+				blit(blended, NullOpt, Rect(i * 17 - 20, i * 11 - 10, 0, 0));
+				blit(opaque, Rect(5, -5, 60, 30), Rect(i * 23 % 290, i * 29 % 190, 0, 0));
+				blit(keyed, NullOpt, Rect(i * 31 % 310, i * 7 % 210, 0, 0));
+				blit(modulated, Rect(10, 10, 40, 40), Rect(i * 13 % 280, i * 19 % 200, 0, 0));
+				if (i % 10 == 0)
+					fill(Rect(i * 5, i * 3, 70, 70), 0x99aabbcc + i);
+			}
+
+			// clip rectangle is taken at recording time
+			target.SetClipRect(Rect(40, 30, 150, 100));
+			fill(NullOpt, 0xddeeff00);
+			blit(blended, NullOpt, Rect(30, 20, 0, 0));
+			target.SetClipRect();
+
+			// self blit is done serially in order
+			blit(target, Rect(0, 0, 64, 64), Rect(200, 100, 0, 0));
+			blit(blended, NullOpt, Rect(210, 110, 0, 0));
+		};
+
+		draw(
+			[&](const Optional<Rect>& rect, Uint32 color) { expected.FillRect(rect, color); },
+			[&](Surface& src, const Optional<Rect>& srcrect, const Rect& dstrect) { src.Blit(srcrect, expected, dstrect); },
+			expected
+		);
+
+		draw(
+			[&](const Optional<Rect>& rect, Uint32 color) { canvas.FillRect(rect, color); },
+			[&](Surface& src, const Optional<Rect>& srcrect, const Rect& dstrect) { canvas.Blit(src, srcrect, dstrect); },
+			actual
+		);
+
+		EXPECT_TRUE(canvas.GetNumPending() > 100);
+		canvas.Flush(pool);
+		EXPECT_EQUAL(canvas.GetNumPending(), 0U);
+
+		EXPECT_TRUE(SurfacesIdentical(expected, actual));
+		EXPECT_EQUAL(actual.GetClipRect(), Rect(0, 0, 301, 203));
+
+		// second flush reuses tile views
+		Rect rects[] = { Rect(0, 0, 10, 10), Rect(100, 100, 150, 20), Rect(290, 190, 50, 50) };
+		expected.FillRects(rects, 3, 0x01020304);
+		canvas.FillRects(rects, 3, 0x01020304).Flush(pool);
+
+		EXPECT_TRUE(SurfacesIdentical(expected, actual));
+
+		// single tile
+		SurfaceCanvas single_tile_canvas(actual, 1024);
+		single_tile_canvas.Blit(blended, NullOpt, Rect(3, 3, 0, 0)).Flush(pool);
+		blended.Blit(NullOpt, expected, Rect(3, 3, 0, 0));
+
+		EXPECT_TRUE(SurfacesIdentical(expected, actual));
+
+		// Clear() discards operations
+		canvas.FillRect(NullOpt, 0).Clear().Flush(pool);
+		EXPECT_TRUE(SurfacesIdentical(expected, actual));
+	}
+
+	EXPECT_EXCEPTION(SurfaceCanvas(blended, 0), std::invalid_argument);
+END_TEST()
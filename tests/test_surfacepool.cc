@@ -0,0 +1,161 @@
+#include <stdexcept>
+#include <utility>
+
+#include <SDL_main.h>
+#include <SDL_pixels.h>
+
+#include <SDL2pp/SurfacePool.hh>
+#include <SDL2pp/Surface.hh>
+#include <SDL2pp/Exception.hh>
+
+#include "testing.h"
+
+using namespace SDL2pp;
+
+BEGIN_TEST(int, char*[])
+	{
+		// Released surface is reused
+		SurfacePool pool;
+
+		void* pixels;
+		{
+			SurfacePool::SurfaceHandle surface = pool.Acquire(32, 16, SDL_PIXELFORMAT_ARGB8888);
+			EXPECT_TRUE(surface.IsValid());
+			EXPECT_EQUAL(surface->GetWidth(), 32);
+			EXPECT_EQUAL(surface->GetHeight(), 16);
+			EXPECT_EQUAL(surface->GetFormat(), (Uint32)SDL_PIXELFORMAT_ARGB8888);
+			EXPECT_EQUAL(pool.GetNumFree(), 0U);
+			pixels = surface->Get()->pixels;
+		}
+
+		EXPECT_EQUAL(pool.GetNumFree(), 1U);
+		EXPECT_EQUAL(pool.GetNumAllocated(), 1U);
+
+		SurfacePool::SurfaceHandle surface = pool.Acquire(32, 16, SDL_PIXELFORMAT_ARGB8888);
+		EXPECT_EQUAL(surface->Get()->pixels, pixels);
+		EXPECT_EQUAL(pool.GetNumFree(), 0U);
+		EXPECT_EQUAL(pool.GetNumAllocated(), 1U);
+	}
+
+	{
+		// Surfaces are keyed by size and format
+		SurfacePool pool;
+
+		pool.Acquire(32, 16, SDL_PIXELFORMAT_ARGB8888);
+		pool.Acquire(16, 32, SDL_PIXELFORMAT_ARGB8888).Release();
+		pool.Acquire(32, 16, SDL_PIXELFORMAT_RGB565);
+
+		EXPECT_EQUAL(pool.GetNumFree(), 3U);
+		EXPECT_EQUAL(pool.GetNumAllocated(), 3U);
+
+		SurfacePool::SurfaceHandle surface = pool.Acquire(32, 16, SDL_PIXELFORMAT_RGB565);
+		EXPECT_EQUAL(surface->GetFormat(), (Uint32)SDL_PIXELFORMAT_RGB565);
+		EXPECT_EQUAL(pool.GetNumAllocated(), 3U);
+
+		pool.Acquire(64, 64, SDL_PIXELFORMAT_RGB565);
+		EXPECT_EQUAL(pool.GetNumAllocated(), 4U);
+	}
+
+	{
+		// Steady state does not allocate new surfaces
+		SurfacePool pool;
+		pool.Reserve(8, 8, SDL_PIXELFORMAT_ABGR8888, 3);
+		EXPECT_EQUAL(pool.GetNumFree(), 3U);
+		EXPECT_EQUAL(pool.GetNumAllocated(), 3U);
+
+		for (int frame = 0; frame < 100; frame++) {
+			SurfacePool::SurfaceHandle a = pool.Acquire(8, 8, SDL_PIXELFORMAT_ABGR8888);
+			SurfacePool::SurfaceHandle b = pool.Acquire(8, 8, SDL_PIXELFORMAT_ABGR8888);
+			SurfacePool::SurfaceHandle c = pool.Acquire(8, 8, SDL_PIXELFORMAT_ABGR8888);
+			a->FillRect(NullOpt, 0);
+		}
+
+		EXPECT_EQUAL(pool.GetNumFree(), 3U);
+		EXPECT_EQUAL(pool.GetNumAllocated(), 3U);
+	}
+
+	{
+		// Surface state is reset on release
+		SurfacePool pool;
+
+		{
+			SurfacePool::SurfaceHandle surface = pool.Acquire(16, 16, SDL_PIXELFORMAT_ARGB8888);
+			surface->SetBlendMode(SDL_BLENDMODE_ADD);
+			surface->SetColorMod(1, 2, 3);
+			surface->SetAlphaMod(4);
+			surface->SetColorKey(true, 0);
+			surface->SetClipRect(Rect(1, 2, 3, 4));
+		}
+
+		SurfacePool::SurfaceHandle surface = pool.Acquire(16, 16, SDL_PIXELFORMAT_ARGB8888);
+		EXPECT_EQUAL(surface->GetBlendMode(), SDL_BLENDMODE_BLEND);
+		EXPECT_EQUAL(surface->GetAlphaMod(), 255);
+		EXPECT_EQUAL(surface->GetClipRect(), Rect(0, 0, 16, 16));
+
+		Uint8 r, g, b;
+		surface->GetColorMod(r, g, b);
+		EXPECT_EQUAL(r, 255);
+		EXPECT_EQUAL(g, 255);
+		EXPECT_EQUAL(b, 255);
+
+		EXPECT_EXCEPTION(surface->GetColorKey(), Exception);
+	}
+
+	{
+		// Handles are movable
+		SurfacePool pool;
+
+		SurfacePool::SurfaceHandle empty;
+		EXPECT_TRUE(!empty.IsValid());
+
+		SurfacePool::SurfaceHandle a = pool.Acquire(4, 4, SDL_PIXELFORMAT_RGB888);
+		SDL_Surface* raw = a->Get();
+
+		SurfacePool::SurfaceHandle b(std::move(a));
+		EXPECT_TRUE(!a.IsValid());
+		EXPECT_EQUAL(b->Get(), raw);
+
+		empty = std::move(b);
+		EXPECT_TRUE(!b.IsValid());
+		EXPECT_EQUAL(empty->Get(), raw);
+		EXPECT_EQUAL(pool.GetNumFree(), 0U);
+
+		empty = pool.Acquire(4, 4, SDL_PIXELFORMAT_RGB888);
+		EXPECT_EQUAL(pool.GetNumFree(), 1U);
+
+		empty.Release();
+		EXPECT_TRUE(!empty.IsValid());
+		EXPECT_EQUAL(pool.GetNumFree(), 2U);
+
+		pool.Clear();
+		EXPECT_EQUAL(pool.GetNumFree(), 0U);
+		EXPECT_EQUAL(pool.GetNumAllocated(), 2U);
+	}
+
+	{
+		// Conversion into pooled surface
+		SurfacePool pool;
+
+		Surface source(0, 2, 1, 32, 0x00ff0000, 0x0000ff00, 0x000000ff, 0xff000000);
+		{
+			Surface::LockHandle lock = source.Lock();
+			static_cast<Uint32*>(lock.GetPixels())[0] = 0xff112233;
+			static_cast<Uint32*>(lock.GetPixels())[1] = 0x80445566;
+		}
+
+		SurfacePool::SurfaceHandle converted = pool.Convert(source, SDL_PIXELFORMAT_ABGR8888);
+		EXPECT_EQUAL(converted->GetFormat(), (Uint32)SDL_PIXELFORMAT_ABGR8888);
+
+		Surface::LockHandle lock = converted->Lock();
+		EXPECT_EQUAL(static_cast<Uint32*>(lock.GetPixels())[0], 0xff332211U);
+		EXPECT_EQUAL(static_cast<Uint32*>(lock.GetPixels())[1], 0x80665544U);
+	}
+
+	{
+		// Invalid arguments
+		SurfacePool pool;
+		EXPECT_EXCEPTION(pool.Acquire(-1, 1, SDL_PIXELFORMAT_ARGB8888), std::invalid_argument);
+		EXPECT_EXCEPTION(pool.Acquire(1, 1, SDL_PIXELFORMAT_IYUV), Exception);
+		EXPECT_EQUAL(pool.GetNumAllocated(), 0U);
+	}
+END_TEST()
@@ -0,0 +1,95 @@
+#include <stdexcept>
+
+#include <SDL_main.h>
+
+#include <SDL2pp/Font.hh>
+#include <SDL2pp/SDLTTF.hh>
+#include <SDL2pp/TextCache.hh>
+
+#include "testing.h"
+
+using namespace SDL2pp;
+
+BEGIN_TEST(int, char*[])
+	SDLTTF ttf;
+	Font font(TESTDATA_DIR "/Vera.ttf", 30);
+
+	{
+		// Hits and misses
+		TextCache cache(1 << 20);
+
+		Surface& first = cache.GetSurfaceUTF8(font, u8"AA", TextRenderMode::Blended, Color(255, 255, 255));
+		EXPECT_EQUAL(first.GetSize(), Point(43, 36));
+		EXPECT_EQUAL(&cache.GetSurfaceUTF8(font, u8"AA", TextRenderMode::Blended, Color(255, 255, 255)), &first);
+
+		// every part of the key matters, except background outside of shaded mode
+		cache.GetSurfaceUTF8(font, u8"AB", TextRenderMode::Blended, Color(255, 255, 255));
+		cache.GetSurfaceUTF8(font, u8"AA", TextRenderMode::Blended, Color(255, 0, 0));
+		cache.GetSurfaceUTF8(font, u8"AA", TextRenderMode::Solid, Color(255, 255, 255));
+		cache.GetSurfaceUTF8(font, u8"AA", TextRenderMode::Blended, Color(255, 255, 255), Color(0, 0, 255));
+		cache.GetSurfaceUTF8(font, u8"AA", TextRenderMode::Shaded, Color(255, 255, 255), Color(0, 0, 255));
+		cache.GetSurfaceUTF8(font, u8"AA", TextRenderMode::Shaded, Color(255, 255, 255), Color(0, 255, 0));
+
+		font.SetStyle(TTF_STYLE_BOLD);
+		cache.GetSurfaceUTF8(font, u8"AA", TextRenderMode::Blended, Color(255, 255, 255));
+		font.SetStyle();
+
+		EXPECT_EQUAL(cache.GetNumEntries(), 7U);
+
+		TextCache::FrameStats stats = cache.GetCurrentFrameStats();
+		EXPECT_EQUAL(stats.hits, 2U);
+		EXPECT_EQUAL(stats.misses, 7U);
+		EXPECT_EQUAL(stats.evictions, 0U);
+		EXPECT_EQUAL(stats.bytes_rendered, cache.GetUsedBytes());
+
+		// per-frame statistics
+		EXPECT_EQUAL(cache.GetFrameStats().misses, 0U);
+		cache.NextFrame();
+		EXPECT_EQUAL(cache.GetFrameStats().misses, 7U);
+		EXPECT_EQUAL(cache.GetCurrentFrameStats().misses, 0U);
+
+		cache.GetSurfaceUTF8(font, u8"AA", TextRenderMode::Solid, Color(255, 255, 255));
+		EXPECT_EQUAL(cache.GetCurrentFrameStats().hits, 1U);
+		EXPECT_EQUAL(cache.GetCurrentFrameStats().misses, 0U);
+
+		// surface cache has no textures
+		EXPECT_EXCEPTION(cache.GetTextureUTF8(font, u8"AA", TextRenderMode::Solid, Color(255, 255, 255)), std::logic_error);
+
+		cache.Remove(font);
+		EXPECT_EQUAL(cache.GetNumEntries(), 0U);
+		EXPECT_EQUAL(cache.GetUsedBytes(), 0U);
+	}
+
+	{
+		// Byte budget
+		TextCache cache(0);
+
+		// last rendered image is kept even if it does not fit
+		cache.GetSurfaceUTF8(font, u8"A", TextRenderMode::Blended, Color(255, 255, 255));
+		EXPECT_EQUAL(cache.GetNumEntries(), 1U);
+
+		size_t size = cache.GetUsedBytes();
+		EXPECT_TRUE(size > 0);
+
+		cache.SetByteBudget(size * 2);
+		cache.GetSurfaceUTF8(font, u8"B", TextRenderMode::Blended, Color(255, 255, 255));
+		cache.GetSurfaceUTF8(font, u8"C", TextRenderMode::Blended, Color(255, 255, 255));
+
+		// most recently used image survives
+		cache.GetSurfaceUTF8(font, u8"A", TextRenderMode::Blended, Color(255, 255, 255));
+		EXPECT_TRUE(cache.GetUsedBytes() <= cache.GetByteBudget());
+		EXPECT_TRUE(cache.GetCurrentFrameStats().evictions >= 1U);
+
+		cache.NextFrame();
+		cache.GetSurfaceUTF8(font, u8"A", TextRenderMode::Blended, Color(255, 255, 255));
+		EXPECT_EQUAL(cache.GetCurrentFrameStats().hits, 1U);
+
+		cache.SetByteBudget(0);
+		EXPECT_EQUAL(cache.GetNumEntries(), 0U);
+
+		cache.GetSurfaceUTF8(font, u8"A", TextRenderMode::Blended, Color(255, 255, 255));
+		cache.Clear();
+		EXPECT_EQUAL(cache.GetNumEntries(), 0U);
+		EXPECT_EQUAL(cache.GetUsedBytes(), 0U);
+	}
+END_TEST()
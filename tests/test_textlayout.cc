@@ -0,0 +1,144 @@
+#include <stdexcept>
+
+#include <SDL_main.h>
+
+#include <SDL2pp/Font.hh>
+#include <SDL2pp/SDLTTF.hh>
+#include <SDL2pp/TextLayout.hh>
+
+#include "testing.h"
+
+using namespace SDL2pp;
+
+BEGIN_TEST(int, char*[])
+	SDLTTF ttf;
+	Font font(TESTDATA_DIR "/Vera.ttf", 30);
+
+	// makes widths exact sums of advances
+	font.SetKerning(false);
+
+	const int a = font.GetGlyphAdvance(u'A');
+	const int s = font.GetGlyphAdvance(u' ');
+	const int lh = font.GetLineSkip();
+
+	{
+		// Construction
+		TextLayout layout(font, 100);
+
+		EXPECT_EQUAL(layout.GetNumLines(), 1U);
+		EXPECT_EQUAL(layout.GetLine(0).begin, 0U);
+		EXPECT_EQUAL(layout.GetLine(0).end, 0U);
+		EXPECT_EQUAL(layout.GetLineHeight(), lh);
+		EXPECT_EQUAL(layout.GetSize(), Point(0, lh));
+	}
+
+	{
+		// Greedy wrapping and incremental edits
+		TextLayout layout(font, 4 * a + s);
+
+		layout.SetText(u8"AA AA AA");
+		EXPECT_EQUAL(layout.GetNumLines(), 2U);
+		EXPECT_EQUAL(layout.GetLine(0).begin, 0U);
+		EXPECT_EQUAL(layout.GetLine(0).end, 5U);
+		EXPECT_EQUAL(layout.GetLine(0).rect, Rect(0, 0, 4 * a + s, lh));
+		EXPECT_EQUAL(layout.GetLine(1).begin, 6U);
+		EXPECT_EQUAL(layout.GetLine(1).end, 8U);
+		EXPECT_EQUAL(layout.GetLine(1).rect, Rect(0, lh, 2 * a, lh));
+
+		layout.Append(u8" AA");
+		EXPECT_EQUAL(layout.GetNumLines(), 2U);
+		EXPECT_EQUAL(layout.GetLine(1).end, 11U);
+
+		layout.Append(u8"\nAA");
+		EXPECT_EQUAL(layout.GetNumLines(), 3U);
+		EXPECT_EQUAL(layout.GetLine(2).begin, 12U);
+		EXPECT_EQUAL(layout.GetLine(2).end, 14U);
+
+		// first paragraph gets a line more, second one is moved
+		layout.Insert(0, u8"AA ");
+		EXPECT_EQUAL(layout.GetText(), std::string(u8"AA AA AA AA AA\nAA"));
+		EXPECT_EQUAL(layout.GetNumLines(), 4U);
+		EXPECT_EQUAL(layout.GetLine(2).begin, 12U);
+		EXPECT_EQUAL(layout.GetLine(2).end, 14U);
+		EXPECT_EQUAL(layout.GetLine(3).begin, 15U);
+		EXPECT_EQUAL(layout.GetLine(3).end, 17U);
+		EXPECT_EQUAL(layout.GetLine(3).rect, Rect(0, 3 * lh, 2 * a, lh));
+
+		// splitting paragraph; leading space is kept on the line
+		layout.Insert(2, u8"\n");
+		EXPECT_EQUAL(layout.GetNumLines(), 5U);
+		EXPECT_EQUAL(layout.GetLine(0).end, 2U);
+		EXPECT_EQUAL(layout.GetLine(1).begin, 3U);
+		EXPECT_EQUAL(layout.GetLine(1).rect.w, s + 2 * a);
+		EXPECT_EQUAL(layout.GetLine(4).begin, 16U);
+
+		// trailing newline makes an empty line
+		layout.Append(u8"\n");
+		EXPECT_EQUAL(layout.GetNumLines(), 6U);
+		EXPECT_EQUAL(layout.GetLine(5).begin, 19U);
+		EXPECT_EQUAL(layout.GetLine(5).end, 19U);
+
+		EXPECT_EXCEPTION(layout.Insert(100, u8"A"), std::out_of_range);
+
+		// same result as laying out from scratch
+		TextLayout fresh(font, 4 * a + s);
+		fresh.SetText(layout.GetText());
+		EXPECT_EQUAL(fresh.GetNumLines(), layout.GetNumLines());
+		for (size_t i = 0; i < fresh.GetNumLines(); i++) {
+			EXPECT_EQUAL(fresh.GetLine(i).begin, layout.GetLine(i).begin);
+			EXPECT_EQUAL(fresh.GetLine(i).end, layout.GetLine(i).end);
+			EXPECT_EQUAL(fresh.GetLine(i).rect, layout.GetLine(i).rect);
+		}
+	}
+
+	{
+		// Optimal breaking
+		TextLayout layout(font, 5 * a + s);
+		layout.SetText(u8"AAA AA AA AAAAA");
+
+		EXPECT_EQUAL(layout.GetNumLines(), 3U);
+		EXPECT_EQUAL(layout.GetLine(0).end, 6U);
+		EXPECT_EQUAL(layout.GetLine(1).begin, 7U);
+		EXPECT_EQUAL(layout.GetLine(1).end, 9U);
+
+		layout.SetLineBreaking(LineBreaking::Optimal);
+		EXPECT_EQUAL(layout.GetNumLines(), 3U);
+		EXPECT_EQUAL(layout.GetLine(0).end, 3U);
+		EXPECT_EQUAL(layout.GetLine(1).begin, 4U);
+		EXPECT_EQUAL(layout.GetLine(1).end, 9U);
+		EXPECT_EQUAL(layout.GetLine(2).begin, 10U);
+
+		// no wrapping
+		layout.SetWidth(0);
+		EXPECT_EQUAL(layout.GetNumLines(), 1U);
+		EXPECT_EQUAL(layout.GetSize(), Point(12 * a + 3 * s, lh));
+	}
+
+	{
+		// Alignment, line height and hit testing
+		TextLayout layout(font, 4 * a + s, TextAlignment::Right);
+		layout.SetText(u8"AA AA AA");
+
+		EXPECT_EQUAL(layout.GetLine(1).rect.x, 2 * a + s);
+
+		layout.SetAlignment(TextAlignment::Center);
+		EXPECT_EQUAL(layout.GetLine(1).rect.x, (2 * a + s) / 2);
+
+		layout.SetLineHeight(50);
+		EXPECT_EQUAL(layout.GetLine(1).rect, Rect((2 * a + s) / 2, 50, 2 * a, 50));
+		EXPECT_EQUAL(layout.GetSize(), Point(4 * a + s, 100));
+		EXPECT_EXCEPTION(layout.SetLineHeight(0), std::invalid_argument);
+
+		layout.SetAlignment(TextAlignment::Left);
+		EXPECT_TRUE(*layout.GetLineAt(Point(1, 1)) == 0U);
+		EXPECT_TRUE(*layout.GetLineAt(Point(1, 51)) == 1U);
+		EXPECT_TRUE(!layout.GetLineAt(Point(-1, 1)));
+		EXPECT_TRUE(!layout.GetLineAt(Point(3 * a, 51)));
+		EXPECT_TRUE(!layout.GetLineAt(Point(1, 101)));
+
+		EXPECT_EQUAL(layout.GetOffsetAt(Point(0, 0)), 0U);
+		EXPECT_EQUAL(layout.GetOffsetAt(Point(a + a / 2 + 1, 0)), 2U);
+		EXPECT_EQUAL(layout.GetOffsetAt(Point(1000, 0)), 5U);
+		EXPECT_EQUAL(layout.GetOffsetAt(Point(0, 1000)), 6U);
+	}
+END_TEST()
@@ -0,0 +1,127 @@
+#include <atomic>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <SDL_main.h>
+
+#include <SDL2pp/ThreadPool.hh>
+#include <SDL2pp/Surface.hh>
+
+#include "testing.h"
+
+using namespace SDL2pp;
+
+static bool SurfacesIdentical(Surface& a, Surface& b) {
+	if (a.GetFormat() != b.GetFormat() || a.GetSize() != b.GetSize())
+		return false;
+
+	Surface::LockHandle alock = a.Lock();
+	Surface::LockHandle block = b.Lock();
+	size_t row_bytes = static_cast<size_t>(a.GetWidth() * a.Get()->format->BytesPerPixel);
+	for (int y = 0; y < a.GetHeight(); y++)
+		if (std::memcmp(static_cast<const Uint8*>(alock.GetPixels()) + y * alock.GetPitch(), static_cast<const Uint8*>(block.GetPixels()) + y * block.GetPitch(), row_bytes) != 0)
+			return false;
+
+	return true;
+}
+
+BEGIN_TEST(int, char*[])
+	ThreadPool pool(3);
+
+	EXPECT_EQUAL(pool.GetConcurrency(), 4U);
+
+	{
+		// Every item is processed exactly once
+		std::vector<std::atomic<int>> counts(1000);
+		for (auto& count : counts)
+			count = 0;
+
+		std::atomic<int> calls(0);
+		pool.ParallelFor(0, 1000, 10, [&](int begin, int end) {
+				calls++;
+				for (int i = begin; i < end; i++)
+					counts[i]++;
+			});
+
+		bool all_once = true;
+		for (auto& count : counts)
+			if (count != 1)
+				all_once = false;
+
+		EXPECT_TRUE(all_once);
+		EXPECT_EQUAL(calls.load(), 4);
+	}
+
+	{
+		// Short ranges stay on calling thread
+		std::thread::id caller = std::this_thread::get_id();
+		std::thread::id worker;
+		int calls = 0;
+
+		pool.ParallelFor(0, 100, 64, [&](int, int) {
+				worker = std::this_thread::get_id();
+				calls++;
+			});
+
+		EXPECT_EQUAL(calls, 1);
+		EXPECT_TRUE(worker == caller);
+
+		pool.ParallelFor(5, 5, 1, [&](int, int) { calls++; });
+		EXPECT_EQUAL(calls, 1);
+	}
+
+	{
+		// Exceptions propagate
+		EXPECT_EXCEPTION(pool.ParallelFor(0, 100, 1, [](int begin, int) {
+				if (begin != 0)
+					throw std::runtime_error("chunk failed");
+			}), std::runtime_error);
+	}
+
+	{
+		// Nested calls
+		std::atomic<int> sum(0);
+		pool.ParallelFor(0, 8, 1, [&](int begin, int end) {
+				for (int i = begin; i < end; i++)
+					pool.ParallelFor(0, 100, 1, [&](int b, int e) { sum += e - b; });
+			});
+
+		EXPECT_EQUAL(sum.load(), 800);
+	}
+
+	{
+		// Parallel surface conversion
+		Surface src(0, 123, 517, 32, 0x000000ff, 0x0000ff00, 0x00ff0000, 0xff000000);
+		{
+			Surface::LockHandle lock = src.Lock();
+			for (int y = 0; y < src.GetHeight(); y++) {
+				Uint8* row = static_cast<Uint8*>(lock.GetPixels()) + y * lock.GetPitch();
+				for (int x = 0; x < src.GetWidth() * 4; x++)
+					row[x] = static_cast<Uint8>(x * 7 + y * 13);
+			}
+		}
+
+		const Uint32 formats[] = { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB24, SDL_PIXELFORMAT_RGB565 };
+		for (Uint32 format : formats) {
+			Surface serial = src.Convert(format);
+			Surface parallel = src.Convert(format, pool, 16);
+
+			EXPECT_TRUE(SurfacesIdentical(serial, parallel));
+			EXPECT_EQUAL(parallel.GetBlendMode(), serial.GetBlendMode());
+			EXPECT_EQUAL(parallel.GetAlphaMod(), serial.GetAlphaMod());
+		}
+
+		// modulation is carried over
+		src.SetAlphaMod(128);
+		src.SetColorMod(1, 2, 3);
+
+		Surface serial = src.Convert(SDL_PIXELFORMAT_RGB24);
+		Surface parallel = src.Convert(SDL_PIXELFORMAT_RGB24, pool, 16);
+
+		EXPECT_EQUAL(parallel.GetBlendMode(), serial.GetBlendMode());
+		EXPECT_EQUAL(parallel.GetAlphaMod(), serial.GetAlphaMod());
+		EXPECT_EQUAL(parallel.GetColorAndAlphaMod(), serial.GetColorAndAlphaMod());
+	}
+END_TEST()
@@ -0,0 +1,100 @@
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+#include <SDL_main.h>
+
+#include <SDL2pp/YUVFrame.hh>
+#include <SDL2pp/YUVFramePool.hh>
+
+#include "testing.h"
+
+using namespace SDL2pp;
+
+static bool IsAligned(const void* ptr, size_t alignment) {
+	return reinterpret_cast<std::uintptr_t>(ptr) % alignment == 0;
+}
+
+BEGIN_TEST(int, char*[])
+	{
+		// Planar layout
+		YUVFrame frame(SDL_PIXELFORMAT_IYUV, 101, 51, 32);
+
+		EXPECT_TRUE(frame.IsOwning());
+		EXPECT_EQUAL(frame.GetNumPlanes(), 3);
+		EXPECT_EQUAL(frame.GetSize(), Point(101, 51));
+
+		EXPECT_EQUAL(frame.GetPitch(0), 128);
+		EXPECT_EQUAL(frame.GetPitch(1), 64);
+		EXPECT_EQUAL(frame.GetPitch(2), 64);
+
+		for (int plane = 0; plane < 3; plane++)
+			EXPECT_TRUE(IsAligned(frame.GetPlane(plane), 32));
+
+		// planes do not overlap
+		EXPECT_TRUE(frame.GetPlane(1) >= frame.GetPlane(0) + 128 * 51);
+		EXPECT_TRUE(frame.GetPlane(2) >= frame.GetPlane(1) + 64 * 26);
+	}
+
+	{
+		// YV12 stores V before U
+		YUVFrame frame(SDL_PIXELFORMAT_YV12, 64, 64, 16);
+
+		EXPECT_TRUE(frame.GetPlane(2) < frame.GetPlane(1));
+	}
+
+	{
+		// Semi-planar layout
+		YUVFrame frame(SDL_PIXELFORMAT_NV12, 101, 51, 16);
+
+		EXPECT_EQUAL(frame.GetNumPlanes(), 2);
+		EXPECT_EQUAL(frame.GetPitch(0), 112);
+		EXPECT_EQUAL(frame.GetPitch(1), 112);
+		EXPECT_TRUE(IsAligned(frame.GetPlane(1), 16));
+	}
+
+	{
+		// Move keeps planes
+		YUVFrame frame(SDL_PIXELFORMAT_IYUV, 16, 16);
+		Uint8* luma = frame.GetPlane(0);
+
+		YUVFrame moved(std::move(frame));
+		EXPECT_TRUE(moved.GetPlane(0) == luma);
+		EXPECT_TRUE(!frame.IsOwning());
+	}
+
+	{
+		// Invalid arguments
+		EXPECT_EXCEPTION(YUVFrame(SDL_PIXELFORMAT_ARGB8888, 16, 16), std::invalid_argument);
+		EXPECT_EXCEPTION(YUVFrame(SDL_PIXELFORMAT_IYUV, 16, 16, 24), std::invalid_argument);
+		EXPECT_EXCEPTION(YUVFramePool(SDL_PIXELFORMAT_ARGB8888, 16, 16), std::invalid_argument);
+	}
+
+	{
+		// Pool recycling
+		YUVFramePool pool(SDL_PIXELFORMAT_IYUV, 64, 32, 32, 1);
+
+		EXPECT_EQUAL(pool.GetNumAllocated(), 1U);
+		EXPECT_EQUAL(pool.GetNumFree(), 1U);
+
+		YUVFrame a = pool.Acquire();
+		YUVFrame b = pool.Acquire();
+		EXPECT_EQUAL(pool.GetNumAllocated(), 2U);
+		EXPECT_EQUAL(pool.GetNumFree(), 0U);
+
+		Uint8* a_luma = a.GetPlane(0);
+		pool.Release(std::move(a));
+		pool.Release(std::move(b));
+		EXPECT_EQUAL(pool.GetNumFree(), 2U);
+
+		// foreign frames are dropped
+		pool.Release(YUVFrame(SDL_PIXELFORMAT_IYUV, 32, 32));
+		EXPECT_EQUAL(pool.GetNumFree(), 2U);
+
+		// steady state reuses frames
+		YUVFrame c = pool.Acquire();
+		YUVFrame d = pool.Acquire();
+		EXPECT_TRUE(c.GetPlane(0) == a_luma || d.GetPlane(0) == a_luma);
+		EXPECT_EQUAL(pool.GetNumAllocated(), 2U);
+	}
+END_TEST()